@@ -0,0 +1,109 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file allocation_map.h
+// \brief Defines functions to find which LBAs of a logical block provisioned device are mapped, so that deallocated regions can be skipped.
+
+#pragma once
+
+#include "common_public.h"
+#include "surface_scan.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    //provisioning status field of an LBA status descriptor
+    typedef enum _eLBAProvisioningStatus
+    {
+        LBA_PROVISIONING_STATUS_MAPPED_OR_UNKNOWN   = 0x0,
+        LBA_PROVISIONING_STATUS_DEALLOCATED         = 0x1,
+        LBA_PROVISIONING_STATUS_ANCHORED            = 0x2,
+        LBA_PROVISIONING_STATUS_MAPPED              = 0x3,
+        LBA_PROVISIONING_STATUS_UNKNOWN             = 0x4,
+    }eLBAProvisioningStatus;
+
+    #define ALLOCATION_MAP_STATUS_BUFFER_SIZE UINT32_C(16392) //8 byte header + 1024 LBA status descriptors
+    #define LBA_STATUS_DESCRIPTOR_LENGTH 16
+
+    typedef struct _allocationMapIterator
+    {
+        tDevice *device;
+        uint64_t nextLBA;//first LBA not yet covered by a descriptor
+        uint64_t endLBA;
+        uint8_t *statusData;
+        uint32_t descriptorOffset;//next descriptor to look at in statusData
+        uint32_t descriptorEnd;
+        lbaInterval pending;//mapped LBAs found so far that may continue into the next descriptor
+        uint32_t commandsIssued;
+    }allocationMapIterator;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  start_Allocation_Map()
+    //
+    //! \brief   Description:  Sets up an iterator over the mapped extents of a range of LBAs, read with the SCSI GET LBA STATUS command.
+    //!                        Deallocated and anchored LBAs are left out. LBAs the device reports as mapped or unknown are treated as mapped, so nothing that may hold data is skipped.
+    //!                        NVMe and ATA have no command that reports the allocation state of LBAs, so this is only supported when drive_type is SCSI_DRIVE.
+    //!                        That includes NVMe and ATA devices behind a translator that does not pass their commands through. Devices the library talks to as ATA or NVMe,
+    //!                        including ATA devices reached with SAT passthrough commands, get NOT_SUPPORTED.
+    //
+    //  Entry:
+    //!   \param[in] device = device to get the allocation map from
+    //!   \param[in] startLBA = first LBA to report
+    //!   \param[in] range = number of LBAs to report. 0 = to the end of the device
+    //!   \param[out] iterator = iterator to set up. Must be freed with free_Allocation_Map()
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, or NOT_SUPPORTED = not a SCSI drive, or the device does not support GET LBA STATUS
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int start_Allocation_Map(tDevice *device, uint64_t startLBA, uint64_t range, allocationMapIterator *iterator);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Next_Mapped_Extent()
+    //
+    //! \brief   Description:  Gets the next run of mapped LBAs. Runs that are next to each other are returned as one extent, even when the device reports them separately.
+    //
+    //  Entry:
+    //!   \param[in] iterator = iterator from start_Allocation_Map()
+    //!   \param[out] extent = next mapped extent. The length is 0 once there are no more mapped LBAs in the range.
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, NOT_SUPPORTED = the device does not support GET LBA STATUS, or FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int get_Next_Mapped_Extent(allocationMapIterator *iterator, lbaInterval *extent);
+
+    OPENSEA_TRANSPORT_API void free_Allocation_Map(allocationMapIterator *iterator);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Mapped_LBA_Ranges()
+    //
+    //! \brief   Description:  Gets all of the mapped extents in a range of LBAs as a run length list.
+    //
+    //  Entry:
+    //!   \param[in] device = device to get the allocation map from
+    //!   \param[in] startLBA = first LBA to report
+    //!   \param[in] range = number of LBAs to report. 0 = to the end of the device
+    //!   \param[out] mappedRanges = mapped extents are added to this set. Start with a zeroed set and free it with free_LBA_Interval_Set()
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, NOT_SUPPORTED, or FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int get_Mapped_LBA_Ranges(tDevice *device, uint64_t startLBA, uint64_t range, lbaIntervalSet *mappedRanges);
+
+#if defined (__cplusplus)
+}
+#endif
@@ -24,6 +24,7 @@ extern "C"
     #define ATA_STATUS_BIT_BUSY BIT7 //if this is set, all other bits are invalid and not to be used
     #define ATA_STATUS_BIT_READY BIT6
     #define ATA_STATUS_BIT_DEVICE_FAULT BIT5 //also called the write fault bit
+    #define ATA_STATUS_BIT_STREAM_ERROR BIT5 //read and write stream commands
     #define ATA_STATUS_BIT_SEEK_COMPLETE BIT4 //old/obsolete and unused. Old drives still set it for backwards compatability
     #define ATA_STATUS_BIT_SERVICE BIT4 //DMA Queued commands. Tagged command queuing AFAIK
     #define ATA_STATUS_BIT_DEFERRED_WRITE_ERROR BIT4 //write stream commands
@@ -40,6 +40,22 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_TRANSPORT_API int ata_Passthrough_Command(tDevice *device, ataPassthroughCommand *ataCommandOptions);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  get_ATA_Passthrough_Function()
+    //
+    //! \brief   Description:  Returns the function that sends ATA commands for the device's current passthroughType.
+    //                         Used to resolve device->ops.ataPassthrough and by ata_Passthrough_Command before that is resolved.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!
+    //  Exit:
+    //!   \return pointer to the passthrough function, NULL if the passthroughType is not known
+    //
+    //-----------------------------------------------------------------------------
+    ata_passthrough_func get_ATA_Passthrough_Function(tDevice *device);
+
     //-----------------------------------------------------------------------------
     //
     //  ata_Sanitize_Command()
@@ -1855,6 +1871,22 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_TRANSPORT_API int fill_In_ATA_Drive_Info(tDevice *device);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  fill_In_ATA_Log_Capabilities()
+    //
+    //! \brief   Description:  Reads the GPL log directory, identify device data log and device statistics log 
+    //                         to set the flags used by the software SAT translator. Requires identify data to already be read.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!
+    //  Exit:
+    //!   \return SUCCESS = pass, NOT_SUPPORTED = GPL not supported, !SUCCESS = something when wrong
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int fill_In_ATA_Log_Capabilities(tDevice *device);
+
     //-----------------------------------------------------------------------------
     //
     //  print_Verbose_ATA_Command_Information()
@@ -2169,6 +2201,57 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_TRANSPORT_API int set_ATA_Checksum_Into_Data_Buffer(uint8_t *ptrData, uint32_t dataSize);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  is_Buffer_Non_Zero(uint8_t* ptrData, uint32_t dataLen)
+    //
+    //! \brief   Description:  Checks if any byte in a buffer is not zero. Useful to check for blank identify data, logs, or erased media.
+    //
+    //  Entry:
+    //!   \param[in] ptrData = pointer to data buffer to check
+    //!   \param[in] dataLen = length of the data buffer
+    //!
+    //  Exit:
+    //!   \return true = at least one byte is not zero, false = all bytes are zero
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API bool is_Buffer_Non_Zero(uint8_t* ptrData, uint32_t dataLen);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  is_Buffer_Repeating_Pattern(uint8_t *ptrData, uint32_t dataLen, uint8_t *pattern, uint32_t patternLength)
+    //
+    //! \brief   Description:  Checks if a buffer is made up of a pattern repeated from the start to the end. The last copy of the pattern may be cut off by the end of the buffer.
+    //
+    //  Entry:
+    //!   \param[in] ptrData = pointer to data buffer to check
+    //!   \param[in] dataLen = length of the data buffer
+    //!   \param[in] pattern = pattern the buffer should be filled with
+    //!   \param[in] patternLength = length of the pattern
+    //!
+    //  Exit:
+    //!   \return true = buffer is the repeating pattern, false = it is not
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API bool is_Buffer_Repeating_Pattern(uint8_t *ptrData, uint32_t dataLen, uint8_t *pattern, uint32_t patternLength);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  find_First_Mismatch(uint8_t *firstBuffer, uint8_t *secondBuffer, uint32_t dataLen)
+    //
+    //! \brief   Description:  Finds the first byte that is different between two buffers. Useful for comparing data read back to what was written.
+    //
+    //  Entry:
+    //!   \param[in] firstBuffer = pointer to first data buffer
+    //!   \param[in] secondBuffer = pointer to second data buffer
+    //!   \param[in] dataLen = length of both data buffers
+    //!
+    //  Exit:
+    //!   \return offset of the first byte that does not match. dataLen if the buffers match
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API uint32_t find_First_Mismatch(uint8_t *firstBuffer, uint8_t *secondBuffer, uint32_t dataLen);
+
     //A couple helper functions to help with Legacu drives
     bool is_LBA_Mode_Supported(tDevice *device);
 
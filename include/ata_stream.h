@@ -0,0 +1,160 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file ata_stream.h
+// \brief Defines a session for continuous reads and writes with the ATA Streaming feature set, where each command has a completion time limit.
+
+#pragma once
+
+#include "common_public.h"
+#include "surface_scan.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    #define ATA_STREAM_MAX_STREAM_ID 7
+    #define ATA_STREAM_DEFAULT_TRANSFER_BYTES UINT32_C(1048576)
+
+    typedef struct _ataStreamOptions
+    {
+        uint8_t streamID;//0 - ATA_STREAM_MAX_STREAM_ID
+        uint32_t deadlineMicroseconds;//time each command must complete in. 0 = no limit
+        uint16_t allocationUnit;//logical blocks the device uses for read look-ahead and write caching of the stream. 0 = the stream minimum request size from identify
+        uint32_t transferLBAs;//LBAs per command used by run_ATA_Stream(). 0 = ATA_STREAM_DEFAULT_TRANSFER_BYTES worth of LBAs. Rounded down to a multiple of the stream minimum request size.
+        bool continuous;//set read continuous/write continuous so the device completes each command by the deadline, even if that means returning data with errors
+    }ataStreamOptions;
+
+    typedef struct _ataStreamCommandResult
+    {
+        uint64_t lba;
+        uint32_t lbaCount;
+        uint64_t nanoseconds;//time the command took, as measured by the host
+        bool streamError;//device reported a stream error. For read continuous, the data may contain errors.
+        bool deadlineMissed;//the command took longer than the deadline, or the device reported that the time limit expired
+    }ataStreamCommandResult;
+
+    typedef struct _ataStreamSession
+    {
+        tDevice *device;
+        uint8_t streamID;
+        uint8_t commandCCTL;//deadline in units of the streaming performance granularity. 0 = no limit on the device, either because there is no deadline or because it is more than 255 units
+        uint64_t deadlineNanoseconds;
+        uint32_t transferLBAs;
+        bool continuous;
+        uint64_t nextLBA;//LBA after the last command. Commands anywhere else are sent as not sequential.
+        uint32_t commandsIssued;
+        uint32_t deadlineMisses;
+        uint64_t totalNanoseconds;
+        uint64_t maxNanoseconds;
+        lbaIntervalSet missedLBAs;//LBAs of the commands that missed the deadline
+        ataStreamCommandResult lastCommand;
+    }ataStreamSession;
+
+    //Called by run_ATA_Stream() after each read with the data read, or before each write to fill in the data to write. Return false to stop.
+    typedef bool (*ataStreamChunk)(ataStreamSession *session, void *chunkData, uint64_t lba, uint8_t *ptrData, uint32_t dataSize);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  start_ATA_Stream()
+    //
+    //! \brief   Description:  Configures a stream with Configure Stream and sets up a session for it. The deadline is converted to a command completion time limit (CCTL)
+    //!                        using the streaming performance granularity from identify words 98-99, rounding up. Every command also measures its own time on the host,
+    //!                        so the deadline is still reported on when the device cannot represent it. A deadline longer than 255 granularity units is not sent to the
+    //!                        device at all (CCTL 0) rather than being clamped to a shorter one, and is only checked on the host.
+    //
+    //  Entry:
+    //!   \param[in] device = ATA device that supports the Streaming feature set
+    //!   \param[in] options = stream settings
+    //!   \param[out] session = session to set up. Must be ended with end_ATA_Stream()
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, NOT_SUPPORTED, or the error from Configure Stream
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int start_ATA_Stream(tDevice *device, ataStreamOptions *options, ataStreamSession *session);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  ata_Stream_Read()
+    //
+    //! \brief   Description:  Reads with a Read Stream command on the session's stream. The not sequential bit is set when the read does not follow on from the last command.
+    //!                        The result is in session->lastCommand.
+    //
+    //  Entry:
+    //!   \param[in] session = session from start_ATA_Stream()
+    //!   \param[in] lba = first LBA to read
+    //!   \param[out] ptrData = buffer to read into
+    //!   \param[in] dataSize = bytes to read. Must be a multiple of the logical block size, up to 65536 logical blocks
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, or the error from the command
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int ata_Stream_Read(ataStreamSession *session, uint64_t lba, uint8_t *ptrData, uint32_t dataSize);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  ata_Stream_Write()
+    //
+    //! \brief   Description:  Writes with a Write Stream command on the session's stream. The result is in session->lastCommand.
+    //
+    //  Entry:
+    //!   \param[in] session = session from start_ATA_Stream()
+    //!   \param[in] lba = first LBA to write
+    //!   \param[in] ptrData = data to write
+    //!   \param[in] dataSize = bytes to write. Must be a multiple of the logical block size, up to 65536 logical blocks
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, or the error from the command
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int ata_Stream_Write(ataStreamSession *session, uint64_t lba, uint8_t *ptrData, uint32_t dataSize);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  run_ATA_Stream()
+    //
+    //! \brief   Description:  Reads or writes a range of LBAs, transferLBAs at a time, with each command sent as soon as the last one completes.
+    //!                        Deadline misses are counted and recorded in session->missedLBAs as the stream runs.
+    //
+    //  Entry:
+    //!   \param[in] session = session from start_ATA_Stream()
+    //!   \param[in] write = true to write the range, false to read it
+    //!   \param[in] startLBA = first LBA of the range
+    //!   \param[in] lbaCount = number of LBAs in the range
+    //!   \param[in] chunk = called with the data of each command. May be NULL to read without looking at the data or to write zeros
+    //!   \param[in] chunkData = passed to chunk
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, ABORTED = chunk returned false, or the error from a command
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int run_ATA_Stream(ataStreamSession *session, bool write, uint64_t startLBA, uint64_t lbaCount, ataStreamChunk chunk, void *chunkData);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  end_ATA_Stream()
+    //
+    //! \brief   Description:  Removes the stream's configuration from the device and frees the session.
+    //
+    //  Entry:
+    //!   \param[in] session = session from start_ATA_Stream()
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, or the error from Configure Stream
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int end_ATA_Stream(ataStreamSession *session);
+
+#if defined (__cplusplus)
+}
+#endif
@@ -126,6 +126,59 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_TRANSPORT_API int fill_Drive_Info_Data(tDevice *device);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  fill_Lazy_Device_Info(tDevice *device, uint32_t lazyInfo)
+    //
+    //! \brief   Description:  Reads any of the requested device information that has not been read yet (LAZY_DISCOVERY)
+    //                         or was invalidated by a command that changed it. Information that is already up to date
+    //                         is not read again, so this is cheap to call before using any of the fields it covers.
+    //  Entry:
+    //!   \param device - pointer to the device structure
+    //!   \param lazyInfo - bitfield of eLazyDeviceInfo values to make sure are filled in
+    //!
+    //  Exit:
+    //!   \return SUCCESS = pass, !SUCCESS = something when wrong
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int fill_Lazy_Device_Info(tDevice *device, uint32_t lazyInfo);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Device_Serial_Number(tDevice *device)
+    //  get_Device_World_Wide_Name(tDevice *device)
+    //  get_Device_Number_Of_Logical_Units(tDevice *device)
+    //
+    //! \brief   Description:  Return drive_info.serialNumber, drive_info.worldWideName, and drive_info.numberOfLUs, reading them first with
+    //                         fill_Lazy_Device_Info() if they have not been read yet. Use these instead of the fields when the device may have been
+    //                         opened with LAZY_DISCOVERY, where the fields stay empty until something asks for them.
+    //  Entry:
+    //!   \param device - pointer to the device structure
+    //!
+    //  Exit:
+    //!   \return the field. Empty string or 0 when the device does not report it
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API const char* get_Device_Serial_Number(tDevice *device);
+    OPENSEA_TRANSPORT_API uint64_t get_Device_World_Wide_Name(tDevice *device);
+    OPENSEA_TRANSPORT_API uint32_t get_Device_Number_Of_Logical_Units(tDevice *device);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  resolve_Device_Operations(tDevice *device)
+    //
+    //! \brief   Description:  Fills in device->ops with the read, write, verify, flush, trim and ATA passthrough functions
+    //                         that match what discovery found out about the device. The generic IO functions (io_Read, verify_LBA, etc)
+    //                         call this on first use, so it only needs to be called directly after changing something the choice depends on.
+    //  Entry:
+    //!   \param device - pointer to the device structure
+    //!
+    //  Exit:
+    //!   \return SUCCESS = pass, !SUCCESS = something when wrong
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int resolve_Device_Operations(tDevice *device);
+
     typedef enum _eDownloadMode
     {
         DL_FW_ACTIVATE,
@@ -359,6 +412,23 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_TRANSPORT_API int flush_Cache(tDevice *device);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  trim_LBA()
+    //
+    //! \brief   Description:  This function sends a TRIM (ATA Data Set Management), UNMAP (SCSI), or Deallocate (NVMe Dataset Management)
+    //                         command to a device for the lba and range specified. Large ranges are split into as many descriptors/commands as needed.
+    //  Entry:
+    //!   \param device - pointer to the device structure
+    //!   \param lba - the LBA you wish to start trimming at
+    //!   \param range - number of LBAs to trim
+    //!   
+    //  Exit:
+    //!   \return SUCCESS = pass, NOT_SUPPORTED = device does not support trim/unmap/deallocate, !SUCCESS = something when wrong
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int trim_LBA(tDevice *device, uint64_t lba, uint64_t range);
+
     //-----------------------------------------------------------------------------
     //
     //  os_Read()
@@ -523,8 +593,32 @@ extern "C"
 
     OPENSEA_TRANSPORT_API int reset_Write_Pointer(tDevice *device, bool resetAll, uint64_t zoneID);
 
+    //NVMe zoned namespace reports are converted to the ZBC format (big endian). ATA reports are returned in the ZAC format (little endian).
+    //Zones on an NVMe zoned namespace can only be written up to their zone capacity, which may be less than the zone length. Converted reports keep it in
+    //bytes ZONE_DESCRIPTOR_CAPACITY_OFFSET to ZONE_DESCRIPTOR_CAPACITY_OFFSET + 7 of each descriptor, which ZBC and ZAC reserve. 0 there means the whole zone can be written.
+    #define ZONE_DESCRIPTOR_CAPACITY_OFFSET 32
     OPENSEA_TRANSPORT_API int report_Zones(tDevice *device, eZoneReportingOptions reportingOptions, bool partial, uint64_t zoneLocator, uint8_t *ptrData, uint32_t dataSize);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  zone_Append()
+    //
+    //! \brief   Description:  Writes data at the write pointer of a zone and returns the LBA it was written at. Many writers can append to one zone at once since none of them
+    //!                        need to know the write pointer ahead of time. Only NVMe zoned namespaces support this. ZBC and ZAC devices must use write_LBA() at the write pointer.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in] zoneID = start LBA of the zone to append to
+    //!   \param[in] ptrData = data to write
+    //!   \param[in] dataSize = number of bytes to write. Must be a multiple of the logical block size
+    //!   \param[out] assignedLBA = LBA the data was written at. UINT64_MAX when the data was written but the OS did not return where. May be NULL
+    //!
+    //  Exit:
+    //!   \return SUCCESS = pass, NOT_SUPPORTED = not a zoned namespace, !SUCCESS = something when wrong. Do not retry after SUCCESS even when the LBA is not known, since the data has already been appended.
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int zone_Append(tDevice *device, uint64_t zoneID, uint8_t *ptrData, uint32_t dataSize, uint64_t *assignedLBA);
+
     #if defined (__cplusplus)
 }
     #endif
@@ -668,6 +668,8 @@ extern "C"
         bool readBufferDMASupported;
         bool writeBufferDMASupported;
         bool downloadMicrocodeDMASupported;
+        bool readStreamDMASupported;
+        bool writeStreamDMASupported;
         bool taggedCommandQueuingSupported;
         bool nativeCommandQueuingSupported;
         bool readWriteMultipleSupported;
@@ -693,6 +695,20 @@ extern "C"
     }eZonedDeviceType;
 
     //This is used by the software SAT translation layer. DO NOT Update this directly
+    //ATA data the software SAT translator keeps between translated commands so that it does not need to reread it for each one.
+    //Identify data (in drive_info.IdentifyData.ata) stays valid until a command that may change it is issued. See invalidate_Software_SAT_Snapshot()
+    //Device statistics change constantly, so they are only reused for a short time. This lets a tool poll several log pages with a single read of the log.
+    #define SOFT_SAT_DEVICE_STATISTICS_SNAPSHOT_MILLISECONDS    1000
+    #define SOFT_SAT_DEVICE_STATISTICS_SNAPSHOT_PAGES           8 //pages 0 - 7 (list, general, free fall, rotating media, general errors, temperature, transport, solid state)
+    typedef struct _softwareSATSnapshot
+    {
+        bool identifyValid;
+        uint8_t identifyCommand;//command used to read the identify data that is reported in the ATA information VPD page
+        uint8_t deviceStatisticsPagesValid;//bitfield. BIT1 = general statistics page, etc. Only pages the device reports as supported are set
+        seatimer_t deviceStatisticsTimer;//started when the device statistics were read
+        uint8_t deviceStatistics[SOFT_SAT_DEVICE_STATISTICS_SNAPSHOT_PAGES][512];
+    }softwareSATSnapshot;
+
     typedef struct _softwareSATFlags
     {
         bool identifyDeviceDataLogSupported;
@@ -715,6 +731,7 @@ extern "C"
         bool zeroExtSupported;
         uint8_t rtfrIndex;
         ataReturnTFRs ataPassthroughResults[16];
+        softwareSATSnapshot snapshot;
     }softwareSATFlags;
 
     //This is for test unit ready after failures to keep up performance on devices that slow down a LOT durring error processing (USB mostly)
@@ -879,6 +896,26 @@ extern "C"
         //TODO: Add more hacks and padd this structure
     }passthroughHacks;
 
+    //Information that can be read the first time it is needed instead of during device discovery (LAZY_DISCOVERY).
+    //These are also used to mark information as out of date after a command that changes it (format, mode select, firmware activation, etc).
+    typedef enum _eLazyDeviceInfo
+    {
+        LAZY_INFO_NONE                  = 0,
+        LAZY_INFO_SERIAL_NUMBER         = BIT0,//unit serial number VPD page
+        LAZY_INFO_WORLD_WIDE_NAME       = BIT1,//device identification VPD page
+        LAZY_INFO_MEDIA_TYPE            = BIT2,//block device characteristics VPD page (SSD vs HDD, zoned type)
+        LAZY_INFO_CAPACITY              = BIT3,//read capacity 10/16. Block sizes, maxLBA, protection type
+        LAZY_INFO_LOGICAL_UNITS         = BIT4,//report LUNs
+        LAZY_INFO_ATA_LOG_CAPABILITIES  = BIT5,//GPL log directory, identify device data log and device statistics log support used by software SAT
+        LAZY_INFO_ALL                   = 0x3F
+    }eLazyDeviceInfo;
+
+    typedef struct _lazyDeviceInfo
+    {
+        uint32_t pending;//eLazyDeviceInfo bits that have not been read from the device yet. Read by fill_Lazy_Device_Info()
+        uint32_t readable;//eLazyDeviceInfo bits that the discovery code for this device knows how to read. Only these bits can be invalidated.
+    }lazyDeviceInfo;
+
     typedef struct _driveInfo {
         eMediaType     media_type;
         eDriveType     drive_type;
@@ -943,6 +980,7 @@ extern "C"
         };
         //9304 bytes to make divisible by 8
         passthroughHacks passThroughHacks;
+        lazyDeviceInfo lazyInfo;//Tracks what device information has not been read yet or is out of date. DO NOT update this directly. Use fill_Lazy_Device_Info() and invalidate_Lazy_Device_Info()
     }driveInfo;
 
 #if defined(UEFI_C_SOURCE)
@@ -988,6 +1026,7 @@ extern "C"
 #define OS_HANDLE_NAME_MAX_LENGTH 256
 #define OS_HANDLE_FRIENDLY_NAME_MAX_LENGTH 24
 #define OS_SECOND_HANDLE_NAME_LENGTH 30
+#define OS_MAX_EXTRA_PATHS 3 //most handles to the same logical unit, besides the one that was opened, that can be used to issue commands
     // \struct typedef struct _OSDriveInfo
     typedef struct _OSDriveInfo
     {
@@ -1064,6 +1103,12 @@ extern "C"
             uint8_t         minorVersion;
             uint8_t         revision;
         }sgDriverVersion;
+        struct {
+            uint8_t         extraPathCount;//additional handles to the same logical unit added with sg_Add_Device_Path(). 0 = only fd is used
+            uint8_t         nextPath;//next path to use for media access commands. 0 = fd, 1 = extraPaths[0], etc
+            uint8_t         failedPaths;//bitfield of paths that reported a transport failure. Bit 0 = fd, bit 1 = extraPaths[0], etc
+            int             extraPaths[OS_MAX_EXTRA_PATHS];
+        }multipath;
         #if defined(VMK_CROSS_COMP)
         uint8_t paddSG[35];//TODO: need to change this based on size of NVMe handle for VMWare.
         #else
@@ -1134,6 +1179,7 @@ extern "C"
         DO_NOT_WAKE_DRIVE, //e.g OK to send commands that do NOT access media
         NO_DRIVE_CMD,
         OPEN_HANDLE_ONLY,
+        LAZY_DISCOVERY, //Only standard inquiry (and ATA identify when ATA is suspected) during discovery. Remaining information is read the first time it is needed. See fill_Lazy_Device_Info()
         BUS_RESCAN_ALLOWED = BIT15,//this may wake the drive!
         //Flags below are bitfields...so multiple can be set. Flags above should be checked by only checking the first word of this enum.
         FORCE_ATA_PIO_ONLY = BIT16, //troubleshooting option to only send PIO versions of commands (used in get_Device/fill_Drive_Info).
@@ -1144,7 +1190,68 @@ extern "C"
 
     typedef int (*issue_io_func)( void * );
 
-    #define DEVICE_BLOCK_VERSION    (6)
+    struct _tDevice;
+    struct _ataPassthroughCommand;
+
+    typedef int (*ata_passthrough_func)(struct _tDevice *device, struct _ataPassthroughCommand *ataCommandOptions);
+
+    //Small per-device buffers for CDBs, sense data and return TFRs so that the passthrough layers do not go to the allocator on every command.
+    //Commands nest (SAT passthrough -> return response info -> OS sense buffer), so there are a few of them. See borrow_Command_Buffer()
+    #define COMMAND_BUFFER_POOL_SLOTS       8
+    #define COMMAND_BUFFER_POOL_SLOT_SIZE   512
+    typedef struct _commandBufferPool
+    {
+        uint64_t slotInUse;//bitfield, one bit per slot. 64bit so that the slots below are 8 byte aligned
+        uint8_t slot[COMMAND_BUFFER_POOL_SLOTS][COMMAND_BUFFER_POOL_SLOT_SIZE];
+    }commandBufferPool;
+
+    //Scratch memory for the software SAT and SNTL translators. Buffers are bump allocated out of one region and all released when the translation finishes.
+    //The region grows between translations to the most that a single translation needed, up to TRANSLATION_SCRATCH_MAX_SIZE. See borrow_Translation_Buffer()
+    #define TRANSLATION_SCRATCH_DEFAULT_SIZE    UINT32_C(16384)
+    #define TRANSLATION_SCRATCH_MAX_SIZE        UINT32_C(1048576)
+    typedef struct _translationScratch
+    {
+        uint8_t *buffer;
+        uint32_t size;
+        uint32_t used;
+        uint32_t depth;//number of translations in progress. Buffers only come from the scratch region while this is nonzero.
+        uint32_t highWaterMark;//most bytes needed by one translation since the region was last sized
+    }translationScratch;
+
+    //Responses from the software SAT and SNTL translators that only depend on what the device supports (supported VPD pages, REPORT SUPPORTED OPERATION CODES, etc).
+    //They are built the first time they are requested and copied out after that until invalidate_Translation_Responses() is called.
+    #define TRANSLATION_RESPONSE_CACHE_ENTRIES  32
+    //Key for a cached response: the SCSI operation code, then up to 7 more bytes of whatever CDB fields change the response.
+    #define TRANSLATION_RESPONSE_KEY(operationCode, b1, b2, b3, b4, b5, b6, b7) M_BytesTo8ByteValue(operationCode, b1, b2, b3, b4, b5, b6, b7)
+    typedef struct _translationResponse
+    {
+        uint64_t key;
+        int result;
+        uint32_t length;
+        uint8_t *data;
+    }translationResponse;
+
+    typedef struct _translationResponseCache
+    {
+        uint32_t entriesValid;//bitfield, one bit per entry
+        uint8_t nextEntry;//entry to replace when all are in use
+        translationResponse entry[TRANSLATION_RESPONSE_CACHE_ENTRIES];
+    }translationResponseCache;
+
+    //Per-device table of the commands used by the generic read/write/verify/flush/trim/passthrough functions.
+    //These are resolved after discovery using the interface, passthrough hacks, SCSI version, DMA mode, etc so that these decisions are not remade on every command.
+    //Any entry may be NULL, in which case the generic function will resolve the table (or fall back to its own logic). See resolve_Device_Operations()
+    typedef struct _deviceOperations
+    {
+        int (*read)(struct _tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint32_t dataSize);
+        int (*write)(struct _tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint32_t dataSize);
+        int (*verify)(struct _tDevice *device, uint64_t lba, uint32_t range);
+        int (*flush)(struct _tDevice *device);
+        int (*trim)(struct _tDevice *device, uint64_t lba, uint64_t range);
+        ata_passthrough_func ataPassthrough;
+    }deviceOperations;
+
+    #define DEVICE_BLOCK_VERSION    (8)
 
     // verification for compatibility checking
     typedef struct _versionBlock
@@ -1164,6 +1271,10 @@ extern "C"
         issue_io_func       issue_nvme_io;//nvme IO function pointer for raid or other driver/custom interface to send commands
         eDiscoveryOptions   dFlags;
         eVerbosityLevels    deviceVerbosity;
+        deviceOperations    ops;//resolved after discovery. Do not set this directly, use resolve_Device_Operations()
+        commandBufferPool   cmdBuffers;//do not use directly. Use borrow_Command_Buffer() and return_Command_Buffer()
+        translationScratch  translationScratch;//do not use directly. Use begin_Translation_Scratch() and borrow_Translation_Buffer()
+        translationResponseCache translationResponses;//do not use directly. Use get_Translation_Response() and save_Translation_Response()
     }tDevice;
 
      //Common enum for getting/setting power states.
@@ -1322,6 +1433,10 @@ extern "C"
     //#define SAT_12_BYTE BIT18
     #define SCAN_SEAGATE_ONLY BIT19
     #define AGRESSIVE_SCAN BIT20 //this can wake a drive up because a bus rescan may be issued. (currently only implemented in Windows)
+    //Use this to pass the drive type and interface filter bits above into the flags for get_Device_Count() and get_Device_List().
+    //Handles the OS can tell will not pass the filters without opening them are then skipped instead of being fully discovered.
+    //Anything that could still match is returned, so scan_Drive_Type_Filter() and scan_Interface_Type_Filter() must still be applied afterwards.
+    #define GET_DEVICE_FUNCS_SCAN_FILTER(scanFlags) ((uint64_t)((scanFlags) & (ALL_DRIVES | ALL_INTERFACES)) << 32)
 #if defined (ENABLE_CSMI)
     #define ALLOW_DUPLICATE_DEVICE BIT24 //This is ONLY used by the scan_And_Print_Devs function to filter what is output from it. This does NOT affect get_Device_List.
     #define IGNORE_CSMI BIT25 //only works in Windows since Linux never adopted CSMI support. Set this to ignore CSMI devices, or compile opensea-transport without the ENABLE_CSMI preprocessor definition.
@@ -1548,6 +1663,23 @@ extern "C"
     //-----------------------------------------------------------------------------
     bool scan_Interface_Type_Filter(tDevice *device, uint32_t scanFlags);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  scan_Filter_Could_Match()
+    //
+    //! \brief   Description:  Used by get_Device_Count() and get_Device_List() to check if a handle is worth opening when scan filters were passed in with GET_DEVICE_FUNCS_SCAN_FILTER().
+    //!                        Only the interface needs to be known. Any drive type that could be attached to that interface is assumed to be possible. SCSI_INTERFACE is also treated as a possible USB device, since discovery reclassifies some of those.
+    //
+    //  Entry:
+    //!   \param[in] interfaceType - interface the OS reports for the handle. UNKNOWN_INTERFACE if it could not be determined.
+    //!   \param[in] getDeviceFlags = flags passed to get_Device_Count() or get_Device_List()
+    //!
+    //  Exit:
+    //!   \return true = device could pass the scan filters, false = device will be filtered out by scan
+    //
+    //-----------------------------------------------------------------------------
+    bool scan_Filter_Could_Match(eInterfaceType interfaceType, uint64_t getDeviceFlags);
+
     //-----------------------------------------------------------------------------
     //
     //  is_Seagate_Family( tDevice * device )
@@ -1732,6 +1864,202 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_TRANSPORT_API bool is_SSD(tDevice *device);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  invalidate_Lazy_Device_Info( tDevice * device, uint32_t lazyInfo )
+    //
+    //! \brief   Marks device information as out of date so that it is read again the next time it is needed. 
+    //!          This is called by commands that change this information (format, mode select, firmware activation, etc).
+    //!          Only information the discovery code knows how to read again for this device is invalidated.
+    //
+    //  Entry:
+    //!   \param[in]  device - file descriptor
+    //!   \param[in]  lazyInfo - bitfield of eLazyDeviceInfo values that are no longer valid
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API void invalidate_Lazy_Device_Info(tDevice *device, uint32_t lazyInfo);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Passthrough_Max_Transfer_Length( tDevice * device )
+    //
+    //! \brief   Gets the largest data transfer the passthrough to this device is known to handle, from the passthrough hacks for the device type
+    //!          and, in Windows, the adapter's maximum transfer size.
+    //
+    //  Entry:
+    //!   \param[in]  device - file descriptor
+    //!
+    //  Exit:
+    //!   \return largest transfer in bytes. 0 = not known
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API uint32_t get_Passthrough_Max_Transfer_Length(tDevice *device);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  borrow_Command_Buffer( tDevice * device, uint32_t size )
+    //
+    //! \brief   Gets a zeroed buffer for a CDB, sense data, or other small transfer from the device's buffer pool.
+    //!          If the request is too big, the device's alignment cannot be met, or all slots are in use, this allocates with calloc_aligned instead.
+    //!          Either way, the buffer must be given back with return_Command_Buffer()
+    //
+    //  Entry:
+    //!   \param[in]  device - file descriptor
+    //!   \param[in]  size - number of bytes needed
+    //!
+    //  Exit:
+    //!   \return pointer to the buffer, NULL if it could not be allocated
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API uint8_t* borrow_Command_Buffer(tDevice *device, uint32_t size);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  return_Command_Buffer( tDevice * device, uint8_t **buffer )
+    //
+    //! \brief   Gives back a buffer from borrow_Command_Buffer(). Frees it if it did not come from the pool. The pointer is set to NULL.
+    //
+    //  Entry:
+    //!   \param[in]  device - file descriptor
+    //!   \param[in,out]  buffer - pointer to the buffer pointer to return. May point to NULL.
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API void return_Command_Buffer(tDevice *device, uint8_t **buffer);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  begin_Translation_Scratch( tDevice * device )
+    //
+    //! \brief   Marks the start of a software translation (SAT or SNTL) so that borrow_Translation_Buffer() gives out memory from the device's scratch region.
+    //!          Must be paired with end_Translation_Scratch(). Translations may nest.
+    //
+    //  Entry:
+    //!   \param[in]  device - file descriptor
+    //!
+    //  Exit:
+    //!   \return mark to pass to end_Translation_Scratch()
+    //
+    //-----------------------------------------------------------------------------
+    uint32_t begin_Translation_Scratch(tDevice *device);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  end_Translation_Scratch( tDevice * device, uint32_t mark )
+    //
+    //! \brief   Releases all scratch buffers borrowed since the matching begin_Translation_Scratch().
+    //!          When the outermost translation finishes, the region is resized for the next one if it was too small.
+    //
+    //  Entry:
+    //!   \param[in]  device - file descriptor
+    //!   \param[in]  mark - value returned by begin_Translation_Scratch()
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    void end_Translation_Scratch(tDevice *device, uint32_t mark);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  borrow_Translation_Buffer( tDevice * device, uint32_t size )
+    //
+    //! \brief   Gets a zeroed, aligned buffer for use during a software translation. Outside of a translation, or when the scratch region is full,
+    //!          this allocates with calloc_aligned instead. Either way, give it back with return_Translation_Buffer().
+    //
+    //  Entry:
+    //!   \param[in]  device - file descriptor
+    //!   \param[in]  size - number of bytes needed
+    //!
+    //  Exit:
+    //!   \return pointer to the buffer, NULL if it could not be allocated
+    //
+    //-----------------------------------------------------------------------------
+    uint8_t* borrow_Translation_Buffer(tDevice *device, uint32_t size);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  return_Translation_Buffer( tDevice * device, uint8_t **buffer )
+    //
+    //! \brief   Gives back a buffer from borrow_Translation_Buffer(). Scratch buffers are released by end_Translation_Scratch(), others are freed. The pointer is set to NULL.
+    //
+    //  Entry:
+    //!   \param[in]  device - file descriptor
+    //!   \param[in,out]  buffer - pointer to the buffer pointer to return. May point to NULL.
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    void return_Translation_Buffer(tDevice *device, uint8_t **buffer);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  free_Translation_Scratch( tDevice * device )
+    //
+    //! \brief   Frees the device's translation scratch region and any cached translation responses. Called when closing or removing a device.
+    //
+    //  Entry:
+    //!   \param[in]  device - file descriptor
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    void free_Translation_Scratch(tDevice *device);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Translation_Response( tDevice * device, uint64_t key, uint8_t *ptrData, uint32_t dataLength, int *result )
+    //
+    //! \brief   Looks up a response saved with save_Translation_Response() and copies as much of it as fits into ptrData.
+    //
+    //  Entry:
+    //!   \param[in]  device - file descriptor
+    //!   \param[in]  key - built with TRANSLATION_RESPONSE_KEY()
+    //!   \param[out] ptrData - buffer to copy the response into. May be NULL
+    //!   \param[in]  dataLength - size of ptrData
+    //!   \param[out] result - return value of the translation that built the response
+    //!
+    //  Exit:
+    //!   \return true = response was found, false = it needs to be built
+    //
+    //-----------------------------------------------------------------------------
+    bool get_Translation_Response(tDevice *device, uint64_t key, uint8_t *ptrData, uint32_t dataLength, int *result);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  save_Translation_Response( tDevice * device, uint64_t key, int result, const uint8_t *response, uint32_t length )
+    //
+    //! \brief   Saves a copy of a translated response that will not change until invalidate_Translation_Responses() is called.
+    //!          If the cache is full, the oldest entry is replaced. Failing to allocate memory is not an error, the response just is not saved.
+    //
+    //  Entry:
+    //!   \param[in]  device - file descriptor
+    //!   \param[in]  key - built with TRANSLATION_RESPONSE_KEY()
+    //!   \param[in]  result - return value of the translation that built the response
+    //!   \param[in]  response - full response data
+    //!   \param[in]  length - length of the response data
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    void save_Translation_Response(tDevice *device, uint64_t key, int result, const uint8_t *response, uint32_t length);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  invalidate_Translation_Responses( tDevice * device )
+    //
+    //! \brief   Discards all saved translation responses. Call this when something the device supports may have changed.
+    //
+    //  Entry:
+    //!   \param[in]  device - file descriptor
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    void invalidate_Translation_Responses(tDevice *device);
+
     OPENSEA_TRANSPORT_API bool is_SATA(tDevice *device);
 
     //-----------------------------------------------------------------------------
@@ -1850,6 +2178,54 @@ extern "C"
         uint8_t raid;
     }removeDuplicateDriveType;
 
+    typedef struct _devicePathGroup
+    {
+        uint32_t pathCount;
+        uint32_t *paths;//indexes into the device list of every path to this device. paths[0] is the preferred path to send commands to. The rest are alternates.
+    }devicePathGroup;
+
+    typedef struct _devicePathGroups
+    {
+        uint32_t groupCount;//number of distinct devices found
+        devicePathGroup *groups;
+        uint32_t *deviceToGroup;//one entry for each device in the list with the index of the group it belongs to
+    }devicePathGroups;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  group_Device_Paths()
+    //
+    //! \brief   Description:  Groups the devices in a list that are paths to the same media, such as both ports of a dual ported SAS drive, NVMe multipath namespaces, or a drive
+    //!                        that shows up through both a RAID (CSMI) interface and the OS. Devices are matched by NVMe NGUID/EUI64, then world wide name, then model and serial number.
+    //!                        Devices without any of these are put in a group by themselves. Runs in linear time using a hash of each device's identity.
+    //!                        The preferred path is the first path found that is not a RAID (CSMI) path, or the first path when they all are.
+    //
+    //  Entry:
+    //!   \param[in] deviceList = list of devices from get_Device_List()
+    //!   \param[in] numberOfDevices = number of devices in deviceList
+    //!   \param[out] pathGroups = filled in with the groups. Must be freed with free_Device_Path_Groups()
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, or MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int group_Device_Paths(tDevice *deviceList, uint32_t numberOfDevices, devicePathGroups *pathGroups);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  free_Device_Path_Groups()
+    //
+    //! \brief   Description:  Frees the memory allocated by group_Device_Paths()
+    //
+    //  Entry:
+    //!   \param[in] pathGroups = groups to free
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API void free_Device_Path_Groups(devicePathGroups *pathGroups);
+
+    //Removes RAID (CSMI) paths to devices that are also reachable through another path in the list (Windows only for now). Always leaves at least one path to each device.
     OPENSEA_TRANSPORT_API int remove_Duplicate_Devices(tDevice *deviceList, volatile uint32_t * numberOfDevices, removeDuplicateDriveType rmvDevFlag);
 
     OPENSEA_TRANSPORT_API int remove_Device(tDevice *deviceList, uint32_t driveToRemoveIdx, volatile uint32_t * numberOfDevices);
@@ -0,0 +1,59 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file copy_offload.h
+// \brief Defines functions to copy LBA ranges within a device, letting the device move the data itself when it can.
+
+#pragma once
+
+#include "common_public.h"
+#include "surface_scan.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    typedef enum _eLBACopyMethod
+    {
+        LBA_COPY_METHOD_AUTO,//use the device's copy command if it has one, otherwise copy through the host
+        LBA_COPY_METHOD_NVME_COPY,//NVMe Copy command
+        LBA_COPY_METHOD_SCSI_TOKEN,//SCSI Populate Token and Write Using Token
+        LBA_COPY_METHOD_HOST,//read_LBA() and write_LBA()
+    }eLBACopyMethod;
+
+    #define LBA_COPY_HOST_BUFFER_BYTES UINT32_C(1048576) //largest read and write used when copying through the host
+
+    //-----------------------------------------------------------------------------
+    //
+    //  copy_LBA_Ranges()
+    //
+    //! \brief   Description:  Copies a list of LBA ranges to one contiguous destination on the same device. The ranges are written one after the other in the order given.
+    //!                        NVMe devices that support the Copy command use it, with as many source ranges per command as the namespace allows.
+    //!                        SCSI devices with a block device ROD token limits descriptor in the third party copy VPD page use Populate Token and Write Using Token.
+    //!                        Either way, the data never crosses the interface. Otherwise, the data is read and written back through the host in LBA_COPY_HOST_BUFFER_BYTES chunks, or smaller ones when the passthrough cannot transfer that much at once.
+    //
+    //  Entry:
+    //!   \param[in] device = device to copy on
+    //!   \param[in] sourceRanges = ranges to copy from
+    //!   \param[in] rangeCount = number of ranges in sourceRanges
+    //!   \param[in] destinationLBA = first LBA to copy to. The destination cannot overlap any of the source ranges.
+    //!   \param[in] method = LBA_COPY_METHOD_AUTO, or a specific method to use. A specific method that the device does not support returns NOT_SUPPORTED.
+    //!   \param[out] methodUsed = method the data was copied with. May be NULL
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, NOT_SUPPORTED, or the error from a copy command. The device's copy command is not retried through the host once it has failed on some of the data.
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int copy_LBA_Ranges(tDevice *device, lbaInterval *sourceRanges, uint32_t rangeCount, uint64_t destinationLBA, eLBACopyMethod method, eLBACopyMethod *methodUsed);
+
+#if defined (__cplusplus)
+}
+#endif
@@ -0,0 +1,69 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file device_executor.h
+// \brief Defines the functions to run the same operation on a list of devices at the same time.
+
+#pragma once
+
+#include "common_public.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    //Operation to run on each device. operationData is passed through unchanged, so anything it points to is shared by all devices and must not be written to without locking.
+    //The return value is saved in the device's deviceOperationResult.
+    typedef int (*deviceOperationFunc)(tDevice *device, void *operationData);
+
+    #define DEVICE_EXECUTOR_DEFAULT_WORKERS     UINT32_C(16)
+    #define DEVICE_EXECUTOR_DEFAULT_PER_ADAPTER UINT32_C(8)
+
+    typedef struct _deviceExecutorOptions
+    {
+        uint32_t maxWorkers;//most devices to run the operation on at once. 0 = DEVICE_EXECUTOR_DEFAULT_WORKERS
+        uint32_t maxPerHostAdapter;//most devices on the same host adapter to run the operation on at once. 0 = DEVICE_EXECUTOR_DEFAULT_PER_ADAPTER, UINT32_MAX = no limit
+    }deviceExecutorOptions;
+
+    typedef struct _deviceOperationResult
+    {
+        bool operationRun;//false if the operation never got to run on this device
+        int result;//return value of the operation
+        uint64_t elapsedNanoseconds;//time the operation took on this device
+    }deviceOperationResult;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  run_Operation_On_Devices()
+    //
+    //! \brief   Description:  Runs an operation on every device in a list using a pool of worker threads.
+    //!                        No more than maxPerHostAdapter devices on the same host adapter (SCSI host in Linux, port number in Windows, controller in UEFI) run at once
+    //!                        so that one busy HBA does not hold up all of the workers. Devices where the adapter cannot be determined are not limited.
+    //!                        On systems without thread support the operation is run on each device one after another.
+    //
+    //  Entry:
+    //!   \param[in] deviceList = list of devices from get_Device_List(). Each device is only used by one thread at a time.
+    //!   \param[in] deviceCount = number of devices in deviceList
+    //!   \param[in] operation = function to run on each device
+    //!   \param[in] operationData = passed to operation for every device. May be NULL
+    //!   \param[in] options = concurrency limits. May be NULL to use the defaults
+    //!   \param[out] results = array of deviceCount results, one for each device in deviceList
+    //!
+    //  Exit:
+    //!   \return SUCCESS = operation was run on every device (check results for each device's status), BAD_PARAMETER, MEMORY_FAILURE,
+    //!           or FAILURE = the operation never ran on at least one device (operationRun is false in its result)
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int run_Operation_On_Devices(tDevice *deviceList, uint32_t deviceCount, deviceOperationFunc operation, void *operationData, deviceExecutorOptions *options, deviceOperationResult *results);
+
+#if defined (__cplusplus)
+}
+#endif
@@ -0,0 +1,201 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file device_service.h
+// \brief Defines a service that keeps a device list open and handles passthrough requests from other processes over a local socket.
+
+#pragma once
+
+#include "common_public.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    //The protocol is only used between processes on the same host, so all fields are in host byte order.
+    #define DEVICE_SERVICE_MAGIC            UINT32_C(0x5354534F) //"OSTS"
+    #define DEVICE_SERVICE_PROTOCOL_VERSION UINT16_C(1)
+    #define DEVICE_SERVICE_MAX_DATA_LENGTH  UINT32_C(16777216) //largest data transfer the service will accept for a single command
+    #define DEVICE_SERVICE_MAX_CLIENTS      16
+    #define DEVICE_SERVICE_CLIENT_IO_TIMEOUT_SECONDS 5 //a client that does not send or receive for this long in the middle of a request is disconnected
+    #define DEVICE_SERVICE_COMMAND_LENGTH   64 //large enough to hold a 32 byte CDB or a 64 byte NVMe submission queue entry
+
+    typedef enum _eDeviceServiceRequest
+    {
+        DEVICE_SERVICE_REQUEST_LIST_DEVICES = 1,
+        DEVICE_SERVICE_REQUEST_SCSI_PASSTHROUGH = 2,
+        DEVICE_SERVICE_REQUEST_NVME_PASSTHROUGH = 3,
+    }eDeviceServiceRequest;
+
+    //Sent by the client. For XFER_DATA_OUT, dataLength bytes of data follow the header.
+    typedef struct _deviceServiceRequestHeader
+    {
+        uint32_t magic;//DEVICE_SERVICE_MAGIC
+        uint16_t version;//DEVICE_SERVICE_PROTOCOL_VERSION
+        uint16_t request;//eDeviceServiceRequest
+        uint32_t deviceIndex;//index into the list the service was started with
+        uint32_t timeoutSeconds;
+        uint32_t dataLength;
+        uint8_t direction;//eDataTransferDirection. Only XFER_NO_DATA, XFER_DATA_IN, and XFER_DATA_OUT are supported
+        uint8_t commandLength;//CDB length for SCSI passthrough
+        uint8_t nvmeCommandType;//eNvmeCmdType for NVMe passthrough
+        uint8_t reserved;
+        uint8_t command[DEVICE_SERVICE_COMMAND_LENGTH];//CDB or NVMe submission queue entry
+    }deviceServiceRequestHeader;
+
+    //Sent by the service. senseLength bytes of sense data follow the header, then dataLength bytes of data.
+    typedef struct _deviceServiceResponseHeader
+    {
+        uint32_t magic;//DEVICE_SERVICE_MAGIC
+        int32_t result;//return code from the library (SUCCESS, FAILURE, etc)
+        uint32_t senseLength;
+        uint32_t dataLength;
+        uint32_t nvmeCommandSpecific;//DW0 of the NVMe completion
+        uint32_t nvmeStatus;//DW3 of the NVMe completion
+        uint64_t commandTimeNanoseconds;//time the device took to complete the command
+    }deviceServiceResponseHeader;
+
+    //One of these is returned for each device the service has open.
+    typedef struct _deviceServiceEntry
+    {
+        char name[OS_HANDLE_NAME_MAX_LENGTH];
+        char friendlyName[OS_HANDLE_FRIENDLY_NAME_MAX_LENGTH];
+        char vendor[16];
+        char model[48];
+        char serialNumber[24];
+        char firmwareRevision[16];
+        uint32_t driveType;//eDriveType
+        uint32_t interfaceType;//eInterfaceType
+        uint64_t maxLBA;
+        uint32_t logicalBlockSize;
+        uint32_t physicalBlockSize;
+    }deviceServiceEntry;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  run_Device_Service()
+    //
+    //! \brief   Description:  Listens on a Unix domain socket and handles requests from clients using the devices in deviceList, which stay open for as long as the service runs.
+    //!                        Commands from all clients are issued one at a time from the calling thread, so no device ever sees more than one command at once.
+    //!                        A client that stalls partway through a request or its response is disconnected after DEVICE_SERVICE_CLIENT_IO_TIMEOUT_SECONDS.
+    //!                        The socket is created so that only the user running the service can connect to it. Not supported on Windows or UEFI.
+    //
+    //  Entry:
+    //!   \param[in] socketPath = path to create the socket at. Any existing socket at this path is removed first. If something other than a socket is there, FAILURE is returned
+    //!   \param[in] deviceList = list of devices from get_Device_List()
+    //!   \param[in] deviceCount = number of devices in deviceList
+    //!   \param[in] stopService = service returns once this is set to true (for example, from a signal handler). Checked about every half second
+    //!
+    //  Exit:
+    //!   \return SUCCESS = service was stopped, BAD_PARAMETER, NOT_SUPPORTED, or FAILURE = could not create the socket
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int run_Device_Service(const char *socketPath, tDevice *deviceList, uint32_t deviceCount, volatile bool *stopService);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  connect_Device_Service()
+    //
+    //! \brief   Description:  Connects to a service started with run_Device_Service()
+    //
+    //  Entry:
+    //!   \param[in] socketPath = path the service was started with
+    //!   \param[out] serviceSocket = connection to pass to the other device_Service functions
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, NOT_SUPPORTED, or FAILURE = could not connect
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int connect_Device_Service(const char *socketPath, int *serviceSocket);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  disconnect_Device_Service()
+    //
+    //! \brief   Description:  Closes a connection from connect_Device_Service()
+    //
+    //  Entry:
+    //!   \param[in] serviceSocket = connection to close
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API void disconnect_Device_Service(int serviceSocket);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  device_Service_Get_Device_List()
+    //
+    //! \brief   Description:  Gets the devices the service has open. The index of a device in this list is the deviceIndex to use for passthrough requests.
+    //
+    //  Entry:
+    //!   \param[in] serviceSocket = connection from connect_Device_Service()
+    //!   \param[out] entries = filled in with up to maxEntries devices. May be NULL when maxEntries is 0 to only get the count
+    //!   \param[in] maxEntries = number of entries in the entries array
+    //!   \param[out] deviceCount = number of devices the service has open. May be more than maxEntries
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, or FAILURE = connection error
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int device_Service_Get_Device_List(int serviceSocket, deviceServiceEntry *entries, uint32_t maxEntries, uint32_t *deviceCount);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  device_Service_SCSI_Passthrough()
+    //
+    //! \brief   Description:  Has the service send a CDB to one of its devices. This works the same as scsi_Send_Cdb() on the device in the service.
+    //
+    //  Entry:
+    //!   \param[in] serviceSocket = connection from connect_Device_Service()
+    //!   \param[in] deviceIndex = device to send the CDB to
+    //!   \param[in] cdb = CDB to send
+    //!   \param[in] cdbLength = length of the CDB. Up to 32 bytes
+    //!   \param[in,out] pdata = data to send or receive. May be NULL for XFER_NO_DATA
+    //!   \param[in] dataLength = length of pdata
+    //!   \param[in] direction = XFER_NO_DATA, XFER_DATA_IN, or XFER_DATA_OUT
+    //!   \param[out] senseData = filled with the sense data from the command. May be NULL
+    //!   \param[in] senseDataLength = length of senseData
+    //!   \param[in] timeoutSeconds = command timeout. 0 uses the default
+    //!
+    //  Exit:
+    //!   \return result of the command in the service, BAD_PARAMETER, or FAILURE = connection error
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int device_Service_SCSI_Passthrough(int serviceSocket, uint32_t deviceIndex, uint8_t *cdb, uint8_t cdbLength, uint8_t *pdata, uint32_t dataLength, eDataTransferDirection direction, uint8_t *senseData, uint32_t senseDataLength, uint32_t timeoutSeconds);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  device_Service_NVMe_Passthrough()
+    //
+    //! \brief   Description:  Has the service send an NVMe command to one of its devices. This works the same as nvme_Cmd() on the device in the service.
+    //
+    //  Entry:
+    //!   \param[in] serviceSocket = connection from connect_Device_Service()
+    //!   \param[in] deviceIndex = device to send the command to
+    //!   \param[in] adminCommand = true for an admin command, false for an NVM command
+    //!   \param[in] command = 64 byte submission queue entry. The service replaces the data pointer with its own buffer and clears the metadata pointer and length, so metadata cannot be transferred.
+    //!   \param[in,out] pdata = data to send or receive. May be NULL for XFER_NO_DATA
+    //!   \param[in] dataLength = length of pdata
+    //!   \param[in] direction = XFER_NO_DATA, XFER_DATA_IN, or XFER_DATA_OUT. Must match opcode bits 1:0 or the service returns BAD_PARAMETER.
+    //!   \param[out] commandSpecific = DW0 of the completion. May be NULL
+    //!   \param[out] status = DW3 of the completion. May be NULL
+    //!   \param[in] timeoutSeconds = command timeout. 0 uses the default
+    //!
+    //  Exit:
+    //!   \return result of the command in the service, BAD_PARAMETER, NOT_SUPPORTED, or FAILURE = connection error
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int device_Service_NVMe_Passthrough(int serviceSocket, uint32_t deviceIndex, bool adminCommand, uint8_t command[DEVICE_SERVICE_COMMAND_LENGTH], uint8_t *pdata, uint32_t dataLength, eDataTransferDirection direction, uint32_t *commandSpecific, uint32_t *status, uint32_t timeoutSeconds);
+
+#if defined (__cplusplus)
+}
+#endif
@@ -0,0 +1,120 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file firmware_download.h
+// \brief Defines a segmented firmware download that sizes its segments from the device and passthrough limits.
+
+#pragma once
+
+#include "common_public.h"
+#include "cmds.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    #define FIRMWARE_DOWNLOAD_DEFAULT_SEGMENT_BYTES UINT32_C(65536)//used when neither the device nor the passthrough reports a limit
+    #define FIRMWARE_DOWNLOAD_DEFAULT_TIMEOUT_SECONDS UINT32_C(30)
+
+    typedef struct _firmwareSegmentLimits
+    {
+        uint32_t alignmentBytes;//segment sizes and offsets must be a multiple of this
+        uint32_t minimumBytes;
+        uint32_t maximumBytes;//smallest of the device and passthrough limits
+        uint32_t bufferCapacity;//SCSI only: largest image the device can take. 0 = not reported
+        bool singleSegment;//the device only takes the image in one command at offset 0
+    }firmwareSegmentLimits;
+
+    typedef struct _firmwareDownloadOptions
+    {
+        eDownloadMode mode;//DL_FW_DEFERRED, DL_FW_DEFERRED_SELECT_ACTIVATE or DL_FW_SEGMENTED. DL_FW_UNKNOWN = deferred when the device supports it, otherwise segmented
+        uint32_t segmentBytes;//0 = the largest legal segment size. Other sizes are rounded down to the alignment and must be within the limits.
+        uint8_t slotNumber;//NVMe firmware slot or SCSI buffer ID. Ignored on ATA.
+        bool existingImage;//passed through to firmware_Download_Activate()
+        bool activate;//activate after a deferred download
+        uint32_t timeoutSeconds;//per command. 0 = FIRMWARE_DOWNLOAD_DEFAULT_TIMEOUT_SECONDS
+    }firmwareDownloadOptions;
+
+    typedef struct _firmwareDownloadResult
+    {
+        eDownloadMode mode;
+        uint32_t segmentBytes;
+        uint32_t segmentsSent;
+        uint32_t bytesSent;
+        uint32_t bufferedSegments;//segments that had to be copied to an aligned buffer. The rest were sent straight from the image.
+        bool activated;
+        uint64_t downloadNanoseconds;//time from the first segment to the last, not counting activation
+    }firmwareDownloadResult;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Firmware_Segment_Limits()
+    //
+    //! \brief   Description:  Works out the segment sizes a firmware download can use.
+    //!                        ATA: download microcode minimum and maximum from the supported capabilities page of the identify device data log, or identify words 234-235.
+    //!                        NVMe: the firmware update granularity (FWUG) and the maximum data transfer size (MDTS).
+    //!                        SCSI: the offset boundary and buffer capacity from READ BUFFER descriptor mode for the buffer ID.
+    //!                        The maximum is also limited by the passthrough's maximum transfer length when one is known.
+    //
+    //  Entry:
+    //!   \param[in] device = device to download to
+    //!   \param[in] slotNumber = NVMe firmware slot or SCSI buffer ID
+    //!   \param[out] limits = segment limits
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, or NOT_SUPPORTED
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int get_Firmware_Segment_Limits(tDevice *device, uint8_t slotNumber, firmwareSegmentLimits *limits);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  firmware_Download_Image()
+    //
+    //! \brief   Description:  Downloads a firmware image in segments, sending each one as soon as the last completes.
+    //!                        Segments are sent straight from the image when it meets the device's alignment requirement, otherwise through one aligned buffer for the whole download.
+    //!                        On ATA, the count field returned by the last segment is checked so an image the device is still waiting on is reported as a failure.
+    //!                        After a deferred download, the image is activated with firmware_Download_Activate() when requested.
+    //
+    //  Entry:
+    //!   \param[in] device = device to download to
+    //!   \param[in] image = firmware image
+    //!   \param[in] imageSize = size of the image in bytes. Must be a multiple of 512 on ATA and of 4 on NVMe.
+    //!   \param[in] options = download settings. May be NULL for a deferred download with the largest segments and no activation.
+    //!   \param[out] result = what was sent. May be NULL
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, NOT_SUPPORTED, MEMORY_FAILURE, FAILURE = the device did not take the full image, or the error from a command
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int firmware_Download_Image(tDevice *device, uint8_t *image, uint32_t imageSize, firmwareDownloadOptions *options, firmwareDownloadResult *result);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  firmware_Download_File()
+    //
+    //! \brief   Description:  Memory maps a firmware file and downloads it with firmware_Download_Image(). In UEFI, where files cannot be mapped, the file is read into memory instead.
+    //
+    //  Entry:
+    //!   \param[in] device = device to download to
+    //!   \param[in] fileName = firmware file
+    //!   \param[in] options = download settings. May be NULL
+    //!   \param[out] result = what was sent. May be NULL
+    //!
+    //  Exit:
+    //!   \return FILE_OPEN_ERROR, or the same values as firmware_Download_Image()
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int firmware_Download_File(tDevice *device, const char *fileName, firmwareDownloadOptions *options, firmwareDownloadResult *result);
+
+#if defined (__cplusplus)
+}
+#endif
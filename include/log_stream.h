@@ -0,0 +1,110 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file log_stream.h
+// \brief Defines a reader that pulls large diagnostic logs from a device in chunks straight into a file or memory region.
+
+#pragma once
+
+#include "common_public.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    #define LOG_STREAM_DEFAULT_CHUNK_BYTES UINT32_C(65536)//used when the passthrough does not report its maximum transfer length
+
+    typedef enum _eLogStreamSource
+    {
+        LOG_STREAM_NVME_TELEMETRY_HOST,//NVMe telemetry host-initiated log
+        LOG_STREAM_NVME_TELEMETRY_CONTROLLER,//NVMe telemetry controller-initiated log
+        LOG_STREAM_ATA_CURRENT_INTERNAL_STATUS,//ATA current device internal status data log
+        LOG_STREAM_ATA_SAVED_INTERNAL_STATUS,//ATA saved device internal status data log
+        LOG_STREAM_SCSI_ERROR_HISTORY,//one buffer of the SCSI error history, read with READ BUFFER mode 1Ch
+    }eLogStreamSource;
+
+    typedef struct _logStreamOptions
+    {
+        uint8_t dataArea;//last data area to read, 1-3, or 4 on NVMe. 0 = 3. Ignored for SCSI.
+        bool createSnapshot;//NVMe host-initiated telemetry and ATA current internal status: have the device capture new data. SCSI: create a new error history snapshot.
+        uint8_t bufferID;//SCSI error history buffer ID (10h-EFh). 0 = the first one listed in the error history directory
+        uint32_t chunkBytes;//most bytes per command. 0 = the passthrough's maximum transfer length. Rounded down to a multiple of 512.
+    }logStreamOptions;
+
+    typedef enum _eLogStreamSinkType
+    {
+        LOG_STREAM_SINK_FILE,//written to file at its current position
+        LOG_STREAM_SINK_MEMORY,//read straight into memory, which may be a memory mapped file
+    }eLogStreamSinkType;
+
+    typedef struct _logStreamSink
+    {
+        eLogStreamSinkType type;
+        FILE *file;
+        uint8_t *memory;
+        uint64_t memoryCapacity;//must be at least the size of the log
+    }logStreamSink;
+
+    typedef struct _logStreamResult
+    {
+        uint64_t logSize;//bytes in the log, including its header
+        uint64_t bytesWritten;//bytes written to the sink. Less than logSize if the stream stopped early.
+        uint32_t chunkBytes;
+        uint32_t commandsIssued;
+        bool overlappedWrites;//file writes ran on the writer thread while the next chunk was read
+    }logStreamResult;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Log_Stream_Size()
+    //
+    //! \brief   Description:  Reads the header of a log to find out how big it is. Use this to size a memory sink.
+    //!                        If createSnapshot is set here, the snapshot it creates is the one stream_Log() reads, so clear createSnapshot before calling stream_Log().
+    //
+    //  Entry:
+    //!   \param[in] device = device to read from
+    //!   \param[in] source = log to read
+    //!   \param[in] options = which part of the log to read. May be NULL for all of it, without creating a new snapshot
+    //!   \param[out] logSize = size of the log in bytes
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, NOT_SUPPORTED, MEMORY_FAILURE, or the error from reading the header
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int get_Log_Stream_Size(tDevice *device, eLogStreamSource source, logStreamOptions *options, uint64_t *logSize);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  stream_Log()
+    //
+    //! \brief   Description:  Reads a whole log in chunks as large as the passthrough allows, using the log page offset (NVMe), log page number (ATA), or buffer offset (SCSI)
+    //!                        for each chunk. Only two chunk sized buffers are allocated however large the log is. For a file sink, one writer thread is started
+    //!                        for the call, and it writes each chunk while the next one is read from the device. For a memory sink, chunks are read straight into the memory when it meets
+    //!                        the OS alignment requirement.
+    //!                        For logs that the device can replace on its own (NVMe controller-initiated telemetry and ATA saved internal status) the data generation
+    //!                        number is checked so that a log that changed partway through is reported as a failure.
+    //
+    //  Entry:
+    //!   \param[in] device = device to read from
+    //!   \param[in] source = log to read
+    //!   \param[in] options = which part of the log to read and how. May be NULL for all of it in the largest chunks, without creating a new snapshot
+    //!   \param[in] sink = where to put the log
+    //!   \param[out] result = what was read. May be NULL
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, NOT_SUPPORTED, MEMORY_FAILURE, ERROR_WRITING_FILE, FAILURE = the log changed while it was read, or the error from a command
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int stream_Log(tDevice *device, eLogStreamSource source, logStreamOptions *options, logStreamSink *sink, logStreamResult *result);
+
+#if defined (__cplusplus)
+}
+#endif
@@ -0,0 +1,134 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file nv_cache_manager.h
+// \brief Defines a manager that pins the most frequently missed LBAs of an ATA hybrid drive into its NV cache.
+
+#pragma once
+
+#include "common_public.h"
+#include "surface_scan.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    #define NV_CACHE_DEFAULT_GRANULARITY_LBAS UINT32_C(2048)
+    #define NV_CACHE_DEFAULT_DECAY_SHIFT 2
+    #define NV_CACHE_HEAT_PER_ACCESS UINT32_C(1024)
+    #define NV_CACHE_LBA_RANGE_ENTRY_LENGTH 8
+    #define NV_CACHE_LBA_RANGE_ENTRIES_PER_BLOCK 64//512 byte block / NV_CACHE_LBA_RANGE_ENTRY_LENGTH
+    //Most 512 byte blocks of LBA range entries sent in one add or remove command: 8KiB, or 1024 entries of up to 65535 LBAs each, so one command covers about 64M LBAs.
+    //Lowered to the passthrough's maximum transfer length when that is smaller.
+    #define NV_CACHE_MAX_BLOCKS_PER_COMMAND UINT16_C(16)
+
+    typedef struct _nvCacheManagerOptions
+    {
+        uint32_t granularityLBAs;//size of each tracked region. 0 = NV_CACHE_DEFAULT_GRANULARITY_LBAS
+        uint8_t decayShift;//each update keeps heat - (heat >> decayShift). 0 = NV_CACHE_DEFAULT_DECAY_SHIFT
+        uint64_t maxPinnedLBAs;//most LBAs to pin. 0 = the NV cache size reported in identify data
+        bool populateImmediately;//have the drive read newly pinned LBAs into the cache right away instead of on their next access
+    }nvCacheManagerOptions;
+
+    typedef struct _nvCacheHeat
+    {
+        uint64_t region;//LBA / granularityLBAs
+        uint32_t heat;
+    }nvCacheHeat;
+
+    typedef struct _nvCacheManager
+    {
+        tDevice *device;
+        uint32_t granularityLBAs;
+        uint8_t decayShift;
+        uint64_t maxPinnedLBAs;
+        bool populateImmediately;
+        uint32_t heatCount;
+        uint32_t heatCapacity;
+        nvCacheHeat *heatMap;//sorted by region. Regions that have cooled to 0 are removed.
+        lbaIntervalSet pinned;//LBAs in the drive's pinned set
+        uint32_t commandsIssued;//add and remove commands sent by apply_NV_Cache_Pinning()
+    }nvCacheManager;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  start_NV_Cache_Manager()
+    //
+    //! \brief   Description:  Sets up a manager for the NV cache of an ATA hybrid drive and reads the drive's current pinned set.
+    //!                        The NV Cache feature set must be enabled and the drive must support DMA, which the pinned set commands use.
+    //
+    //  Entry:
+    //!   \param[in] device = ATA hybrid drive
+    //!   \param[in] options = manager settings. May be NULL to use the defaults
+    //!   \param[out] manager = manager to set up. Must be freed with free_NV_Cache_Manager()
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, NOT_SUPPORTED, or FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int start_NV_Cache_Manager(tDevice *device, nvCacheManagerOptions *options, nvCacheManager *manager);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  update_NV_Cache_Heat()
+    //
+    //! \brief   Description:  Cools the whole heat map, then reads the drive's NV cache misses and warms each region a missed range falls in.
+    //!                        Call this periodically, then call apply_NV_Cache_Pinning() to act on the new heat map.
+    //
+    //  Entry:
+    //!   \param[in] manager = manager from start_NV_Cache_Manager()
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, or the error from Query NV Cache Misses
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int update_NV_Cache_Heat(nvCacheManager *manager);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  nv_Cache_Note_Access()
+    //
+    //! \brief   Description:  Warms the regions of a range of LBAs the host knows it accessed, in addition to the misses the drive reports.
+    //!                        A range longer than maxPinnedLBAs only warms the regions covering its first maxPinnedLBAs, since the rest could not be pinned with it.
+    //
+    //  Entry:
+    //!   \param[in] manager = manager from start_NV_Cache_Manager()
+    //!   \param[in] lba = first LBA accessed
+    //!   \param[in] length = number of LBAs accessed
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, or MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int nv_Cache_Note_Access(nvCacheManager *manager, uint64_t lba, uint64_t length);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  apply_NV_Cache_Pinning()
+    //
+    //! \brief   Description:  Pins the hottest regions, up to maxPinnedLBAs, and unpins anything else the manager's pinned set holds.
+    //!                        Neighbouring regions are merged, and the LBA range entries are packed NV_CACHE_MAX_BLOCKS_PER_COMMAND blocks to a command, so the fewest commands are sent.
+    //!                        LBAs are unpinned before new ones are pinned so that the pinned set never needs more than maxPinnedLBAs.
+    //
+    //  Entry:
+    //!   \param[in] manager = manager from start_NV_Cache_Manager()
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, or the error from an add or remove command. After an error, the pinned set is read back from the drive.
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int apply_NV_Cache_Pinning(nvCacheManager *manager);
+
+    OPENSEA_TRANSPORT_API void free_NV_Cache_Manager(nvCacheManager *manager);
+
+#if defined (__cplusplus)
+}
+#endif
@@ -55,8 +55,15 @@ extern "C"
         NVME_IDENTIFY_CTRL = 1,
         NVME_IDENTIFY_ALL_ACTIVE_NS = 2,
         NVME_IDENTIFY_NS_ID_DESCRIPTOR_LIST = 3,
+        NVME_IDENTIFY_IO_CMD_SET_NS = 5,//command set specific namespace data. The command set is selected with the CSI field
     } eNvmeIdentifyCNS;
 
+    typedef enum _eNvmeCommandSetIdentifier {
+        NVME_CSI_NVM = 0,
+        NVME_CSI_KEY_VALUE = 1,
+        NVME_CSI_ZONED_NAMESPACE = 2,
+    } eNvmeCommandSetIdentifier;
+
     typedef enum _eNvmePowerFlags{
         NVME_PS_FLAG_MAX_POWER_SCALE    = 1 << 0,
         NVME_PS_FLAG_NON_OP_STATE   = 1 << 1,
@@ -386,8 +393,32 @@ extern "C"
         NVME_CMD_RESERVATION_REPORT     = 0x0E,
         NVME_CMD_RESERVATION_ACQUIRE    = 0x11,
         NVME_CMD_RESERVATION_RELEASE    = 0x15,
+        NVME_CMD_COPY                   = 0x19,
+        NVME_CMD_ZONE_MANAGEMENT_SEND   = 0x79,
+        NVME_CMD_ZONE_MANAGEMENT_RECEIVE = 0x7A,
+        NVME_CMD_ZONE_APPEND            = 0x7D,
     } eNvmeOPCodes;
 
+    typedef enum _eNvmeZoneSendAction {
+        NVME_ZONE_SEND_ACTION_CLOSE                 = 0x01,
+        NVME_ZONE_SEND_ACTION_FINISH                = 0x02,
+        NVME_ZONE_SEND_ACTION_OPEN                  = 0x03,
+        NVME_ZONE_SEND_ACTION_RESET                 = 0x04,
+        NVME_ZONE_SEND_ACTION_OFFLINE               = 0x05,
+        NVME_ZONE_SEND_ACTION_SET_DESCRIPTOR_EXT    = 0x10,
+    } eNvmeZoneSendAction;
+
+    typedef enum _eNvmeZoneReceiveAction {
+        NVME_ZONE_RECEIVE_ACTION_REPORT_ZONES           = 0x00,
+        NVME_ZONE_RECEIVE_ACTION_EXTENDED_REPORT_ZONES  = 0x01,
+    } eNvmeZoneReceiveAction;
+
+    #define NVME_COPY_SOURCE_RANGE_LENGTH 32 //format 0 source range entry for the copy command
+
+    //Zone descriptors in a ZNS report zones data structure follow a 64 byte header and are 64 bytes each (plus the zone descriptor extension size in an extended report)
+    #define NVME_ZONE_DESCRIPTOR_LENGTH 64
+    #define NVME_ZNS_LBA_FORMAT_EXTENSION_OFFSET 2816 //offset of the LBA format extensions (zone size) in the ZNS identify namespace data
+
 
     #if !defined (__GNUC__) || defined (__MINGW32__) || defined (__MINGW64__)
     #pragma pack(push, 1)
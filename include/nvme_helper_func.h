@@ -189,6 +189,25 @@ OPENSEA_TRANSPORT_API int nvme_Get_DevSelfTest_Log_Page(tDevice *device, uint8_t
 //-----------------------------------------------------------------------------
 OPENSEA_TRANSPORT_API int nvme_Identify(tDevice *device, uint8_t *ptrData, uint32_t nvmeNamespace, uint32_t cns);
 
+//-----------------------------------------------------------------------------
+//
+//  nvme_Identify_IO_Command_Set()
+//
+//! \brief   Description:  Function to send a NVMe identify command for data that is specific to an I/O command set, such as the zoned namespace identify namespace data
+//
+//  Entry:
+//!   \param[in] device = pointer to tDevice structure
+//!   \param[out] ptrData = pointer to the data buffer to be filled in with identify data. Must be NVME_IDENTIFY_DATA_LEN bytes
+//!   \param[in] nvmeNamespace = namespace ID
+//!   \param[in] cns = identify data structure to return. Ex: NVME_IDENTIFY_IO_CMD_SET_NS
+//!   \param[in] csi = command set identifier. Ex: NVME_CSI_ZONED_NAMESPACE
+//!
+//  Exit:
+//!   \return SUCCESS = pass, !SUCCESS = something when wrong
+//
+//-----------------------------------------------------------------------------
+OPENSEA_TRANSPORT_API int nvme_Identify_IO_Command_Set(tDevice *device, uint8_t *ptrData, uint32_t nvmeNamespace, uint8_t cns, uint8_t csi);
+
 //-----------------------------------------------------------------------------
 //
 //  nvme_Firmware_Image_Dl()
@@ -329,6 +348,92 @@ OPENSEA_TRANSPORT_API int nvme_Reservation_Acquire(tDevice *device, uint8_t rese
 
 OPENSEA_TRANSPORT_API int nvme_Reservation_Release(tDevice *device, uint8_t reservationType, bool ignoreExistingKey, uint8_t reservtionReleaseAction, uint8_t *ptrData, uint32_t dataSize);
 
+//-----------------------------------------------------------------------------
+//
+//  nvme_Copy()
+//
+//! \brief   Description:  Sends an NVMe Copy command to copy one or more source ranges to a single destination range on the same namespace without transferring the data to the host
+//
+//  Entry:
+//!   \param[in] device = pointer to tDevice structure
+//!   \param[in] destinationLBA = first LBA to write the copied data to. Source ranges are written one after the other from here
+//!   \param[in] numberOfRanges = number of source range entries in ptrData. 0 based
+//!   \param[in] descriptorFormat = format of the source range entries. Format 0 entries are NVME_COPY_SOURCE_RANGE_LENGTH bytes
+//!   \param[in] limitedRetry = limited retry
+//!   \param[in] fua = force unit access
+//!   \param[in] ptrData = source range entries
+//!   \param[in] dataLength = length of ptrData
+//!   \param[in] timeoutSeconds = command timeout. Copies of a lot of data take longer. 0 = 15 seconds
+//!
+//  Exit:
+//!   \return SUCCESS = pass, !SUCCESS = something when wrong
+//
+//-----------------------------------------------------------------------------
+OPENSEA_TRANSPORT_API int nvme_Copy(tDevice *device, uint64_t destinationLBA, uint8_t numberOfRanges, uint8_t descriptorFormat, bool limitedRetry, bool fua, uint8_t *ptrData, uint32_t dataLength, uint32_t timeoutSeconds);
+
+//-----------------------------------------------------------------------------
+//
+//  nvme_Zone_Management_Send()
+//
+//! \brief   Description:  Sends a zoned namespace Zone Management Send command to close, finish, open, reset, or offline a zone
+//
+//  Entry:
+//!   \param[in] device = pointer to tDevice structure
+//!   \param[in] startingLBA = start LBA of the zone
+//!   \param[in] selectAll = set to apply the action to all zones it is valid for. startingLBA is ignored
+//!   \param[in] zoneSendAction = eNvmeZoneSendAction
+//!   \param[in] ptrData = zone descriptor extension for NVME_ZONE_SEND_ACTION_SET_DESCRIPTOR_EXT, otherwise NULL
+//!   \param[in] dataLength = length of ptrData
+//!
+//  Exit:
+//!   \return SUCCESS = pass, !SUCCESS = something when wrong
+//
+//-----------------------------------------------------------------------------
+OPENSEA_TRANSPORT_API int nvme_Zone_Management_Send(tDevice *device, uint64_t startingLBA, bool selectAll, uint8_t zoneSendAction, uint8_t *ptrData, uint32_t dataLength);
+
+//-----------------------------------------------------------------------------
+//
+//  nvme_Zone_Management_Receive()
+//
+//! \brief   Description:  Sends a zoned namespace Zone Management Receive command to report zones
+//
+//  Entry:
+//!   \param[in] device = pointer to tDevice structure
+//!   \param[in] startingLBA = LBA to start reporting zones from
+//!   \param[in] zoneReceiveAction = eNvmeZoneReceiveAction
+//!   \param[in] reportingOptions = which zones to report. 0 = all. 1 - 7 match ZONE_REPORT_LIST_EMPTY_ZONES through ZONE_REPORT_LIST_OFFLINE_ZONES
+//!   \param[in] partial = set for the number of zones in the header to only count the zones that fit in the buffer
+//!   \param[out] ptrData = buffer to fill with the report
+//!   \param[in] dataLength = length of ptrData. Must be a multiple of 4 bytes
+//!
+//  Exit:
+//!   \return SUCCESS = pass, !SUCCESS = something when wrong
+//
+//-----------------------------------------------------------------------------
+OPENSEA_TRANSPORT_API int nvme_Zone_Management_Receive(tDevice *device, uint64_t startingLBA, uint8_t zoneReceiveAction, uint8_t reportingOptions, bool partial, uint8_t *ptrData, uint32_t dataLength);
+
+//-----------------------------------------------------------------------------
+//
+//  nvme_Zone_Append()
+//
+//! \brief   Description:  Sends a zoned namespace Zone Append command. The controller writes the data at the zone's write pointer and returns where it was written,
+//!                        so many writers can append to the same zone without waiting on each other to know the write pointer.
+//
+//  Entry:
+//!   \param[in] device = pointer to tDevice structure
+//!   \param[in] zoneStartLBA = start LBA of the zone to append to
+//!   \param[in] numberOfLogicalBlocks = number of logical blocks to write. 0 based, same as nvme_Write()
+//!   \param[in] fua = force unit access
+//!   \param[in] ptrData = data to write
+//!   \param[in] dataLength = length of ptrData
+//!   \param[out] assignedLBA = LBA the first block was written at. UINT64_MAX when the OS did not return the completion data holding it. May be NULL
+//!
+//  Exit:
+//!   \return SUCCESS = pass, !SUCCESS = something when wrong
+//
+//-----------------------------------------------------------------------------
+OPENSEA_TRANSPORT_API int nvme_Zone_Append(tDevice *device, uint64_t zoneStartLBA, uint16_t numberOfLogicalBlocks, bool fua, uint8_t *ptrData, uint32_t dataLength, uint64_t *assignedLBA);
+
 OPENSEA_TRANSPORT_API int pci_Correctble_Err(tDevice *device,uint8_t  opcode, uint32_t  nsid, uint32_t  cdw10, uint32_t cdw11, uint32_t data_len, void *data);
 
 // \fn fill_In_NVMe_Device_Info(tDevice * device)
@@ -0,0 +1,206 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file progress_monitor.h
+// \brief Defines a single threaded monitor that polls long running operations on many devices from a timer wheel.
+
+#pragma once
+
+#include "common_public.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    typedef enum _eMonitoredOperation
+    {
+        MONITORED_OPERATION_SANITIZE,
+        MONITORED_OPERATION_SELF_TEST,
+        MONITORED_OPERATION_FORMAT,
+    }eMonitoredOperation;
+
+    typedef enum _eMonitoredOperationState
+    {
+        MONITORED_OPERATION_STATE_IN_PROGRESS,
+        MONITORED_OPERATION_STATE_COMPLETE,
+        MONITORED_OPERATION_STATE_FAILED,
+        MONITORED_OPERATION_STATE_ERROR,//the device could not be polled
+    }eMonitoredOperationState;
+
+    typedef struct _operationProgress
+    {
+        eMonitoredOperationState state;
+        bool percentValid;//some devices only report whether the operation is still running
+        double percentComplete;
+    }operationProgress;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Operation_Progress()
+    //
+    //! \brief   Description:  Reads the progress of a sanitize, self-test, or format once.
+    //!                        ATA: sanitize status, or the self-test execution status from SMART read data. ATA has no format to report on.
+    //!                        SCSI: the progress indication from REQUEST SENSE, and the self-test results log page for background self-tests.
+    //!                        NVMe: the sanitize status or device self-test log page, or the format progress indicator in identify namespace.
+    //
+    //  Entry:
+    //!   \param[in] device = device to check
+    //!   \param[in] operation = operation to check
+    //!   \param[out] progress = state and percent complete
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, NOT_SUPPORTED, or the error from the command used to read the progress
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int get_Operation_Progress(tDevice *device, eMonitoredOperation operation, operationProgress *progress);
+
+    //Called on every poll when progressUpdates is set, otherwise only once the operation is no longer in progress.
+    //progress is a copy that is only valid during the call. The callback may call add_Monitored_Operation() on the same monitor.
+    typedef void (*progressMonitorCallback)(tDevice *device, eMonitoredOperation operation, operationProgress *progress, void *callbackData);
+
+    #define PROGRESS_MONITOR_WHEEL_SLOTS 256
+    #define PROGRESS_MONITOR_DEFAULT_TICK_MILLISECONDS UINT32_C(250)
+    #define PROGRESS_MONITOR_DEFAULT_MIN_INTERVAL_MILLISECONDS UINT32_C(1000)
+    #define PROGRESS_MONITOR_DEFAULT_MAX_INTERVAL_MILLISECONDS UINT32_C(300000)
+
+    typedef struct _progressMonitorOptions
+    {
+        uint32_t tickMilliseconds;//timer wheel resolution. 0 = PROGRESS_MONITOR_DEFAULT_TICK_MILLISECONDS
+        uint32_t minIntervalMilliseconds;//shortest time between polls of one operation. 0 = PROGRESS_MONITOR_DEFAULT_MIN_INTERVAL_MILLISECONDS
+        uint32_t maxIntervalMilliseconds;//longest time between polls of one operation. 0 = PROGRESS_MONITOR_DEFAULT_MAX_INTERVAL_MILLISECONDS
+    }progressMonitorOptions;
+
+    typedef struct _monitoredOperation
+    {
+        tDevice *device;
+        eMonitoredOperation operation;
+        progressMonitorCallback callback;
+        void *callbackData;
+        bool progressUpdates;
+        bool active;
+        operationProgress progress;
+        uint32_t pollCount;
+        uint64_t lastPollMilliseconds;
+        double lastPercentComplete;
+        uint32_t intervalMilliseconds;
+        uint64_t dueTick;
+        uint32_t nextInSlot;//UINT32_MAX = end of the slot's list
+    }monitoredOperation;
+
+    typedef struct _progressMonitor
+    {
+        seatimer_t clock;//started when the monitor is set up. The time since then is the monitor's clock.
+        uint32_t tickMilliseconds;
+        uint32_t minIntervalMilliseconds;
+        uint32_t maxIntervalMilliseconds;
+        uint64_t processedTick;//every tick up to and including this one has been handled
+        uint32_t wheel[PROGRESS_MONITOR_WHEEL_SLOTS];//first operation due in each slot. UINT32_MAX = empty
+        uint32_t operationCount;
+        uint32_t operationCapacity;
+        monitoredOperation *operations;
+        uint32_t activeCount;
+    }progressMonitor;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  init_Progress_Monitor()
+    //
+    //! \brief   Description:  Sets up an empty monitor.
+    //
+    //  Entry:
+    //!   \param[out] monitor = monitor to set up. Must be freed with free_Progress_Monitor()
+    //!   \param[in] options = monitor settings. May be NULL to use the defaults
+    //!
+    //  Exit:
+    //!   \return SUCCESS or BAD_PARAMETER
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int init_Progress_Monitor(progressMonitor *monitor, progressMonitorOptions *options);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  add_Monitored_Operation()
+    //
+    //! \brief   Description:  Adds an operation that has already been started to the monitor. It is first polled after minIntervalMilliseconds.
+    //!                        After each poll, the next one is scheduled from the progress rate: about a quarter of the estimated time left, between the minimum and maximum intervals.
+    //!                        When the progress does not move, or the device does not report a percentage, the interval doubles up to the maximum.
+    //
+    //  Entry:
+    //!   \param[in] monitor = monitor from init_Progress_Monitor()
+    //!   \param[in] device = device running the operation
+    //!   \param[in] operation = operation to monitor
+    //!   \param[in] callback = called when the operation finishes. May be NULL
+    //!   \param[in] callbackData = passed to callback
+    //!   \param[in] progressUpdates = call the callback after every poll, not only when the operation finishes
+    //!   \param[out] operationID = ID to use with get_Monitored_Operation_Progress(). May be NULL
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, or MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int add_Monitored_Operation(progressMonitor *monitor, tDevice *device, eMonitoredOperation operation, progressMonitorCallback callback, void *callbackData, bool progressUpdates, uint32_t *operationID);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  progress_Monitor_Poll()
+    //
+    //! \brief   Description:  Polls every operation that is due. Operations that are no longer in progress are removed from the wheel after their callback.
+    //!                        Callbacks may add operations. An operation added from a callback is first polled on a later call.
+    //!                        Use this to drive the monitor from an existing loop, or use run_Progress_Monitor().
+    //
+    //  Entry:
+    //!   \param[in] monitor = monitor from init_Progress_Monitor()
+    //!   \param[out] millisecondsToNextPoll = time until the next operation is due. UINT32_MAX when nothing is left. May be NULL
+    //!
+    //  Exit:
+    //!   \return SUCCESS or BAD_PARAMETER
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int progress_Monitor_Poll(progressMonitor *monitor, uint32_t *millisecondsToNextPoll);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  run_Progress_Monitor()
+    //
+    //! \brief   Description:  Polls and sleeps until every operation has finished.
+    //
+    //  Entry:
+    //!   \param[in] monitor = monitor from init_Progress_Monitor()
+    //!   \param[in] stopMonitor = set to true from a callback or signal handler to return early. May be NULL
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, or ABORTED = stopped early
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int run_Progress_Monitor(progressMonitor *monitor, volatile bool *stopMonitor);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Monitored_Operation_Progress()
+    //
+    //! \brief   Description:  Gets the progress of an operation as of its last poll.
+    //
+    //  Entry:
+    //!   \param[in] monitor = monitor from init_Progress_Monitor()
+    //!   \param[in] operationID = ID from add_Monitored_Operation()
+    //!   \param[out] progress = progress from the last poll
+    //!
+    //  Exit:
+    //!   \return SUCCESS or BAD_PARAMETER
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int get_Monitored_Operation_Progress(progressMonitor *monitor, uint32_t operationID, operationProgress *progress);
+
+    OPENSEA_TRANSPORT_API void free_Progress_Monitor(progressMonitor *monitor);
+
+#if defined (__cplusplus)
+}
+#endif
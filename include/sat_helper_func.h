@@ -213,7 +213,7 @@ extern "C"
     //
     //  Entry:
     //!   \param[in] device = pointer to device struct for device command will be sent to.
-    //!   \param[out] satCDB = 16byte array to hold the built command.
+    //!   \param[out] satCDB = pointer to set to the built command. This is borrowed with borrow_Command_Buffer() and must be given back with return_Command_Buffer()
     //!   \param[out] cdbLen = length of CDB built
     //!   \param[in] ataCommandOptions = pointer to ATA command options that defines the command to build.
     //!
@@ -257,6 +257,22 @@ extern "C"
     //-----------------------------------------------------------------------------
     int translate_SCSI_Command(tDevice *device, ScsiIoCtx *scsiIoCtx);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  invalidate_Software_SAT_Snapshot(tDevice *device)
+    //
+    //! \brief   Description:  Discards the identify data and device statistics the software SAT translator kept from earlier commands
+    //!          so that they are read from the device again the next time they are needed. Call this after any command that may change them
+    //!          (set features, security, sanitize, download microcode, set max, format, etc).
+    //
+    //  Entry:
+    //!   \param[in] device = pointer to the device structure
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    void invalidate_Software_SAT_Snapshot(tDevice *device);
+
 #if defined (__cplusplus)
 }
 #endif
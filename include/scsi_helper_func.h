@@ -54,7 +54,7 @@ extern "C"
     //
     //  uint16_t calculate_Logical_Block_Guard(uint8_t *buffer, uint32_t userDataLength, uint32_t totalDataLength)
     //
-    //! \brief   Description:  This function will perform the SBC CRC16 calculation for a logical block guard used when a drive is formatted with PI. This should be used one sector at a time.
+    //! \brief   Description:  This function will perform the SBC CRC16 calculation for a logical block guard used when a drive is formatted with PI. This should be used one sector (or protection interval) at a time.
     //
     //  Entry:
     //!   \param buffer - pointer a buffer with user data
@@ -67,6 +67,53 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_TRANSPORT_API uint16_t calculate_Logical_Block_Guard(uint8_t *buffer, uint32_t userDataLength, uint32_t totalDataLength);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  generate_Protection_Information()
+    //
+    //! \brief   Description:  Fills in the 8 byte protection information (guard, application tag, reference tag) after each protection interval of a buffer.
+    //!                        The buffer is laid out the way the drive transfers it with PI: each protection interval (logical block size >> PI exponent) followed by its PI.
+    //!                        For Types 1 and 2 the reference tag starts at initialReferenceTag and increments by one for each protection interval. For Type 3 every interval gets initialReferenceTag.
+    //
+    //  Entry:
+    //!   \param buffer - pointer to the data with room for the PI after each protection interval
+    //!   \param bufferLength - length of the buffer. Must be a multiple of the protection interval size + 8
+    //!   \param logicalBlockSize - logical block size without PI (device->drive_info.deviceBlockSize)
+    //!   \param protectionType - 1, 2, or 3 (device->drive_info.currentProtectionType)
+    //!   \param piExponent - protection information intervals exponent (device->drive_info.piExponent)
+    //!   \param initialReferenceTag - reference tag for the first protection interval. For Type 1 this is the low 32 bits of the starting LBA
+    //!   \param applicationTag - application tag to set in every interval
+    //!
+    //  Exit:
+    //!   \return SUCCESS = pass, BAD_PARAMETER = invalid buffer layout or protection type
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int generate_Protection_Information(uint8_t *buffer, uint32_t bufferLength, uint32_t logicalBlockSize, uint8_t protectionType, uint8_t piExponent, uint32_t initialReferenceTag, uint16_t applicationTag);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  verify_Protection_Information()
+    //
+    //! \brief   Description:  Checks the protection information in a buffer read with PI against the data and the expected tags. See generate_Protection_Information() for the buffer layout and reference tag rules.
+    //!                        Intervals with an application tag of FFFFh (and for Type 3, a reference tag of FFFFFFFFh) are skipped, the same as the drive does.
+    //
+    //  Entry:
+    //!   \param buffer - pointer to the data and PI to check
+    //!   \param bufferLength - length of the buffer. Must be a multiple of the protection interval size + 8
+    //!   \param logicalBlockSize - logical block size without PI (device->drive_info.deviceBlockSize)
+    //!   \param protectionType - 1, 2, or 3 (device->drive_info.currentProtectionType)
+    //!   \param piExponent - protection information intervals exponent (device->drive_info.piExponent)
+    //!   \param initialReferenceTag - expected reference tag of the first protection interval. Not checked for Type 3
+    //!   \param applicationTag - expected application tag
+    //!   \param applicationTagMask - which bits of the application tag to check. 0 to not check the application tag
+    //!   \param firstBadInterval - set to the index of the first protection interval that did not match. May be NULL
+    //!
+    //  Exit:
+    //!   \return SUCCESS = all PI matched, FAILURE = a guard or tag did not match, BAD_PARAMETER = invalid buffer layout or protection type
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int verify_Protection_Information(uint8_t *buffer, uint32_t bufferLength, uint32_t logicalBlockSize, uint8_t protectionType, uint8_t piExponent, uint32_t initialReferenceTag, uint16_t applicationTag, uint16_t applicationTagMask, uint32_t *firstBadInterval);
+
     //-----------------------------------------------------------------------------
     //
     //  check_Sense_Key_ASC_ASCQ_And_FRU()
@@ -194,6 +241,23 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_TRANSPORT_API int fill_In_Device_Info(tDevice *device);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  fill_Lazy_SCSI_Device_Info()
+    //
+    //! \brief   Description:  Reads the SCSI device information that was skipped during LAZY_DISCOVERY (or invalidated).
+    //                         Use fill_Lazy_Device_Info() instead of calling this directly so that pending flags are tracked.
+    //
+    //  Entry:
+    //!   \param[out] device - pointer to the device structure
+    //!   \param[in] lazyInfo - bitfield of eLazyDeviceInfo values to read
+    //!
+    //  Exit:
+    //!   \return SUCCESS = pass, !SUCCESS = something when wrong
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int fill_Lazy_SCSI_Device_Info(tDevice *device, uint32_t lazyInfo);
+
     //-----------------------------------------------------------------------------
     //
     //  copy_Inquiry_Data()
@@ -1048,6 +1112,62 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_TRANSPORT_API int scsi_Get_Lba_Status(tDevice *device, uint64_t logicalBlockAddress, uint32_t allocationLength, uint8_t *ptrData);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  scsi_Populate_Token()
+    //
+    //! \brief   Description:  Send a SCSI Populate Token command to create a point in time ROD token for a list of LBA ranges. The token is read back with scsi_Receive_ROD_Token_Information()
+    //
+    //  Entry:
+    //!   \param device - pointer to the device structure
+    //!   \param listIdentifier - identifies this copy operation in later commands
+    //!   \param ptrData - populate token parameter list with the block device range descriptors
+    //!   \param parameterListLength - length of ptrData
+    //!   \param timeoutSeconds - command timeout
+    //!
+    //  Exit:
+    //!   \return SUCCESS = pass, !SUCCESS = something when wrong
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int scsi_Populate_Token(tDevice *device, uint32_t listIdentifier, uint8_t *ptrData, uint32_t parameterListLength, uint32_t timeoutSeconds);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  scsi_Write_Using_Token()
+    //
+    //! \brief   Description:  Send a SCSI Write Using Token command to write the data represented by a ROD token to a list of LBA ranges
+    //
+    //  Entry:
+    //!   \param device - pointer to the device structure
+    //!   \param listIdentifier - identifies this copy operation in later commands
+    //!   \param ptrData - write using token parameter list with the ROD token and block device range descriptors
+    //!   \param parameterListLength - length of ptrData
+    //!   \param timeoutSeconds - command timeout
+    //!
+    //  Exit:
+    //!   \return SUCCESS = pass, !SUCCESS = something when wrong
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int scsi_Write_Using_Token(tDevice *device, uint32_t listIdentifier, uint8_t *ptrData, uint32_t parameterListLength, uint32_t timeoutSeconds);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  scsi_Receive_ROD_Token_Information()
+    //
+    //! \brief   Description:  Send a SCSI Receive ROD Token Information command to get the status of a Populate Token or Write Using Token command, and the ROD token made by Populate Token
+    //
+    //  Entry:
+    //!   \param device - pointer to the device structure
+    //!   \param listIdentifier - list identifier the Populate Token or Write Using Token command was sent with
+    //!   \param ptrData - pointer to the data buffer to fill upon command completion
+    //!   \param allocationLength - size of the data buffer to transfer
+    //!
+    //  Exit:
+    //!   \return SUCCESS = pass, !SUCCESS = something when wrong
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int scsi_Receive_ROD_Token_Information(tDevice *device, uint32_t listIdentifier, uint8_t *ptrData, uint32_t allocationLength);
+
     //-----------------------------------------------------------------------------
     //
     //  scsi_orwrite_16()
@@ -213,6 +213,14 @@ extern "C"
 #define OPENSEA_SG_ERR_DID_SOFT_ERROR 0x000B
 #endif
 
+#ifndef OPENSEA_SG_ERR_DID_TRANSPORT_DISRUPTED
+#define OPENSEA_SG_ERR_DID_TRANSPORT_DISRUPTED 0x000E
+#endif
+
+#ifndef OPENSEA_SG_ERR_DID_TRANSPORT_FAILFAST
+#define OPENSEA_SG_ERR_DID_TRANSPORT_FAILFAST 0x000F
+#endif
+
 // \fn send_sg_io(scsiIoCtx * scsiIoCtx)
 // \brief Function to send a SG_IO ioctl
 // \param scsiIoCtx
@@ -271,6 +279,25 @@ int os_Bus_Reset(tDevice *device);
 //-----------------------------------------------------------------------------
 int os_Controller_Reset(tDevice *device);
 
+//-----------------------------------------------------------------------------
+//
+//  sg_Add_Device_Path(tDevice *device, const char *filename)
+//
+//! \brief   Description:  Opens another handle to the same logical unit, such as the second port of a dual ported SAS drive, so commands can be issued through either path.
+//!                        Reads, writes, and verifies are spread round robin across all paths. Other commands always use the first working path so that state kept
+//!                        per I_T nexus (sense data, reservations, etc) stays on one path. When a path reports a transport failure, it is skipped and the command is retried on the next path.
+//
+//  Entry:
+//!   \param[in]  device = pointer to device context from get_Device()
+//!   \param[in]  filename = handle for the other path (/dev/sg? or /dev/sd?)
+//! 
+//!
+//  Exit:
+//!   \return SUCCESS = path added, BAD_PARAMETER = filename is not the same logical unit or is a path the device already has, FAILURE = no more paths can be added, or the error from get_Device() on the new path
+//
+//-----------------------------------------------------------------------------
+int sg_Add_Device_Path(tDevice *device, const char *filename);
+
 
 #if !defined(DISABLE_NVME_PASSTHROUGH)
 //-----------------------------------------------------------------------------
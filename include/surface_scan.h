@@ -0,0 +1,148 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file surface_scan.h
+// \brief Defines the functions to scan a range of LBAs for media errors and keep track of the bad LBAs found.
+
+#pragma once
+
+#include "common_public.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    typedef struct _lbaInterval
+    {
+        uint64_t startLBA;
+        uint64_t length;
+    }lbaInterval;
+
+    //Sorted list of LBA ranges. Ranges that overlap or touch are merged when added, so a run of bad LBAs takes up one entry.
+    typedef struct _lbaIntervalSet
+    {
+        uint32_t intervalCount;
+        uint32_t intervalCapacity;
+        lbaInterval *intervals;
+    }lbaIntervalSet;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  add_LBA_Interval()
+    //
+    //! \brief   Description:  Adds a range of LBAs to an interval set, merging it with any ranges it overlaps or touches.
+    //
+    //  Entry:
+    //!   \param[in] intervalSet = set to add to. Start with a zeroed set.
+    //!   \param[in] startLBA = first LBA of the range
+    //!   \param[in] length = number of LBAs in the range
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, or MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int add_LBA_Interval(lbaIntervalSet *intervalSet, uint64_t startLBA, uint64_t length);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  is_LBA_In_Interval_Set()
+    //
+    //! \brief   Description:  Checks if an LBA is in any of the ranges in an interval set.
+    //
+    //  Entry:
+    //!   \param[in] intervalSet = set to search
+    //!   \param[in] lba = LBA to look for
+    //!
+    //  Exit:
+    //!   \return true = LBA is in the set, false = it is not
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API bool is_LBA_In_Interval_Set(lbaIntervalSet *intervalSet, uint64_t lba);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_LBA_Interval_Set_Total()
+    //
+    //! \brief   Description:  Gets the number of LBAs covered by all of the ranges in an interval set.
+    //
+    //  Entry:
+    //!   \param[in] intervalSet = set to count
+    //!
+    //  Exit:
+    //!   \return number of LBAs in the set
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API uint64_t get_LBA_Interval_Set_Total(lbaIntervalSet *intervalSet);
+
+    OPENSEA_TRANSPORT_API void free_LBA_Interval_Set(lbaIntervalSet *intervalSet);
+
+    typedef enum _eSurfaceScanMode
+    {
+        SURFACE_SCAN_VERIFY,//verify commands. No data is transferred.
+        SURFACE_SCAN_READ,//read commands. Data is transferred, which also tests the interface.
+    }eSurfaceScanMode;
+
+    //Called after each command. currentLBA is the next LBA to be scanned. Return false to stop the scan.
+    typedef bool (*surfaceScanProgress)(tDevice *device, void *progressData, uint64_t currentLBA, uint64_t badLBACount);
+
+    #define SURFACE_SCAN_DEFAULT_VERIFY_CHUNK UINT32_C(65536)
+    #define SURFACE_SCAN_DEFAULT_READ_BYTES UINT32_C(1048576)
+
+    typedef struct _surfaceScanOptions
+    {
+        eSurfaceScanMode mode;
+        uint64_t startLBA;
+        uint64_t range;//number of LBAs to scan. 0 = to the end of the drive
+        uint32_t chunkSize;//LBAs per command. 0 = SURFACE_SCAN_DEFAULT_VERIFY_CHUNK for verify, or SURFACE_SCAN_DEFAULT_READ_BYTES worth of LBAs for read
+        uint32_t maxSkipLBAs;//largest jump to make over a cluster of bad LBAs. 0 = never skip, every LBA is scanned
+        uint64_t maxBadLBAs;//stop once this many bad LBAs are found. 0 = no limit
+        bool skipUnmappedLBAs;//only scan LBAs the device reports as mapped. Scans everything when the device cannot report which LBAs are mapped.
+        surfaceScanProgress progress;//may be NULL
+        void *progressData;
+    }surfaceScanOptions;
+
+    typedef struct _surfaceScanResults
+    {
+        uint64_t lbasScanned;
+        uint32_t commandsIssued;
+        uint64_t badLBACount;
+        lbaIntervalSet badLBAs;
+        lbaIntervalSet skippedLBAs;//ranges jumped over after clustered errors. These were not scanned and can be scanned again later with maxSkipLBAs set to 0
+        uint64_t unmappedLBAs;//LBAs not scanned because they are deallocated or anchored
+        bool stoppedEarly;//progress callback returned false, or maxBadLBAs was reached
+    }surfaceScanResults;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  run_Surface_Scan()
+    //
+    //! \brief   Description:  Scans a range of LBAs with read or verify commands, chunkSize LBAs at a time. When a command fails, the first bad LBA is found
+    //!                        using the sense data information field when it is available, otherwise by splitting the failing range in half until a single bad LBA is found.
+    //!                        The scan then continues after the bad LBA. When bad LBAs are next to each other, the scan skips ahead, doubling the distance each time up to maxSkipLBAs,
+    //!                        so that a large damaged area does not take a command per LBA. Skipped ranges are saved so they can be scanned again later.
+    //!                        A command that fails with FAILURE is treated as a media error. Any other error stops the scan and is returned.
+    //
+    //  Entry:
+    //!   \param[in] device = device to scan
+    //!   \param[in] options = what to scan and how
+    //!   \param[out] results = LBAs scanned and bad LBAs found. Must be freed with free_Surface_Scan_Results()
+    //!
+    //  Exit:
+    //!   \return SUCCESS = scan completed (check results for bad LBAs), BAD_PARAMETER, MEMORY_FAILURE, or the error that stopped the scan
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int run_Surface_Scan(tDevice *device, surfaceScanOptions *options, surfaceScanResults *results);
+
+    OPENSEA_TRANSPORT_API void free_Surface_Scan_Results(surfaceScanResults *results);
+
+#if defined (__cplusplus)
+}
+#endif
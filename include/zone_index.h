@@ -0,0 +1,189 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file zone_index.h
+// \brief Defines an in memory table of the zones on a ZBC or ZAC device that is kept up to date as zones are written and managed.
+
+#pragma once
+
+#include "common_public.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    //Zone type field of a zone descriptor (same for ZBC and ZAC)
+    typedef enum _eZoneType
+    {
+        ZONE_TYPE_CONVENTIONAL                  = 0x1,
+        ZONE_TYPE_SEQUENTIAL_WRITE_REQUIRED     = 0x2,
+        ZONE_TYPE_SEQUENTIAL_WRITE_PREFERRED    = 0x3,
+        ZONE_TYPE_SEQUENTIAL_OR_BEFORE_REQUIRED = 0x4,
+        ZONE_TYPE_GAP                           = 0x5,
+    }eZoneType;
+
+    //Zone condition field of a zone descriptor (same for ZBC and ZAC)
+    typedef enum _eZoneCondition
+    {
+        ZONE_CONDITION_NOT_WRITE_POINTER        = 0x0,
+        ZONE_CONDITION_EMPTY                    = 0x1,
+        ZONE_CONDITION_IMPLICITLY_OPENED        = 0x2,
+        ZONE_CONDITION_EXPLICITLY_OPENED        = 0x3,
+        ZONE_CONDITION_CLOSED                   = 0x4,
+        ZONE_CONDITION_INACTIVE                 = 0x5,
+        ZONE_CONDITION_READ_ONLY                = 0xD,
+        ZONE_CONDITION_FULL                     = 0xE,
+        ZONE_CONDITION_OFFLINE                  = 0xF,
+    }eZoneCondition;
+
+    #define ZONE_DESCRIPTOR_LENGTH UINT32_C(64)
+    #define ZONE_INDEX_REPORT_BUFFER_SIZE UINT32_C(524288) //largest report zones transfer used while building or refreshing the index. Holds 8191 zone descriptors.
+
+    //Zones are kept in the order they are on the device, which is also zone start LBA order. Each zone ends where the next one starts.
+    //The fields are kept in separate arrays so that searches only touch the data they need. Do not change these directly. Use the zone_Index functions.
+    typedef struct _zoneIndex
+    {
+        uint32_t zoneCount;
+        uint8_t *zoneType;//eZoneType
+        uint8_t *zoneCondition;//eZoneCondition
+        uint64_t *zoneStartLBA;
+        uint64_t *writePointer;//not valid for conventional and gap zones, or zones that are read only, full, or offline
+        uint64_t *zoneCapacity;//LBAs that can be written from the start of the zone, when an NVMe zoned namespace reports less than the zone length. 0 = the whole zone
+        uint64_t endLBA;//LBA after the end of the last zone
+        uint32_t *writableTree;//Fenwick tree of zones that can be written, used to skip to the next writable zone in O(log n)
+        uint32_t writableZoneCount;
+    }zoneIndex;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  build_Zone_Index()
+    //
+    //! \brief   Description:  Reads all the zones on a device into a zone index. Uses report zones commands of up to ZONE_INDEX_REPORT_BUFFER_SIZE bytes,
+    //!                        with the partial bit set after the first one so that the device does not need to count the zones that were not requested.
+    //
+    //  Entry:
+    //!   \param[in] device = ATA or SCSI zoned device, or NVMe zoned namespace
+    //!   \param[out] index = index to build. Any zones already in it are freed first. Must be freed with free_Zone_Index()
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, NOT_SUPPORTED, or FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int build_Zone_Index(tDevice *device, zoneIndex *index);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  refresh_Zone_Index_Range()
+    //
+    //! \brief   Description:  Re-reads only the zones that contain the LBAs from startLBA to startLBA + lbaCount - 1.
+    //!                        If the device reports zones that do not match the ones in the index, the whole index is rebuilt.
+    //
+    //  Entry:
+    //!   \param[in] device = device the index was built from
+    //!   \param[in] index = index to update
+    //!   \param[in] startLBA = first LBA to refresh
+    //!   \param[in] lbaCount = number of LBAs to refresh. 0 refreshes only the zone containing startLBA
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, or the error from report zones
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int refresh_Zone_Index_Range(tDevice *device, zoneIndex *index, uint64_t startLBA, uint64_t lbaCount);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  find_Zone_In_Index()
+    //
+    //! \brief   Description:  Finds the zone that contains an LBA using a binary search.
+    //
+    //  Entry:
+    //!   \param[in] index = zone index
+    //!   \param[in] lba = LBA to look for
+    //!   \param[out] zoneNumber = position of the zone in the index arrays
+    //!
+    //  Exit:
+    //!   \return SUCCESS or BAD_PARAMETER = the LBA is not in any zone
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int find_Zone_In_Index(zoneIndex *index, uint64_t lba, uint32_t *zoneNumber);
+
+    OPENSEA_TRANSPORT_API uint64_t get_Zone_Index_Zone_Length(zoneIndex *index, uint32_t zoneNumber);
+
+    //Number of LBAs that can be written from the start of a zone. Less than the zone length on NVMe zoned namespaces with a smaller zone capacity. A zone is full once its write pointer reaches this.
+    OPENSEA_TRANSPORT_API uint64_t get_Zone_Index_Zone_Capacity(zoneIndex *index, uint32_t zoneNumber);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Next_Writable_LBA()
+    //
+    //! \brief   Description:  Finds the first LBA at or after lba that can be written without an error or breaking the sequential order of a zone.
+    //!                        For conventional zones this is the LBA itself. For sequential zones it is the write pointer, as long as the write pointer is not before lba.
+    //!                        Zones that are full, read only, offline, inactive, or gaps are skipped. Takes O(log n) time.
+    //
+    //  Entry:
+    //!   \param[in] index = zone index
+    //!   \param[in] lba = LBA to start looking from
+    //!   \param[out] writableLBA = LBA that can be written next
+    //!   \param[out] zoneNumber = zone containing writableLBA. May be NULL
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, or NOT_SUPPORTED = no zone at or after lba can be written
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int get_Next_Writable_LBA(zoneIndex *index, uint64_t lba, uint64_t *writableLBA, uint32_t *zoneNumber);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  zone_Index_Write_LBA()
+    //
+    //! \brief   Description:  Same as write_LBA(), then updates the write pointers of the zones written in the index without reading them from the device.
+    //!                        If the write fails, the zones it covered are refreshed from the device instead.
+    //
+    //  Entry:
+    //!   \param[in] device = device the index was built from
+    //!   \param[in] index = index to update
+    //!   \param[in] lba = LBA to write at
+    //!   \param[in] ptrData = data to write
+    //!   \param[in] dataSize = number of bytes to write. Must be a multiple of the logical block size
+    //!
+    //  Exit:
+    //!   \return result of the write, BAD_PARAMETER
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int zone_Index_Write_LBA(tDevice *device, zoneIndex *index, uint64_t lba, uint8_t *ptrData, uint32_t dataSize);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  zone_Index_Note_Write()
+    //
+    //! \brief   Description:  Updates the write pointers in the index for a write that completed successfully outside of zone_Index_Write_LBA()
+    //
+    //  Entry:
+    //!   \param[in] index = index to update
+    //!   \param[in] lba = first LBA written
+    //!   \param[in] lbaCount = number of LBAs written
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API void zone_Index_Note_Write(zoneIndex *index, uint64_t lba, uint64_t lbaCount);
+
+    //These call open_Zone(), close_Zone(), finish_Zone(), and reset_Write_Pointer(), then refresh the zone from the device, or the whole index when all zones were changed.
+    OPENSEA_TRANSPORT_API int zone_Index_Open_Zone(tDevice *device, zoneIndex *index, bool openAll, uint64_t zoneID);
+    OPENSEA_TRANSPORT_API int zone_Index_Close_Zone(tDevice *device, zoneIndex *index, bool closeAll, uint64_t zoneID);
+    OPENSEA_TRANSPORT_API int zone_Index_Finish_Zone(tDevice *device, zoneIndex *index, bool finishAll, uint64_t zoneID);
+    OPENSEA_TRANSPORT_API int zone_Index_Reset_Write_Pointer(tDevice *device, zoneIndex *index, bool resetAll, uint64_t zoneID);
+
+    OPENSEA_TRANSPORT_API void free_Zone_Index(zoneIndex *index);
+
+#if defined (__cplusplus)
+}
+#endif
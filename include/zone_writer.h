@@ -0,0 +1,135 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file zone_writer.h
+// \brief Defines a writer that lays a stream of data out sequentially across several open zones of a host managed or host aware device.
+
+#pragma once
+
+#include "common_public.h"
+#include "zone_index.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    #define ZONE_WRITER_DEFAULT_MAX_OPEN_ZONES UINT32_C(4)
+    #define ZONE_WRITER_DEFAULT_CHUNK_BYTES UINT32_C(1048576)
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Max_Open_Sequential_Write_Required_Zones()
+    //
+    //! \brief   Description:  Gets the maximum number of sequential write required zones the device allows to be open at once.
+    //!                        This comes from the zoned block device characteristics VPD page on SCSI, or the zoned device information page of the identify device data log on ATA.
+    //
+    //  Entry:
+    //!   \param[in] device = zoned device
+    //!   \param[out] maxOpenZones = maximum open zones. UINT32_MAX when the device does not report a limit
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, NOT_SUPPORTED, or FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int get_Max_Open_Sequential_Write_Required_Zones(tDevice *device, uint32_t *maxOpenZones);
+
+    typedef struct _zoneWriterOptions
+    {
+        uint64_t startLBA;//zones are used starting from the first writable zone at or after this LBA
+        uint32_t maxOpenZones;//number of zones to write to at once. 0 = ZONE_WRITER_DEFAULT_MAX_OPEN_ZONES. Always limited to what the device reports.
+        uint32_t chunkLBAs;//LBAs written to a zone before moving to the next open zone. 0 = ZONE_WRITER_DEFAULT_CHUNK_BYTES worth of LBAs
+        bool explicitOpen;//open zones with open_Zone() before writing to them. Explicitly opened zones are not closed by the device to make room for other implicitly opened zones.
+    }zoneWriterOptions;
+
+    //Where part of the stream was written. streamOffsetLBAs is counted in logical blocks from the start of the stream.
+    typedef struct _zoneWriterExtent
+    {
+        uint64_t streamOffsetLBAs;
+        uint64_t lba;
+        uint64_t lbaCount;
+    }zoneWriterExtent;
+
+    typedef struct _zoneWriter
+    {
+        tDevice *device;
+        zoneIndex *index;
+        bool explicitOpen;
+        uint32_t maxOpenZones;
+        uint32_t chunkLBAs;
+        uint32_t openZoneCount;
+        uint32_t *openZones;//zone numbers in the index, in the order chunks are handed out
+        uint32_t nextOpenZone;
+        uint64_t nextSearchLBA;//where to look for the next zone to open
+        uint64_t streamLBAs;//LBAs of the stream written so far
+        uint32_t extentCount;
+        uint32_t extentCapacity;
+        zoneWriterExtent *extents;//in stream order
+    }zoneWriter;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  start_Zone_Writer()
+    //
+    //! \brief   Description:  Sets up a writer that spreads a stream across up to maxOpenZones zones. Each chunk of the stream is written at the write pointer of the next open zone in turn,
+    //!                        so writes to every zone stay strictly sequential. Zones are removed from the set as they fill and the next writable zone is opened in their place.
+    //!                        The number of open zones is limited to the device's maximum open sequential write required zones.
+    //
+    //  Entry:
+    //!   \param[in] device = host managed or host aware device
+    //!   \param[in] index = zone index built with build_Zone_Index(). It is kept up to date as the writer writes and manages zones.
+    //!   \param[in] options = writer settings. May be NULL to use the defaults
+    //!   \param[out] writer = writer to set up. Must be ended with end_Zone_Writer() and freed with free_Zone_Writer()
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, or MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int start_Zone_Writer(tDevice *device, zoneIndex *index, zoneWriterOptions *options, zoneWriter *writer);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  zone_Writer_Write()
+    //
+    //! \brief   Description:  Writes the next part of the stream. Use the writer's extents to find where each part of the stream was written.
+    //
+    //  Entry:
+    //!   \param[in] writer = writer from start_Zone_Writer()
+    //!   \param[in] ptrData = data to write
+    //!   \param[in] dataSize = number of bytes to write. Must be a multiple of the logical block size
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, NOT_SUPPORTED = no writable zones are left, or the error from a write or zone command.
+    //!           On an error, the stream is written up to streamLBAs and writing can continue from there.
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int zone_Writer_Write(zoneWriter *writer, uint8_t *ptrData, uint32_t dataSize);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  end_Zone_Writer()
+    //
+    //! \brief   Description:  Finishes or closes the zones the writer still has open so they no longer count against the device's open zone limit.
+    //
+    //  Entry:
+    //!   \param[in] writer = writer from start_Zone_Writer()
+    //!   \param[in] finishZones = true to finish the zones (no more data can be written to them), false to close them so that they can be written again later
+    //!
+    //  Exit:
+    //!   \return SUCCESS or the first error from finishing or closing a zone
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int end_Zone_Writer(zoneWriter *writer, bool finishZones);
+
+    OPENSEA_TRANSPORT_API void free_Zone_Writer(zoneWriter *writer);
+
+#if defined (__cplusplus)
+}
+#endif
@@ -0,0 +1,174 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file allocation_map.c
+// \brief Defines functions to find which LBAs of a logical block provisioned device are mapped, so that deallocated regions can be skipped.
+
+#include "allocation_map.h"
+#include "cmds.h"
+#include "scsi_helper_func.h"
+
+int start_Allocation_Map(tDevice *device, uint64_t startLBA, uint64_t range, allocationMapIterator *iterator)
+{
+    if (!device || !iterator)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(iterator, 0, sizeof(allocationMapIterator));
+    if (device->drive_info.drive_type != SCSI_DRIVE)
+    {
+        return NOT_SUPPORTED;
+    }
+    fill_Lazy_Device_Info(device, LAZY_INFO_CAPACITY);
+    if (startLBA > device->drive_info.deviceMaxLba)
+    {
+        return BAD_PARAMETER;
+    }
+    iterator->device = device;
+    iterator->nextLBA = startLBA;
+    iterator->endLBA = device->drive_info.deviceMaxLba + 1;
+    if (range > 0 && range < iterator->endLBA - startLBA)
+    {
+        iterator->endLBA = startLBA + range;
+    }
+    iterator->pending.startLBA = startLBA;
+    iterator->statusData = C_CAST(uint8_t*, calloc_aligned(ALLOCATION_MAP_STATUS_BUFFER_SIZE, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!iterator->statusData)
+    {
+        return MEMORY_FAILURE;
+    }
+    return SUCCESS;
+}
+
+//reads the descriptors starting at nextLBA into the iterator's buffer
+static int read_LBA_Status_Descriptors(allocationMapIterator *iterator)
+{
+    int ret = SUCCESS;
+    uint32_t parameterDataLength = 0;
+    memset(iterator->statusData, 0, ALLOCATION_MAP_STATUS_BUFFER_SIZE);
+    ret = scsi_Get_Lba_Status(iterator->device, iterator->nextLBA, ALLOCATION_MAP_STATUS_BUFFER_SIZE, iterator->statusData);
+    if (ret != SUCCESS)
+    {
+        uint8_t senseKey = 0;
+        uint8_t asc = 0;
+        uint8_t ascq = 0;
+        uint8_t fru = 0;
+        get_Sense_Key_ASC_ASCQ_FRU(iterator->device->drive_info.lastCommandSenseData, SPC3_SENSE_LEN, &senseKey, &asc, &ascq, &fru);
+        if (iterator->commandsIssued == 0 && senseKey == SENSE_KEY_ILLEGAL_REQUEST)
+        {
+            ret = NOT_SUPPORTED;
+        }
+        return ret;
+    }
+    iterator->commandsIssued += 1;
+    //parameter data length does not include itself. It may be more than was transferred, in which case the rest is read by the next command.
+    parameterDataLength = M_BytesTo4ByteValue(iterator->statusData[0], iterator->statusData[1], iterator->statusData[2], iterator->statusData[3]);
+    iterator->descriptorOffset = 8;
+    iterator->descriptorEnd = C_CAST(uint32_t, M_Min(C_CAST(uint64_t, parameterDataLength) + 4, ALLOCATION_MAP_STATUS_BUFFER_SIZE));
+    iterator->descriptorEnd -= (iterator->descriptorEnd - iterator->descriptorOffset) % LBA_STATUS_DESCRIPTOR_LENGTH;
+    if (iterator->descriptorEnd <= iterator->descriptorOffset)
+    {
+        //no descriptors means no progress can be made
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+int get_Next_Mapped_Extent(allocationMapIterator *iterator, lbaInterval *extent)
+{
+    if (!iterator || !iterator->statusData || !extent)
+    {
+        return BAD_PARAMETER;
+    }
+    while (iterator->nextLBA < iterator->endLBA)
+    {
+        uint8_t *descriptor = NULL;
+        uint64_t descriptorLBA = 0;
+        uint64_t descriptorEnd = 0;
+        uint8_t provisioningStatus = 0;
+        if (iterator->descriptorOffset >= iterator->descriptorEnd)
+        {
+            int ret = read_LBA_Status_Descriptors(iterator);
+            if (ret != SUCCESS)
+            {
+                return ret;
+            }
+        }
+        descriptor = &iterator->statusData[iterator->descriptorOffset];
+        iterator->descriptorOffset += LBA_STATUS_DESCRIPTOR_LENGTH;
+        descriptorLBA = M_BytesTo8ByteValue(descriptor[0], descriptor[1], descriptor[2], descriptor[3], descriptor[4], descriptor[5], descriptor[6], descriptor[7]);
+        descriptorEnd = descriptorLBA + M_BytesTo4ByteValue(descriptor[8], descriptor[9], descriptor[10], descriptor[11]);
+        provisioningStatus = M_Nibble0(descriptor[12]);
+        if (descriptorLBA > iterator->nextLBA || descriptorEnd <= iterator->nextLBA)
+        {
+            if (descriptorEnd <= iterator->nextLBA && iterator->descriptorOffset < iterator->descriptorEnd)
+            {
+                //already covered, look at the next one
+                continue;
+            }
+            //descriptors must start at the requested LBA and follow each other with no gaps
+            return FAILURE;
+        }
+        descriptorEnd = M_Min(descriptorEnd, iterator->endLBA);
+        if (provisioningStatus == LBA_PROVISIONING_STATUS_DEALLOCATED || provisioningStatus == LBA_PROVISIONING_STATUS_ANCHORED)
+        {
+            iterator->nextLBA = descriptorEnd;
+            if (iterator->pending.length > 0)
+            {
+                *extent = iterator->pending;
+                iterator->pending.startLBA = descriptorEnd;
+                iterator->pending.length = 0;
+                return SUCCESS;
+            }
+            iterator->pending.startLBA = descriptorEnd;
+        }
+        else
+        {
+            iterator->pending.length += descriptorEnd - iterator->nextLBA;
+            iterator->nextLBA = descriptorEnd;
+        }
+    }
+    *extent = iterator->pending;
+    iterator->pending.startLBA = iterator->endLBA;
+    iterator->pending.length = 0;
+    return SUCCESS;
+}
+
+void free_Allocation_Map(allocationMapIterator *iterator)
+{
+    if (iterator)
+    {
+        safe_Free_aligned(iterator->statusData)
+        memset(iterator, 0, sizeof(allocationMapIterator));
+    }
+}
+
+int get_Mapped_LBA_Ranges(tDevice *device, uint64_t startLBA, uint64_t range, lbaIntervalSet *mappedRanges)
+{
+    int ret = SUCCESS;
+    allocationMapIterator iterator;
+    if (!mappedRanges)
+    {
+        return BAD_PARAMETER;
+    }
+    ret = start_Allocation_Map(device, startLBA, range, &iterator);
+    while (ret == SUCCESS)
+    {
+        lbaInterval extent;
+        ret = get_Next_Mapped_Extent(&iterator, &extent);
+        if (ret != SUCCESS || extent.length == 0)
+        {
+            break;
+        }
+        ret = add_LBA_Interval(mappedRanges, extent.startLBA, extent.length);
+    }
+    free_Allocation_Map(&iterator);
+    return ret;
+}
@@ -23,35 +23,45 @@
 #include "psp_legacy_helper.h"
 #include "csmi_legacy_pt_cdb_helper.h"
 
-int ata_Passthrough_Command(tDevice *device, ataPassthroughCommand  *ataCommandOptions)
+ata_passthrough_func get_ATA_Passthrough_Function(tDevice *device)
 {
-    int ret = UNKNOWN;
     switch (device->drive_info.passThroughHacks.passthroughType)
     {
     case ATA_PASSTHROUGH_PSP:
-        ret = send_PSP_Legacy_Passthrough_Command(device, ataCommandOptions);
-        break;
+        return send_PSP_Legacy_Passthrough_Command;
     case ATA_PASSTHROUGH_CYPRESS:
-        ret = send_Cypress_Legacy_Passthrough_Command(device, ataCommandOptions);
-        break;
+        return send_Cypress_Legacy_Passthrough_Command;
     case ATA_PASSTHROUGH_PROLIFIC:
-        ret = send_Prolific_Legacy_Passthrough_Command(device, ataCommandOptions);
-        break;
+        return send_Prolific_Legacy_Passthrough_Command;
     case ATA_PASSTHROUGH_TI:
-        ret = send_TI_Legacy_Passthrough_Command(device, ataCommandOptions);
-        break;
+        return send_TI_Legacy_Passthrough_Command;
     case ATA_PASSTHROUGH_NEC:
-        ret = send_NEC_Legacy_Passthrough_Command(device, ataCommandOptions);
-        break;
+        return send_NEC_Legacy_Passthrough_Command;
     case ATA_PASSTHROUGH_SAT:
-        ret = send_SAT_Passthrough_Command(device, ataCommandOptions);
-        break;
+        return send_SAT_Passthrough_Command;
     case ATA_PASSTHROUGH_CSMI:
-        ret = send_CSMI_Legacy_ATA_Passthrough(device, ataCommandOptions);
-        break;
+        return send_CSMI_Legacy_ATA_Passthrough;
     default:
+        return NULL;
+    }
+}
+
+int ata_Passthrough_Command(tDevice *device, ataPassthroughCommand  *ataCommandOptions)
+{
+    int ret = UNKNOWN;
+    ata_passthrough_func passthrough = device->ops.ataPassthrough;
+    if (!passthrough)
+    {
+        //not resolved yet (still in discovery, or the passthrough type was just changed), so look it up from the passthroughType
+        passthrough = get_ATA_Passthrough_Function(device);
+    }
+    if (passthrough)
+    {
+        ret = passthrough(device, ataCommandOptions);
+    }
+    else
+    {
         ret = BAD_PARAMETER;
-        break;
     }
     return ret;
 }
@@ -235,6 +245,11 @@ int ata_Sanitize_Command(tDevice *device, eATASanitizeFeature sanitizeFeature, u
             print_Return_Enum("Sanitize - Unknown", ret);
         }
     }
+    if (ret == SUCCESS && sanitizeFeature != ATA_SANITIZE_STATUS)
+    {
+        //identify data reported by the software SAT translator has changed
+        invalidate_Software_SAT_Snapshot(device);
+    }
     return ret;
 }
 
@@ -866,6 +881,10 @@ int ata_Security_Disable_Password(tDevice *device, uint8_t *ptrData)
     {
         print_Return_Enum("Security Disable Password", ret);
     }
+    if (ret == SUCCESS)
+    {
+        invalidate_Software_SAT_Snapshot(device);
+    }
     return ret;
 }
 
@@ -933,6 +952,10 @@ int ata_Security_Erase_Unit(tDevice *device, uint8_t *ptrData, uint32_t timeout)
         print_Return_Enum("Security Erase Unit", ret);
     }
 
+    if (ret == SUCCESS)
+    {
+        invalidate_Software_SAT_Snapshot(device);
+    }
     return ret;
 }
 
@@ -967,6 +990,10 @@ int ata_Security_Set_Password(tDevice *device, uint8_t *ptrData)
         print_Return_Enum("Security Set Password", ret);
     }
 
+    if (ret == SUCCESS)
+    {
+        invalidate_Software_SAT_Snapshot(device);
+    }
     return ret;
 }
 
@@ -1001,6 +1028,10 @@ int ata_Security_Unlock(tDevice *device, uint8_t *ptrData)
         print_Return_Enum("Security Unlock", ret);
     }
 
+    if (ret == SUCCESS)
+    {
+        invalidate_Software_SAT_Snapshot(device);
+    }
     return ret;
 }
 
@@ -1033,6 +1064,10 @@ int ata_Security_Freeze_Lock(tDevice *device)
         print_Return_Enum("Security Erase Freeze Lock", ret);
     }
 
+    if (ret == SUCCESS)
+    {
+        invalidate_Software_SAT_Snapshot(device);
+    }
     return ret;
 }
 
@@ -1234,6 +1269,10 @@ int ata_Set_Max(tDevice *device, eHPAFeature setMaxFeature, uint32_t newMaxLBA,
     {
         print_Return_Enum("Set Max", ret);
     }
+    if (ret == SUCCESS && setMaxFeature == HPA_SET_MAX_ADDRESS)
+    {
+        invalidate_Lazy_Device_Info(device, LAZY_INFO_CAPACITY);
+    }
     return ret;
 }
 
@@ -1302,6 +1341,10 @@ int ata_Set_Max_Address_Ext(tDevice *device, uint64_t newMaxLBA, bool volatileVa
     {
         print_Return_Enum("Set Native Max Address Ext", ret);
     }
+    if (ret == SUCCESS)
+    {
+        invalidate_Lazy_Device_Info(device, LAZY_INFO_CAPACITY);
+    }
     return ret;
 }
 
@@ -1403,6 +1446,11 @@ int ata_Download_Microcode(tDevice *device, eDownloadMicrocodeFeatures subComman
             print_Return_Enum("Download Microcode", ret);
         }
     }
+    if (ret == SUCCESS && subCommand != ATA_DL_MICROCODE_OFFSETS_SAVE_FUTURE)
+    {
+        //new firmware may report different device information
+        invalidate_Lazy_Device_Info(device, LAZY_INFO_ALL);
+    }
     return ret;
 }
 
@@ -3894,6 +3942,10 @@ int ata_Set_Features(tDevice *device, uint8_t subcommand, uint8_t subcommandCoun
     {
         print_Return_Enum("Set Features", ret);
     }
+    if (ret == SUCCESS)
+    {
+        invalidate_Software_SAT_Snapshot(device);
+    }
     return ret;
 }
 
@@ -4667,6 +4719,11 @@ int ata_Set_Sector_Configuration_Ext(tDevice *device, uint16_t commandCheck, uin
         print_Return_Enum("Set Sector Configuration Ext", ret);
     }
 
+    if (ret == SUCCESS)
+    {
+        //logical sector size changed
+        invalidate_Lazy_Device_Info(device, LAZY_INFO_CAPACITY);
+    }
     return ret;
 }
 
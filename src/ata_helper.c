@@ -18,16 +18,81 @@
 
 bool is_Buffer_Non_Zero(uint8_t* ptrData, uint32_t dataLen)
 {
-    bool isNonZero = false;
-    for (uint32_t iter = 0; iter < dataLen; ++iter)
+    if (!ptrData || dataLen == 0)
     {
-        if (ptrData[iter] != 0)
+        return false;
+    }
+    //The buffer is all zeros if the first byte is zero and every byte matches the one before it. memcmp is already vectorized by the C library, so this is much faster than a byte loop on large buffers.
+    return ptrData[0] != 0 || memcmp(&ptrData[0], &ptrData[1], dataLen - 1) != 0;
+}
+
+bool is_Buffer_Repeating_Pattern(uint8_t *ptrData, uint32_t dataLen, uint8_t *pattern, uint32_t patternLength)
+{
+    uint32_t firstCopyLength = 0;
+    if (!ptrData || !pattern || patternLength == 0)
+    {
+        return false;
+    }
+    firstCopyLength = M_Min(dataLen, patternLength);
+    if (memcmp(ptrData, pattern, firstCopyLength) != 0)
+    {
+        return false;
+    }
+    //once the first copy of the pattern matches, every byte after it must match the byte one pattern length before it
+    return dataLen <= patternLength || memcmp(&ptrData[patternLength], ptrData, dataLen - patternLength) == 0;
+}
+
+uint32_t find_First_Mismatch(uint8_t *firstBuffer, uint8_t *secondBuffer, uint32_t dataLen)
+{
+    #define MISMATCH_SEARCH_CHUNK UINT32_C(4096)
+    uint32_t offset = 0;
+    if (!firstBuffer || !secondBuffer)
+    {
+        return 0;
+    }
+    //find the chunk with the difference using memcmp, then narrow it down to the byte
+    for (; offset < dataLen; offset += MISMATCH_SEARCH_CHUNK)
+    {
+        uint32_t chunkLength = M_Min(dataLen - offset, MISMATCH_SEARCH_CHUNK);
+        if (memcmp(&firstBuffer[offset], &secondBuffer[offset], chunkLength) != 0)
         {
-            isNonZero = true;
-            break;
+            for (uint32_t byteIter = 0; byteIter < chunkLength; ++byteIter)
+            {
+                if (firstBuffer[offset + byteIter] != secondBuffer[offset + byteIter])
+                {
+                    return offset + byteIter;
+                }
+            }
+        }
+    }
+    #undef MISMATCH_SEARCH_CHUNK
+    return dataLen;
+}
+
+//Adds up bytes modulo 256. 8 bytes are read at a time and their bytes added into four 16 bit lanes.
+//Each lane gains at most 510 per word, so 128 words can be added before a lane could overflow.
+static uint8_t sum_Bytes(uint8_t *ptrData, uint32_t dataLen)
+{
+    uint8_t sum = 0;
+    uint32_t iter = 0;
+    while (iter + sizeof(uint64_t) <= dataLen)
+    {
+        uint64_t laneSums = 0;
+        uint32_t wordCount = M_Min((dataLen - iter) / C_CAST(uint32_t, sizeof(uint64_t)), UINT32_C(128));
+        for (uint32_t wordIter = 0; wordIter < wordCount; ++wordIter, iter += sizeof(uint64_t))
+        {
+            uint64_t word = 0;
+            memcpy(&word, &ptrData[iter], sizeof(uint64_t));
+            laneSums += (word & UINT64_C(0x00FF00FF00FF00FF)) + ((word >> 8) & UINT64_C(0x00FF00FF00FF00FF));
         }
+        //only the low byte of the total is needed, which is the sum of the low bytes of each lane. This does not depend on byte order.
+        sum = C_CAST(uint8_t, sum + M_Byte0(laneSums) + M_Byte2(laneSums) + M_Byte4(laneSums) + M_Byte6(laneSums));
+    }
+    for (; iter < dataLen; ++iter)
+    {
+        sum = C_CAST(uint8_t, sum + ptrData[iter]);
     }
-    return isNonZero;
+    return sum;
 }
 
 //This will send a read log ext command, and if it's DMA and sense data tells us that we had an invalid field in CDB, then we retry with PIO mode
@@ -659,8 +724,7 @@ int send_ATA_Read_Stream_Cmd(tDevice *device, uint8_t streamID, bool notSequenti
 {
     int ret = NOT_SUPPORTED;
     bool dmaRetry = false;
-    static bool streamDMA = true;
-    if (device->drive_info.ata_Options.dmaMode != ATA_DMA_MODE_NO_DMA && streamDMA && device->drive_info.ata_Options.dmaSupported)
+    if (device->drive_info.ata_Options.dmaMode != ATA_DMA_MODE_NO_DMA && device->drive_info.ata_Options.readStreamDMASupported)
     {
         ret = ata_Read_Stream_Ext(device, true, streamID, notSequential, readContinuous, commandCCTL, LBA, ptrData, dataSize);
         if (ret == SUCCESS)
@@ -676,7 +740,7 @@ int send_ATA_Read_Stream_Cmd(tDevice *device, uint8_t streamID, bool notSequenti
             {
                 //turn off DMA mode
                 dmaRetry = true;
-                streamDMA = false;
+                device->drive_info.ata_Options.readStreamDMASupported = false;
             }
             else
             {
@@ -689,7 +753,7 @@ int send_ATA_Read_Stream_Cmd(tDevice *device, uint8_t streamID, bool notSequenti
     if (dmaRetry && ret != SUCCESS)
     {
         //this means something else is wrong, and it's not the DMA mode, so we can turn it back on
-        streamDMA = true;
+        device->drive_info.ata_Options.readStreamDMASupported = true;
     }
     return ret;
 }
@@ -698,8 +762,7 @@ int send_ATA_Write_Stream_Cmd(tDevice *device, uint8_t streamID, bool flush, boo
 {
     int ret = NOT_SUPPORTED;
     bool dmaRetry = false;
-    static bool streamDMA = true;
-    if (device->drive_info.ata_Options.dmaMode != ATA_DMA_MODE_NO_DMA && streamDMA && device->drive_info.ata_Options.dmaSupported)
+    if (device->drive_info.ata_Options.dmaMode != ATA_DMA_MODE_NO_DMA && device->drive_info.ata_Options.writeStreamDMASupported)
     {
         ret = ata_Write_Stream_Ext(device, true, streamID, flush, writeContinuous, commandCCTL, LBA, ptrData, dataSize);
         if (ret == SUCCESS)
@@ -715,7 +778,7 @@ int send_ATA_Write_Stream_Cmd(tDevice *device, uint8_t streamID, bool flush, boo
             {
                 //turn off DMA mode
                 dmaRetry = true;
-                streamDMA = false;
+                device->drive_info.ata_Options.writeStreamDMASupported = false;
             }
             else
             {
@@ -728,7 +791,7 @@ int send_ATA_Write_Stream_Cmd(tDevice *device, uint8_t streamID, bool flush, boo
     if (dmaRetry && ret != SUCCESS)
     {
         //this means something else is wrong, and it's not the DMA mode, so we can turn it back on
-        streamDMA = true;
+        device->drive_info.ata_Options.writeStreamDMASupported = true;
     }
     return ret;
 }
@@ -755,6 +818,218 @@ static bool is_SAT_Invalid_Operation_Code(tDevice *device)
     return invalidOP;
 }
 
+int fill_In_ATA_Log_Capabilities(tDevice *device)
+{
+    int ret = NOT_SUPPORTED;
+    //clear out what was previously read in case this is being read again after being invalidated
+    device->drive_info.softSATFlags.identifyDeviceDataLogSupported = false;
+    device->drive_info.softSATFlags.deviceStatisticsSupported = false;
+    memset(&device->drive_info.softSATFlags.deviceStatsPages, 0, sizeof(device->drive_info.softSATFlags.deviceStatsPages));
+    device->drive_info.softSATFlags.currentInternalStatusLogSupported = false;
+    device->drive_info.softSATFlags.savedInternalStatusLogSupported = false;
+    device->drive_info.softSATFlags.deferredDownloadSupported = false;
+    device->drive_info.softSATFlags.hostLogsSupported = false;
+    device->drive_info.softSATFlags.dataSetManagementXLSupported = false;
+    device->drive_info.softSATFlags.zeroExtSupported = false;
+    //only bother reading logs if GPL is supported...not going to bother with SMART even though some of the things we are looking for are in SMART - TJE
+    if (device->drive_info.ata_Options.generalPurposeLoggingSupported)
+    {
+        uint8_t logBuffer[LEGACY_DRIVE_SEC_SIZE] = { 0 };
+        if (SUCCESS == send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_DIRECTORY, 0, logBuffer, LEGACY_DRIVE_SEC_SIZE, 0))
+        {
+            ret = SUCCESS;
+            bool readIDDataLog = false;
+            bool readDeviceStatisticsLog = false;
+            //check for support of ID Data Log, Current Device Internal Status, Saved Device Internal Status, Device Statistics Log
+            if (M_BytesTo2ByteValue(logBuffer[(ATA_LOG_DEVICE_STATISTICS * 2) + 1], logBuffer[(ATA_LOG_DEVICE_STATISTICS * 2)]) > 0)
+            {
+                readDeviceStatisticsLog = true;
+            }
+            if (M_BytesTo2ByteValue(logBuffer[(ATA_LOG_CURRENT_DEVICE_INTERNAL_STATUS_DATA_LOG * 2) + 1], logBuffer[(ATA_LOG_CURRENT_DEVICE_INTERNAL_STATUS_DATA_LOG * 2)]) > 0)
+            {
+                device->drive_info.softSATFlags.currentInternalStatusLogSupported = true;
+            }
+            if (M_BytesTo2ByteValue(logBuffer[(ATA_LOG_SAVED_DEVICE_INTERNAL_STATUS_DATA_LOG * 2) + 1], logBuffer[(ATA_LOG_SAVED_DEVICE_INTERNAL_STATUS_DATA_LOG * 2)]) > 0)
+            {
+                device->drive_info.softSATFlags.savedInternalStatusLogSupported = true;
+            }
+            if (M_BytesTo2ByteValue(logBuffer[(ATA_LOG_IDENTIFY_DEVICE_DATA * 2) + 1], logBuffer[(ATA_LOG_IDENTIFY_DEVICE_DATA * 2)]) > 0)
+            {
+                readIDDataLog = true;
+            }
+            //could check any log from address 80h through 9Fh...but one should be enough (used for SAT application client log page translation)
+            //Using 90h since that is the first page the application client translation uses.
+            if (M_BytesTo2ByteValue(logBuffer[(0x90 * 2) + 1], logBuffer[(0x90 * 2)]) > 0)
+            {
+                device->drive_info.softSATFlags.hostLogsSupported = true;
+            }
+            //now read the couple pages of logs we care about to set some more flags for software SAT
+            if (readIDDataLog)
+            {
+                bool copyOfIDData = false;
+                bool supportedCapabilities = false;
+                bool zonedDeviceInfo = false;
+                memset(logBuffer, 0, LEGACY_DRIVE_SEC_SIZE);
+                if (SUCCESS == send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_IDENTIFY_DEVICE_DATA, ATA_ID_DATA_LOG_SUPPORTED_PAGES, logBuffer, LEGACY_DRIVE_SEC_SIZE, 0))
+                {
+                    uint8_t pageNumber = logBuffer[2];
+                    uint16_t revision = M_BytesTo2ByteValue(logBuffer[1], logBuffer[0]);
+                    if (pageNumber == C_CAST(uint8_t, ATA_ID_DATA_LOG_SUPPORTED_PAGES) && revision >= 0x0001)
+                    {
+                        //data is valid, so figure out supported pages
+                        uint8_t listLen = logBuffer[8];
+                        for (uint16_t iter = 9; iter < C_CAST(uint16_t, listLen + 8) && iter < UINT16_C(512); ++iter)
+                        {
+                            switch (logBuffer[iter])
+                            {
+                            case ATA_ID_DATA_LOG_SUPPORTED_PAGES:
+                                break;
+                            case ATA_ID_DATA_LOG_COPY_OF_IDENTIFY_DATA:
+                                copyOfIDData = true;
+                                break;
+                            case ATA_ID_DATA_LOG_CAPACITY:
+                                break;
+                            case ATA_ID_DATA_LOG_SUPPORTED_CAPABILITIES:
+                                supportedCapabilities = true;
+                                break;
+                            case ATA_ID_DATA_LOG_CURRENT_SETTINGS:
+                            case ATA_ID_DATA_LOG_ATA_STRINGS:
+                            case ATA_ID_DATA_LOG_SECURITY:
+                            case ATA_ID_DATA_LOG_PARALLEL_ATA:
+                            case ATA_ID_DATA_LOG_SERIAL_ATA:
+                                break;
+                            case ATA_ID_DATA_LOG_ZONED_DEVICE_INFORMATION:
+                                zonedDeviceInfo = true;
+                                break;
+                            default:
+                                break;
+                            }
+                        }
+                    }
+                }
+                memset(logBuffer, 0, LEGACY_DRIVE_SEC_SIZE);
+                if (copyOfIDData && SUCCESS == send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_IDENTIFY_DEVICE_DATA, ATA_ID_DATA_LOG_COPY_OF_IDENTIFY_DATA, logBuffer, LEGACY_DRIVE_SEC_SIZE, 0))
+                {
+                    device->drive_info.softSATFlags.identifyDeviceDataLogSupported = true;
+                }
+                memset(logBuffer, 0, LEGACY_DRIVE_SEC_SIZE);
+                if (supportedCapabilities && SUCCESS == send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_IDENTIFY_DEVICE_DATA, ATA_ID_DATA_LOG_SUPPORTED_CAPABILITIES, logBuffer, LEGACY_DRIVE_SEC_SIZE, 0))
+                {
+                    uint64_t qword0 = M_BytesTo8ByteValue(logBuffer[7], logBuffer[6], logBuffer[5], logBuffer[4], logBuffer[3], logBuffer[2], logBuffer[1], logBuffer[0]);
+                    if (qword0 & BIT63 && M_Byte2(qword0) == ATA_ID_DATA_LOG_SUPPORTED_CAPABILITIES && M_Word0(qword0) >= 0x0001)
+                    {
+                        uint64_t supportedCapabilitiesQWord = M_BytesTo8ByteValue(logBuffer[15], logBuffer[14], logBuffer[13], logBuffer[12], logBuffer[11], logBuffer[10], logBuffer[9], logBuffer[8]);
+                        if (supportedCapabilitiesQWord & BIT63)
+                        {
+                            if (supportedCapabilitiesQWord & BIT50)
+                            {
+                                device->drive_info.softSATFlags.dataSetManagementXLSupported = true;
+                            }
+                            if (supportedCapabilitiesQWord & BIT48)
+                            {
+                                device->drive_info.softSATFlags.zeroExtSupported = true;
+                            }
+                        }
+                        uint64_t downloadCapabilities = M_BytesTo8ByteValue(logBuffer[23], logBuffer[22], logBuffer[21], logBuffer[20], logBuffer[19], logBuffer[18], logBuffer[17], logBuffer[16]);
+                        if (downloadCapabilities & BIT63 && downloadCapabilities & BIT34)
+                        {
+                            device->drive_info.softSATFlags.deferredDownloadSupported = true;
+                        }
+                        uint64_t supportedZACCapabilities = M_BytesTo8ByteValue(logBuffer[119], logBuffer[118], logBuffer[117], logBuffer[116], logBuffer[115], logBuffer[114], logBuffer[113], logBuffer[112]);
+                        if (supportedZACCapabilities & BIT63)//qword valid
+                        {
+                            //check if any of the ZAC commands are supported.
+                            if (supportedZACCapabilities & BIT0 || supportedZACCapabilities & BIT1 || supportedZACCapabilities & BIT2 || supportedZACCapabilities & BIT3 || supportedZACCapabilities & BIT4)
+                            {
+                                //according to what I can find in the spec, a HOST Managed drive reports a different signature, but doens't set any identify bytes like a host aware drive.
+                                //because of this and not being able to get the real signature, this check is the only way to determine we are talking to an ATA host managed drive. - TJE
+                                if (device->drive_info.zonedType == ZONED_TYPE_NOT_ZONED)
+                                {
+                                    device->drive_info.zonedType = ZONED_TYPE_HOST_MANAGED;
+                                }
+                            }
+                        }
+                    }
+                }
+                memset(logBuffer, 0, LEGACY_DRIVE_SEC_SIZE);
+                if (zonedDeviceInfo && SUCCESS == send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_IDENTIFY_DEVICE_DATA, ATA_ID_DATA_LOG_ZONED_DEVICE_INFORMATION, logBuffer, LEGACY_DRIVE_SEC_SIZE, 0))
+                {
+                    uint64_t qword0 = M_BytesTo8ByteValue(logBuffer[7], logBuffer[6], logBuffer[5], logBuffer[4], logBuffer[3], logBuffer[2], logBuffer[1], logBuffer[0]);
+                    if (qword0 & BIT63 && M_Byte2(qword0) == ATA_ID_DATA_LOG_ZONED_DEVICE_INFORMATION && M_Word0(qword0) >= 0x0001)//validating we got the right page
+                    {
+                        //according to what I can find in the spec, a HOST Managed drive reports a different signature, but doens't set any identify bytes like a host aware drive.
+                        //because of this and not being able to get the real signature, this check is the only way to determine we are talking to an ATA host managed drive. - TJE
+                        if (device->drive_info.zonedType == ZONED_TYPE_NOT_ZONED)
+                        {
+                            device->drive_info.zonedType = ZONED_TYPE_HOST_MANAGED;
+                        }
+                    }
+                }
+            }
+            if (readDeviceStatisticsLog)
+            {
+                memset(logBuffer, 0, LEGACY_DRIVE_SEC_SIZE);
+                if (SUCCESS == send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_DEVICE_STATISTICS, ATA_DEVICE_STATS_LOG_LIST, logBuffer, LEGACY_DRIVE_SEC_SIZE, 0))
+                {
+                    uint16_t iter = 9;
+                    uint8_t numberOfEntries = logBuffer[8];
+                    for (iter = 9; iter < (numberOfEntries + 9) && iter < 512; ++iter)
+                    {
+                        switch (logBuffer[iter])
+                        {
+                        case ATA_DEVICE_STATS_LOG_LIST:
+                            break;
+                        case ATA_DEVICE_STATS_LOG_GENERAL:
+                            device->drive_info.softSATFlags.deviceStatsPages.generalStatisitcsSupported = true;
+                            break;
+                        case ATA_DEVICE_STATS_LOG_FREE_FALL:
+                            break;
+                        case ATA_DEVICE_STATS_LOG_ROTATING_MEDIA:
+                            device->drive_info.softSATFlags.deviceStatsPages.rotatingMediaStatisticsPageSupported = true;
+                            break;
+                        case ATA_DEVICE_STATS_LOG_GEN_ERR:
+                            device->drive_info.softSATFlags.deviceStatsPages.generalErrorStatisticsSupported = true;
+                            break;
+                        case ATA_DEVICE_STATS_LOG_TEMP:
+                            device->drive_info.softSATFlags.deviceStatsPages.temperatureStatisticsSupported = true;
+                            break;
+                        case ATA_DEVICE_STATS_LOG_TRANSPORT:
+                            break;
+                        case ATA_DEVICE_STATS_LOG_SSD:
+                            device->drive_info.softSATFlags.deviceStatsPages.solidStateDeviceStatisticsSupported = true;
+                            break;
+                        default:
+                            break;
+                        }
+                    }
+                    if (device->drive_info.softSATFlags.deviceStatsPages.generalStatisitcsSupported)
+                    {
+                        //need to read this page and check if the data and time timestamp statistic is supported
+                        memset(logBuffer, 0, LEGACY_DRIVE_SEC_SIZE);
+                        if (SUCCESS == send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_DEVICE_STATISTICS, ATA_DEVICE_STATS_LOG_GENERAL, logBuffer, LEGACY_DRIVE_SEC_SIZE, 0))
+                        {
+                            uint64_t qword0 = M_BytesTo8ByteValue(logBuffer[7], logBuffer[6], logBuffer[5], logBuffer[4], logBuffer[3], logBuffer[2], logBuffer[1], logBuffer[0]);
+                            if (M_Byte2(qword0) == ATA_DEVICE_STATS_LOG_GENERAL && M_Word0(qword0) >= 0x0001)//validating we got the right page
+                            {
+                                uint64_t dateAndTime = M_BytesTo8ByteValue(logBuffer[63], logBuffer[62], logBuffer[61], logBuffer[60], logBuffer[59], logBuffer[58], logBuffer[57], logBuffer[56]);
+                                if (dateAndTime & BIT63)
+                                {
+                                    device->drive_info.softSATFlags.deviceStatsPages.dateAndTimeTimestampSupported = true;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        else
+        {
+            ret = FAILURE;
+        }
+    }
+    return ret;
+}
+
 int fill_In_ATA_Drive_Info(tDevice *device)
 {
     int ret = UNKNOWN;
@@ -1012,6 +1287,12 @@ int fill_In_ATA_Drive_Info(tDevice *device)
             {
                 device->drive_info.ata_Options.downloadMicrocodeDMASupported = true;
             }
+            //read/write stream DMA. Identify has no separate bit for these, so try them whenever DMA is supported. They are turned off if the translator rejects them.
+            if (device->drive_info.ata_Options.dmaSupported)
+            {
+                device->drive_info.ata_Options.readStreamDMASupported = true;
+                device->drive_info.ata_Options.writeStreamDMASupported = true;
+            }
         }
         //set zoned device type
         if (device->drive_info.zonedType != ZONED_TYPE_HOST_MANAGED)
@@ -1120,6 +1401,8 @@ int fill_In_ATA_Drive_Info(tDevice *device)
                 device->drive_info.ata_Options.readBufferDMASupported = false;
                 device->drive_info.ata_Options.readLogWriteLogDMASupported = false;
                 device->drive_info.ata_Options.writeBufferDMASupported = false;
+                device->drive_info.ata_Options.readStreamDMASupported = false;
+                device->drive_info.ata_Options.writeStreamDMASupported = false;
             }
         }
 
@@ -1161,6 +1444,8 @@ int fill_In_ATA_Drive_Info(tDevice *device)
         device->drive_info.ata_Options.readBufferDMASupported = false;
         device->drive_info.ata_Options.readLogWriteLogDMASupported = false;
         device->drive_info.ata_Options.writeBufferDMASupported = false;
+        device->drive_info.ata_Options.readStreamDMASupported = false;
+        device->drive_info.ata_Options.writeStreamDMASupported = false;
     }
     //check if we're being asked to set the protocol to DMA for DMA commands (default behavior depends on drive support from identify)
     if ((device->dFlags & FORCE_ATA_DMA_SAT_MODE) != 0)
@@ -1174,195 +1459,17 @@ int fill_In_ATA_Drive_Info(tDevice *device)
     }
 
     //device->drive_info.softSATFlags.senseDataDescriptorFormat = true;//by default software SAT will set this to descriptor format so that ATA pass-through works as expected with RTFRs.
-    //only bother reading logs if GPL is supported...not going to bother with SMART even though some of the things we are looking for are in SMART - TJE
-    if (retrievedIdentifyData && device->drive_info.ata_Options.generalPurposeLoggingSupported)
+    if (retrievedIdentifyData)
     {
-        uint8_t logBuffer[LEGACY_DRIVE_SEC_SIZE] = { 0 };
-        if (SUCCESS == send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_DIRECTORY, 0, logBuffer, LEGACY_DRIVE_SEC_SIZE, 0))
+        device->drive_info.lazyInfo.readable |= LAZY_INFO_ATA_LOG_CAPABILITIES;
+        if (M_Word0(device->dFlags) == LAZY_DISCOVERY)
         {
-            bool readIDDataLog = false;
-            bool readDeviceStatisticsLog = false;
-            //check for support of ID Data Log, Current Device Internal Status, Saved Device Internal Status, Device Statistics Log
-            if (M_BytesTo2ByteValue(logBuffer[(ATA_LOG_DEVICE_STATISTICS * 2) + 1], logBuffer[(ATA_LOG_DEVICE_STATISTICS * 2)]) > 0)
-            {
-                readDeviceStatisticsLog = true;
-            }
-            if (M_BytesTo2ByteValue(logBuffer[(ATA_LOG_CURRENT_DEVICE_INTERNAL_STATUS_DATA_LOG * 2) + 1], logBuffer[(ATA_LOG_CURRENT_DEVICE_INTERNAL_STATUS_DATA_LOG * 2)]) > 0)
-            {
-                device->drive_info.softSATFlags.currentInternalStatusLogSupported = true;
-            }
-            if (M_BytesTo2ByteValue(logBuffer[(ATA_LOG_SAVED_DEVICE_INTERNAL_STATUS_DATA_LOG * 2) + 1], logBuffer[(ATA_LOG_SAVED_DEVICE_INTERNAL_STATUS_DATA_LOG * 2)]) > 0)
-            {
-                device->drive_info.softSATFlags.savedInternalStatusLogSupported = true;
-            }
-            if (M_BytesTo2ByteValue(logBuffer[(ATA_LOG_IDENTIFY_DEVICE_DATA * 2) + 1], logBuffer[(ATA_LOG_IDENTIFY_DEVICE_DATA * 2)]) > 0)
-            {
-                readIDDataLog = true;
-            }
-            //could check any log from address 80h through 9Fh...but one should be enough (used for SAT application client log page translation)
-            //Using 90h since that is the first page the application client translation uses.
-            if (M_BytesTo2ByteValue(logBuffer[(0x90 * 2) + 1], logBuffer[(0x90 * 2)]) > 0)
-            {
-                device->drive_info.softSATFlags.hostLogsSupported = true;
-            }
-            //now read the couple pages of logs we care about to set some more flags for software SAT
-            if (readIDDataLog)
-            {
-                bool copyOfIDData = false;
-                bool supportedCapabilities = false;
-                bool zonedDeviceInfo = false;
-                memset(logBuffer, 0, LEGACY_DRIVE_SEC_SIZE);
-                if (SUCCESS == send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_IDENTIFY_DEVICE_DATA, ATA_ID_DATA_LOG_SUPPORTED_PAGES, logBuffer, LEGACY_DRIVE_SEC_SIZE, 0))
-                {
-                    uint8_t pageNumber = logBuffer[2];
-                    uint16_t revision = M_BytesTo2ByteValue(logBuffer[1], logBuffer[0]);
-                    if (pageNumber == C_CAST(uint8_t, ATA_ID_DATA_LOG_SUPPORTED_PAGES) && revision >= 0x0001)
-                    {
-                        //data is valid, so figure out supported pages
-                        uint8_t listLen = logBuffer[8];
-                        for (uint16_t iter = 9; iter < C_CAST(uint16_t, listLen + 8) && iter < UINT16_C(512); ++iter)
-                        {
-                            switch (logBuffer[iter])
-                            {
-                            case ATA_ID_DATA_LOG_SUPPORTED_PAGES:
-                                break;
-                            case ATA_ID_DATA_LOG_COPY_OF_IDENTIFY_DATA:
-                                copyOfIDData = true;
-                                break;
-                            case ATA_ID_DATA_LOG_CAPACITY:
-                                break;
-                            case ATA_ID_DATA_LOG_SUPPORTED_CAPABILITIES:
-                                supportedCapabilities = true;
-                                break;
-                            case ATA_ID_DATA_LOG_CURRENT_SETTINGS:
-                            case ATA_ID_DATA_LOG_ATA_STRINGS:
-                            case ATA_ID_DATA_LOG_SECURITY:
-                            case ATA_ID_DATA_LOG_PARALLEL_ATA:
-                            case ATA_ID_DATA_LOG_SERIAL_ATA:
-                                break;
-                            case ATA_ID_DATA_LOG_ZONED_DEVICE_INFORMATION:
-                                zonedDeviceInfo = true;
-                                break;
-                            default:
-                                break;
-                            }
-                        }
-                    }
-                }
-                memset(logBuffer, 0, LEGACY_DRIVE_SEC_SIZE);
-                if (copyOfIDData && SUCCESS == send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_IDENTIFY_DEVICE_DATA, ATA_ID_DATA_LOG_COPY_OF_IDENTIFY_DATA, logBuffer, LEGACY_DRIVE_SEC_SIZE, 0))
-                {
-                    device->drive_info.softSATFlags.identifyDeviceDataLogSupported = true;
-                }
-                memset(logBuffer, 0, LEGACY_DRIVE_SEC_SIZE);
-                if (supportedCapabilities && SUCCESS == send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_IDENTIFY_DEVICE_DATA, ATA_ID_DATA_LOG_SUPPORTED_CAPABILITIES, logBuffer, LEGACY_DRIVE_SEC_SIZE, 0))
-                {
-                    uint64_t qword0 = M_BytesTo8ByteValue(logBuffer[7], logBuffer[6], logBuffer[5], logBuffer[4], logBuffer[3], logBuffer[2], logBuffer[1], logBuffer[0]);
-                    if (qword0 & BIT63 && M_Byte2(qword0) == ATA_ID_DATA_LOG_SUPPORTED_CAPABILITIES && M_Word0(qword0) >= 0x0001)
-                    {
-                        uint64_t supportedCapabilitiesQWord = M_BytesTo8ByteValue(logBuffer[15], logBuffer[14], logBuffer[13], logBuffer[12], logBuffer[11], logBuffer[10], logBuffer[9], logBuffer[8]);
-                        if (supportedCapabilitiesQWord & BIT63)
-                        {
-                            if (supportedCapabilitiesQWord & BIT50)
-                            {
-                                device->drive_info.softSATFlags.dataSetManagementXLSupported = true;
-                            }
-                            if (supportedCapabilitiesQWord & BIT48)
-                            {
-                                device->drive_info.softSATFlags.zeroExtSupported = true;
-                            }
-                        }
-                        uint64_t downloadCapabilities = M_BytesTo8ByteValue(logBuffer[23], logBuffer[22], logBuffer[21], logBuffer[20], logBuffer[19], logBuffer[18], logBuffer[17], logBuffer[16]);
-                        if (downloadCapabilities & BIT63 && downloadCapabilities & BIT34)
-                        {
-                            device->drive_info.softSATFlags.deferredDownloadSupported = true;
-                        }
-                        uint64_t supportedZACCapabilities = M_BytesTo8ByteValue(logBuffer[119], logBuffer[118], logBuffer[117], logBuffer[116], logBuffer[115], logBuffer[114], logBuffer[113], logBuffer[112]);
-                        if (supportedZACCapabilities & BIT63)//qword valid
-                        {
-                            //check if any of the ZAC commands are supported.
-                            if (supportedZACCapabilities & BIT0 || supportedZACCapabilities & BIT1 || supportedZACCapabilities & BIT2 || supportedZACCapabilities & BIT3 || supportedZACCapabilities & BIT4)
-                            {
-                                //according to what I can find in the spec, a HOST Managed drive reports a different signature, but doens't set any identify bytes like a host aware drive.
-                                //because of this and not being able to get the real signature, this check is the only way to determine we are talking to an ATA host managed drive. - TJE
-                                if (device->drive_info.zonedType == ZONED_TYPE_NOT_ZONED)
-                                {
-                                    device->drive_info.zonedType = ZONED_TYPE_HOST_MANAGED;
-                                }
-                            }
-                        }
-                    }
-                }
-                memset(logBuffer, 0, LEGACY_DRIVE_SEC_SIZE);
-                if (zonedDeviceInfo && SUCCESS == send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_IDENTIFY_DEVICE_DATA, ATA_ID_DATA_LOG_ZONED_DEVICE_INFORMATION, logBuffer, LEGACY_DRIVE_SEC_SIZE, 0))
-                {
-                    uint64_t qword0 = M_BytesTo8ByteValue(logBuffer[7], logBuffer[6], logBuffer[5], logBuffer[4], logBuffer[3], logBuffer[2], logBuffer[1], logBuffer[0]);
-                    if (qword0 & BIT63 && M_Byte2(qword0) == ATA_ID_DATA_LOG_ZONED_DEVICE_INFORMATION && M_Word0(qword0) >= 0x0001)//validating we got the right page
-                    {
-                        //according to what I can find in the spec, a HOST Managed drive reports a different signature, but doens't set any identify bytes like a host aware drive.
-                        //because of this and not being able to get the real signature, this check is the only way to determine we are talking to an ATA host managed drive. - TJE
-                        if (device->drive_info.zonedType == ZONED_TYPE_NOT_ZONED)
-                        {
-                            device->drive_info.zonedType = ZONED_TYPE_HOST_MANAGED;
-                        }
-                    }
-                }
-            }
-            if (readDeviceStatisticsLog)
-            {
-                memset(logBuffer, 0, LEGACY_DRIVE_SEC_SIZE);
-                if (SUCCESS == send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_DEVICE_STATISTICS, ATA_DEVICE_STATS_LOG_LIST, logBuffer, LEGACY_DRIVE_SEC_SIZE, 0))
-                {
-                    uint16_t iter = 9;
-                    uint8_t numberOfEntries = logBuffer[8];
-                    for (iter = 9; iter < (numberOfEntries + 9) && iter < 512; ++iter)
-                    {
-                        switch (logBuffer[iter])
-                        {
-                        case ATA_DEVICE_STATS_LOG_LIST:
-                            break;
-                        case ATA_DEVICE_STATS_LOG_GENERAL:
-                            device->drive_info.softSATFlags.deviceStatsPages.generalStatisitcsSupported = true;
-                            break;
-                        case ATA_DEVICE_STATS_LOG_FREE_FALL:
-                            break;
-                        case ATA_DEVICE_STATS_LOG_ROTATING_MEDIA:
-                            device->drive_info.softSATFlags.deviceStatsPages.rotatingMediaStatisticsPageSupported = true;
-                            break;
-                        case ATA_DEVICE_STATS_LOG_GEN_ERR:
-                            device->drive_info.softSATFlags.deviceStatsPages.generalErrorStatisticsSupported = true;
-                            break;
-                        case ATA_DEVICE_STATS_LOG_TEMP:
-                            device->drive_info.softSATFlags.deviceStatsPages.temperatureStatisticsSupported = true;
-                            break;
-                        case ATA_DEVICE_STATS_LOG_TRANSPORT:
-                            break;
-                        case ATA_DEVICE_STATS_LOG_SSD:
-                            device->drive_info.softSATFlags.deviceStatsPages.solidStateDeviceStatisticsSupported = true;
-                            break;
-                        default:
-                            break;
-                        }
-                    }
-                    if (device->drive_info.softSATFlags.deviceStatsPages.generalStatisitcsSupported)
-                    {
-                        //need to read this page and check if the data and time timestamp statistic is supported
-                        memset(logBuffer, 0, LEGACY_DRIVE_SEC_SIZE);
-                        if (SUCCESS == send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_DEVICE_STATISTICS, ATA_DEVICE_STATS_LOG_GENERAL, logBuffer, LEGACY_DRIVE_SEC_SIZE, 0))
-                        {
-                            uint64_t qword0 = M_BytesTo8ByteValue(logBuffer[7], logBuffer[6], logBuffer[5], logBuffer[4], logBuffer[3], logBuffer[2], logBuffer[1], logBuffer[0]);
-                            if (M_Byte2(qword0) == ATA_DEVICE_STATS_LOG_GENERAL && M_Word0(qword0) >= 0x0001)//validating we got the right page
-                            {
-                                uint64_t dateAndTime = M_BytesTo8ByteValue(logBuffer[63], logBuffer[62], logBuffer[61], logBuffer[60], logBuffer[59], logBuffer[58], logBuffer[57], logBuffer[56]);
-                                if (dateAndTime & BIT63)
-                                {
-                                    device->drive_info.softSATFlags.deviceStatsPages.dateAndTimeTimestampSupported = true;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+            //These logs are only needed by software SAT, so wait until it is used to read them. See fill_Lazy_Device_Info()
+            device->drive_info.lazyInfo.pending |= LAZY_INFO_ATA_LOG_CAPABILITIES;
+        }
+        else
+        {
+            fill_In_ATA_Log_Capabilities(device);
         }
     }
     device->drive_info.dataTransferSize = LEGACY_DRIVE_SEC_SIZE;
@@ -1534,17 +1641,11 @@ void print_Verbose_ATA_Command_Result_Information(ataPassthroughCommand *ataComm
 
 uint8_t calculate_ATA_Checksum(uint8_t *ptrData)
 {
-    uint8_t checksum = 0;
-    uint32_t counter = 0;
     if (!ptrData)
     {
         return BAD_PARAMETER;
-    }  
-    for (counter = 0; counter < 511; ++counter)
-    {
-        checksum = checksum + ptrData[counter];
     }
-    return checksum; // (~checksum + 1);//return this? or just the checksum?
+    return sum_Bytes(ptrData, LEGACY_DRIVE_SEC_SIZE - 1); // (~checksum + 1);//return this? or just the checksum?
 }
 
 bool is_Checksum_Valid(uint8_t *ptrData, uint32_t dataSize, uint32_t *firstInvalidSector)
@@ -1554,14 +1655,10 @@ bool is_Checksum_Valid(uint8_t *ptrData, uint32_t dataSize, uint32_t *firstInval
     {
         return false;
     }
-    uint8_t checksumCalc = 0;
     for (uint32_t blockIter = 0; blockIter < (dataSize / LEGACY_DRIVE_SEC_SIZE); ++blockIter)
     {
-        for (uint32_t counter = 0; counter <= 511; ++counter)
-        {
-            checksumCalc = checksumCalc + ptrData[counter + (blockIter * 512)];
-        }
-        if (checksumCalc == 0)
+        //all 512 bytes including the checksum byte add up to zero when the checksum is valid
+        if (sum_Bytes(&ptrData[blockIter * LEGACY_DRIVE_SEC_SIZE], LEGACY_DRIVE_SEC_SIZE) == 0)
         {
             isValid = true;
         }
@@ -1585,8 +1682,9 @@ int set_ATA_Checksum_Into_Data_Buffer(uint8_t *ptrData, uint32_t dataSize)
     uint8_t checksum = 0;
     for (uint32_t blockIter = 0; blockIter < (dataSize / LEGACY_DRIVE_SEC_SIZE); ++blockIter)
     {
-        checksum = calculate_ATA_Checksum(&ptrData[blockIter]);
-        ptrData[blockIter + 511] = (~checksum + 1);
+        uint8_t *block = &ptrData[blockIter * LEGACY_DRIVE_SEC_SIZE];
+        checksum = calculate_ATA_Checksum(block);
+        block[LEGACY_DRIVE_SEC_SIZE - 1] = (~checksum + 1);
     }
     return ret;
 }
@@ -0,0 +1,217 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file ata_stream.c
+// \brief Defines a session for continuous reads and writes with the ATA Streaming feature set, where each command has a completion time limit.
+
+#include "ata_stream.h"
+#include "cmds.h"
+#include "ata_helper_func.h"
+
+static bool is_ATA_Streaming_Supported(tDevice *device)
+{
+    //words 84 and 87 are only valid when bit 14 is set and bit 15 is clear
+    uint16_t word084 = device->drive_info.IdentifyData.ata.Word084;
+    uint16_t word087 = device->drive_info.IdentifyData.ata.Word087;
+    return ((word084 & (BIT15 | BIT14)) == BIT14 && (word084 & BIT4)) || ((word087 & (BIT15 | BIT14)) == BIT14 && (word087 & BIT4));
+}
+
+int start_ATA_Stream(tDevice *device, ataStreamOptions *options, ataStreamSession *session)
+{
+    int ret = SUCCESS;
+    uint32_t minimumRequestSize = 0;
+    uint32_t granularityMicroseconds = 0;
+    uint16_t allocationUnit = 0;
+    if (!device || !options || !session || options->streamID > ATA_STREAM_MAX_STREAM_ID)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(session, 0, sizeof(ataStreamSession));
+    if (device->drive_info.drive_type != ATA_DRIVE || !is_ATA_Streaming_Supported(device))
+    {
+        return NOT_SUPPORTED;
+    }
+    fill_Lazy_Device_Info(device, LAZY_INFO_CAPACITY);
+    if (device->drive_info.deviceBlockSize == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    //word 95 = stream minimum request size. words 98-99 = streaming performance granularity, the unit of the CCTL fields in microseconds
+    minimumRequestSize = M_Max(device->drive_info.IdentifyData.ata.Word095, UINT16_C(1));
+    granularityMicroseconds = M_WordsTo4ByteValue(device->drive_info.IdentifyData.ata.Word099, device->drive_info.IdentifyData.ata.Word098);
+    session->device = device;
+    session->streamID = options->streamID;
+    session->continuous = options->continuous;
+    session->nextLBA = UINT64_MAX;
+    session->deadlineNanoseconds = C_CAST(uint64_t, options->deadlineMicroseconds) * UINT64_C(1000);
+    if (options->deadlineMicroseconds > 0 && granularityMicroseconds > 0)
+    {
+        uint64_t cctl = (C_CAST(uint64_t, options->deadlineMicroseconds) + granularityMicroseconds - 1) / granularityMicroseconds;
+        //Clamping a longer deadline to 255 would have the device give up sooner than asked, so leave the device without a limit and only check it on the host.
+        if (cctl <= UINT8_MAX)
+        {
+            session->commandCCTL = C_CAST(uint8_t, cctl);
+        }
+    }
+    session->transferLBAs = options->transferLBAs;
+    if (session->transferLBAs == 0)
+    {
+        session->transferLBAs = M_Max(ATA_STREAM_DEFAULT_TRANSFER_BYTES / device->drive_info.deviceBlockSize, UINT32_C(1));
+    }
+    //the sector count of a stream command is 16 bits with 0 meaning 65536
+    session->transferLBAs = M_Min(session->transferLBAs, UINT32_C(65536));
+    if (session->transferLBAs >= minimumRequestSize)
+    {
+        session->transferLBAs -= session->transferLBAs % minimumRequestSize;
+    }
+    allocationUnit = options->allocationUnit > 0 ? options->allocationUnit : C_CAST(uint16_t, minimumRequestSize);
+    ret = ata_Configure_Stream(device, session->streamID, true, false, session->commandCCTL, allocationUnit);
+    if (ret != SUCCESS)
+    {
+        memset(session, 0, sizeof(ataStreamSession));
+    }
+    return ret;
+}
+
+static int ata_Stream_Command(ataStreamSession *session, bool write, uint64_t lba, uint8_t *ptrData, uint32_t dataSize)
+{
+    int ret = SUCCESS;
+    tDevice *device = NULL;
+    uint32_t lbaCount = 0;
+    bool notSequential = false;
+    ataStreamCommandResult *result = NULL;
+    if (!session || !session->device || !ptrData)
+    {
+        return BAD_PARAMETER;
+    }
+    device = session->device;
+    if (dataSize == 0 || dataSize % device->drive_info.deviceBlockSize != 0)
+    {
+        return BAD_PARAMETER;
+    }
+    lbaCount = dataSize / device->drive_info.deviceBlockSize;
+    if (lbaCount > UINT32_C(65536) || lba > device->drive_info.deviceMaxLba || lbaCount > device->drive_info.deviceMaxLba - lba + 1)
+    {
+        return BAD_PARAMETER;
+    }
+    notSequential = lba != session->nextLBA;
+    if (write)
+    {
+        ret = send_ATA_Write_Stream_Cmd(device, session->streamID, false, session->continuous, session->commandCCTL, lba, ptrData, dataSize);
+    }
+    else
+    {
+        ret = send_ATA_Read_Stream_Cmd(device, session->streamID, notSequential, session->continuous, session->commandCCTL, lba, ptrData, dataSize);
+    }
+    result = &session->lastCommand;
+    memset(result, 0, sizeof(ataStreamCommandResult));
+    result->lba = lba;
+    result->lbaCount = lbaCount;
+    if (ret != SUCCESS && ret != FAILURE && ret != ABORTED)
+    {
+        //only SUCCESS, FAILURE and ABORTED come from the device status. Anything else means the command did not complete on the device, so the returned registers and command time are left over from an earlier command
+        session->nextLBA = UINT64_MAX;
+        return ret;
+    }
+    result->nanoseconds = device->drive_info.lastCommandTimeNanoSeconds;
+    if (device->drive_info.lastCommandRTFRs.status & ATA_STATUS_BIT_STREAM_ERROR)
+    {
+        result->streamError = true;
+        if (!(device->drive_info.lastCommandRTFRs.status & ATA_STATUS_BIT_ERROR))
+        {
+            //with read/write continuous, the device completes the command and only flags the stream error
+            ret = SUCCESS;
+        }
+    }
+    if ((result->streamError && (device->drive_info.lastCommandRTFRs.error & ATA_ERROR_BIT_COMMAND_COMPLETION_TIME_OUT)) || (session->deadlineNanoseconds > 0 && result->nanoseconds > session->deadlineNanoseconds))
+    {
+        result->deadlineMissed = true;
+        session->deadlineMisses += 1;
+        if (SUCCESS != add_LBA_Interval(&session->missedLBAs, lba, lbaCount) && ret == SUCCESS)
+        {
+            ret = MEMORY_FAILURE;
+        }
+    }
+    session->commandsIssued += 1;
+    session->totalNanoseconds += result->nanoseconds;
+    session->maxNanoseconds = M_Max(session->maxNanoseconds, result->nanoseconds);
+    session->nextLBA = lba + lbaCount;
+    return ret;
+}
+
+int ata_Stream_Read(ataStreamSession *session, uint64_t lba, uint8_t *ptrData, uint32_t dataSize)
+{
+    return ata_Stream_Command(session, false, lba, ptrData, dataSize);
+}
+
+int ata_Stream_Write(ataStreamSession *session, uint64_t lba, uint8_t *ptrData, uint32_t dataSize)
+{
+    return ata_Stream_Command(session, true, lba, ptrData, dataSize);
+}
+
+int run_ATA_Stream(ataStreamSession *session, bool write, uint64_t startLBA, uint64_t lbaCount, ataStreamChunk chunk, void *chunkData)
+{
+    int ret = SUCCESS;
+    tDevice *device = NULL;
+    uint8_t *buffer = NULL;
+    uint64_t lba = startLBA;
+    uint64_t endLBA = 0;
+    if (!session || !session->device || lbaCount == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    device = session->device;
+    if (startLBA > device->drive_info.deviceMaxLba || lbaCount > device->drive_info.deviceMaxLba - startLBA + 1)
+    {
+        return BAD_PARAMETER;
+    }
+    endLBA = startLBA + lbaCount;
+    buffer = C_CAST(uint8_t*, calloc_aligned(C_CAST(size_t, session->transferLBAs) * device->drive_info.deviceBlockSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!buffer)
+    {
+        return MEMORY_FAILURE;
+    }
+    while (lba < endLBA)
+    {
+        uint32_t count = C_CAST(uint32_t, M_Min(C_CAST(uint64_t, session->transferLBAs), endLBA - lba));
+        uint32_t dataSize = count * device->drive_info.deviceBlockSize;
+        if (write && chunk && !chunk(session, chunkData, lba, buffer, dataSize))
+        {
+            ret = ABORTED;
+            break;
+        }
+        ret = ata_Stream_Command(session, write, lba, buffer, dataSize);
+        if (ret != SUCCESS)
+        {
+            break;
+        }
+        if (!write && chunk && !chunk(session, chunkData, lba, buffer, dataSize))
+        {
+            ret = ABORTED;
+            break;
+        }
+        lba += count;
+    }
+    safe_Free_aligned(buffer)
+    return ret;
+}
+
+int end_ATA_Stream(ataStreamSession *session)
+{
+    int ret = SUCCESS;
+    if (!session || !session->device)
+    {
+        return BAD_PARAMETER;
+    }
+    ret = ata_Configure_Stream(session->device, session->streamID, false, false, 0, 0);
+    free_LBA_Interval_Set(&session->missedLBAs);
+    memset(session, 0, sizeof(ataStreamSession));
+    return ret;
+}
@@ -943,6 +943,7 @@ static int ada_filter( const struct dirent *entry )
 
 int close_Device(tDevice *dev)
 {
+    free_Translation_Scratch(dev);
     if (dev->os_info.cam_dev)
     {
         cam_close_device(dev->os_info.cam_dev);
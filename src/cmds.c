@@ -252,6 +252,8 @@ int fill_Drive_Info_Data(tDevice *device)
     #endif
     if (device)
     {       
+        //Everything the ops table is chosen from can change during discovery. It is resolved again on first use.
+        memset(&device->ops, 0, sizeof(deviceOperations));
         if (device->drive_info.interface_type == UNKNOWN_INTERFACE)
         {
             status = BAD_PARAMETER;
@@ -310,6 +312,8 @@ int fill_Drive_Info_Data(tDevice *device)
             status = fill_In_Device_Info(device);
             break;
         }       
+        //in case any commands during discovery resolved the table before all the hacks were set up
+        memset(&device->ops, 0, sizeof(deviceOperations));
     }
     else
     {
@@ -327,6 +331,62 @@ int fill_Drive_Info_Data(tDevice *device)
     return status;
 }
 
+int fill_Lazy_Device_Info(tDevice *device, uint32_t lazyInfo)
+{
+    int ret = SUCCESS;
+    uint32_t toRead = 0;
+    if (!device)
+    {
+        return BAD_PARAMETER;
+    }
+    toRead = device->drive_info.lazyInfo.pending & lazyInfo;
+    if (toRead == 0)
+    {
+        //already up to date
+        return SUCCESS;
+    }
+    //clear these before issuing any commands so that a translator calling back into here does not try reading them again
+    device->drive_info.lazyInfo.pending &= ~toRead;
+    if (toRead & LAZY_INFO_ATA_LOG_CAPABILITIES)
+    {
+        //Not having GPL or these logs is not an error. The software SAT flags stay false.
+        fill_In_ATA_Log_Capabilities(device);
+    }
+    if (toRead & (LAZY_INFO_SERIAL_NUMBER | LAZY_INFO_WORLD_WIDE_NAME | LAZY_INFO_MEDIA_TYPE | LAZY_INFO_CAPACITY | LAZY_INFO_LOGICAL_UNITS))
+    {
+        ret = fill_Lazy_SCSI_Device_Info(device, toRead);
+    }
+    if (toRead & LAZY_INFO_CAPACITY)
+    {
+        //read/write command selection depends on the max LBA
+        memset(&device->ops, 0, sizeof(deviceOperations));
+    }
+    if (ret == MEMORY_FAILURE)
+    {
+        //try again next time
+        device->drive_info.lazyInfo.pending |= toRead;
+    }
+    return ret;
+}
+
+const char* get_Device_Serial_Number(tDevice *device)
+{
+    fill_Lazy_Device_Info(device, LAZY_INFO_SERIAL_NUMBER);
+    return device->drive_info.serialNumber;
+}
+
+uint64_t get_Device_World_Wide_Name(tDevice *device)
+{
+    fill_Lazy_Device_Info(device, LAZY_INFO_WORLD_WIDE_NAME);
+    return device->drive_info.worldWideName;
+}
+
+uint32_t get_Device_Number_Of_Logical_Units(tDevice *device)
+{
+    fill_Lazy_Device_Info(device, LAZY_INFO_LOGICAL_UNITS);
+    return device->drive_info.numberOfLUs;
+}
+
 int firmware_Download_Command(tDevice *device, eDownloadMode dlMode, uint32_t offset, uint32_t xferLen, uint8_t *ptrData, uint8_t slotNumber, bool existingImage, bool firstSegment, bool lastSegment, uint32_t timeoutSeconds)
 {
     int ret = UNKNOWN;
@@ -1026,6 +1086,10 @@ int ata_Read(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint32
                                     //this means that the error is not related to DMA mode command, so we can turn that back on and pass up the return status.
                                     device->drive_info.ata_Options.dmaMode = currentDMAMode;
                                 }
+                                else
+                                {
+                                    resolve_Device_Operations(device);
+                                }
                             }
                         }
                     }                    
@@ -1141,6 +1205,10 @@ int ata_Read(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint32
                                     //this means that the error is not related to DMA mode command, so we can turn that back on and pass up the return status.
                                     device->drive_info.ata_Options.dmaMode = currentDMAMode;
                                 }
+                                else
+                                {
+                                    resolve_Device_Operations(device);
+                                }
                             }
                         }
                     }
@@ -1277,6 +1345,10 @@ int ata_Write(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint3
                                     //this means that the error is not related to DMA mode command, so we can turn that back on and pass up the return status.
                                     device->drive_info.ata_Options.dmaMode = currentDMAMode;
                                 }
+                                else
+                                {
+                                    resolve_Device_Operations(device);
+                                }
                             }
                         }
                     }
@@ -1392,6 +1464,10 @@ int ata_Write(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint3
                                     //this means that the error is not related to DMA mode command, so we can turn that back on and pass up the return status.
                                     device->drive_info.ata_Options.dmaMode = currentDMAMode;
                                 }
+                                else
+                                {
+                                    resolve_Device_Operations(device);
+                                }
                             }
                         }
                     }
@@ -1477,6 +1553,7 @@ int scsi_Read(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint3
                             //setup the hacks like this so prevent future retries
                             device->drive_info.passThroughHacks.scsiHacks.readWrite.available = true;
                             device->drive_info.passThroughHacks.scsiHacks.readWrite.rw6 = true;
+                            resolve_Device_Operations(device);
                         }
                     }
                 }
@@ -1561,6 +1638,7 @@ int scsi_Write(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint
                             //setup the hacks like this so prevent future retries
                             device->drive_info.passThroughHacks.scsiHacks.readWrite.available = true;
                             device->drive_info.passThroughHacks.scsiHacks.readWrite.rw6 = true;
+                            resolve_Device_Operations(device);
                         }
                     }
                 }
@@ -1577,37 +1655,23 @@ int io_Read(tDevice *device, uint64_t lba, bool async, uint8_t* ptrData, uint32_
     {
         return NOT_SUPPORTED;
     }
+    //block size is needed below
+    fill_Lazy_Device_Info(device, LAZY_INFO_CAPACITY);
     //make sure that the data size is at least logical sector in size
     if (dataSize < device->drive_info.deviceBlockSize)
     {
         return BAD_PARAMETER;
     }
 
-    switch (device->drive_info.interface_type)
+    if (!device->ops.read)
     {
-    case IDE_INTERFACE:
-        //perform ATA reads
-        return ata_Read(device, lba, async, ptrData, dataSize);
-    case SCSI_INTERFACE:
-    case USB_INTERFACE:
-    case MMC_INTERFACE:
-    case SD_INTERFACE:
-    case IEEE_1394_INTERFACE:
-        //perform SCSI reads
-        return scsi_Read(device, lba, async, ptrData, dataSize);
-    case NVME_INTERFACE:
-#if !defined (DISABLE_NVME_PASSTHROUGH)
-        return nvme_Read(device, lba, C_CAST(uint16_t, (dataSize / device->drive_info.deviceBlockSize) - 1), false, false, 0, ptrData, dataSize);
-#else 
-        //perform SCSI reads
-        return scsi_Read(device, lba, async, ptrData, dataSize);
-#endif
-    case RAID_INTERFACE:
-        //perform SCSI reads for now. We may need to add unique functions for NVMe and RAID reads later
-        return scsi_Read(device, lba, async, ptrData, dataSize);
-    default:
-        return NOT_SUPPORTED;
+        resolve_Device_Operations(device);
     }
+    if (device->ops.read)
+    {
+        return device->ops.read(device, lba, async, ptrData, dataSize);
+    }
+    return NOT_SUPPORTED;
 }
 
 int io_Write(tDevice *device, uint64_t lba, bool async, uint8_t* ptrData, uint32_t dataSize)
@@ -1617,41 +1681,28 @@ int io_Write(tDevice *device, uint64_t lba, bool async, uint8_t* ptrData, uint32
     {
         return NOT_SUPPORTED;
     }
+    //block size is needed below
+    fill_Lazy_Device_Info(device, LAZY_INFO_CAPACITY);
     //make sure that the data size is at least logical sector in size
     if (dataSize < device->drive_info.deviceBlockSize)
     {
         return BAD_PARAMETER;
     }
 
-    switch (device->drive_info.interface_type)
+    if (!device->ops.write)
     {
-    case IDE_INTERFACE:
-        //perform ATA writes
-        return ata_Write(device, lba, async, ptrData, dataSize);
-    case SCSI_INTERFACE:
-    case USB_INTERFACE:
-    case MMC_INTERFACE:
-    case SD_INTERFACE:
-    case IEEE_1394_INTERFACE:
-        //perform SCSI writes
-        return scsi_Write(device, lba, async, ptrData, dataSize);
-    case NVME_INTERFACE:
-#if !defined (DISABLE_NVME_PASSTHROUGH)
-        return nvme_Write(device, lba, C_CAST(uint16_t, (dataSize / device->drive_info.deviceBlockSize) - 1), false, false, 0, 0, ptrData, dataSize);
-#else 
-        //perform SCSI writes
-        return scsi_Write(device, lba, async, ptrData, dataSize);
-#endif
-    case RAID_INTERFACE:
-        //perform SCSI writes for now. We may need to add unique functions for NVMe and RAID writes later
-        return scsi_Write(device, lba, async, ptrData, dataSize);
-    default:
-        return NOT_SUPPORTED;
+        resolve_Device_Operations(device);
+    }
+    if (device->ops.write)
+    {
+        return device->ops.write(device, lba, async, ptrData, dataSize);
     }
+    return NOT_SUPPORTED;
 }
 
 int read_LBA(tDevice *device, uint64_t lba, bool async, uint8_t* ptrData, uint32_t dataSize)
 {
+    fill_Lazy_Device_Info(device, LAZY_INFO_CAPACITY);
     if (device->os_info.osReadWriteRecommended)
     {
         //Old comment says this function does not always work reliably in Windows...This is NOT functional in other OS's.
@@ -1666,6 +1717,7 @@ int read_LBA(tDevice *device, uint64_t lba, bool async, uint8_t* ptrData, uint32
 
 int write_LBA(tDevice *device, uint64_t lba, bool async, uint8_t* ptrData, uint32_t dataSize)
 {
+    fill_Lazy_Device_Info(device, LAZY_INFO_CAPACITY);
     if (device->os_info.osReadWriteRecommended)
     {
         //Old comment says this function does not always work reliably in Windows...This is NOT functional in other OS's.
@@ -1806,37 +1858,22 @@ int nvme_Verify_LBA(tDevice *device, uint64_t lba, uint32_t range)
 
 int verify_LBA(tDevice *device, uint64_t lba, uint32_t range)
 {
+    fill_Lazy_Device_Info(device, LAZY_INFO_CAPACITY);
     if (device->os_info.osReadWriteRecommended)
     {
         return os_Verify(device, lba, range);
     }
     else
     {
-        switch (device->drive_info.interface_type)
+        if (!device->ops.verify)
         {
-        case IDE_INTERFACE:
-            //perform ATA verifies
-            return ata_Read_Verify(device, lba, range);
-        case SCSI_INTERFACE:
-        case USB_INTERFACE:
-        case MMC_INTERFACE:
-        case SD_INTERFACE:
-        case IEEE_1394_INTERFACE:
-            //perform SCSI verifies
-            return scsi_Verify(device, lba, range);
-        case NVME_INTERFACE:
-#if !defined (DISABLE_NVME_PASSTHROUGH)
-            return nvme_Verify_LBA(device, lba, range);
-#else 
-            //perform SCSI verifies
-            return scsi_Verify(device, lba, range);
-#endif
-        case RAID_INTERFACE:
-            //perform SCSI verifies for now. We may need to add unique functions for NVMe and RAID writes later
-            return scsi_Verify(device, lba, range);
-        default:
-            return NOT_SUPPORTED;
+            resolve_Device_Operations(device);
+        }
+        if (device->ops.verify)
+        {
+            return device->ops.verify(device, lba, range);
         }
+        return NOT_SUPPORTED;
     }
 }
 
@@ -1872,32 +1909,533 @@ int flush_Cache(tDevice *device)
     }
     else
     {
-        switch (device->drive_info.interface_type)
+        if (!device->ops.flush)
         {
-        case IDE_INTERFACE:
-            //perform ATA writes
-            return ata_Flush_Cache_Command(device);
-        case SCSI_INTERFACE:
-        case USB_INTERFACE:
-        case MMC_INTERFACE:
-        case SD_INTERFACE:
-        case IEEE_1394_INTERFACE:
-            //perform SCSI writes
-            return scsi_Synchronize_Cache_Command(device);
-        case NVME_INTERFACE:
+            resolve_Device_Operations(device);
+        }
+        if (device->ops.flush)
+        {
+            return device->ops.flush(device);
+        }
+        return NOT_SUPPORTED;
+    }
+}
+
+//These are the functions device->ops is filled in with by resolve_Device_Operations().
+//They issue the same commands ata_Read/scsi_Read/etc would for the device, but without rechecking the hacks, interface, DMA mode, etc on every call.
+static int get_Sector_Count_For_Operation(tDevice *device, bool async, uint32_t dataSize, uint32_t *sectors)
+{
+    if (async)
+    {
+        //asynchronous not supported yet
+        return NOT_SUPPORTED;
+    }
+    //make sure that the data size is at least logical sector in size
+    if (dataSize < device->drive_info.deviceBlockSize)
+    {
+        return BAD_PARAMETER;
+    }
+    *sectors = dataSize / device->drive_info.deviceBlockSize;
+    return SUCCESS;
+}
+
+//Same transfer length and LBA limits as ata_Read/ata_Write. The returned sector count is already set to 0 when requesting the maximum (65536 or 256)
+static int get_ATA_Sector_Count_For_Operation(tDevice *device, uint64_t lba, bool async, uint32_t dataSize, uint16_t *sectorCount)
+{
+    uint32_t sectors = 0;
+    int ret = get_Sector_Count_For_Operation(device, async, dataSize, &sectors);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+    if (device->drive_info.ata_Options.fourtyEightBitAddressFeatureSetSupported)
+    {
+        if (sectors > 65536 || lba > MAX_48_BIT_LBA)
+        {
+            return BAD_PARAMETER;
+        }
+    }
+    else
+    {
+        if (sectors > 256 || lba > MAX_28_BIT_LBA)
+        {
+            return BAD_PARAMETER;
+        }
+        if (sectors == 256)
+        {
+            sectors = 0;
+        }
+    }
+    *sectorCount = C_CAST(uint16_t, sectors);//65536 becomes 0 here, which is how it is represented in the command
+    return SUCCESS;
+}
+
+//Checks if a DMA command failed because the translator/adapter does not support DMA. If so, switches the device over to PIO commands and re-resolves the ops table
+static bool switch_ATA_Operations_To_PIO(tDevice *device)
+{
+    uint8_t senseKey = 0, asc = 0, ascq = 0, fru = 0;
+    get_Sense_Key_ASC_ASCQ_FRU(device->drive_info.lastCommandSenseData, SPC3_SENSE_LEN, &senseKey, &asc, &ascq, &fru);
+    //Checking for illegal request, invalid field in CDB since this is what we've seen reported when DMA commands are not supported.
+    if (senseKey == SENSE_KEY_ILLEGAL_REQUEST && asc == 0x24 && ascq == 0x00)
+    {
+        device->drive_info.ata_Options.dmaMode = ATA_DMA_MODE_NO_DMA;
+        resolve_Device_Operations(device);
+        return true;
+    }
+    return false;
+}
+
+static int ata_Read_DMA_Operation(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint32_t dataSize)
+{
+    uint16_t sectorCount = 0;
+    int ret = get_ATA_Sector_Count_For_Operation(device, lba, async, dataSize, &sectorCount);
+    if (ret == SUCCESS)
+    {
+        ret = ata_Read_DMA(device, lba, ptrData, sectorCount, dataSize, device->drive_info.ata_Options.fourtyEightBitAddressFeatureSetSupported);
+        if (ret != SUCCESS)
+        {
+            eATASynchronousDMAMode currentDMAMode = device->drive_info.ata_Options.dmaMode;
+            if (switch_ATA_Operations_To_PIO(device))
+            {
+                ret = device->ops.read(device, lba, async, ptrData, dataSize);
+                if (ret != SUCCESS)
+                {
+                    //this means that the error is not related to DMA mode command, so we can turn that back on and pass up the return status.
+                    device->drive_info.ata_Options.dmaMode = currentDMAMode;
+                    resolve_Device_Operations(device);
+                }
+            }
+        }
+    }
+    return ret;
+}
+
+static int ata_Write_DMA_Operation(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint32_t dataSize)
+{
+    uint16_t sectorCount = 0;
+    int ret = get_ATA_Sector_Count_For_Operation(device, lba, async, dataSize, &sectorCount);
+    if (ret == SUCCESS)
+    {
+        ret = ata_Write_DMA(device, lba, ptrData, dataSize, device->drive_info.ata_Options.fourtyEightBitAddressFeatureSetSupported, false);
+        if (ret != SUCCESS)
+        {
+            eATASynchronousDMAMode currentDMAMode = device->drive_info.ata_Options.dmaMode;
+            if (switch_ATA_Operations_To_PIO(device))
+            {
+                ret = device->ops.write(device, lba, async, ptrData, dataSize);
+                if (ret != SUCCESS)
+                {
+                    //this means that the error is not related to DMA mode command, so we can turn that back on and pass up the return status.
+                    device->drive_info.ata_Options.dmaMode = currentDMAMode;
+                    resolve_Device_Operations(device);
+                }
+            }
+        }
+    }
+    return ret;
+}
+
+static int ata_Read_PIO_Operation(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint32_t dataSize)
+{
+    uint16_t sectorCount = 0;
+    int ret = get_ATA_Sector_Count_For_Operation(device, lba, async, dataSize, &sectorCount);
+    if (ret == SUCCESS)
+    {
+        ret = ata_Read_Sectors(device, lba, ptrData, sectorCount, dataSize, device->drive_info.ata_Options.fourtyEightBitAddressFeatureSetSupported);
+    }
+    return ret;
+}
+
+static int ata_Write_PIO_Operation(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint32_t dataSize)
+{
+    uint16_t sectorCount = 0;
+    int ret = get_ATA_Sector_Count_For_Operation(device, lba, async, dataSize, &sectorCount);
+    if (ret == SUCCESS)
+    {
+        ret = ata_Write_Sectors(device, lba, ptrData, dataSize, device->drive_info.ata_Options.fourtyEightBitAddressFeatureSetSupported);
+    }
+    return ret;
+}
+
+static int scsi_Read_16_Operation(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint32_t dataSize)
+{
+    uint32_t sectors = 0;
+    int ret = get_Sector_Count_For_Operation(device, async, dataSize, &sectors);
+    if (ret == SUCCESS)
+    {
+        ret = scsi_Read_16(device, 0, false, false, false, lba, 0, sectors, ptrData, dataSize);
+    }
+    return ret;
+}
+
+static int scsi_Write_16_Operation(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint32_t dataSize)
+{
+    uint32_t sectors = 0;
+    int ret = get_Sector_Count_For_Operation(device, async, dataSize, &sectors);
+    if (ret == SUCCESS)
+    {
+        ret = scsi_Write_16(device, 0, false, false, lba, 0, sectors, ptrData, dataSize);
+    }
+    return ret;
+}
+
+static int scsi_Read_12_Operation(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint32_t dataSize)
+{
+    uint32_t sectors = 0;
+    int ret = get_Sector_Count_For_Operation(device, async, dataSize, &sectors);
+    if (ret == SUCCESS)
+    {
+        ret = scsi_Read_12(device, 0, false, false, false, C_CAST(uint32_t, lba), 0, sectors, ptrData, dataSize);
+    }
+    return ret;
+}
+
+static int scsi_Write_12_Operation(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint32_t dataSize)
+{
+    uint32_t sectors = 0;
+    int ret = get_Sector_Count_For_Operation(device, async, dataSize, &sectors);
+    if (ret == SUCCESS)
+    {
+        ret = scsi_Write_12(device, 0, false, false, C_CAST(uint32_t, lba), 0, sectors, ptrData, dataSize);
+    }
+    return ret;
+}
+
+static int scsi_Read_10_Operation(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint32_t dataSize)
+{
+    uint32_t sectors = 0;
+    int ret = get_Sector_Count_For_Operation(device, async, dataSize, &sectors);
+    if (ret == SUCCESS)
+    {
+        ret = scsi_Read_10(device, 0, false, false, false, C_CAST(uint32_t, lba), 0, C_CAST(uint16_t, sectors), ptrData, dataSize);
+    }
+    return ret;
+}
+
+static int scsi_Write_10_Operation(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint32_t dataSize)
+{
+    uint32_t sectors = 0;
+    int ret = get_Sector_Count_For_Operation(device, async, dataSize, &sectors);
+    if (ret == SUCCESS)
+    {
+        ret = scsi_Write_10(device, 0, false, false, C_CAST(uint32_t, lba), 0, C_CAST(uint16_t, sectors), ptrData, dataSize);
+    }
+    return ret;
+}
+
+static int scsi_Read_6_Operation(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint32_t dataSize)
+{
+    uint32_t sectors = 0;
+    int ret = get_Sector_Count_For_Operation(device, async, dataSize, &sectors);
+    if (ret == SUCCESS)
+    {
+        ret = scsi_Read_6(device, C_CAST(uint32_t, lba), C_CAST(uint8_t, sectors), ptrData, dataSize);
+    }
+    return ret;
+}
+
+static int scsi_Write_6_Operation(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint32_t dataSize)
+{
+    uint32_t sectors = 0;
+    int ret = get_Sector_Count_For_Operation(device, async, dataSize, &sectors);
+    if (ret == SUCCESS)
+    {
+        ret = scsi_Write_6(device, C_CAST(uint32_t, lba), C_CAST(uint8_t, sectors), ptrData, dataSize);
+    }
+    return ret;
+}
+
 #if !defined (DISABLE_NVME_PASSTHROUGH)
-            return nvme_Flush(device);
-#else
-            //perform SCSI flush
-            return scsi_Synchronize_Cache_Command(device);
+static int nvme_Read_Operation(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint32_t dataSize)
+{
+    uint32_t sectors = 0;
+    int ret = get_Sector_Count_For_Operation(device, async, dataSize, &sectors);
+    if (ret == SUCCESS)
+    {
+        ret = nvme_Read(device, lba, C_CAST(uint16_t, sectors - 1), false, false, 0, ptrData, dataSize);
+    }
+    return ret;
+}
+
+static int nvme_Write_Operation(tDevice *device, uint64_t lba, bool async, uint8_t *ptrData, uint32_t dataSize)
+{
+    uint32_t sectors = 0;
+    int ret = get_Sector_Count_For_Operation(device, async, dataSize, &sectors);
+    if (ret == SUCCESS)
+    {
+        ret = nvme_Write(device, lba, C_CAST(uint16_t, sectors - 1), false, false, 0, 0, ptrData, dataSize);
+    }
+    return ret;
+}
 #endif
-        case RAID_INTERFACE:
-            //perform SCSI writes for now. We may need to add unique functions for NVMe and RAID writes later
-            return scsi_Synchronize_Cache_Command(device);
-        default:
-            return NOT_SUPPORTED;
+
+#define ATA_DSM_TRIM_BLOCK_SIZE     UINT32_C(512)
+#define ATA_DSM_MAX_RANGE_LENGTH    UINT16_MAX
+
+static int ata_Trim_Operation(tDevice *device, uint64_t lba, uint64_t range)
+{
+    int ret = SUCCESS;
+    uint8_t *trimBuffer = NULL;
+    if (!(device->drive_info.IdentifyData.ata.Word169 & BIT0) || !device->drive_info.ata_Options.fourtyEightBitAddressFeatureSetSupported)
+    {
+        return NOT_SUPPORTED;
+    }
+    if (range == 0 || lba > MAX_48_BIT_LBA || range > (MAX_48_BIT_LBA - lba + 1))
+    {
+        return BAD_PARAMETER;
+    }
+    trimBuffer = C_CAST(uint8_t*, calloc_aligned(ATA_DSM_TRIM_BLOCK_SIZE, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!trimBuffer)
+    {
+        return MEMORY_FAILURE;
+    }
+    while (range > 0 && ret == SUCCESS)
+    {
+        //fill one 512B block of 8 byte range entries (48bit LBA + 16bit length, little endian) then send it
+        uint32_t offset = 0;
+        memset(trimBuffer, 0, ATA_DSM_TRIM_BLOCK_SIZE);
+        for (offset = 0; offset < ATA_DSM_TRIM_BLOCK_SIZE && range > 0; offset += 8)
+        {
+            uint16_t rangeLength = C_CAST(uint16_t, M_Min(range, ATA_DSM_MAX_RANGE_LENGTH));
+            trimBuffer[offset + 0] = M_Byte0(lba);
+            trimBuffer[offset + 1] = M_Byte1(lba);
+            trimBuffer[offset + 2] = M_Byte2(lba);
+            trimBuffer[offset + 3] = M_Byte3(lba);
+            trimBuffer[offset + 4] = M_Byte4(lba);
+            trimBuffer[offset + 5] = M_Byte5(lba);
+            trimBuffer[offset + 6] = M_Byte0(rangeLength);
+            trimBuffer[offset + 7] = M_Byte1(rangeLength);
+            lba += rangeLength;
+            range -= rangeLength;
+        }
+        ret = ata_Data_Set_Management(device, true, trimBuffer, ATA_DSM_TRIM_BLOCK_SIZE, false);
+    }
+    safe_Free_aligned(trimBuffer)
+    return ret;
+}
+
+#define SCSI_UNMAP_PARAMETER_LIST_LENGTH    UINT16_C(512)
+#define SCSI_UNMAP_HEADER_LENGTH            UINT16_C(8)
+#define SCSI_UNMAP_DESCRIPTOR_LENGTH        UINT16_C(16)
+
+static int scsi_Trim_Operation(tDevice *device, uint64_t lba, uint64_t range)
+{
+    int ret = SUCCESS;
+    uint8_t *unmapBuffer = NULL;
+    if (range == 0 || lba > device->drive_info.deviceMaxLba || range > (device->drive_info.deviceMaxLba - lba + 1))
+    {
+        return BAD_PARAMETER;
+    }
+    unmapBuffer = C_CAST(uint8_t*, calloc_aligned(SCSI_UNMAP_PARAMETER_LIST_LENGTH, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!unmapBuffer)
+    {
+        return MEMORY_FAILURE;
+    }
+    while (range > 0 && ret == SUCCESS)
+    {
+        uint16_t offset = SCSI_UNMAP_HEADER_LENGTH;
+        memset(unmapBuffer, 0, SCSI_UNMAP_PARAMETER_LIST_LENGTH);
+        for (; (offset + SCSI_UNMAP_DESCRIPTOR_LENGTH) <= SCSI_UNMAP_PARAMETER_LIST_LENGTH && range > 0; offset += SCSI_UNMAP_DESCRIPTOR_LENGTH)
+        {
+            uint32_t unmapLength = C_CAST(uint32_t, M_Min(range, UINT32_MAX));
+            unmapBuffer[offset + 0] = M_Byte7(lba);
+            unmapBuffer[offset + 1] = M_Byte6(lba);
+            unmapBuffer[offset + 2] = M_Byte5(lba);
+            unmapBuffer[offset + 3] = M_Byte4(lba);
+            unmapBuffer[offset + 4] = M_Byte3(lba);
+            unmapBuffer[offset + 5] = M_Byte2(lba);
+            unmapBuffer[offset + 6] = M_Byte1(lba);
+            unmapBuffer[offset + 7] = M_Byte0(lba);
+            unmapBuffer[offset + 8] = M_Byte3(unmapLength);
+            unmapBuffer[offset + 9] = M_Byte2(unmapLength);
+            unmapBuffer[offset + 10] = M_Byte1(unmapLength);
+            unmapBuffer[offset + 11] = M_Byte0(unmapLength);
+            lba += unmapLength;
+            range -= unmapLength;
+        }
+        //unmap data length
+        unmapBuffer[0] = M_Byte1(offset - 2);
+        unmapBuffer[1] = M_Byte0(offset - 2);
+        //block descriptor data length
+        unmapBuffer[2] = M_Byte1(offset - SCSI_UNMAP_HEADER_LENGTH);
+        unmapBuffer[3] = M_Byte0(offset - SCSI_UNMAP_HEADER_LENGTH);
+        ret = scsi_Unmap(device, false, 0, offset, unmapBuffer);
+    }
+    safe_Free_aligned(unmapBuffer)
+    return ret;
+}
+
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+#define NVME_DSM_MAX_RANGES         UINT16_C(256)
+#define NVME_DSM_RANGE_LENGTH       UINT16_C(16)
+
+static int nvme_Trim_Operation(tDevice *device, uint64_t lba, uint64_t range)
+{
+    int ret = SUCCESS;
+    uint8_t *rangeBuffer = NULL;
+    uint32_t rangeBufferLength = C_CAST(uint32_t, NVME_DSM_MAX_RANGES) * NVME_DSM_RANGE_LENGTH;
+    if (!(device->drive_info.IdentifyData.nvme.ctrl.oncs & BIT2))
+    {
+        //dataset management command not supported
+        return NOT_SUPPORTED;
+    }
+    if (range == 0 || lba > device->drive_info.deviceMaxLba || range > (device->drive_info.deviceMaxLba - lba + 1))
+    {
+        return BAD_PARAMETER;
+    }
+    rangeBuffer = C_CAST(uint8_t*, calloc_aligned(rangeBufferLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!rangeBuffer)
+    {
+        return MEMORY_FAILURE;
+    }
+    while (range > 0 && ret == SUCCESS)
+    {
+        uint16_t numberOfRanges = 0;
+        memset(rangeBuffer, 0, rangeBufferLength);
+        for (; numberOfRanges < NVME_DSM_MAX_RANGES && range > 0; ++numberOfRanges)
+        {
+            //context attributes (bytes 3:0) left as zero. Length (7:4) and starting LBA (15:8) are little endian
+            uint32_t offset = C_CAST(uint32_t, numberOfRanges) * NVME_DSM_RANGE_LENGTH;
+            uint32_t rangeLength = C_CAST(uint32_t, M_Min(range, UINT32_MAX));
+            rangeBuffer[offset + 4] = M_Byte0(rangeLength);
+            rangeBuffer[offset + 5] = M_Byte1(rangeLength);
+            rangeBuffer[offset + 6] = M_Byte2(rangeLength);
+            rangeBuffer[offset + 7] = M_Byte3(rangeLength);
+            rangeBuffer[offset + 8] = M_Byte0(lba);
+            rangeBuffer[offset + 9] = M_Byte1(lba);
+            rangeBuffer[offset + 10] = M_Byte2(lba);
+            rangeBuffer[offset + 11] = M_Byte3(lba);
+            rangeBuffer[offset + 12] = M_Byte4(lba);
+            rangeBuffer[offset + 13] = M_Byte5(lba);
+            rangeBuffer[offset + 14] = M_Byte6(lba);
+            rangeBuffer[offset + 15] = M_Byte7(lba);
+            lba += rangeLength;
+            range -= rangeLength;
+        }
+        //number of ranges is a zeroes based value
+        ret = nvme_Dataset_Management(device, C_CAST(uint8_t, numberOfRanges - 1), true, false, false, rangeBuffer, rangeBufferLength);
+    }
+    safe_Free_aligned(rangeBuffer)
+    return ret;
+}
+#endif
+
+int resolve_Device_Operations(tDevice *device)
+{
+    if (!device)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(&device->ops, 0, sizeof(deviceOperations));
+    //read/write choices depend on the capacity, so make sure it has been read.
+    fill_Lazy_Device_Info(device, LAZY_INFO_CAPACITY);
+    switch (device->drive_info.interface_type)
+    {
+    case IDE_INTERFACE:
+        //every device on an IDE interface, including ATAPI and tape drives, gets the ATA commands. Only ATA drives get the faster DMA and PIO paths.
+        if (device->drive_info.drive_type == ATA_DRIVE && !device->drive_info.ata_Options.chsModeOnly)
+        {
+            if (device->drive_info.ata_Options.dmaMode != ATA_DMA_MODE_NO_DMA)
+            {
+                device->ops.read = ata_Read_DMA_Operation;
+                device->ops.write = ata_Write_DMA_Operation;
+            }
+            else if (device->drive_info.passThroughHacks.ataPTHacks.noMultipleModeCommands || !device->drive_info.ata_Options.readWriteMultipleSupported || !device->drive_info.ata_Options.isParallelTransport || device->drive_info.ata_Options.logicalSectorsPerDRQDataBlock == 0 || device->drive_info.ata_Options.logicalSectorsPerDRQDataBlock > ATA_MAX_BLOCKS_PER_DRQ_DATA_BLOCKS)
+            {
+                device->ops.read = ata_Read_PIO_Operation;
+                device->ops.write = ata_Write_PIO_Operation;
+            }
+        }
+        if (!device->ops.read)
+        {
+            //CHS, read/write multiple and non-ATA devices are rare enough that these just go through the full set of checks
+            device->ops.read = ata_Read;
+            device->ops.write = ata_Write;
+        }
+        device->ops.verify = ata_Read_Verify;
+        device->ops.flush = ata_Flush_Cache_Command;
+        device->ops.trim = ata_Trim_Operation;
+        break;
+    case SCSI_INTERFACE:
+    case USB_INTERFACE:
+    case MMC_INTERFACE:
+    case SD_INTERFACE:
+    case IEEE_1394_INTERFACE:
+    case RAID_INTERFACE:
+        if (device->drive_info.passThroughHacks.scsiHacks.readWrite.available)
+        {
+            //This device is in the database or the command support has been determined some other way
+            if (device->drive_info.passThroughHacks.scsiHacks.readWrite.rw16)
+            {
+                device->ops.read = scsi_Read_16_Operation;
+                device->ops.write = scsi_Write_16_Operation;
+            }
+            else if (device->drive_info.passThroughHacks.scsiHacks.readWrite.rw12)
+            {
+                device->ops.read = scsi_Read_12_Operation;
+                device->ops.write = scsi_Write_12_Operation;
+            }
+            else if (device->drive_info.passThroughHacks.scsiHacks.readWrite.rw10)
+            {
+                device->ops.read = scsi_Read_10_Operation;
+                device->ops.write = scsi_Write_10_Operation;
+            }
+            else if (device->drive_info.passThroughHacks.scsiHacks.readWrite.rw6)
+            {
+                device->ops.read = scsi_Read_6_Operation;
+                device->ops.write = scsi_Write_6_Operation;
+            }
+        }
+        else if (device->drive_info.scsiVersion >= SCSI_VERSION_SPC_3 && device->drive_info.deviceMaxLba > SCSI_MAX_32_LBA)
+        {
+            //every LBA past the 32bit boundary needs read/write 16, so always use them.
+            device->ops.read = scsi_Read_16_Operation;
+            device->ops.write = scsi_Write_16_Operation;
         }
+        if (!device->ops.read)
+        {
+            //read/write 10 vs 16 depends on the request, and older devices may need to fall back to read/write 6.
+            device->ops.read = scsi_Read;
+            device->ops.write = scsi_Write;
+        }
+        device->ops.verify = scsi_Verify;
+        device->ops.flush = scsi_Synchronize_Cache_Command;
+        device->ops.trim = scsi_Trim_Operation;
+        break;
+    case NVME_INTERFACE:
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+        device->ops.read = nvme_Read_Operation;
+        device->ops.write = nvme_Write_Operation;
+        device->ops.verify = nvme_Verify_LBA;
+        device->ops.flush = nvme_Flush;
+        device->ops.trim = nvme_Trim_Operation;
+#else
+        device->ops.read = scsi_Read;
+        device->ops.write = scsi_Write;
+        device->ops.verify = scsi_Verify;
+        device->ops.flush = scsi_Synchronize_Cache_Command;
+        device->ops.trim = scsi_Trim_Operation;
+#endif
+        break;
+    default:
+        //leave these NULL. The generic functions return NOT_SUPPORTED
+        break;
+    }
+    device->ops.ataPassthrough = get_ATA_Passthrough_Function(device);
+    return SUCCESS;
+}
+
+int trim_LBA(tDevice *device, uint64_t lba, uint64_t range)
+{
+    if (!device->ops.trim)
+    {
+        resolve_Device_Operations(device);
+    }
+    if (device->ops.trim)
+    {
+        return device->ops.trim(device, lba, range);
     }
+    return NOT_SUPPORTED;
 }
 
 int close_Zone(tDevice *device, bool closeAll, uint64_t zoneID)
@@ -1908,6 +2446,13 @@ int close_Zone(tDevice *device, bool closeAll, uint64_t zoneID)
     case ATA_DRIVE:
         ret = ata_Close_Zone_Ext(device, closeAll, zoneID);
         break;
+    case NVME_DRIVE:
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+        ret = nvme_Zone_Management_Send(device, zoneID, closeAll, NVME_ZONE_SEND_ACTION_CLOSE, NULL, 0);
+        break;
+#else
+        //rely on SCSI translation
+#endif
     case SCSI_DRIVE:
         ret = scsi_Close_Zone(device, closeAll, zoneID);
         break;
@@ -1926,6 +2471,13 @@ int finish_Zone(tDevice *device, bool finishAll, uint64_t zoneID)
     case ATA_DRIVE:
         ret = ata_Finish_Zone_Ext(device, finishAll, zoneID);
         break;
+    case NVME_DRIVE:
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+        ret = nvme_Zone_Management_Send(device, zoneID, finishAll, NVME_ZONE_SEND_ACTION_FINISH, NULL, 0);
+        break;
+#else
+        //rely on SCSI translation
+#endif
     case SCSI_DRIVE:
         ret = scsi_Finish_Zone(device, finishAll, zoneID);
         break;
@@ -1944,6 +2496,13 @@ int open_Zone(tDevice *device, bool openAll, uint64_t zoneID)
     case ATA_DRIVE:
         ret = ata_Open_Zone_Ext(device, openAll, zoneID);
         break;
+    case NVME_DRIVE:
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+        ret = nvme_Zone_Management_Send(device, zoneID, openAll, NVME_ZONE_SEND_ACTION_OPEN, NULL, 0);
+        break;
+#else
+        //rely on SCSI translation
+#endif
     case SCSI_DRIVE:
         ret = scsi_Open_Zone(device, openAll, zoneID);
         break;
@@ -1962,6 +2521,13 @@ int reset_Write_Pointer(tDevice *device, bool resetAll, uint64_t zoneID)
     case ATA_DRIVE:
         ret = ata_Reset_Write_Pointers_Ext(device, resetAll, zoneID);
         break;
+    case NVME_DRIVE:
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+        ret = nvme_Zone_Management_Send(device, zoneID, resetAll, NVME_ZONE_SEND_ACTION_RESET, NULL, 0);
+        break;
+#else
+        //rely on SCSI translation
+#endif
     case SCSI_DRIVE:
         ret = scsi_Reset_Write_Pointers(device, resetAll, zoneID);
         break;
@@ -1972,6 +2538,120 @@ int reset_Write_Pointer(tDevice *device, bool resetAll, uint64_t zoneID)
     return ret;
 }
 
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+//Zone size from the zoned namespace identify namespace data for the current LBA format
+static int get_NVMe_Zone_Size(tDevice *device, uint64_t *zoneSize)
+{
+    int ret = SUCCESS;
+    uint8_t *zonedNamespaceData = C_CAST(uint8_t*, calloc_aligned(NVME_IDENTIFY_DATA_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!zonedNamespaceData)
+    {
+        return MEMORY_FAILURE;
+    }
+    ret = nvme_Identify_IO_Command_Set(device, zonedNamespaceData, device->drive_info.namespaceID, NVME_IDENTIFY_IO_CMD_SET_NS, NVME_CSI_ZONED_NAMESPACE);
+    if (ret == SUCCESS)
+    {
+        //FLBAS bits 3:0 are the low bits of the format index. Bits 6:5 are the upper bits when there are more than 16 formats, and 0 otherwise.
+        uint8_t flbas = device->drive_info.IdentifyData.nvme.ns.flbas;
+        uint32_t formatIndex = C_CAST(uint32_t, M_Nibble0(flbas)) | (C_CAST(uint32_t, M_GETBITRANGE(flbas, 6, 5)) << 4);
+        uint32_t offset = NVME_ZNS_LBA_FORMAT_EXTENSION_OFFSET + 16 * formatIndex;
+        *zoneSize = M_BytesTo8ByteValue(zonedNamespaceData[offset + 7], zonedNamespaceData[offset + 6], zonedNamespaceData[offset + 5], zonedNamespaceData[offset + 4], zonedNamespaceData[offset + 3], zonedNamespaceData[offset + 2], zonedNamespaceData[offset + 1], zonedNamespaceData[offset + 0]);
+        if (*zoneSize == 0)
+        {
+            ret = NOT_SUPPORTED;
+        }
+    }
+    safe_Free_aligned(zonedNamespaceData)
+    return ret;
+}
+
+//Reports zones from a zoned namespace and converts the report in place to the ZBC report zones format so that report_Zones() returns the same thing for every drive type.
+//The header and descriptors are both 64 bytes in each format. ZNS descriptors have the zone capacity where ZBC has the zone length, so the zone size is filled in instead
+//and the capacity is moved to ZONE_DESCRIPTOR_CAPACITY_OFFSET.
+static int nvme_Report_Zones_As_ZBC(tDevice *device, eZoneReportingOptions reportingOptions, bool partial, uint64_t zoneLocator, uint8_t *ptrData, uint32_t dataSize)
+{
+    int ret = SUCCESS;
+    uint64_t numberOfZones = 0;
+    uint32_t descriptorCount = 0;
+    uint64_t zoneSize = 0;
+    if (reportingOptions > ZONE_REPORT_LIST_OFFLINE_ZONES)
+    {
+        //reset and non-sequential options are ZBC only
+        return NOT_SUPPORTED;
+    }
+    if (!ptrData || dataSize < NVME_ZONE_DESCRIPTOR_LENGTH || dataSize % 4 != 0)
+    {
+        return BAD_PARAMETER;
+    }
+    fill_Lazy_Device_Info(device, LAZY_INFO_CAPACITY);
+    ret = nvme_Zone_Management_Receive(device, zoneLocator, NVME_ZONE_RECEIVE_ACTION_REPORT_ZONES, C_CAST(uint8_t, reportingOptions), partial, ptrData, dataSize);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+    numberOfZones = M_BytesTo8ByteValue(ptrData[7], ptrData[6], ptrData[5], ptrData[4], ptrData[3], ptrData[2], ptrData[1], ptrData[0]);
+    descriptorCount = C_CAST(uint32_t, M_Min(numberOfZones, C_CAST(uint64_t, (dataSize / NVME_ZONE_DESCRIPTOR_LENGTH) - 1)));
+    if (descriptorCount >= 2 && reportingOptions == ZONE_REPORT_LIST_ALL_ZONES)
+    {
+        //all zones in a namespace are the same size, so the distance between two that are next to each other is the zone size
+        uint8_t *first = &ptrData[NVME_ZONE_DESCRIPTOR_LENGTH + 16];
+        uint8_t *second = &ptrData[2 * NVME_ZONE_DESCRIPTOR_LENGTH + 16];
+        zoneSize = M_BytesTo8ByteValue(second[7], second[6], second[5], second[4], second[3], second[2], second[1], second[0]) - M_BytesTo8ByteValue(first[7], first[6], first[5], first[4], first[3], first[2], first[1], first[0]);
+    }
+    else if (descriptorCount > 0)
+    {
+        ret = get_NVMe_Zone_Size(device, &zoneSize);
+        if (ret != SUCCESS)
+        {
+            return ret;
+        }
+    }
+    //header: zone list length, SAME = 1 since every zone has the same type and length, maximum LBA
+    memset(ptrData, 0, NVME_ZONE_DESCRIPTOR_LENGTH);
+    numberOfZones = M_Min(numberOfZones * NVME_ZONE_DESCRIPTOR_LENGTH, UINT32_MAX);
+    ptrData[0] = M_Byte3(numberOfZones);
+    ptrData[1] = M_Byte2(numberOfZones);
+    ptrData[2] = M_Byte1(numberOfZones);
+    ptrData[3] = M_Byte0(numberOfZones);
+    ptrData[4] = 1;
+    ptrData[8] = M_Byte7(device->drive_info.deviceMaxLba);
+    ptrData[9] = M_Byte6(device->drive_info.deviceMaxLba);
+    ptrData[10] = M_Byte5(device->drive_info.deviceMaxLba);
+    ptrData[11] = M_Byte4(device->drive_info.deviceMaxLba);
+    ptrData[12] = M_Byte3(device->drive_info.deviceMaxLba);
+    ptrData[13] = M_Byte2(device->drive_info.deviceMaxLba);
+    ptrData[14] = M_Byte1(device->drive_info.deviceMaxLba);
+    ptrData[15] = M_Byte0(device->drive_info.deviceMaxLba);
+    for (uint32_t descriptorIter = 1; descriptorIter <= descriptorCount; ++descriptorIter)
+    {
+        uint8_t *descriptor = &ptrData[descriptorIter * NVME_ZONE_DESCRIPTOR_LENGTH];
+        uint8_t zoneType = M_Nibble0(descriptor[0]);
+        uint8_t zoneState = descriptor[1] & 0xF0;
+        bool resetRecommended = descriptor[2] & BIT2;
+        uint64_t zoneStartLBA = M_BytesTo8ByteValue(descriptor[23], descriptor[22], descriptor[21], descriptor[20], descriptor[19], descriptor[18], descriptor[17], descriptor[16]);
+        uint64_t writePointer = M_BytesTo8ByteValue(descriptor[31], descriptor[30], descriptor[29], descriptor[28], descriptor[27], descriptor[26], descriptor[25], descriptor[24]);
+        uint64_t zoneCapacity = M_BytesTo8ByteValue(descriptor[15], descriptor[14], descriptor[13], descriptor[12], descriptor[11], descriptor[10], descriptor[9], descriptor[8]);
+        memset(descriptor, 0, NVME_ZONE_DESCRIPTOR_LENGTH);
+        //zone type 2h (sequential write required) and the zone states have the same values in both
+        descriptor[0] = zoneType;
+        descriptor[1] = zoneState;
+        if (resetRecommended)
+        {
+            descriptor[1] |= BIT0;
+        }
+        for (uint8_t byteIter = 0; byteIter < 8; ++byteIter)
+        {
+            uint8_t shift = C_CAST(uint8_t, 56 - (byteIter * 8));
+            descriptor[8 + byteIter] = C_CAST(uint8_t, zoneSize >> shift);
+            descriptor[16 + byteIter] = C_CAST(uint8_t, zoneStartLBA >> shift);
+            descriptor[24 + byteIter] = C_CAST(uint8_t, writePointer >> shift);
+            descriptor[ZONE_DESCRIPTOR_CAPACITY_OFFSET + byteIter] = C_CAST(uint8_t, zoneCapacity >> shift);
+        }
+    }
+    return ret;
+}
+#endif //DISABLE_NVME_PASSTHROUGH
+
 int report_Zones(tDevice *device, eZoneReportingOptions reportingOptions, bool partial, uint64_t zoneLocator, uint8_t *ptrData, uint32_t dataSize)
 {
     int ret = UNKNOWN;
@@ -1984,6 +2664,13 @@ int report_Zones(tDevice *device, eZoneReportingOptions reportingOptions, bool p
         }
         ret = ata_Report_Zones_Ext(device, reportingOptions, partial, C_CAST(uint16_t, dataSize / LEGACY_DRIVE_SEC_SIZE), zoneLocator, ptrData, dataSize);
         break;
+    case NVME_DRIVE:
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+        ret = nvme_Report_Zones_As_ZBC(device, reportingOptions, partial, zoneLocator, ptrData, dataSize);
+        break;
+#else
+        //rely on SCSI translation
+#endif
     case SCSI_DRIVE:
         ret = scsi_Report_Zones(device, reportingOptions, partial, dataSize, zoneLocator, ptrData);
         break;
@@ -1993,3 +2680,37 @@ int report_Zones(tDevice *device, eZoneReportingOptions reportingOptions, bool p
     }
     return ret;
 }
+
+int zone_Append(tDevice *device, uint64_t zoneID, uint8_t *ptrData, uint32_t dataSize, uint64_t *assignedLBA)
+{
+    int ret = NOT_SUPPORTED;
+    if (!device || !ptrData)
+    {
+        return BAD_PARAMETER;
+    }
+    switch (device->drive_info.drive_type)
+    {
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+    case NVME_DRIVE:
+    {
+        uint32_t logicalBlocks = 0;
+        if (device->drive_info.deviceBlockSize == 0 || dataSize % device->drive_info.deviceBlockSize != 0)
+        {
+            return BAD_PARAMETER;
+        }
+        logicalBlocks = dataSize / device->drive_info.deviceBlockSize;
+        if (logicalBlocks == 0 || logicalBlocks > 65536)
+        {
+            return BAD_PARAMETER;
+        }
+        ret = nvme_Zone_Append(device, zoneID, C_CAST(uint16_t, logicalBlocks - 1), false, ptrData, dataSize, assignedLBA);
+    }
+        break;
+#endif
+    default:
+        //ZBC and ZAC do not have an append command
+        ret = NOT_SUPPORTED;
+        break;
+    }
+    return ret;
+}
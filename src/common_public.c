@@ -10,6 +10,9 @@
 // ******************************************************************************************
 // 
 #include "common_public.h"
+#include "cmds.h"
+#include "scsi_helper_func.h"
+#include "sat_helper_func.h"
 
 #include "platform_helper.h"
 
@@ -160,6 +163,61 @@ bool scan_Interface_Type_Filter(tDevice *device, uint32_t scanFlags)
     return showInterface;
 }
 
+bool scan_Filter_Could_Match(eInterfaceType interfaceType, uint64_t getDeviceFlags)
+{
+    uint32_t scanFlags = C_CAST(uint32_t, getDeviceFlags >> 32);
+    uint32_t driveFilter = scanFlags & ALL_DRIVES;
+    uint32_t interfaceFilter = scanFlags & ALL_INTERFACES;
+    bool couldBeUSB = false;
+    if (interfaceType == UNKNOWN_INTERFACE)
+    {
+        //nothing is known until it's opened
+        return true;
+    }
+    //Not every USB device can be told apart from SCSI by its handle. Discovery moves some of them to USB_INTERFACE once it has the inquiry data
+    //(USB standard descriptor, or a USB vendor ID), so anything that looks like SCSI here may still turn out to be USB.
+    couldBeUSB = interfaceType == USB_INTERFACE || interfaceType == SCSI_INTERFACE;
+    if (interfaceFilter != DEFAULT_SCAN)
+    {
+        if (!((interfaceFilter & USB_INTERFACE_DRIVES && couldBeUSB)
+            || (interfaceFilter & IDE_INTERFACE_DRIVES && interfaceType == IDE_INTERFACE)
+            || (interfaceFilter & SCSI_INTERFACE_DRIVES && interfaceType == SCSI_INTERFACE)
+            || (interfaceFilter & NVME_INTERFACE_DRIVES && interfaceType == NVME_INTERFACE)
+            || (interfaceFilter & RAID_INTERFACE_DRIVES && interfaceType == RAID_INTERFACE)))
+        {
+            return false;
+        }
+    }
+    if (driveFilter != DEFAULT_SCAN)
+    {
+        //The drive type is not known until the device is opened, so this only rules out interfaces that particular drive type is never found on.
+        //Ex: ATA and SCSI drives can be behind a SAS or RAID controller, and USB to NVMe adapters report an NVMe drive on a USB interface.
+        bool couldMatch = false;
+        if (driveFilter & ATA_DRIVES && interfaceType != USB_INTERFACE && interfaceType != NVME_INTERFACE)
+        {
+            couldMatch = true;
+        }
+        if (driveFilter & USB_DRIVES && couldBeUSB)
+        {
+            couldMatch = true;
+        }
+        if (driveFilter & SCSI_DRIVES && interfaceType != NVME_INTERFACE)
+        {
+            couldMatch = true;
+        }
+        if (driveFilter & NVME_DRIVES && (interfaceType == NVME_INTERFACE || couldBeUSB || interfaceType == RAID_INTERFACE))
+        {
+            couldMatch = true;
+        }
+        if (driveFilter & RAID_DRIVES && interfaceType != USB_INTERFACE && interfaceType != NVME_INTERFACE && interfaceType != IDE_INTERFACE)
+        {
+            couldMatch = true;
+        }
+        return couldMatch;
+    }
+    return true;
+}
+
 void write_JSON_To_File(void *customData, char *message)
 {
     FILE *jsonFile = C_CAST(FILE*, customData);
@@ -182,7 +240,7 @@ void scan_And_Print_Devs(unsigned int flags, OutputInfo *outputInfo, eVerbosityL
     uint32_t csmiDeviceCount = 0;
     bool csmiDeviceCountValid = false;
 #endif
-    uint32_t getCountFlags = 0;
+    uint64_t getCountFlags = GET_DEVICE_FUNCS_SCAN_FILTER(flags);
     if (flags & AGRESSIVE_SCAN)
     {
         getCountFlags |= BUS_RESCAN_ALLOWED;
@@ -203,7 +261,7 @@ void scan_And_Print_Devs(unsigned int flags, OutputInfo *outputInfo, eVerbosityL
             memset(&version, 0, sizeof(versionBlock));
             version.size = sizeof(tDevice);
             version.version = DEVICE_BLOCK_VERSION;
-            uint64_t getDeviceflags = FAST_SCAN;
+            uint64_t getDeviceflags = FAST_SCAN | GET_DEVICE_FUNCS_SCAN_FILTER(flags);
 
             //set the verbosity for all devices before the scan
             for (uint32_t devi = 0; devi < deviceCount; ++devi)
@@ -334,13 +392,13 @@ void scan_And_Print_Devs(unsigned int flags, OutputInfo *outputInfo, eVerbosityL
                             for (uint32_t dupCheck = 0; dupCheck < (deviceCount - csmiDeviceCount); ++dupCheck)
                             {
                                 //check if the WWN is valid (non-zero value) and then check if it matches anything else already in the list...this should be faster than the SN comparison below. - TJE
-                                if (deviceList[devIter].drive_info.worldWideName != 0 && deviceList[devIter].drive_info.worldWideName == deviceList[dupCheck].drive_info.worldWideName)
+                                if (get_Device_World_Wide_Name(&deviceList[devIter]) != 0 && get_Device_World_Wide_Name(&deviceList[devIter]) == get_Device_World_Wide_Name(&deviceList[dupCheck]))
                                 {
                                     skipThisDevice = true;
                                     break;
                                 }
                                 //check if the SN is valid (non-zero length) and then check if it matches anything already seen in the list... - TJE
-                                else if (strlen(deviceList[devIter].drive_info.serialNumber) && strcmp(deviceList[devIter].drive_info.serialNumber, deviceList[dupCheck].drive_info.serialNumber) == 0)
+                                else if (strlen(get_Device_Serial_Number(&deviceList[devIter])) && strcmp(get_Device_Serial_Number(&deviceList[devIter]), get_Device_Serial_Number(&deviceList[dupCheck])) == 0)
                                 {
                                     skipThisDevice = true;
                                     break;
@@ -389,7 +447,7 @@ void scan_And_Print_Devs(unsigned int flags, OutputInfo *outputInfo, eVerbosityL
                         }
 #endif
                         char printable_sn[SERIAL_NUM_LEN + 1] = { 0 };
-                        snprintf(printable_sn, SERIAL_NUM_LEN + 1, "%s", deviceList[devIter].drive_info.serialNumber);
+                        snprintf(printable_sn, SERIAL_NUM_LEN + 1, "%s", get_Device_Serial_Number(&deviceList[devIter]));
                         //if seagate scsi, need to truncate to 8 digits
                         if (deviceList[devIter].drive_info.drive_type == SCSI_DRIVE && is_Seagate_Family(&deviceList[devIter]) == SEAGATE)
                         {
@@ -1629,6 +1687,7 @@ eSeagateFamily is_Seagate_Family(tDevice *device)
 }
 bool is_SSD(tDevice *device)
 {
+    fill_Lazy_Device_Info(device, LAZY_INFO_MEDIA_TYPE);
     if (device->drive_info.media_type == MEDIA_NVM || device->drive_info.media_type == MEDIA_SSD)
     {
         return true;
@@ -1639,6 +1698,236 @@ bool is_SSD(tDevice *device)
     }
 }
 
+void invalidate_Lazy_Device_Info(tDevice *device, uint32_t lazyInfo)
+{
+    if (device)
+    {
+        device->drive_info.lazyInfo.pending |= lazyInfo & device->drive_info.lazyInfo.readable;
+        //anything that changes the lazy info also changes what the software SAT translator would report
+        invalidate_Software_SAT_Snapshot(device);
+        invalidate_Translation_Responses(device);
+    }
+}
+
+uint32_t get_Passthrough_Max_Transfer_Length(tDevice *device)
+{
+    uint32_t maxTransfer = 0;
+    switch (device->drive_info.drive_type)
+    {
+    case ATA_DRIVE:
+        maxTransfer = device->drive_info.passThroughHacks.ataPTHacks.maxTransferLength;
+        break;
+    case NVME_DRIVE:
+        maxTransfer = device->drive_info.passThroughHacks.nvmePTHacks.maxTransferLength;
+        break;
+    default:
+        maxTransfer = device->drive_info.passThroughHacks.scsiHacks.maxTransferLength;
+        break;
+    }
+#if defined (_WIN32) && !defined (UEFI_C_SOURCE)
+    if (device->os_info.adapterMaxTransferSize > 0)
+    {
+        maxTransfer = maxTransfer > 0 ? M_Min(maxTransfer, device->os_info.adapterMaxTransferSize) : device->os_info.adapterMaxTransferSize;
+    }
+#endif
+    return maxTransfer;
+}
+
+uint8_t* borrow_Command_Buffer(tDevice *device, uint32_t size)
+{
+    if (size <= COMMAND_BUFFER_POOL_SLOT_SIZE)
+    {
+        uint8_t slotIter = 0;
+        for (; slotIter < COMMAND_BUFFER_POOL_SLOTS; ++slotIter)
+        {
+            if (!(device->cmdBuffers.slotInUse & (UINT64_C(1) << slotIter)))
+            {
+                uint8_t *buffer = device->cmdBuffers.slot[slotIter];
+                if (device->os_info.minimumAlignment > 1 && (C_CAST(uintptr_t, buffer) % device->os_info.minimumAlignment) != 0)
+                {
+                    //the slots are laid out the same, so none of them will meet this alignment
+                    break;
+                }
+                device->cmdBuffers.slotInUse |= (UINT64_C(1) << slotIter);
+                memset(buffer, 0, size);
+                return buffer;
+            }
+        }
+    }
+    return C_CAST(uint8_t*, calloc_aligned(size, sizeof(uint8_t), device->os_info.minimumAlignment));
+}
+
+void return_Command_Buffer(tDevice *device, uint8_t **buffer)
+{
+    if (buffer && *buffer)
+    {
+        uint8_t *poolStart = &device->cmdBuffers.slot[0][0];
+        uint8_t *poolEnd = poolStart + sizeof(device->cmdBuffers.slot);
+        if (*buffer >= poolStart && *buffer < poolEnd)
+        {
+            uint8_t slotIter = C_CAST(uint8_t, C_CAST(size_t, *buffer - poolStart) / COMMAND_BUFFER_POOL_SLOT_SIZE);
+            device->cmdBuffers.slotInUse &= ~(UINT64_C(1) << slotIter);
+            *buffer = NULL;
+        }
+        else
+        {
+            safe_Free_aligned(*buffer)
+        }
+    }
+}
+
+uint32_t begin_Translation_Scratch(tDevice *device)
+{
+    device->translationScratch.depth += 1;
+    return device->translationScratch.used;
+}
+
+void end_Translation_Scratch(tDevice *device, uint32_t mark)
+{
+    translationScratch *scratch = &device->translationScratch;
+    scratch->used = mark;
+    if (scratch->depth > 0)
+    {
+        scratch->depth -= 1;
+    }
+    if (scratch->depth == 0 && scratch->highWaterMark > scratch->size && scratch->size < TRANSLATION_SCRATCH_MAX_SIZE)
+    {
+        //the last translation did not fit, so size it up for the next one. It gets allocated again on the next borrow.
+        safe_Free_aligned(scratch->buffer)
+        scratch->size = M_Min(((scratch->highWaterMark + 4095) / 4096) * 4096, TRANSLATION_SCRATCH_MAX_SIZE);
+        scratch->used = 0;
+        scratch->highWaterMark = 0;
+    }
+}
+
+uint8_t* borrow_Translation_Buffer(tDevice *device, uint32_t size)
+{
+    translationScratch *scratch = &device->translationScratch;
+    if (scratch->depth > 0 && size > 0)
+    {
+        uint32_t alignment = M_Max(device->os_info.minimumAlignment, sizeof(void*));
+        uint32_t offset = ((scratch->used + alignment - 1) / alignment) * alignment;
+        if (!scratch->buffer)
+        {
+            if (scratch->size == 0)
+            {
+                scratch->size = TRANSLATION_SCRATCH_DEFAULT_SIZE;
+            }
+            scratch->buffer = C_CAST(uint8_t*, calloc_aligned(scratch->size, sizeof(uint8_t), device->os_info.minimumAlignment));
+        }
+        if (offset <= UINT32_MAX - size)
+        {
+            scratch->highWaterMark = M_Max(scratch->highWaterMark, offset + size);
+            if (scratch->buffer && (offset + size) <= scratch->size)
+            {
+                uint8_t *buffer = scratch->buffer + offset;
+                scratch->used = offset + size;
+                memset(buffer, 0, size);
+                return buffer;
+            }
+        }
+    }
+    return C_CAST(uint8_t*, calloc_aligned(size, sizeof(uint8_t), device->os_info.minimumAlignment));
+}
+
+void return_Translation_Buffer(tDevice *device, uint8_t **buffer)
+{
+    if (buffer && *buffer)
+    {
+        translationScratch *scratch = &device->translationScratch;
+        if (scratch->buffer && *buffer >= scratch->buffer && *buffer < (scratch->buffer + scratch->size))
+        {
+            //released all at once by end_Translation_Scratch
+            *buffer = NULL;
+        }
+        else
+        {
+            safe_Free_aligned(*buffer)
+        }
+    }
+}
+
+void free_Translation_Scratch(tDevice *device)
+{
+    if (device)
+    {
+        safe_Free_aligned(device->translationScratch.buffer)
+        memset(&device->translationScratch, 0, sizeof(translationScratch));
+        invalidate_Translation_Responses(device);
+    }
+}
+
+bool get_Translation_Response(tDevice *device, uint64_t key, uint8_t *ptrData, uint32_t dataLength, int *result)
+{
+    translationResponseCache *cache = &device->translationResponses;
+    uint8_t entryIter = 0;
+    for (; entryIter < TRANSLATION_RESPONSE_CACHE_ENTRIES; ++entryIter)
+    {
+        if (cache->entriesValid & (UINT32_C(1) << entryIter) && cache->entry[entryIter].key == key)
+        {
+            if (ptrData)
+            {
+                memcpy(ptrData, cache->entry[entryIter].data, M_Min(cache->entry[entryIter].length, dataLength));
+            }
+            if (result)
+            {
+                *result = cache->entry[entryIter].result;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void save_Translation_Response(tDevice *device, uint64_t key, int result, const uint8_t *response, uint32_t length)
+{
+    translationResponseCache *cache = &device->translationResponses;
+    uint8_t entryIter = 0;
+    uint8_t *data = NULL;
+    if (!response || length == 0)
+    {
+        return;
+    }
+    data = C_CAST(uint8_t*, malloc(length));
+    if (!data)
+    {
+        return;
+    }
+    memcpy(data, response, length);
+    //use an empty entry if there is one, otherwise replace the oldest
+    for (; entryIter < TRANSLATION_RESPONSE_CACHE_ENTRIES; ++entryIter)
+    {
+        if (!(cache->entriesValid & (UINT32_C(1) << entryIter)))
+        {
+            break;
+        }
+    }
+    if (entryIter == TRANSLATION_RESPONSE_CACHE_ENTRIES)
+    {
+        entryIter = cache->nextEntry;
+        cache->nextEntry = (cache->nextEntry + 1) % TRANSLATION_RESPONSE_CACHE_ENTRIES;
+        safe_Free(cache->entry[entryIter].data)
+    }
+    cache->entry[entryIter].key = key;
+    cache->entry[entryIter].result = result;
+    cache->entry[entryIter].length = length;
+    cache->entry[entryIter].data = data;
+    cache->entriesValid |= UINT32_C(1) << entryIter;
+}
+
+void invalidate_Translation_Responses(tDevice *device)
+{
+    if (device)
+    {
+        uint8_t entryIter = 0;
+        for (; entryIter < TRANSLATION_RESPONSE_CACHE_ENTRIES; ++entryIter)
+        {
+            safe_Free(device->translationResponses.entry[entryIter].data)
+        }
+        memset(&device->translationResponses, 0, sizeof(translationResponseCache));
+    }
+}
+
 bool is_SATA(tDevice *device)
 {
     if (device->drive_info.drive_type == ATA_DRIVE)
@@ -1966,67 +2255,274 @@ uint64_t align_LBA(tDevice *device, uint64_t LBA)
 }
 
 
-int remove_Duplicate_Devices(tDevice *deviceList, volatile uint32_t * numberOfDevices, removeDuplicateDriveType rmvDevFlag)
+#define DEVICE_IDENTITY_MAX_LENGTH (MODEL_NUM_LEN + SERIAL_NUM_LEN + 8)
+
+typedef enum _eDeviceIdentityType
 {
-    volatile uint32_t i, j;
-    bool sameSlNo = false;
-    int ret = UNKNOWN;
+    DEVICE_IDENTITY_NONE,
+    DEVICE_IDENTITY_NVME_NGUID,
+    DEVICE_IDENTITY_NVME_EUI64,
+    DEVICE_IDENTITY_WWN,
+    DEVICE_IDENTITY_SERIAL_NUMBER,
+}eDeviceIdentityType;
 
+typedef struct _deviceIdentity
+{
+    eDeviceIdentityType type;
+    uint32_t length;
+    uint64_t hash;
+    uint8_t value[DEVICE_IDENTITY_MAX_LENGTH];
+}deviceIdentity;
 
-    /*
-    Go through all the devices in the list. 
-    */
-    for (i = 0; i < *numberOfDevices - 1; i++)
+static bool is_Zero_Identifier(const uint8_t *identifier, uint32_t length)
+{
+    for (uint32_t iter = 0; iter < length; ++iter)
     {
-        /*
-        Go compare it to all the rest of the drives i + 1. 
-        */
-        for (j = i + 1; j < *numberOfDevices; j++)
+        if (identifier[iter] != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void add_To_Device_Identity(deviceIdentity *identity, const void *value, uint32_t length)
+{
+    length = M_Min(length, C_CAST(uint32_t, DEVICE_IDENTITY_MAX_LENGTH) - identity->length);
+    memcpy(&identity->value[identity->length], value, length);
+    identity->length += length;
+}
 
+//Gets the value that is the same on every path to a device.
+static void get_Device_Identity(tDevice *device, deviceIdentity *identity)
+{
+    memset(identity, 0, sizeof(deviceIdentity));
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+    if (device->drive_info.drive_type == NVME_DRIVE)
+    {
+        //namespace identifiers are unique across the whole subsystem, so they match on every controller the namespace is attached to.
+        if (!is_Zero_Identifier(device->drive_info.IdentifyData.nvme.ns.nguid, 16))
         {
-#ifdef _DEBUG
-            printf("%s --> For drive i : %d and j : %d \n", __FUNCTION__, i, j);
+            identity->type = DEVICE_IDENTITY_NVME_NGUID;
+            add_To_Device_Identity(identity, device->drive_info.IdentifyData.nvme.ns.nguid, 16);
+        }
+        else if (!is_Zero_Identifier(device->drive_info.IdentifyData.nvme.ns.eui64, 8))
+        {
+            identity->type = DEVICE_IDENTITY_NVME_EUI64;
+            add_To_Device_Identity(identity, device->drive_info.IdentifyData.nvme.ns.eui64, 8);
+        }
+    }
 #endif
-            ret = SUCCESS;
-            sameSlNo = false;
+    if (identity->type == DEVICE_IDENTITY_NONE && get_Device_World_Wide_Name(device) != 0)
+    {
+        identity->type = DEVICE_IDENTITY_WWN;
+        add_To_Device_Identity(identity, &device->drive_info.worldWideName, sizeof(uint64_t));
+        if (device->drive_info.drive_type == NVME_DRIVE)
+        {
+            add_To_Device_Identity(identity, &device->drive_info.namespaceID, sizeof(uint32_t));
+        }
+    }
+    if (identity->type == DEVICE_IDENTITY_NONE && strlen(get_Device_Serial_Number(device)) > 0)
+    {
+        identity->type = DEVICE_IDENTITY_SERIAL_NUMBER;
+        //vendor is left out since a translator (SAT, RAID driver) may report something different than the native interface does for the same drive
+        add_To_Device_Identity(identity, device->drive_info.product_identification, C_CAST(uint32_t, strlen(device->drive_info.product_identification)));
+        add_To_Device_Identity(identity, "\n", 1);
+        add_To_Device_Identity(identity, device->drive_info.serialNumber, C_CAST(uint32_t, strlen(device->drive_info.serialNumber)));
+        if (device->drive_info.drive_type == NVME_DRIVE)
+        {
+            add_To_Device_Identity(identity, &device->drive_info.namespaceID, sizeof(uint32_t));
+        }
+    }
+    //FNV-1a
+    identity->hash = UINT64_C(14695981039346656037);
+    for (uint32_t iter = 0; iter < identity->length; ++iter)
+    {
+        identity->hash ^= identity->value[iter];
+        identity->hash *= UINT64_C(1099511628211);
+    }
+    identity->hash ^= C_CAST(uint64_t, identity->type);
+}
 
-            if ( ((deviceList + i) && strlen((deviceList + i)->drive_info.serialNumber) > 0) &&
-                 ((deviceList + j) && strlen((deviceList + j)->drive_info.serialNumber) > 0) )
-            {
-                 sameSlNo = (strncmp((deviceList + i)->drive_info.serialNumber,
-                     (deviceList + j)->drive_info.serialNumber,
-                     strlen((deviceList + i)->drive_info.serialNumber)) == 0);
-            }
+static bool is_Same_Device_Identity(deviceIdentity *first, deviceIdentity *second)
+{
+    return first->type != DEVICE_IDENTITY_NONE && first->type == second->type && first->hash == second->hash && first->length == second->length && memcmp(first->value, second->value, first->length) == 0;
+}
 
-            if (sameSlNo)
+void free_Device_Path_Groups(devicePathGroups *pathGroups)
+{
+    if (pathGroups)
+    {
+        if (pathGroups->groups)
+        {
+            //all of the path arrays are carved out of the first group's allocation
+            safe_Free(pathGroups->groups[0].paths)
+        }
+        safe_Free(pathGroups->groups)
+        safe_Free(pathGroups->deviceToGroup)
+        pathGroups->groupCount = 0;
+    }
+}
+
+int group_Device_Paths(tDevice *deviceList, uint32_t numberOfDevices, devicePathGroups *pathGroups)
+{
+    int ret = SUCCESS;
+    deviceIdentity *identities = NULL;
+    uint32_t *hashTable = NULL;
+    uint32_t *groupFirstDevice = NULL;
+    uint32_t *pathStorage = NULL;
+    uint32_t hashTableSize = 1;
+    if (!deviceList || !pathGroups || numberOfDevices == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(pathGroups, 0, sizeof(devicePathGroups));
+    //open addressing table at least twice the number of devices so probe chains stay short
+    while (hashTableSize < numberOfDevices * 2)
+    {
+        hashTableSize <<= 1;
+    }
+    identities = C_CAST(deviceIdentity*, calloc(numberOfDevices, sizeof(deviceIdentity)));
+    hashTable = C_CAST(uint32_t*, malloc(hashTableSize * sizeof(uint32_t)));
+    groupFirstDevice = C_CAST(uint32_t*, calloc(numberOfDevices, sizeof(uint32_t)));
+    pathStorage = C_CAST(uint32_t*, calloc(numberOfDevices, sizeof(uint32_t)));
+    pathGroups->deviceToGroup = C_CAST(uint32_t*, calloc(numberOfDevices, sizeof(uint32_t)));
+    pathGroups->groups = C_CAST(devicePathGroup*, calloc(numberOfDevices, sizeof(devicePathGroup)));
+    if (!identities || !hashTable || !groupFirstDevice || !pathStorage || !pathGroups->deviceToGroup || !pathGroups->groups)
+    {
+        safe_Free(identities)
+        safe_Free(hashTable)
+        safe_Free(groupFirstDevice)
+        safe_Free(pathStorage)
+        safe_Free(pathGroups->deviceToGroup)
+        safe_Free(pathGroups->groups)
+        return MEMORY_FAILURE;
+    }
+    memset(hashTable, 0xFF, hashTableSize * sizeof(uint32_t));//UINT32_MAX = empty slot
+    for (uint32_t deviceIter = 0; deviceIter < numberOfDevices; ++deviceIter)
+    {
+        uint32_t group = UINT32_MAX;
+        get_Device_Identity(&deviceList[deviceIter], &identities[deviceIter]);
+        if (identities[deviceIter].type != DEVICE_IDENTITY_NONE)
+        {
+            uint32_t slot = C_CAST(uint32_t, identities[deviceIter].hash) & (hashTableSize - 1);
+            while (hashTable[slot] != UINT32_MAX)
             {
-#ifdef _DEBUG
-                printf("We have same serial no \n");
-#endif
-#if defined (_WIN32)
-                /* We are supporting csmi only - for now */
-                if (rmvDevFlag.csmi != 0)
+                if (is_Same_Device_Identity(&identities[deviceIter], &identities[groupFirstDevice[hashTable[slot]]]))
                 {
-                    if (is_CSMI_Device(deviceList + i))
-                    {
-                        ret |= remove_Device(deviceList, i, numberOfDevices);
-                        i--;
-                        j--;
-                    }
-
-                    if (is_CSMI_Device(deviceList + j))
-                    {
-                        ret |= remove_Device(deviceList, j, numberOfDevices);
-                        j--;
-                    }
+                    group = hashTable[slot];
+                    break;
                 }
-#else 
-                M_USE_UNUSED(rmvDevFlag);
+                slot = (slot + 1) & (hashTableSize - 1);
+            }
+            if (group == UINT32_MAX)
+            {
+                hashTable[slot] = pathGroups->groupCount;
+            }
+        }
+        if (group == UINT32_MAX)
+        {
+            group = pathGroups->groupCount;
+            groupFirstDevice[group] = deviceIter;
+            ++pathGroups->groupCount;
+        }
+        pathGroups->deviceToGroup[deviceIter] = group;
+        pathGroups->groups[group].pathCount += 1;
+    }
+    //lay out each group's paths in one array, then fill them in device order with the preferred path moved to the front
+    {
+        uint32_t offset = 0;
+        for (uint32_t groupIter = 0; groupIter < pathGroups->groupCount; ++groupIter)
+        {
+            pathGroups->groups[groupIter].paths = &pathStorage[offset];
+            offset += pathGroups->groups[groupIter].pathCount;
+            pathGroups->groups[groupIter].pathCount = 0;
+        }
+    }
+    for (uint32_t deviceIter = 0; deviceIter < numberOfDevices; ++deviceIter)
+    {
+        devicePathGroup *group = &pathGroups->groups[pathGroups->deviceToGroup[deviceIter]];
+        group->paths[group->pathCount] = deviceIter;
+        if (group->pathCount > 0 && is_CSMI_Device(&deviceList[group->paths[0]]) && !is_CSMI_Device(&deviceList[deviceIter]))
+        {
+            group->paths[group->pathCount] = group->paths[0];
+            group->paths[0] = deviceIter;
+        }
+        group->pathCount += 1;
+    }
+    safe_Free(identities)
+    safe_Free(hashTable)
+    safe_Free(groupFirstDevice)
+    return ret;
+}
+
+static void release_Removed_Device(tDevice *device)
+{
+    /*
+     *  TODO - Use close_Handle() rather than free().
+     **/
+    if (is_CSMI_Device(device))
+    {
+        safe_Free(device->raid_device)
+    }
+    free_Translation_Scratch(device);
+}
 
+int remove_Duplicate_Devices(tDevice *deviceList, volatile uint32_t * numberOfDevices, removeDuplicateDriveType rmvDevFlag)
+{
+    int ret = SUCCESS;
+    devicePathGroups pathGroups;
+    uint32_t keptDevices = 0;
+    if (!deviceList || !numberOfDevices)
+    {
+        return BAD_PARAMETER;
+    }
+    if (*numberOfDevices < 2)
+    {
+        return SUCCESS;
+    }
+    ret = group_Device_Paths(deviceList, *numberOfDevices, &pathGroups);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+    //compact the list in one pass instead of shifting the whole list down for each device removed
+    for (uint32_t deviceIter = 0; deviceIter < *numberOfDevices; ++deviceIter)
+    {
+        bool removeDevice = false;
+        devicePathGroup *group = &pathGroups.groups[pathGroups.deviceToGroup[deviceIter]];
+#if defined (_WIN32)
+        /* We are supporting csmi only - for now */
+        if (rmvDevFlag.csmi != 0 && group->pathCount > 1 && group->paths[0] != deviceIter && is_CSMI_Device(&deviceList[deviceIter]))
+        {
+#ifdef _DEBUG
+            printf("Removing Drive with index : %" PRIu32 ". Same device as index %" PRIu32 "\n", deviceIter, group->paths[0]);
 #endif
+            removeDevice = true;
+        }
+#else
+        M_USE_UNUSED(rmvDevFlag);
+        M_USE_UNUSED(group);
+#endif
+        if (removeDevice)
+        {
+            release_Removed_Device(&deviceList[deviceIter]);
+        }
+        else
+        {
+            if (keptDevices != deviceIter)
+            {
+                memcpy(&deviceList[keptDevices], &deviceList[deviceIter], sizeof(tDevice));
             }
+            ++keptDevices;
         }
     }
+    if (keptDevices < *numberOfDevices)
+    {
+        memset(&deviceList[keptDevices], 0, sizeof(tDevice) * (*numberOfDevices - keptDevices));
+    }
+    *numberOfDevices = keptDevices;
+    free_Device_Path_Groups(&pathGroups);
     return ret;
 }
 
@@ -2044,13 +2540,7 @@ int remove_Device(tDevice *deviceList, uint32_t driveToRemoveIdx, volatile uint3
         return ret;
     }
 
-    /*
-     *  TODO - Use close_Handle() rather than free().
-     **/
-    if (is_CSMI_Device(deviceList + driveToRemoveIdx))
-    {
-        free((deviceList + driveToRemoveIdx)->raid_device);
-    }
+    release_Removed_Device(deviceList + driveToRemoveIdx);
 
     for (i = driveToRemoveIdx; i < *numberOfDevices - 1; i++)
     {
@@ -0,0 +1,489 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file copy_offload.c
+// \brief Defines functions to copy LBA ranges within a device, letting the device move the data itself when it can.
+
+#include "copy_offload.h"
+#include "cmds.h"
+#include "scsi_helper_func.h"
+#include "nvme_helper_func.h"
+
+//Position in the list of source ranges. Each copy command takes as much as it can from here and moves it forward by what it copied.
+typedef struct _lbaCopyCursor
+{
+    lbaInterval *ranges;
+    uint32_t rangeCount;
+    uint32_t rangeIndex;
+    uint64_t rangeOffset;
+}lbaCopyCursor;
+
+static bool lba_Copy_Cursor_Done(lbaCopyCursor *cursor)
+{
+    return cursor->rangeIndex >= cursor->rangeCount;
+}
+
+//gets the next piece of up to maxLength LBAs without moving the cursor. Pieces never span two source ranges.
+//To pack several pieces into one command, peek and advance a copy of the cursor, then advance the real cursor by what the device copied.
+static void lba_Copy_Cursor_Peek(lbaCopyCursor *cursor, uint64_t maxLength, uint64_t *lba, uint64_t *length)
+{
+    if (lba_Copy_Cursor_Done(cursor))
+    {
+        *lba = 0;
+        *length = 0;
+        return;
+    }
+    *lba = cursor->ranges[cursor->rangeIndex].startLBA + cursor->rangeOffset;
+    *length = M_Min(cursor->ranges[cursor->rangeIndex].length - cursor->rangeOffset, maxLength);
+}
+
+static void lba_Copy_Cursor_Advance(lbaCopyCursor *cursor, uint64_t lbaCount)
+{
+    while (lbaCount > 0 && cursor->rangeIndex < cursor->rangeCount)
+    {
+        uint64_t step = M_Min(cursor->ranges[cursor->rangeIndex].length - cursor->rangeOffset, lbaCount);
+        cursor->rangeOffset += step;
+        lbaCount -= step;
+        if (cursor->rangeOffset == cursor->ranges[cursor->rangeIndex].length)
+        {
+            cursor->rangeIndex += 1;
+            cursor->rangeOffset = 0;
+        }
+    }
+}
+
+//Copy commands move the data inside the device, but large ones still take a while. Allow the usual 15 seconds plus a second for every
+//LBA_COPY_TIMEOUT_BYTES_PER_SECOND so that a command covering several gigabytes is not aborted while the device is still working on it.
+#define LBA_COPY_TIMEOUT_BYTES_PER_SECOND UINT64_C(104857600)
+static uint32_t get_Copy_Timeout_Seconds(tDevice *device, uint32_t minimumSeconds, uint64_t lbaCount)
+{
+    uint64_t seconds = UINT64_C(15) + (lbaCount * device->drive_info.deviceBlockSize) / LBA_COPY_TIMEOUT_BYTES_PER_SECOND;
+    return C_CAST(uint32_t, M_Min(M_Max(seconds, C_CAST(uint64_t, minimumSeconds)), C_CAST(uint64_t, UINT32_MAX)));
+}
+
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+static int nvme_Copy_LBA_Ranges(tDevice *device, lbaCopyCursor *cursor, uint64_t destinationLBA)
+{
+    int ret = SUCCESS;
+    //copy limits are in the identify namespace data bytes 72 - 78, which are not broken out in the namespace structure
+    uint8_t *namespaceData = C_CAST(uint8_t*, &device->drive_info.IdentifyData.nvme.ns);
+    uint64_t maxSingleSourceRangeLength = M_BytesTo2ByteValue(namespaceData[73], namespaceData[72]);
+    uint64_t maxCopyLength = M_BytesTo4ByteValue(namespaceData[77], namespaceData[76], namespaceData[75], namespaceData[74]);
+    uint32_t maxSourceRanges = C_CAST(uint32_t, namespaceData[78]) + 1;
+    uint8_t *sourceRangeEntries = NULL;
+    if (!(device->drive_info.IdentifyData.nvme.ctrl.oncs & BIT8))
+    {
+        return NOT_SUPPORTED;
+    }
+    //the number of logical blocks in a source range entry is a 0 based 16 bit field
+    if (maxSingleSourceRangeLength == 0 || maxSingleSourceRangeLength > UINT64_C(65536))
+    {
+        maxSingleSourceRangeLength = UINT64_C(65536);
+    }
+    if (maxCopyLength == 0)
+    {
+        maxCopyLength = UINT32_MAX;
+    }
+    sourceRangeEntries = C_CAST(uint8_t*, calloc_aligned(maxSourceRanges * NVME_COPY_SOURCE_RANGE_LENGTH, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!sourceRangeEntries)
+    {
+        return MEMORY_FAILURE;
+    }
+    while (!lba_Copy_Cursor_Done(cursor))
+    {
+        uint32_t entryCount = 0;
+        uint64_t commandLength = 0;
+        lbaCopyCursor packCursor = *cursor;
+        memset(sourceRangeEntries, 0, maxSourceRanges * NVME_COPY_SOURCE_RANGE_LENGTH);
+        //pack as many ranges into the command as the namespace allows
+        while (entryCount < maxSourceRanges && commandLength < maxCopyLength)
+        {
+            uint64_t lba = 0;
+            uint64_t length = 0;
+            uint8_t *entry = &sourceRangeEntries[entryCount * NVME_COPY_SOURCE_RANGE_LENGTH];
+            lba_Copy_Cursor_Peek(&packCursor, M_Min(maxSingleSourceRangeLength, maxCopyLength - commandLength), &lba, &length);
+            if (length == 0)
+            {
+                break;
+            }
+            lba_Copy_Cursor_Advance(&packCursor, length);
+            entry[8] = M_Byte0(lba);
+            entry[9] = M_Byte1(lba);
+            entry[10] = M_Byte2(lba);
+            entry[11] = M_Byte3(lba);
+            entry[12] = M_Byte4(lba);
+            entry[13] = M_Byte5(lba);
+            entry[14] = M_Byte6(lba);
+            entry[15] = M_Byte7(lba);
+            entry[16] = M_Byte0(length - 1);
+            entry[17] = M_Byte1(length - 1);
+            entryCount += 1;
+            commandLength += length;
+        }
+        ret = nvme_Copy(device, destinationLBA, C_CAST(uint8_t, entryCount - 1), 0, false, false, sourceRangeEntries, entryCount * NVME_COPY_SOURCE_RANGE_LENGTH, get_Copy_Timeout_Seconds(device, 0, commandLength));
+        if (ret != SUCCESS)
+        {
+            break;
+        }
+        lba_Copy_Cursor_Advance(cursor, commandLength);
+        destinationLBA += commandLength;
+    }
+    safe_Free_aligned(sourceRangeEntries)
+    return ret;
+}
+#endif //DISABLE_NVME_PASSTHROUGH
+
+#define ROD_TOKEN_LENGTH 512
+#define ROD_RANGE_DESCRIPTOR_LENGTH 16
+#define ROD_COPY_TIMEOUT_SECONDS 60
+#define RRTI_DATA_LENGTH UINT32_C(1024) //header, up to 252 bytes of sense data, and the ROD token
+
+static void set_Block_Device_Range_Descriptor(uint8_t *descriptor, uint64_t lba, uint32_t length)
+{
+    descriptor[0] = M_Byte7(lba);
+    descriptor[1] = M_Byte6(lba);
+    descriptor[2] = M_Byte5(lba);
+    descriptor[3] = M_Byte4(lba);
+    descriptor[4] = M_Byte3(lba);
+    descriptor[5] = M_Byte2(lba);
+    descriptor[6] = M_Byte1(lba);
+    descriptor[7] = M_Byte0(lba);
+    descriptor[8] = M_Byte3(length);
+    descriptor[9] = M_Byte2(length);
+    descriptor[10] = M_Byte1(length);
+    descriptor[11] = M_Byte0(length);
+    descriptor[12] = RESERVED;
+    descriptor[13] = RESERVED;
+    descriptor[14] = RESERVED;
+    descriptor[15] = RESERVED;
+}
+
+//Reads the block device ROD token limits descriptor from the third party copy VPD page
+static int get_ROD_Token_Limits(tDevice *device, uint16_t *maxRangeDescriptors, uint64_t *maxTokenTransferSize)
+{
+    int ret = SUCCESS;
+    uint32_t pageLength = 0;
+    uint8_t *thirdPartyCopy = C_CAST(uint8_t*, calloc_aligned(4096, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!thirdPartyCopy)
+    {
+        return MEMORY_FAILURE;
+    }
+    ret = scsi_Inquiry(device, thirdPartyCopy, 4096, THIRD_PARTY_COPY, true, false);
+    if (ret != SUCCESS || thirdPartyCopy[1] != THIRD_PARTY_COPY)
+    {
+        safe_Free_aligned(thirdPartyCopy)
+        return NOT_SUPPORTED;
+    }
+    ret = NOT_SUPPORTED;
+    pageLength = M_Min(C_CAST(uint32_t, M_BytesTo2ByteValue(thirdPartyCopy[2], thirdPartyCopy[3])) + 4, UINT32_C(4096));
+    for (uint32_t offset = 4; offset + 4 <= pageLength;)
+    {
+        uint16_t descriptorType = M_BytesTo2ByteValue(thirdPartyCopy[offset], thirdPartyCopy[offset + 1]);
+        uint16_t descriptorLength = M_BytesTo2ByteValue(thirdPartyCopy[offset + 2], thirdPartyCopy[offset + 3]);
+        if (descriptorType == 0x0000 && offset + 36 <= pageLength)
+        {
+            uint8_t *limits = &thirdPartyCopy[offset];
+            *maxRangeDescriptors = M_BytesTo2ByteValue(limits[10], limits[11]);
+            *maxTokenTransferSize = M_BytesTo8ByteValue(limits[20], limits[21], limits[22], limits[23], limits[24], limits[25], limits[26], limits[27]);
+            if (*maxRangeDescriptors > 0)
+            {
+                ret = SUCCESS;
+            }
+            break;
+        }
+        offset += 4 + descriptorLength;
+    }
+    safe_Free_aligned(thirdPartyCopy)
+    return ret;
+}
+
+//Gets the transfer count from receive ROD token information. Also copies out the ROD token when rodToken is not NULL.
+static int get_ROD_Token_Information(tDevice *device, uint32_t listIdentifier, uint8_t *rrtiData, uint64_t *transferCount, uint8_t *rodToken)
+{
+    int ret = scsi_Receive_ROD_Token_Information(device, listIdentifier, rrtiData, RRTI_DATA_LENGTH);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+    //copy operation status 01h = completed without errors. 03h and 04h also completed without errors, but with partial ROD token usage or residual data.
+    //Either way the transfer count is smaller than what was asked for, and the caller picks up the rest with the next command.
+    switch (rrtiData[5] & 0x7F)
+    {
+    case 0x01:
+    case 0x03:
+    case 0x04:
+        break;
+    default:
+        return FAILURE;
+    }
+    *transferCount = M_BytesTo8ByteValue(rrtiData[16], rrtiData[17], rrtiData[18], rrtiData[19], rrtiData[20], rrtiData[21], rrtiData[22], rrtiData[23]);
+    if (rodToken)
+    {
+        //sense data, then the ROD token descriptors length, 2 reserved bytes, and the token
+        uint32_t tokenOffset = 32 + rrtiData[13] + 6;
+        if (tokenOffset + ROD_TOKEN_LENGTH > RRTI_DATA_LENGTH)
+        {
+            return FAILURE;
+        }
+        memcpy(rodToken, &rrtiData[tokenOffset], ROD_TOKEN_LENGTH);
+    }
+    return SUCCESS;
+}
+
+static int scsi_Token_Copy_LBA_Ranges(tDevice *device, lbaCopyCursor *cursor, uint64_t destinationLBA)
+{
+    int ret = SUCCESS;
+    uint16_t maxRangeDescriptors = 0;
+    uint64_t maxTokenTransferSize = 0;
+    uint32_t listIdentifier = 0;
+    uint32_t populateTokenLength = 0;
+    uint8_t *populateToken = NULL;
+    uint8_t *writeUsingToken = NULL;
+    uint8_t *rrtiData = NULL;
+    bool firstCommand = true;
+    ret = get_ROD_Token_Limits(device, &maxRangeDescriptors, &maxTokenTransferSize);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+    //Keep each token to what one destination range descriptor can describe
+    if (maxTokenTransferSize == 0 || maxTokenTransferSize > UINT32_MAX)
+    {
+        maxTokenTransferSize = UINT32_MAX;
+    }
+    populateTokenLength = 16 + C_CAST(uint32_t, maxRangeDescriptors) * ROD_RANGE_DESCRIPTOR_LENGTH;
+    populateToken = C_CAST(uint8_t*, calloc_aligned(populateTokenLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+    writeUsingToken = C_CAST(uint8_t*, calloc_aligned(536 + ROD_RANGE_DESCRIPTOR_LENGTH, sizeof(uint8_t), device->os_info.minimumAlignment));
+    rrtiData = C_CAST(uint8_t*, calloc_aligned(RRTI_DATA_LENGTH, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!populateToken || !writeUsingToken || !rrtiData)
+    {
+        safe_Free_aligned(populateToken)
+        safe_Free_aligned(writeUsingToken)
+        safe_Free_aligned(rrtiData)
+        return MEMORY_FAILURE;
+    }
+    while (!lba_Copy_Cursor_Done(cursor))
+    {
+        uint16_t descriptorCount = 0;
+        uint64_t tokenLength = 0;
+        uint64_t representedLength = 0;
+        uint64_t writtenLength = 0;
+        uint32_t parameterLength = 0;
+        lbaCopyCursor packCursor = *cursor;
+        memset(populateToken, 0, populateTokenLength);
+        while (descriptorCount < maxRangeDescriptors && tokenLength < maxTokenTransferSize)
+        {
+            uint64_t lba = 0;
+            uint64_t length = 0;
+            lba_Copy_Cursor_Peek(&packCursor, maxTokenTransferSize - tokenLength, &lba, &length);
+            if (length == 0)
+            {
+                break;
+            }
+            lba_Copy_Cursor_Advance(&packCursor, length);
+            set_Block_Device_Range_Descriptor(&populateToken[16 + descriptorCount * ROD_RANGE_DESCRIPTOR_LENGTH], lba, C_CAST(uint32_t, length));
+            descriptorCount += 1;
+            tokenLength += length;
+        }
+        listIdentifier += 1;
+        parameterLength = 16 + C_CAST(uint32_t, descriptorCount) * ROD_RANGE_DESCRIPTOR_LENGTH;
+        //populate token data length, no immediate, default inactivity timeout and ROD type
+        populateToken[0] = M_Byte1(parameterLength - 2);
+        populateToken[1] = M_Byte0(parameterLength - 2);
+        populateToken[14] = M_Byte1(descriptorCount * ROD_RANGE_DESCRIPTOR_LENGTH);
+        populateToken[15] = M_Byte0(descriptorCount * ROD_RANGE_DESCRIPTOR_LENGTH);
+        ret = scsi_Populate_Token(device, listIdentifier, populateToken, parameterLength, ROD_COPY_TIMEOUT_SECONDS);
+        if (ret != SUCCESS)
+        {
+            uint8_t senseKey = 0;
+            uint8_t asc = 0;
+            uint8_t ascq = 0;
+            uint8_t fru = 0;
+            get_Sense_Key_ASC_ASCQ_FRU(device->drive_info.lastCommandSenseData, SPC3_SENSE_LEN, &senseKey, &asc, &ascq, &fru);
+            if (firstCommand && senseKey == SENSE_KEY_ILLEGAL_REQUEST)
+            {
+                ret = NOT_SUPPORTED;
+            }
+            break;
+        }
+        memset(writeUsingToken, 0, 536 + ROD_RANGE_DESCRIPTOR_LENGTH);
+        ret = get_ROD_Token_Information(device, listIdentifier, rrtiData, &representedLength, &writeUsingToken[16]);
+        if (ret != SUCCESS)
+        {
+            break;
+        }
+        //the device may make a token for less than was asked for
+        representedLength = M_Min(representedLength, tokenLength);
+        if (representedLength == 0)
+        {
+            ret = FAILURE;
+            break;
+        }
+        firstCommand = false;
+        listIdentifier += 1;
+        parameterLength = 536 + ROD_RANGE_DESCRIPTOR_LENGTH;
+        writeUsingToken[0] = M_Byte1(parameterLength - 2);
+        writeUsingToken[1] = M_Byte0(parameterLength - 2);
+        //offset into ROD (bytes 8 - 15) is 0. ROD token is at bytes 16 - 527
+        writeUsingToken[534] = M_Byte1(ROD_RANGE_DESCRIPTOR_LENGTH);
+        writeUsingToken[535] = M_Byte0(ROD_RANGE_DESCRIPTOR_LENGTH);
+        set_Block_Device_Range_Descriptor(&writeUsingToken[536], destinationLBA, C_CAST(uint32_t, representedLength));
+        ret = scsi_Write_Using_Token(device, listIdentifier, writeUsingToken, parameterLength, get_Copy_Timeout_Seconds(device, ROD_COPY_TIMEOUT_SECONDS, representedLength));
+        if (ret != SUCCESS)
+        {
+            break;
+        }
+        ret = get_ROD_Token_Information(device, listIdentifier, rrtiData, &writtenLength, NULL);
+        if (ret != SUCCESS)
+        {
+            break;
+        }
+        writtenLength = M_Min(writtenLength, representedLength);
+        if (writtenLength == 0)
+        {
+            ret = FAILURE;
+            break;
+        }
+        //anything not written is picked up by the next token
+        lba_Copy_Cursor_Advance(cursor, writtenLength);
+        destinationLBA += writtenLength;
+    }
+    safe_Free_aligned(populateToken)
+    safe_Free_aligned(writeUsingToken)
+    safe_Free_aligned(rrtiData)
+    return ret;
+}
+
+static int host_Copy_LBA_Ranges(tDevice *device, lbaCopyCursor *cursor, uint64_t destinationLBA)
+{
+    int ret = SUCCESS;
+    uint32_t chunkBytes = LBA_COPY_HOST_BUFFER_BYTES;
+    uint32_t maxTransfer = get_Passthrough_Max_Transfer_Length(device);
+    uint32_t chunkLBAs = 0;
+    if (maxTransfer > 0)
+    {
+        chunkBytes = M_Min(chunkBytes, maxTransfer);
+    }
+    chunkLBAs = M_Max(chunkBytes / device->drive_info.deviceBlockSize, UINT32_C(1));
+    uint8_t *buffer = C_CAST(uint8_t*, calloc_aligned(C_CAST(size_t, chunkLBAs) * device->drive_info.deviceBlockSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!buffer)
+    {
+        return MEMORY_FAILURE;
+    }
+    while (!lba_Copy_Cursor_Done(cursor))
+    {
+        uint64_t lba = 0;
+        uint64_t length = 0;
+        uint32_t bytes = 0;
+        lba_Copy_Cursor_Peek(cursor, chunkLBAs, &lba, &length);
+        bytes = C_CAST(uint32_t, length * device->drive_info.deviceBlockSize);
+        ret = read_LBA(device, lba, false, buffer, bytes);
+        if (ret != SUCCESS)
+        {
+            break;
+        }
+        ret = write_LBA(device, destinationLBA, false, buffer, bytes);
+        if (ret != SUCCESS)
+        {
+            break;
+        }
+        lba_Copy_Cursor_Advance(cursor, length);
+        destinationLBA += length;
+    }
+    safe_Free_aligned(buffer)
+    return ret;
+}
+
+int copy_LBA_Ranges(tDevice *device, lbaInterval *sourceRanges, uint32_t rangeCount, uint64_t destinationLBA, eLBACopyMethod method, eLBACopyMethod *methodUsed)
+{
+    int ret = NOT_SUPPORTED;
+    lbaCopyCursor cursor;
+    uint64_t totalLength = 0;
+    bool autoMethod = method == LBA_COPY_METHOD_AUTO;
+    if (!device || !sourceRanges || rangeCount == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    fill_Lazy_Device_Info(device, LAZY_INFO_CAPACITY);
+    if (device->drive_info.deviceBlockSize == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    for (uint32_t rangeIter = 0; rangeIter < rangeCount; ++rangeIter)
+    {
+        lbaInterval *range = &sourceRanges[rangeIter];
+        if (range->length == 0 || range->startLBA > device->drive_info.deviceMaxLba || range->length > device->drive_info.deviceMaxLba - range->startLBA + 1)
+        {
+            return BAD_PARAMETER;
+        }
+        totalLength += range->length;
+    }
+    if (destinationLBA > device->drive_info.deviceMaxLba || totalLength > device->drive_info.deviceMaxLba - destinationLBA + 1)
+    {
+        return BAD_PARAMETER;
+    }
+    for (uint32_t rangeIter = 0; rangeIter < rangeCount; ++rangeIter)
+    {
+        //copy commands do not define what happens when the source and destination overlap
+        if (sourceRanges[rangeIter].startLBA < destinationLBA + totalLength && destinationLBA < sourceRanges[rangeIter].startLBA + sourceRanges[rangeIter].length)
+        {
+            return BAD_PARAMETER;
+        }
+    }
+    memset(&cursor, 0, sizeof(lbaCopyCursor));
+    cursor.ranges = sourceRanges;
+    cursor.rangeCount = rangeCount;
+    if (method == LBA_COPY_METHOD_AUTO)
+    {
+        switch (device->drive_info.drive_type)
+        {
+        case NVME_DRIVE:
+            method = LBA_COPY_METHOD_NVME_COPY;
+            break;
+        case SCSI_DRIVE:
+            method = LBA_COPY_METHOD_SCSI_TOKEN;
+            break;
+        default:
+            method = LBA_COPY_METHOD_HOST;
+            break;
+        }
+    }
+    else if ((method == LBA_COPY_METHOD_NVME_COPY && device->drive_info.drive_type != NVME_DRIVE) || (method == LBA_COPY_METHOD_SCSI_TOKEN && device->drive_info.drive_type != SCSI_DRIVE))
+    {
+        return NOT_SUPPORTED;
+    }
+    switch (method)
+    {
+    case LBA_COPY_METHOD_NVME_COPY:
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+        ret = nvme_Copy_LBA_Ranges(device, &cursor, destinationLBA);
+#endif
+        break;
+    case LBA_COPY_METHOD_SCSI_TOKEN:
+        ret = scsi_Token_Copy_LBA_Ranges(device, &cursor, destinationLBA);
+        break;
+    case LBA_COPY_METHOD_HOST:
+        ret = host_Copy_LBA_Ranges(device, &cursor, destinationLBA);
+        break;
+    default:
+        return BAD_PARAMETER;
+    }
+    if (ret == NOT_SUPPORTED && autoMethod && method != LBA_COPY_METHOD_HOST && cursor.rangeIndex == 0 && cursor.rangeOffset == 0)
+    {
+        //nothing has been copied yet, so the host can do all of it
+        method = LBA_COPY_METHOD_HOST;
+        ret = host_Copy_LBA_Ranges(device, &cursor, destinationLBA);
+    }
+    if (methodUsed)
+    {
+        *methodUsed = method;
+    }
+    return ret;
+}
@@ -88,7 +88,7 @@ int send_Cypress_Legacy_Passthrough_Command(tDevice *device, ataPassthroughComma
     bool localSenseData = false;
     if (!ataCommandOptions->ptrSenseData)
     {
-        senseData = C_CAST(uint8_t*, calloc_aligned(SPC3_SENSE_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+        senseData = borrow_Command_Buffer(device, SPC3_SENSE_LEN);
         if (!senseData)
         {
             return MEMORY_FAILURE;
@@ -139,7 +139,7 @@ int send_Cypress_Legacy_Passthrough_Command(tDevice *device, ataPassthroughComma
     memset(device->drive_info.lastCommandSenseData, 0, SPC3_SENSE_LEN);//clear before copying over data
     memcpy(&device->drive_info.lastCommandSenseData[0], &ataCommandOptions->ptrSenseData, M_Min(SPC3_SENSE_LEN, ataCommandOptions->senseDataSize));
     memcpy(&device->drive_info.lastCommandRTFRs, &ataCommandOptions->rtfr, sizeof(ataReturnTFRs));
-    safe_Free_aligned(senseData)
+    return_Command_Buffer(device, &senseData);
     if (localSenseData)
     {
         ataCommandOptions->ptrSenseData = NULL;
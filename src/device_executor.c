@@ -0,0 +1,301 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file device_executor.c
+// \brief Defines the functions to run the same operation on a list of devices at the same time.
+
+#include "device_executor.h"
+
+#if defined (_WIN32)
+#include <windows.h>
+#include <process.h>
+#define EXECUTOR_THREADS_SUPPORTED
+#elif !defined (UEFI_C_SOURCE)
+#include <pthread.h>
+#define EXECUTOR_THREADS_SUPPORTED
+#endif
+
+//Returns a value identifying the host adapter a device is attached to, or -1 when it cannot be determined.
+static int64_t get_Device_Host_Adapter(tDevice *device)
+{
+#if defined (UEFI_C_SOURCE)
+    return C_CAST(int64_t, device->os_info.controllerNum);
+#elif defined (_WIN32)
+    return C_CAST(int64_t, device->os_info.scsi_addr.PortNumber);
+#elif defined (__linux__)
+    if (device->os_info.scsiAddressValid)
+    {
+        return C_CAST(int64_t, device->os_info.scsiAddress.host);
+    }
+    return -1;
+#else
+    M_USE_UNUSED(device);
+    return -1;
+#endif
+}
+
+static void run_Device_Operation(tDevice *device, deviceOperationFunc operation, void *operationData, deviceOperationResult *result)
+{
+    seatimer_t operationTimer;
+    memset(&operationTimer, 0, sizeof(seatimer_t));
+    start_Timer(&operationTimer);
+    result->result = operation(device, operationData);
+    stop_Timer(&operationTimer);
+    result->elapsedNanoseconds = get_Nano_Seconds(operationTimer);
+    result->operationRun = true;
+}
+
+#if defined (EXECUTOR_THREADS_SUPPORTED)
+
+#if defined (_WIN32)
+typedef CRITICAL_SECTION executorLock;
+typedef CONDITION_VARIABLE executorCondition;
+#define executor_Lock_Init(lock) InitializeCriticalSection(lock)
+#define executor_Lock_Destroy(lock) DeleteCriticalSection(lock)
+#define executor_Lock(lock) EnterCriticalSection(lock)
+#define executor_Unlock(lock) LeaveCriticalSection(lock)
+#define executor_Condition_Init(cond) InitializeConditionVariable(cond)
+#define executor_Condition_Destroy(cond)
+#define executor_Condition_Wait(cond, lock) SleepConditionVariableCS(cond, lock, INFINITE)
+#define executor_Condition_Broadcast(cond) WakeAllConditionVariable(cond)
+#else
+typedef pthread_mutex_t executorLock;
+typedef pthread_cond_t executorCondition;
+#define executor_Lock_Init(lock) pthread_mutex_init(lock, NULL)
+#define executor_Lock_Destroy(lock) pthread_mutex_destroy(lock)
+#define executor_Lock(lock) pthread_mutex_lock(lock)
+#define executor_Unlock(lock) pthread_mutex_unlock(lock)
+#define executor_Condition_Init(cond) pthread_cond_init(cond, NULL)
+#define executor_Condition_Destroy(cond) pthread_cond_destroy(cond)
+#define executor_Condition_Wait(cond, lock) pthread_cond_wait(cond, lock)
+#define executor_Condition_Broadcast(cond) pthread_cond_broadcast(cond)
+#endif
+
+typedef struct _deviceExecutor
+{
+    tDevice *deviceList;
+    uint32_t deviceCount;
+    deviceOperationFunc operation;
+    void *operationData;
+    deviceOperationResult *results;
+    uint32_t maxPerHostAdapter;
+    //adapter bookkeeping. adapterIndex maps each device to an entry in adaptersInUse, or UINT32_MAX if it is not limited
+    uint32_t *adapterIndex;
+    uint32_t *adaptersInUse;
+    bool *started;
+    uint32_t remaining;//devices not started yet
+    executorLock lock;
+    executorCondition deviceFinished;
+}deviceExecutor;
+
+//Must hold the lock. Returns the next device that can be started without going over an adapter's limit, or UINT32_MAX if none can right now.
+static uint32_t get_Next_Device(deviceExecutor *executor)
+{
+    uint32_t deviceIter = 0;
+    for (; deviceIter < executor->deviceCount; ++deviceIter)
+    {
+        if (!executor->started[deviceIter])
+        {
+            uint32_t adapter = executor->adapterIndex[deviceIter];
+            if (adapter == UINT32_MAX || executor->adaptersInUse[adapter] < executor->maxPerHostAdapter)
+            {
+                return deviceIter;
+            }
+        }
+    }
+    return UINT32_MAX;
+}
+
+static void device_Executor_Worker(deviceExecutor *executor)
+{
+    executor_Lock(&executor->lock);
+    while (executor->remaining > 0)
+    {
+        uint32_t deviceNumber = get_Next_Device(executor);
+        if (deviceNumber == UINT32_MAX)
+        {
+            //every device left is on an adapter that is already at its limit. Wait for one of them to finish.
+            executor_Condition_Wait(&executor->deviceFinished, &executor->lock);
+            continue;
+        }
+        executor->started[deviceNumber] = true;
+        executor->remaining -= 1;
+        if (executor->adapterIndex[deviceNumber] != UINT32_MAX)
+        {
+            executor->adaptersInUse[executor->adapterIndex[deviceNumber]] += 1;
+        }
+        executor_Unlock(&executor->lock);
+
+        run_Device_Operation(&executor->deviceList[deviceNumber], executor->operation, executor->operationData, &executor->results[deviceNumber]);
+
+        executor_Lock(&executor->lock);
+        if (executor->adapterIndex[deviceNumber] != UINT32_MAX)
+        {
+            executor->adaptersInUse[executor->adapterIndex[deviceNumber]] -= 1;
+            executor_Condition_Broadcast(&executor->deviceFinished);
+        }
+    }
+    executor_Unlock(&executor->lock);
+}
+
+#if defined (_WIN32)
+//started with _beginthreadex rather than CreateThread since operations use the C runtime
+static unsigned __stdcall device_Executor_Thread(void *executor)
+{
+    device_Executor_Worker(C_CAST(deviceExecutor*, executor));
+    return 0;
+}
+#else
+static void* device_Executor_Thread(void *executor)
+{
+    device_Executor_Worker(C_CAST(deviceExecutor*, executor));
+    return NULL;
+}
+#endif
+
+#endif //EXECUTOR_THREADS_SUPPORTED
+
+int run_Operation_On_Devices(tDevice *deviceList, uint32_t deviceCount, deviceOperationFunc operation, void *operationData, deviceExecutorOptions *options, deviceOperationResult *results)
+{
+    int ret = SUCCESS;
+    if (!deviceList || !operation || !results || deviceCount == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(results, 0, sizeof(deviceOperationResult) * deviceCount);
+#if defined (EXECUTOR_THREADS_SUPPORTED)
+    {
+        deviceExecutor executor;
+        uint32_t maxWorkers = DEVICE_EXECUTOR_DEFAULT_WORKERS;
+        uint32_t workerCount = 0;
+        uint32_t threadsStarted = 0;
+        uint32_t adapterCount = 0;
+        int64_t *adapters = NULL;
+    #if defined (_WIN32)
+        HANDLE *workers = NULL;
+    #else
+        pthread_t *workers = NULL;
+    #endif
+        memset(&executor, 0, sizeof(deviceExecutor));
+        executor.deviceList = deviceList;
+        executor.deviceCount = deviceCount;
+        executor.operation = operation;
+        executor.operationData = operationData;
+        executor.results = results;
+        executor.remaining = deviceCount;
+        executor.maxPerHostAdapter = DEVICE_EXECUTOR_DEFAULT_PER_ADAPTER;
+        if (options)
+        {
+            if (options->maxWorkers > 0)
+            {
+                maxWorkers = options->maxWorkers;
+            }
+            if (options->maxPerHostAdapter > 0)
+            {
+                executor.maxPerHostAdapter = options->maxPerHostAdapter;
+            }
+        }
+        workerCount = M_Min(maxWorkers, deviceCount);
+        executor.adapterIndex = C_CAST(uint32_t*, calloc(deviceCount, sizeof(uint32_t)));
+        executor.adaptersInUse = C_CAST(uint32_t*, calloc(deviceCount, sizeof(uint32_t)));
+        executor.started = C_CAST(bool*, calloc(deviceCount, sizeof(bool)));
+        adapters = C_CAST(int64_t*, calloc(deviceCount, sizeof(int64_t)));
+    #if defined (_WIN32)
+        workers = C_CAST(HANDLE*, calloc(workerCount, sizeof(HANDLE)));
+    #else
+        workers = C_CAST(pthread_t*, calloc(workerCount, sizeof(pthread_t)));
+    #endif
+        if (!executor.adapterIndex || !executor.adaptersInUse || !executor.started || !adapters || !workers)
+        {
+            safe_Free(executor.adapterIndex)
+            safe_Free(executor.adaptersInUse)
+            safe_Free(executor.started)
+            safe_Free(adapters)
+            safe_Free(workers)
+            return MEMORY_FAILURE;
+        }
+        //give each distinct adapter an index so the in use counts can be kept in a flat array
+        for (uint32_t deviceIter = 0; deviceIter < deviceCount; ++deviceIter)
+        {
+            int64_t adapter = get_Device_Host_Adapter(&deviceList[deviceIter]);
+            executor.adapterIndex[deviceIter] = UINT32_MAX;
+            if (adapter >= 0 && executor.maxPerHostAdapter != UINT32_MAX)
+            {
+                uint32_t adapterIter = 0;
+                for (; adapterIter < adapterCount; ++adapterIter)
+                {
+                    if (adapters[adapterIter] == adapter)
+                    {
+                        break;
+                    }
+                }
+                if (adapterIter == adapterCount)
+                {
+                    adapters[adapterCount] = adapter;
+                    ++adapterCount;
+                }
+                executor.adapterIndex[deviceIter] = adapterIter;
+            }
+        }
+        safe_Free(adapters)
+        executor_Lock_Init(&executor.lock);
+        executor_Condition_Init(&executor.deviceFinished);
+        for (; threadsStarted < workerCount; ++threadsStarted)
+        {
+    #if defined (_WIN32)
+            workers[threadsStarted] = C_CAST(HANDLE, _beginthreadex(NULL, 0, device_Executor_Thread, &executor, 0, NULL));
+            if (!workers[threadsStarted])
+            {
+                break;
+            }
+    #else
+            if (0 != pthread_create(&workers[threadsStarted], NULL, device_Executor_Thread, &executor))
+            {
+                break;
+            }
+    #endif
+        }
+        if (threadsStarted == 0)
+        {
+            //could not start any threads, so do the work on this one.
+            device_Executor_Worker(&executor);
+        }
+        for (uint32_t workerIter = 0; workerIter < threadsStarted; ++workerIter)
+        {
+    #if defined (_WIN32)
+            WaitForSingleObject(workers[workerIter], INFINITE);
+            CloseHandle(workers[workerIter]);
+    #else
+            pthread_join(workers[workerIter], NULL);
+    #endif
+        }
+        executor_Condition_Destroy(&executor.deviceFinished);
+        executor_Lock_Destroy(&executor.lock);
+        safe_Free(executor.adapterIndex)
+        safe_Free(executor.adaptersInUse)
+        safe_Free(executor.started)
+        safe_Free(workers)
+    }
+#else
+    for (uint32_t deviceIter = 0; deviceIter < deviceCount; ++deviceIter)
+    {
+        run_Device_Operation(&deviceList[deviceIter], operation, operationData, &results[deviceIter]);
+    }
+#endif
+    for (uint32_t deviceIter = 0; deviceIter < deviceCount; ++deviceIter)
+    {
+        if (!results[deviceIter].operationRun)
+        {
+            ret = FAILURE;
+            break;
+        }
+    }
+    return ret;
+}
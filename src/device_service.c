@@ -0,0 +1,669 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file device_service.c
+// \brief Defines a service that keeps a device list open and handles passthrough requests from other processes over a local socket.
+
+#include "device_service.h"
+#include "cmds.h"
+#include "scsi_helper_func.h"
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+#include "nvme_helper_func.h"
+#endif
+
+#if !defined (_WIN32) && !defined (UEFI_C_SOURCE)
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define DEVICE_SERVICE_SUPPORTED
+#endif
+
+#if defined (DEVICE_SERVICE_SUPPORTED)
+
+#if defined (MSG_NOSIGNAL)
+#define DEVICE_SERVICE_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define DEVICE_SERVICE_SEND_FLAGS 0
+#endif
+
+static bool read_Full(int socketDescriptor, void *buffer, size_t length)
+{
+    uint8_t *ptr = C_CAST(uint8_t*, buffer);
+    while (length > 0)
+    {
+        ssize_t bytesRead = recv(socketDescriptor, ptr, length, 0);
+        if (bytesRead < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (bytesRead <= 0)
+        {
+            return false;
+        }
+        ptr += bytesRead;
+        length -= C_CAST(size_t, bytesRead);
+    }
+    return true;
+}
+
+static bool write_Full(int socketDescriptor, const void *buffer, size_t length)
+{
+    const uint8_t *ptr = C_CAST(const uint8_t*, buffer);
+    while (length > 0)
+    {
+        ssize_t bytesWritten = send(socketDescriptor, ptr, length, DEVICE_SERVICE_SEND_FLAGS);
+        if (bytesWritten < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (bytesWritten <= 0)
+        {
+            return false;
+        }
+        ptr += bytesWritten;
+        length -= C_CAST(size_t, bytesWritten);
+    }
+    return true;
+}
+
+static bool set_Socket_Path(struct sockaddr_un *address, const char *socketPath)
+{
+    memset(address, 0, sizeof(struct sockaddr_un));
+    address->sun_family = AF_UNIX;
+    if (strlen(socketPath) >= sizeof(address->sun_path))
+    {
+        return false;
+    }
+    snprintf(address->sun_path, sizeof(address->sun_path), "%s", socketPath);
+    return true;
+}
+
+//Removes a socket left behind by an earlier service. Anything at the path that is not a socket is left alone.
+static bool remove_Stale_Socket(const char *socketPath)
+{
+    struct stat socketStat;
+    memset(&socketStat, 0, sizeof(struct stat));
+    if (0 != lstat(socketPath, &socketStat))
+    {
+        return errno == ENOENT;
+    }
+    if (!S_ISSOCK(socketStat.st_mode))
+    {
+        return false;
+    }
+    return 0 == unlink(socketPath) || errno == ENOENT;
+}
+
+//Each read and write to a client gives up after this long, so a client that stops partway through a request or stops reading its response
+//only holds up the other clients (and a stop request) for this long before it is disconnected.
+static void set_Client_Timeouts(int socketDescriptor)
+{
+    struct timeval timeout;
+    memset(&timeout, 0, sizeof(struct timeval));
+    timeout.tv_sec = DEVICE_SERVICE_CLIENT_IO_TIMEOUT_SECONDS;
+    setsockopt(socketDescriptor, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(struct timeval));
+    setsockopt(socketDescriptor, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(struct timeval));
+}
+
+static void no_SIGPIPE(int socketDescriptor)
+{
+#if defined (SO_NOSIGPIPE)
+    int on = 1;
+    setsockopt(socketDescriptor, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#else
+    M_USE_UNUSED(socketDescriptor);
+#endif
+}
+
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+//Opcode bits 1:0 give the data direction of every NVMe command, including vendor unique ones.
+static eDataTransferDirection get_NVMe_Opcode_Direction(uint8_t opcode)
+{
+    switch (opcode & 0x03)
+    {
+    case 0:
+        return XFER_NO_DATA;
+    case 1:
+        return XFER_DATA_OUT;
+    case 2:
+        return XFER_DATA_IN;
+    default:
+        return XFER_DATA_IN_OUT;
+    }
+}
+#endif
+
+//Sense data is trimmed to the length the device reported so that a good status does not send 252 bytes of zeros back to the client.
+static uint32_t get_Returned_Sense_Length(uint8_t *senseData)
+{
+    switch (senseData[0] & 0x7F)
+    {
+    case SCSI_SENSE_CUR_INFO_FIXED:
+    case SCSI_SENSE_DEFER_ERR_FIXED:
+    case SCSI_SENSE_CUR_INFO_DESC:
+    case SCSI_SENSE_DEFER_ERR_DESC:
+        return M_Min(C_CAST(uint32_t, senseData[7]) + UINT32_C(8), SPC3_SENSE_LEN);
+    default:
+        return 0;
+    }
+}
+
+static void fill_Device_Service_Entry(tDevice *device, deviceServiceEntry *entry)
+{
+    memset(entry, 0, sizeof(deviceServiceEntry));
+    snprintf(entry->name, sizeof(entry->name), "%s", device->os_info.name);
+    snprintf(entry->friendlyName, sizeof(entry->friendlyName), "%s", device->os_info.friendlyName);
+    snprintf(entry->vendor, sizeof(entry->vendor), "%s", device->drive_info.T10_vendor_ident);
+    snprintf(entry->model, sizeof(entry->model), "%s", device->drive_info.product_identification);
+    snprintf(entry->serialNumber, sizeof(entry->serialNumber), "%s", get_Device_Serial_Number(device));
+    snprintf(entry->firmwareRevision, sizeof(entry->firmwareRevision), "%s", device->drive_info.product_revision);
+    entry->driveType = C_CAST(uint32_t, device->drive_info.drive_type);
+    entry->interfaceType = C_CAST(uint32_t, device->drive_info.interface_type);
+    entry->maxLBA = device->drive_info.deviceMaxLba;
+    entry->logicalBlockSize = device->drive_info.deviceBlockSize;
+    entry->physicalBlockSize = device->drive_info.devicePhyBlockSize;
+}
+
+//Reads one request from the client, runs it, and sends back the response.
+//Returns false when the connection should be closed (client hung up or sent something that is not a valid request).
+static bool handle_Device_Service_Request(int client, tDevice *deviceList, uint32_t deviceCount)
+{
+    deviceServiceRequestHeader request;
+    deviceServiceResponseHeader response;
+    uint8_t senseData[SPC3_SENSE_LEN] = { 0 };
+    uint8_t *data = NULL;
+    bool connectionGood = true;
+    memset(&request, 0, sizeof(deviceServiceRequestHeader));
+    memset(&response, 0, sizeof(deviceServiceResponseHeader));
+    if (!read_Full(client, &request, sizeof(deviceServiceRequestHeader)))
+    {
+        return false;
+    }
+    if (request.magic != DEVICE_SERVICE_MAGIC || request.version != DEVICE_SERVICE_PROTOCOL_VERSION || request.dataLength > DEVICE_SERVICE_MAX_DATA_LENGTH)
+    {
+        //cannot trust anything else in the header, so there is no way to get back in sync with this client
+        return false;
+    }
+    response.magic = DEVICE_SERVICE_MAGIC;
+    response.result = SUCCESS;
+    if (request.dataLength > 0)
+    {
+        uint8_t alignment = request.deviceIndex < deviceCount ? deviceList[request.deviceIndex].os_info.minimumAlignment : 0;
+        data = C_CAST(uint8_t*, calloc_aligned(request.dataLength, sizeof(uint8_t), alignment));
+        if (!data)
+        {
+            return false;
+        }
+    }
+    //any data-out is read before looking at the request so that the next header is found where the client put it, even for requests that do not use the data
+    if (request.direction == XFER_DATA_OUT && request.dataLength > 0 && !read_Full(client, data, request.dataLength))
+    {
+        safe_Free_aligned(data)
+        return false;
+    }
+    if (request.request == DEVICE_SERVICE_REQUEST_LIST_DEVICES)
+    {
+        deviceServiceEntry *entries = NULL;
+        safe_Free_aligned(data)
+        entries = C_CAST(deviceServiceEntry*, calloc(M_Max(deviceCount, UINT32_C(1)), sizeof(deviceServiceEntry)));
+        if (!entries)
+        {
+            response.result = MEMORY_FAILURE;
+            return write_Full(client, &response, sizeof(deviceServiceResponseHeader));
+        }
+        for (uint32_t deviceIter = 0; deviceIter < deviceCount; ++deviceIter)
+        {
+            fill_Device_Service_Entry(&deviceList[deviceIter], &entries[deviceIter]);
+        }
+        response.dataLength = C_CAST(uint32_t, deviceCount * sizeof(deviceServiceEntry));
+        connectionGood = write_Full(client, &response, sizeof(deviceServiceResponseHeader)) && write_Full(client, entries, response.dataLength);
+        safe_Free(entries)
+        return connectionGood;
+    }
+    if (request.deviceIndex >= deviceCount)
+    {
+        response.result = BAD_PARAMETER;
+    }
+    else if (request.direction != XFER_NO_DATA && request.direction != XFER_DATA_IN && request.direction != XFER_DATA_OUT)
+    {
+        response.result = NOT_SUPPORTED;
+    }
+    else if ((request.direction == XFER_NO_DATA) != (request.dataLength == 0))
+    {
+        response.result = BAD_PARAMETER;
+    }
+    else
+    {
+        tDevice *device = &deviceList[request.deviceIndex];
+        switch (request.request)
+        {
+        case DEVICE_SERVICE_REQUEST_SCSI_PASSTHROUGH:
+            if (request.commandLength == 0 || request.commandLength > CDB_LEN_32)
+            {
+                response.result = BAD_PARAMETER;
+                break;
+            }
+            response.result = scsi_Send_Cdb(device, request.command, C_CAST(eCDBLen, request.commandLength), data, request.dataLength, C_CAST(eDataTransferDirection, request.direction), senseData, SPC3_SENSE_LEN, request.timeoutSeconds);
+            response.senseLength = get_Returned_Sense_Length(senseData);
+            break;
+        case DEVICE_SERVICE_REQUEST_NVME_PASSTHROUGH:
+    #if !defined (DISABLE_NVME_PASSTHROUGH)
+            if (device->drive_info.drive_type != NVME_DRIVE)
+            {
+                response.result = NOT_SUPPORTED;
+                break;
+            }
+            else
+            {
+                nvmeCmdCtx nvmeCommand;
+                memset(&nvmeCommand, 0, sizeof(nvmeCmdCtx));
+                memcpy(&nvmeCommand.cmd, request.command, M_Min(sizeof(nvmeCommands), DEVICE_SERVICE_COMMAND_LENGTH));
+                if (get_NVMe_Opcode_Direction(nvmeCommand.cmd.adminCmd.opcode) != C_CAST(eDataTransferDirection, request.direction))
+                {
+                    //the driver moves data based on the opcode, so a request that disagrees with it could overrun the buffer
+                    response.result = BAD_PARAMETER;
+                    break;
+                }
+                nvmeCommand.commandType = request.nvmeCommandType == NVM_ADMIN_CMD ? NVM_ADMIN_CMD : NVM_CMD;
+                //never pass pointers from another process on to the driver. Data only moves through the service's own buffer and metadata is not supported.
+                if (nvmeCommand.commandType == NVM_ADMIN_CMD)
+                {
+                    nvmeCommand.cmd.adminCmd.metadata = 0;
+                    nvmeCommand.cmd.adminCmd.metadataLen = 0;
+                    nvmeCommand.cmd.adminCmd.addr = C_CAST(uint64_t, C_CAST(uintptr_t, data));
+                    nvmeCommand.cmd.adminCmd.empty = 0;
+                }
+                else
+                {
+                    nvmeCommand.cmd.nvmCmd.metadata = 0;
+                    nvmeCommand.cmd.nvmCmd.prp1 = 0;
+                    nvmeCommand.cmd.nvmCmd.prp2 = 0;
+                }
+                nvmeCommand.commandDirection = C_CAST(eDataTransferDirection, request.direction);
+                nvmeCommand.ptrData = data;
+                nvmeCommand.dataSize = request.dataLength;
+                nvmeCommand.timeout = request.timeoutSeconds;
+                response.result = nvme_Cmd(device, &nvmeCommand);
+                response.nvmeCommandSpecific = device->drive_info.lastNVMeResult.lastNVMeCommandSpecific;
+                response.nvmeStatus = device->drive_info.lastNVMeResult.lastNVMeStatus;
+            }
+    #else
+            response.result = NOT_SUPPORTED;
+    #endif
+            break;
+        default:
+            response.result = NOT_SUPPORTED;
+            break;
+        }
+        response.commandTimeNanoseconds = device->drive_info.lastCommandTimeNanoSeconds;
+    }
+    if (request.direction == XFER_DATA_IN)
+    {
+        //always return the whole buffer so the client knows how much to read, even if the command failed.
+        response.dataLength = request.dataLength;
+    }
+    connectionGood = write_Full(client, &response, sizeof(deviceServiceResponseHeader));
+    if (connectionGood && response.senseLength > 0)
+    {
+        connectionGood = write_Full(client, senseData, response.senseLength);
+    }
+    if (connectionGood && response.dataLength > 0)
+    {
+        connectionGood = write_Full(client, data, response.dataLength);
+    }
+    safe_Free_aligned(data)
+    return connectionGood;
+}
+
+#endif //DEVICE_SERVICE_SUPPORTED
+
+int run_Device_Service(const char *socketPath, tDevice *deviceList, uint32_t deviceCount, volatile bool *stopService)
+{
+#if defined (DEVICE_SERVICE_SUPPORTED)
+    struct sockaddr_un address;
+    struct pollfd fds[DEVICE_SERVICE_MAX_CLIENTS + 1];
+    nfds_t clientCount = 0;
+    int listener = -1;
+    if (!socketPath || !stopService || (!deviceList && deviceCount > 0))
+    {
+        return BAD_PARAMETER;
+    }
+    if (!set_Socket_Path(&address, socketPath))
+    {
+        return BAD_PARAMETER;
+    }
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0)
+    {
+        return FAILURE;
+    }
+    if (!remove_Stale_Socket(socketPath))
+    {
+        close(listener);
+        return FAILURE;
+    }
+    if (0 != bind(listener, C_CAST(struct sockaddr*, &address), sizeof(struct sockaddr_un)))
+    {
+        close(listener);
+        return FAILURE;
+    }
+    //anyone who can connect can send any command to any device, so only allow the owner of the service.
+    //Nobody can connect until listen() is called, so there is no window where the socket is open to others.
+    if (0 != chmod(socketPath, S_IRUSR | S_IWUSR) || 0 != listen(listener, DEVICE_SERVICE_MAX_CLIENTS))
+    {
+        close(listener);
+        remove_Stale_Socket(socketPath);
+        return FAILURE;
+    }
+    memset(fds, 0, sizeof(fds));
+    fds[0].fd = listener;
+    fds[0].events = POLLIN;
+    while (!*stopService)
+    {
+        int ready = poll(fds, clientCount + 1, 500);
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+        if (ready == 0)
+        {
+            continue;
+        }
+        //walk clients backwards so that removing one by moving the last entry into its place does not skip anyone
+        for (nfds_t clientIter = clientCount; clientIter > 0 && !*stopService; --clientIter)
+        {
+            if (fds[clientIter].revents == 0)
+            {
+                continue;
+            }
+            if ((fds[clientIter].revents & POLLIN) == 0 || !handle_Device_Service_Request(fds[clientIter].fd, deviceList, deviceCount))
+            {
+                close(fds[clientIter].fd);
+                fds[clientIter] = fds[clientCount];
+                memset(&fds[clientCount], 0, sizeof(struct pollfd));
+                --clientCount;
+            }
+        }
+        if (fds[0].revents & POLLIN)
+        {
+            int client = accept(listener, NULL, NULL);
+            if (client >= 0)
+            {
+                if (clientCount < DEVICE_SERVICE_MAX_CLIENTS)
+                {
+                    no_SIGPIPE(client);
+                    set_Client_Timeouts(client);
+                    ++clientCount;
+                    fds[clientCount].fd = client;
+                    fds[clientCount].events = POLLIN;
+                    fds[clientCount].revents = 0;
+                }
+                else
+                {
+                    close(client);
+                }
+            }
+        }
+    }
+    for (nfds_t clientIter = 1; clientIter <= clientCount; ++clientIter)
+    {
+        close(fds[clientIter].fd);
+    }
+    close(listener);
+    remove_Stale_Socket(socketPath);
+    return SUCCESS;
+#else
+    M_USE_UNUSED(socketPath);
+    M_USE_UNUSED(deviceList);
+    M_USE_UNUSED(deviceCount);
+    M_USE_UNUSED(stopService);
+    return NOT_SUPPORTED;
+#endif
+}
+
+int connect_Device_Service(const char *socketPath, int *serviceSocket)
+{
+#if defined (DEVICE_SERVICE_SUPPORTED)
+    struct sockaddr_un address;
+    int connection = -1;
+    if (!socketPath || !serviceSocket || !set_Socket_Path(&address, socketPath))
+    {
+        return BAD_PARAMETER;
+    }
+    connection = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (connection < 0)
+    {
+        return FAILURE;
+    }
+    if (0 != connect(connection, C_CAST(struct sockaddr*, &address), sizeof(struct sockaddr_un)))
+    {
+        close(connection);
+        return FAILURE;
+    }
+    no_SIGPIPE(connection);
+    *serviceSocket = connection;
+    return SUCCESS;
+#else
+    M_USE_UNUSED(socketPath);
+    M_USE_UNUSED(serviceSocket);
+    return NOT_SUPPORTED;
+#endif
+}
+
+void disconnect_Device_Service(int serviceSocket)
+{
+#if defined (DEVICE_SERVICE_SUPPORTED)
+    if (serviceSocket >= 0)
+    {
+        close(serviceSocket);
+    }
+#else
+    M_USE_UNUSED(serviceSocket);
+#endif
+}
+
+#if defined (DEVICE_SERVICE_SUPPORTED)
+//Sends a request and reads the response header and sense data. The caller reads any data that follows.
+static int device_Service_Transaction(int serviceSocket, deviceServiceRequestHeader *request, uint8_t *dataOut, deviceServiceResponseHeader *response, uint8_t *senseData, uint32_t senseDataLength)
+{
+    request->magic = DEVICE_SERVICE_MAGIC;
+    request->version = DEVICE_SERVICE_PROTOCOL_VERSION;
+    if (!write_Full(serviceSocket, request, sizeof(deviceServiceRequestHeader)))
+    {
+        return FAILURE;
+    }
+    if (request->direction == XFER_DATA_OUT && request->dataLength > 0 && !write_Full(serviceSocket, dataOut, request->dataLength))
+    {
+        return FAILURE;
+    }
+    if (!read_Full(serviceSocket, response, sizeof(deviceServiceResponseHeader)) || response->magic != DEVICE_SERVICE_MAGIC || response->senseLength > SPC3_SENSE_LEN)
+    {
+        return FAILURE;
+    }
+    if (response->senseLength > 0)
+    {
+        uint8_t sense[SPC3_SENSE_LEN] = { 0 };
+        if (!read_Full(serviceSocket, sense, response->senseLength))
+        {
+            return FAILURE;
+        }
+        if (senseData && senseDataLength > 0)
+        {
+            memcpy(senseData, sense, M_Min(senseDataLength, response->senseLength));
+        }
+    }
+    return SUCCESS;
+}
+
+//Reads the data phase of a response into pdata. Anything beyond pdataLength is read and thrown away to stay in sync with the service.
+static int device_Service_Read_Data(int serviceSocket, uint32_t responseLength, uint8_t *pdata, uint32_t pdataLength)
+{
+    uint32_t copyLength = M_Min(responseLength, pdataLength);
+    if (copyLength > 0 && !read_Full(serviceSocket, pdata, copyLength))
+    {
+        return FAILURE;
+    }
+    responseLength -= copyLength;
+    while (responseLength > 0)
+    {
+        uint8_t discard[512];
+        uint32_t discardLength = M_Min(responseLength, C_CAST(uint32_t, sizeof(discard)));
+        if (!read_Full(serviceSocket, discard, discardLength))
+        {
+            return FAILURE;
+        }
+        responseLength -= discardLength;
+    }
+    return SUCCESS;
+}
+#endif //DEVICE_SERVICE_SUPPORTED
+
+int device_Service_Get_Device_List(int serviceSocket, deviceServiceEntry *entries, uint32_t maxEntries, uint32_t *deviceCount)
+{
+#if defined (DEVICE_SERVICE_SUPPORTED)
+    deviceServiceRequestHeader request;
+    deviceServiceResponseHeader response;
+    int ret = SUCCESS;
+    if (!deviceCount || (!entries && maxEntries > 0))
+    {
+        return BAD_PARAMETER;
+    }
+    memset(&request, 0, sizeof(deviceServiceRequestHeader));
+    memset(&response, 0, sizeof(deviceServiceResponseHeader));
+    request.request = DEVICE_SERVICE_REQUEST_LIST_DEVICES;
+    request.direction = XFER_DATA_IN;
+    ret = device_Service_Transaction(serviceSocket, &request, NULL, &response, NULL, 0);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+    *deviceCount = C_CAST(uint32_t, response.dataLength / sizeof(deviceServiceEntry));
+    ret = device_Service_Read_Data(serviceSocket, response.dataLength, C_CAST(uint8_t*, entries), C_CAST(uint32_t, maxEntries * sizeof(deviceServiceEntry)));
+    if (ret == SUCCESS)
+    {
+        ret = response.result;
+    }
+    return ret;
+#else
+    M_USE_UNUSED(serviceSocket);
+    M_USE_UNUSED(entries);
+    M_USE_UNUSED(maxEntries);
+    M_USE_UNUSED(deviceCount);
+    return NOT_SUPPORTED;
+#endif
+}
+
+int device_Service_SCSI_Passthrough(int serviceSocket, uint32_t deviceIndex, uint8_t *cdb, uint8_t cdbLength, uint8_t *pdata, uint32_t dataLength, eDataTransferDirection direction, uint8_t *senseData, uint32_t senseDataLength, uint32_t timeoutSeconds)
+{
+#if defined (DEVICE_SERVICE_SUPPORTED)
+    deviceServiceRequestHeader request;
+    deviceServiceResponseHeader response;
+    int ret = SUCCESS;
+    if (!cdb || cdbLength == 0 || cdbLength > CDB_LEN_32 || (!pdata && dataLength > 0))
+    {
+        return BAD_PARAMETER;
+    }
+    memset(&request, 0, sizeof(deviceServiceRequestHeader));
+    memset(&response, 0, sizeof(deviceServiceResponseHeader));
+    request.request = DEVICE_SERVICE_REQUEST_SCSI_PASSTHROUGH;
+    request.deviceIndex = deviceIndex;
+    request.timeoutSeconds = timeoutSeconds;
+    request.dataLength = dataLength;
+    request.direction = C_CAST(uint8_t, direction);
+    request.commandLength = cdbLength;
+    memcpy(request.command, cdb, cdbLength);
+    if (senseData && senseDataLength > 0)
+    {
+        memset(senseData, 0, senseDataLength);
+    }
+    ret = device_Service_Transaction(serviceSocket, &request, pdata, &response, senseData, senseDataLength);
+    if (ret == SUCCESS)
+    {
+        ret = device_Service_Read_Data(serviceSocket, response.dataLength, pdata, direction == XFER_DATA_IN ? dataLength : 0);
+    }
+    if (ret == SUCCESS)
+    {
+        ret = response.result;
+    }
+    return ret;
+#else
+    M_USE_UNUSED(serviceSocket);
+    M_USE_UNUSED(deviceIndex);
+    M_USE_UNUSED(cdb);
+    M_USE_UNUSED(cdbLength);
+    M_USE_UNUSED(pdata);
+    M_USE_UNUSED(dataLength);
+    M_USE_UNUSED(direction);
+    M_USE_UNUSED(senseData);
+    M_USE_UNUSED(senseDataLength);
+    M_USE_UNUSED(timeoutSeconds);
+    return NOT_SUPPORTED;
+#endif
+}
+
+int device_Service_NVMe_Passthrough(int serviceSocket, uint32_t deviceIndex, bool adminCommand, uint8_t command[DEVICE_SERVICE_COMMAND_LENGTH], uint8_t *pdata, uint32_t dataLength, eDataTransferDirection direction, uint32_t *commandSpecific, uint32_t *status, uint32_t timeoutSeconds)
+{
+#if defined (DEVICE_SERVICE_SUPPORTED) && !defined (DISABLE_NVME_PASSTHROUGH)
+    deviceServiceRequestHeader request;
+    deviceServiceResponseHeader response;
+    int ret = SUCCESS;
+    if (!command || (!pdata && dataLength > 0))
+    {
+        return BAD_PARAMETER;
+    }
+    memset(&request, 0, sizeof(deviceServiceRequestHeader));
+    memset(&response, 0, sizeof(deviceServiceResponseHeader));
+    request.request = DEVICE_SERVICE_REQUEST_NVME_PASSTHROUGH;
+    request.deviceIndex = deviceIndex;
+    request.timeoutSeconds = timeoutSeconds;
+    request.dataLength = dataLength;
+    request.direction = C_CAST(uint8_t, direction);
+    request.nvmeCommandType = adminCommand ? NVM_ADMIN_CMD : NVM_CMD;
+    memcpy(request.command, command, DEVICE_SERVICE_COMMAND_LENGTH);
+    ret = device_Service_Transaction(serviceSocket, &request, pdata, &response, NULL, 0);
+    if (ret == SUCCESS)
+    {
+        ret = device_Service_Read_Data(serviceSocket, response.dataLength, pdata, direction == XFER_DATA_IN ? dataLength : 0);
+    }
+    if (ret == SUCCESS)
+    {
+        if (commandSpecific)
+        {
+            *commandSpecific = response.nvmeCommandSpecific;
+        }
+        if (status)
+        {
+            *status = response.nvmeStatus;
+        }
+        ret = response.result;
+    }
+    return ret;
+#else
+    M_USE_UNUSED(serviceSocket);
+    M_USE_UNUSED(deviceIndex);
+    M_USE_UNUSED(adminCommand);
+    M_USE_UNUSED(command);
+    M_USE_UNUSED(pdata);
+    M_USE_UNUSED(dataLength);
+    M_USE_UNUSED(direction);
+    M_USE_UNUSED(commandSpecific);
+    M_USE_UNUSED(status);
+    M_USE_UNUSED(timeoutSeconds);
+    return NOT_SUPPORTED;
+#endif
+}
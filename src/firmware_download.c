@@ -0,0 +1,455 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file firmware_download.c
+// \brief Defines a segmented firmware download that sizes its segments from the device and passthrough limits.
+
+#include "firmware_download.h"
+#include "ata_helper_func.h"
+#include "scsi_helper_func.h"
+#include "nvme_helper_func.h"
+
+#if defined (UEFI_C_SOURCE)
+//no memory mapped files. The image is read into memory instead.
+#elif defined (_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+//Largest transfer the passthrough is known to handle, including the Windows firmware download IOCTL's own limit. 0 = not known
+static uint32_t get_Firmware_Passthrough_Max_Transfer(tDevice *device)
+{
+    uint32_t maxTransfer = get_Passthrough_Max_Transfer_Length(device);
+#if defined (_WIN32) && !defined (UEFI_C_SOURCE)
+    if (device->os_info.fwdlIOsupport.fwdlIOSupported && device->os_info.fwdlIOsupport.maxXferSize > 0)
+    {
+        maxTransfer = maxTransfer > 0 ? M_Min(maxTransfer, device->os_info.fwdlIOsupport.maxXferSize) : device->os_info.fwdlIOsupport.maxXferSize;
+    }
+#endif
+    return maxTransfer;
+}
+
+static void get_ATA_Firmware_Segment_Limits(tDevice *device, firmwareSegmentLimits *limits)
+{
+    uint16_t minimumBlocks = 0;
+    uint16_t maximumBlocks = 0;
+    fill_Lazy_Device_Info(device, LAZY_INFO_ATA_LOG_CAPABILITIES);
+    if (device->drive_info.softSATFlags.identifyDeviceDataLogSupported)
+    {
+        uint8_t logBuffer[LEGACY_DRIVE_SEC_SIZE] = { 0 };
+        if (SUCCESS == send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_IDENTIFY_DEVICE_DATA, ATA_ID_DATA_LOG_SUPPORTED_CAPABILITIES, logBuffer, LEGACY_DRIVE_SEC_SIZE, 0))
+        {
+            //download microcode capabilities: bits 31:16 = maximum, bits 15:0 = minimum, in 512 byte blocks
+            uint64_t downloadCapabilities = M_BytesTo8ByteValue(logBuffer[23], logBuffer[22], logBuffer[21], logBuffer[20], logBuffer[19], logBuffer[18], logBuffer[17], logBuffer[16]);
+            if (downloadCapabilities & BIT63)
+            {
+                minimumBlocks = M_Word0(downloadCapabilities);
+                maximumBlocks = M_Word1(downloadCapabilities);
+            }
+        }
+    }
+    if (maximumBlocks == 0)
+    {
+        minimumBlocks = device->drive_info.IdentifyData.ata.Word234;
+        maximumBlocks = device->drive_info.IdentifyData.ata.Word235;
+    }
+    limits->alignmentBytes = LEGACY_DRIVE_SEC_SIZE;
+    limits->minimumBytes = LEGACY_DRIVE_SEC_SIZE;
+    limits->maximumBytes = FIRMWARE_DOWNLOAD_DEFAULT_SEGMENT_BYTES;
+    if (minimumBlocks != 0 && minimumBlocks != UINT16_MAX)
+    {
+        limits->minimumBytes = C_CAST(uint32_t, minimumBlocks) * LEGACY_DRIVE_SEC_SIZE;
+    }
+    if (maximumBlocks != 0 && maximumBlocks != UINT16_MAX)
+    {
+        limits->maximumBytes = C_CAST(uint32_t, maximumBlocks) * LEGACY_DRIVE_SEC_SIZE;
+    }
+}
+
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+static void get_NVMe_Firmware_Segment_Limits(tDevice *device, firmwareSegmentLimits *limits)
+{
+    uint8_t fwug = device->drive_info.IdentifyData.nvme.ctrl.fwug;
+    uint8_t mdts = device->drive_info.IdentifyData.nvme.ctrl.mdts;
+    //FWUG is in 4KiB units. 0 = not reported, so use 4KiB. FFh = no restriction beyond the dword units of the command
+    if (fwug == UINT8_MAX)
+    {
+        limits->alignmentBytes = 4;
+    }
+    else
+    {
+        limits->alignmentBytes = C_CAST(uint32_t, M_Max(fwug, UINT8_C(1))) * UINT32_C(4096);
+    }
+    limits->minimumBytes = limits->alignmentBytes;
+    //MDTS is a power of two of the minimum memory page size, assumed to be 4KiB like the SNTL does. 0 = no limit
+    if (mdts > 0 && mdts < 20)
+    {
+        limits->maximumBytes = UINT32_C(4096) << mdts;
+    }
+    else
+    {
+        limits->maximumBytes = UINT32_MAX - (UINT32_MAX % limits->alignmentBytes);
+    }
+}
+#endif //DISABLE_NVME_PASSTHROUGH
+
+static void get_SCSI_Firmware_Segment_Limits(tDevice *device, uint8_t bufferID, firmwareSegmentLimits *limits)
+{
+    uint8_t descriptor[4] = { 0 };
+    limits->alignmentBytes = LEGACY_DRIVE_SEC_SIZE;
+    limits->minimumBytes = 1;
+    limits->maximumBytes = FIRMWARE_DOWNLOAD_DEFAULT_SEGMENT_BYTES;
+    //Descriptor mode: byte 0 = offset boundary as a power of two, bytes 1-3 = buffer capacity
+    if (SUCCESS == scsi_Read_Buffer(device, 0x03, bufferID, 0, 4, descriptor))
+    {
+        if (descriptor[0] == UINT8_MAX)
+        {
+            //only offset 0 is allowed
+            limits->singleSegment = true;
+            limits->alignmentBytes = 1;
+        }
+        else if (descriptor[0] < 31)
+        {
+            limits->alignmentBytes = UINT32_C(1) << descriptor[0];
+        }
+        limits->bufferCapacity = M_BytesTo4ByteValue(0, descriptor[1], descriptor[2], descriptor[3]);
+        if (limits->singleSegment && limits->bufferCapacity > 0)
+        {
+            limits->maximumBytes = limits->bufferCapacity;
+        }
+        else if (limits->bufferCapacity > 0)
+        {
+            limits->maximumBytes = M_Max(M_Min(limits->maximumBytes, limits->bufferCapacity), limits->alignmentBytes);
+        }
+    }
+}
+
+int get_Firmware_Segment_Limits(tDevice *device, uint8_t slotNumber, firmwareSegmentLimits *limits)
+{
+    uint32_t passthroughMax = 0;
+    if (!device || !limits)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(limits, 0, sizeof(firmwareSegmentLimits));
+    switch (device->drive_info.drive_type)
+    {
+    case ATA_DRIVE:
+        get_ATA_Firmware_Segment_Limits(device, limits);
+        break;
+    case NVME_DRIVE:
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+        get_NVMe_Firmware_Segment_Limits(device, limits);
+        break;
+#else
+        return NOT_SUPPORTED;
+#endif
+    case SCSI_DRIVE:
+        get_SCSI_Firmware_Segment_Limits(device, slotNumber, limits);
+        break;
+    default:
+        return NOT_SUPPORTED;
+    }
+    passthroughMax = get_Firmware_Passthrough_Max_Transfer(device);
+    if (passthroughMax > 0)
+    {
+        if (device->drive_info.drive_type == SCSI_DRIVE && !limits->singleSegment)
+        {
+            //nothing on the device side limits a write buffer segment other than the buffer itself, so use everything the passthrough allows
+            limits->maximumBytes = limits->bufferCapacity > 0 ? M_Min(passthroughMax, limits->bufferCapacity) : passthroughMax;
+        }
+        else
+        {
+            limits->maximumBytes = M_Min(limits->maximumBytes, passthroughMax);
+        }
+    }
+#if defined (_WIN32) && !defined (UEFI_C_SOURCE)
+    if (device->os_info.fwdlIOsupport.fwdlIOSupported && device->os_info.fwdlIOsupport.payloadAlignment > limits->alignmentBytes)
+    {
+        limits->alignmentBytes = device->os_info.fwdlIOsupport.payloadAlignment;
+    }
+#endif
+    if (limits->maximumBytes < limits->alignmentBytes || limits->maximumBytes < limits->minimumBytes)
+    {
+        //the passthrough cannot carry a segment the device would accept
+        return NOT_SUPPORTED;
+    }
+    return SUCCESS;
+}
+
+int firmware_Download_Image(tDevice *device, uint8_t *image, uint32_t imageSize, firmwareDownloadOptions *options, firmwareDownloadResult *result)
+{
+    int ret = SUCCESS;
+    firmwareDownloadOptions defaultOptions;
+    firmwareSegmentLimits limits;
+    firmwareDownloadResult localResult;
+    eDownloadMode mode = DL_FW_UNKNOWN;
+    uint32_t segmentBytes = 0;
+    uint32_t timeoutSeconds = FIRMWARE_DOWNLOAD_DEFAULT_TIMEOUT_SECONDS;
+    uint32_t commandUnit = 1;
+    uint8_t *bounceBuffer = NULL;
+    bool activate = false;
+    seatimer_t downloadTimer;
+    if (!device || !image || imageSize == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    if (!options)
+    {
+        memset(&defaultOptions, 0, sizeof(firmwareDownloadOptions));
+        defaultOptions.mode = DL_FW_DEFERRED;
+        options = &defaultOptions;
+    }
+    if (!result)
+    {
+        result = &localResult;
+    }
+    memset(result, 0, sizeof(firmwareDownloadResult));
+    memset(&downloadTimer, 0, sizeof(seatimer_t));
+    ret = get_Firmware_Segment_Limits(device, options->slotNumber, &limits);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+    //Pick the mode
+    mode = options->mode;
+    activate = options->activate;
+    switch (mode)
+    {
+    case DL_FW_UNKNOWN:
+        mode = DL_FW_DEFERRED;
+        if (device->drive_info.drive_type == ATA_DRIVE && !device->drive_info.softSATFlags.deferredDownloadSupported)
+        {
+            mode = DL_FW_SEGMENTED;
+        }
+        break;
+    case DL_FW_SEGMENTED:
+        if (device->drive_info.drive_type == NVME_DRIVE)
+        {
+            //NVMe only has a deferred download. Activating right after it is the same as a segmented download.
+            mode = DL_FW_DEFERRED;
+            activate = true;
+        }
+        break;
+    case DL_FW_DEFERRED:
+    case DL_FW_DEFERRED_SELECT_ACTIVATE:
+        break;
+    default:
+        return BAD_PARAMETER;
+    }
+    //Pick the segment size
+    switch (device->drive_info.drive_type)
+    {
+    case ATA_DRIVE:
+        commandUnit = LEGACY_DRIVE_SEC_SIZE;
+        break;
+    case NVME_DRIVE:
+        commandUnit = 4;
+        break;
+    default:
+        break;
+    }
+    if (imageSize % commandUnit != 0 || (limits.bufferCapacity > 0 && imageSize > limits.bufferCapacity))
+    {
+        return BAD_PARAMETER;
+    }
+    if (options->segmentBytes > 0)
+    {
+        if (options->segmentBytes > limits.maximumBytes)
+        {
+            return BAD_PARAMETER;
+        }
+        segmentBytes = options->segmentBytes;
+    }
+    else
+    {
+        segmentBytes = limits.maximumBytes;
+    }
+    segmentBytes -= segmentBytes % limits.alignmentBytes;
+    if (segmentBytes == 0 || segmentBytes < limits.minimumBytes)
+    {
+        return BAD_PARAMETER;
+    }
+    if (limits.singleSegment)
+    {
+        if (imageSize > limits.maximumBytes)
+        {
+            return NOT_SUPPORTED;
+        }
+        segmentBytes = imageSize;
+    }
+    segmentBytes = M_Min(segmentBytes, imageSize);
+    if (options->timeoutSeconds > 0)
+    {
+        timeoutSeconds = options->timeoutSeconds;
+    }
+    result->mode = mode;
+    result->segmentBytes = segmentBytes;
+    //Send the segments back to back
+    start_Timer(&downloadTimer);
+    for (uint32_t offset = 0; offset < imageSize;)
+    {
+        uint32_t transferBytes = M_Min(segmentBytes, imageSize - offset);
+        uint8_t *segment = image + offset;
+        bool firstSegment = offset == 0;
+        bool lastSegment = offset + transferBytes == imageSize;
+        if (device->os_info.minimumAlignment > 1 && (C_CAST(uintptr_t, segment) % device->os_info.minimumAlignment) != 0)
+        {
+            //the image does not meet the OS alignment requirement here, so copy the segment into one aligned buffer that is reused for the rest of the download
+            if (!bounceBuffer)
+            {
+                bounceBuffer = C_CAST(uint8_t*, calloc_aligned(segmentBytes, sizeof(uint8_t), device->os_info.minimumAlignment));
+                if (!bounceBuffer)
+                {
+                    ret = MEMORY_FAILURE;
+                    break;
+                }
+            }
+            memcpy(bounceBuffer, segment, transferBytes);
+            segment = bounceBuffer;
+            result->bufferedSegments += 1;
+        }
+        ret = firmware_Download_Command(device, mode, offset, transferBytes, segment, options->slotNumber, options->existingImage, firstSegment, lastSegment, timeoutSeconds);
+        if (ret != SUCCESS)
+        {
+            break;
+        }
+        result->segmentsSent += 1;
+        result->bytesSent += transferBytes;
+        offset += transferBytes;
+        if (lastSegment && device->drive_info.drive_type == ATA_DRIVE && !device->drive_info.passThroughHacks.ataPTHacks.noRTFRsPossible && device->drive_info.lastCommandRTFRs.secCnt == 0x01)
+        {
+            //count = 01h means the device is still expecting more of the image
+            ret = FAILURE;
+        }
+    }
+    stop_Timer(&downloadTimer);
+    result->downloadNanoseconds = get_Nano_Seconds(downloadTimer);
+    safe_Free_aligned(bounceBuffer)
+    if (ret == SUCCESS && activate && mode != DL_FW_SEGMENTED)
+    {
+        ret = firmware_Download_Activate(device, options->slotNumber, options->existingImage, timeoutSeconds);
+        if (ret == SUCCESS)
+        {
+            result->activated = true;
+        }
+    }
+    return ret;
+}
+
+int firmware_Download_File(tDevice *device, const char *fileName, firmwareDownloadOptions *options, firmwareDownloadResult *result)
+{
+    int ret = SUCCESS;
+    uint8_t *image = NULL;
+    uint32_t imageSize = 0;
+    if (!device || !fileName)
+    {
+        return BAD_PARAMETER;
+    }
+#if defined (UEFI_C_SOURCE)
+    {
+        FILE *firmwareFile = fopen(fileName, "rb");
+        long fileSize = 0;
+        if (!firmwareFile)
+        {
+            return FILE_OPEN_ERROR;
+        }
+        if (fseek(firmwareFile, 0, SEEK_END) != 0 || (fileSize = ftell(firmwareFile)) <= 0 || C_CAST(uint64_t, fileSize) > UINT32_MAX || fseek(firmwareFile, 0, SEEK_SET) != 0)
+        {
+            fclose(firmwareFile);
+            return BAD_PARAMETER;
+        }
+        imageSize = C_CAST(uint32_t, fileSize);
+        image = C_CAST(uint8_t*, calloc_aligned(imageSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+        if (!image)
+        {
+            fclose(firmwareFile);
+            return MEMORY_FAILURE;
+        }
+        if (fread(image, sizeof(uint8_t), imageSize, firmwareFile) != imageSize)
+        {
+            ret = FILE_OPEN_ERROR;
+        }
+        fclose(firmwareFile);
+        if (ret == SUCCESS)
+        {
+            ret = firmware_Download_Image(device, image, imageSize, options, result);
+        }
+        safe_Free_aligned(image)
+    }
+#elif defined (_WIN32)
+    {
+        HANDLE firmwareFile = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        HANDLE mapping = NULL;
+        LARGE_INTEGER fileSize;
+        if (firmwareFile == INVALID_HANDLE_VALUE)
+        {
+            return FILE_OPEN_ERROR;
+        }
+        if (!GetFileSizeEx(firmwareFile, &fileSize) || fileSize.QuadPart <= 0 || C_CAST(uint64_t, fileSize.QuadPart) > UINT32_MAX)
+        {
+            CloseHandle(firmwareFile);
+            return BAD_PARAMETER;
+        }
+        imageSize = C_CAST(uint32_t, fileSize.QuadPart);
+        //copy on write so the file is never changed even if a lower layer writes to the buffer
+        mapping = CreateFileMappingA(firmwareFile, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+        if (mapping)
+        {
+            image = C_CAST(uint8_t*, MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+        }
+        if (image)
+        {
+            ret = firmware_Download_Image(device, image, imageSize, options, result);
+            UnmapViewOfFile(image);
+        }
+        else
+        {
+            ret = FILE_OPEN_ERROR;
+        }
+        if (mapping)
+        {
+            CloseHandle(mapping);
+        }
+        CloseHandle(firmwareFile);
+    }
+#else
+    {
+        struct stat fileStat;
+        void *mapped = MAP_FAILED;
+        int firmwareFile = open(fileName, O_RDONLY);
+        if (firmwareFile < 0)
+        {
+            return FILE_OPEN_ERROR;
+        }
+        if (fstat(firmwareFile, &fileStat) != 0 || fileStat.st_size <= 0 || C_CAST(uint64_t, fileStat.st_size) > UINT32_MAX)
+        {
+            close(firmwareFile);
+            return BAD_PARAMETER;
+        }
+        imageSize = C_CAST(uint32_t, fileStat.st_size);
+        //private so the file is never changed even if a lower layer writes to the buffer
+        mapped = mmap(NULL, imageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, firmwareFile, 0);
+        close(firmwareFile);
+        if (mapped == MAP_FAILED)
+        {
+            return FILE_OPEN_ERROR;
+        }
+        image = C_CAST(uint8_t*, mapped);
+        ret = firmware_Download_Image(device, image, imageSize, options, result);
+        munmap(mapped, imageSize);
+    }
+#endif
+    return ret;
+}
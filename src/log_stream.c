@@ -0,0 +1,599 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file log_stream.c
+// \brief Defines a reader that pulls large diagnostic logs from a device in chunks straight into a file or memory region.
+
+#include "log_stream.h"
+#include "ata_helper_func.h"
+#include "scsi_helper_func.h"
+#include "nvme_helper_func.h"
+
+#if defined (UEFI_C_SOURCE)
+//no threads. Each chunk is written before the next one is read.
+#elif defined (_WIN32)
+#include <windows.h>
+#include <process.h>
+#define LOG_STREAM_THREADS_SUPPORTED
+#else
+#include <pthread.h>
+#define LOG_STREAM_THREADS_SUPPORTED
+#endif
+
+#define LOG_STREAM_BLOCK_SIZE UINT32_C(512)//telemetry data blocks, ATA log pages, and the unit chunks are rounded to
+#define LOG_STREAM_SCSI_DIRECTORY_LENGTH UINT32_C(2048)//header plus an entry for every error history buffer ID
+#define READ_BUFFER_MODE_ERROR_HISTORY 0x1C
+
+typedef struct _logStreamSourceInfo
+{
+    uint64_t logSize;
+    uint32_t maxChunk;//most bytes one command can read of this log
+    bool singleCommand;//the log has no offsets, so it must be read in one command
+    bool checkGeneration;//the device can replace the log on its own, so make sure it did not while it was read
+    uint8_t generation;
+    uint8_t bufferID;
+}logStreamSourceInfo;
+
+static int read_Log_Stream_Header(tDevice *device, eLogStreamSource source, bool createSnapshot, uint8_t *header)
+{
+    int ret = NOT_SUPPORTED;
+    switch (source)
+    {
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+    case LOG_STREAM_NVME_TELEMETRY_HOST:
+    case LOG_STREAM_NVME_TELEMETRY_CONTROLLER:
+    {
+        nvmeGetLogPageCmdOpts getLogPage;
+        memset(&getLogPage, 0, sizeof(nvmeGetLogPageCmdOpts));
+        getLogPage.nsid = UINT32_MAX;
+        getLogPage.addr = header;
+        getLogPage.dataLen = LOG_STREAM_BLOCK_SIZE;
+        getLogPage.lid = source == LOG_STREAM_NVME_TELEMETRY_HOST ? NVME_LOG_TELEMETRY_HOST : NVME_LOG_TELEMETRY_CTRL;
+        if (source == LOG_STREAM_NVME_TELEMETRY_HOST && createSnapshot)
+        {
+            getLogPage.lsp = BIT0;//create telemetry host-initiated data
+        }
+        ret = nvme_Get_Log_Page(device, &getLogPage);
+    }
+        break;
+#endif
+    case LOG_STREAM_ATA_CURRENT_INTERNAL_STATUS:
+        ret = send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_CURRENT_DEVICE_INTERNAL_STATUS_DATA_LOG, 0, header, LEGACY_DRIVE_SEC_SIZE, createSnapshot ? BIT0 : 0);
+        break;
+    case LOG_STREAM_ATA_SAVED_INTERNAL_STATUS:
+        ret = send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_SAVED_DEVICE_INTERNAL_STATUS_DATA_LOG, 0, header, LEGACY_DRIVE_SEC_SIZE, 0);
+        break;
+    default:
+        break;
+    }
+    return ret;
+}
+
+static int get_Log_Stream_Source_Info(tDevice *device, eLogStreamSource source, logStreamOptions *options, logStreamSourceInfo *info)
+{
+    int ret = SUCCESS;
+    uint8_t dataArea = 3;
+    uint8_t *header = NULL;
+    memset(info, 0, sizeof(logStreamSourceInfo));
+    if (options && options->dataArea > 0)
+    {
+        dataArea = options->dataArea;
+    }
+    switch (source)
+    {
+    case LOG_STREAM_NVME_TELEMETRY_HOST:
+    case LOG_STREAM_NVME_TELEMETRY_CONTROLLER:
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+        if (device->drive_info.drive_type != NVME_DRIVE || !(device->drive_info.IdentifyData.nvme.ctrl.lpa & BIT3))
+        {
+            return NOT_SUPPORTED;
+        }
+        if (dataArea > 4)
+        {
+            return BAD_PARAMETER;
+        }
+        //without extended data for get log page there is no offset, so the log has to be read in one command
+        info->singleCommand = !(device->drive_info.IdentifyData.nvme.ctrl.lpa & BIT2);
+        info->maxChunk = UINT32_MAX;
+        info->checkGeneration = source == LOG_STREAM_NVME_TELEMETRY_CONTROLLER;
+        break;
+#else
+        return NOT_SUPPORTED;
+#endif
+    case LOG_STREAM_ATA_CURRENT_INTERNAL_STATUS:
+    case LOG_STREAM_ATA_SAVED_INTERNAL_STATUS:
+        if (device->drive_info.drive_type != ATA_DRIVE || !device->drive_info.ata_Options.generalPurposeLoggingSupported)
+        {
+            return NOT_SUPPORTED;
+        }
+        if (dataArea > 3)
+        {
+            return BAD_PARAMETER;
+        }
+        //the page count of read log ext is 16 bits
+        info->maxChunk = UINT16_MAX * LEGACY_DRIVE_SEC_SIZE;
+        info->checkGeneration = source == LOG_STREAM_ATA_SAVED_INTERNAL_STATUS;
+        break;
+    case LOG_STREAM_SCSI_ERROR_HISTORY:
+        if (device->drive_info.drive_type != SCSI_DRIVE)
+        {
+            return NOT_SUPPORTED;
+        }
+        header = C_CAST(uint8_t*, calloc_aligned(LOG_STREAM_SCSI_DIRECTORY_LENGTH, sizeof(uint8_t), device->os_info.minimumAlignment));
+        if (!header)
+        {
+            return MEMORY_FAILURE;
+        }
+        //buffer ID 00h = error history directory, 01h = error history directory after creating a new snapshot
+        ret = scsi_Read_Buffer(device, READ_BUFFER_MODE_ERROR_HISTORY, (options && options->createSnapshot) ? 0x01 : 0x00, 0, LOG_STREAM_SCSI_DIRECTORY_LENGTH, header);
+        if (ret == SUCCESS)
+        {
+            uint32_t directoryEnd = M_Min(UINT32_C(32) + M_BytesTo2ByteValue(header[30], header[31]), LOG_STREAM_SCSI_DIRECTORY_LENGTH);
+            ret = NOT_SUPPORTED;
+            for (uint32_t entryOffset = 32; entryOffset + 8 <= directoryEnd; entryOffset += 8)
+            {
+                uint8_t bufferID = header[entryOffset];
+                //10h - EFh are the buffers holding the error history
+                if (bufferID >= 0x10 && bufferID <= 0xEF && (!options || options->bufferID == 0 || options->bufferID == bufferID))
+                {
+                    info->bufferID = bufferID;
+                    info->logSize = M_BytesTo4ByteValue(header[entryOffset + 4], header[entryOffset + 5], header[entryOffset + 6], header[entryOffset + 7]);
+                    info->maxChunk = UINT32_MAX;
+                    ret = SUCCESS;
+                    break;
+                }
+            }
+        }
+        safe_Free_aligned(header)
+        return ret;
+    default:
+        return BAD_PARAMETER;
+    }
+    header = C_CAST(uint8_t*, calloc_aligned(LOG_STREAM_BLOCK_SIZE, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!header)
+    {
+        return MEMORY_FAILURE;
+    }
+    ret = read_Log_Stream_Header(device, source, options ? options->createSnapshot : false, header);
+    if (ret == SUCCESS)
+    {
+        //Both headers keep the last block or page of each data area in the same place. Block 0 is the header itself.
+        uint32_t lastBlock = 0;
+        switch (dataArea)
+        {
+        case 1:
+            lastBlock = M_BytesTo2ByteValue(header[9], header[8]);
+            break;
+        case 2:
+            lastBlock = M_BytesTo2ByteValue(header[11], header[10]);
+            break;
+        case 3:
+            lastBlock = M_BytesTo2ByteValue(header[13], header[12]);
+            break;
+        case 4:
+            lastBlock = M_BytesTo4ByteValue(header[19], header[18], header[17], header[16]);
+            break;
+        default:
+            break;
+        }
+        info->logSize = (C_CAST(uint64_t, lastBlock) + 1) * LOG_STREAM_BLOCK_SIZE;
+        info->generation = header[383];
+    }
+    safe_Free_aligned(header)
+    return ret;
+}
+
+int get_Log_Stream_Size(tDevice *device, eLogStreamSource source, logStreamOptions *options, uint64_t *logSize)
+{
+    int ret = SUCCESS;
+    logStreamSourceInfo info;
+    if (!device || !logSize)
+    {
+        return BAD_PARAMETER;
+    }
+    ret = get_Log_Stream_Source_Info(device, source, options, &info);
+    *logSize = ret == SUCCESS ? info.logSize : 0;
+    return ret;
+}
+
+static int read_Log_Stream_Chunk(tDevice *device, eLogStreamSource source, logStreamSourceInfo *info, uint64_t offset, uint8_t *ptrData, uint32_t dataSize)
+{
+    int ret = NOT_SUPPORTED;
+    switch (source)
+    {
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+    case LOG_STREAM_NVME_TELEMETRY_HOST:
+    case LOG_STREAM_NVME_TELEMETRY_CONTROLLER:
+    {
+        nvmeGetLogPageCmdOpts getLogPage;
+        memset(&getLogPage, 0, sizeof(nvmeGetLogPageCmdOpts));
+        getLogPage.nsid = UINT32_MAX;
+        getLogPage.addr = ptrData;
+        getLogPage.dataLen = dataSize;
+        getLogPage.lid = source == LOG_STREAM_NVME_TELEMETRY_HOST ? NVME_LOG_TELEMETRY_HOST : NVME_LOG_TELEMETRY_CTRL;
+        getLogPage.offset = offset;
+        ret = nvme_Get_Log_Page(device, &getLogPage);
+    }
+        break;
+#endif
+    case LOG_STREAM_ATA_CURRENT_INTERNAL_STATUS:
+        ret = send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_CURRENT_DEVICE_INTERNAL_STATUS_DATA_LOG, C_CAST(uint16_t, offset / LEGACY_DRIVE_SEC_SIZE), ptrData, dataSize, 0);
+        break;
+    case LOG_STREAM_ATA_SAVED_INTERNAL_STATUS:
+        ret = send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_SAVED_DEVICE_INTERNAL_STATUS_DATA_LOG, C_CAST(uint16_t, offset / LEGACY_DRIVE_SEC_SIZE), ptrData, dataSize, 0);
+        break;
+    case LOG_STREAM_SCSI_ERROR_HISTORY:
+        //READ BUFFER 10 has 24 bit offset and length fields
+        if (offset + dataSize <= UINT32_C(0xFFFFFF))
+        {
+            ret = scsi_Read_Buffer(device, READ_BUFFER_MODE_ERROR_HISTORY, info->bufferID, C_CAST(uint32_t, offset), dataSize, ptrData);
+        }
+        else
+        {
+            ret = scsi_Read_Buffer_16(device, READ_BUFFER_MODE_ERROR_HISTORY, 0, info->bufferID, offset, dataSize, ptrData);
+        }
+        break;
+    default:
+        break;
+    }
+    return ret;
+}
+
+//One writer thread per stream_Log() call. Chunks are handed to it one at a time, so it writes one buffer while the next chunk is read into the other.
+typedef struct _logStreamWriter
+{
+    FILE *file;
+    uint8_t *data;
+    uint32_t dataSize;
+    bool failed;
+#if defined (LOG_STREAM_THREADS_SUPPORTED)
+    bool threadRunning;
+    bool chunkPending;//handed to the writer thread and not written yet
+    bool stop;
+#if defined (_WIN32)
+    HANDLE thread;
+    HANDLE chunkReady;//auto reset. Set when a chunk is handed over or stop is set
+    HANDLE chunkWritten;//auto reset. Set by the writer thread after each chunk
+#else
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;//signalled when a chunk is handed over, when it has been written, and when stop is set
+#endif
+#endif
+}logStreamWriter;
+
+static void write_Log_Stream_Chunk(logStreamWriter *writer)
+{
+    if (fwrite(writer->data, sizeof(uint8_t), writer->dataSize, writer->file) != writer->dataSize)
+    {
+        writer->failed = true;
+    }
+}
+
+#if defined (LOG_STREAM_THREADS_SUPPORTED)
+#if defined (_WIN32)
+//started with _beginthreadex rather than CreateThread since it writes with fwrite
+static unsigned __stdcall log_Stream_Write_Thread(void *logWriter)
+{
+    logStreamWriter *writer = C_CAST(logStreamWriter*, logWriter);
+    while (WAIT_OBJECT_0 == WaitForSingleObject(writer->chunkReady, INFINITE) && !writer->stop)
+    {
+        write_Log_Stream_Chunk(writer);
+        SetEvent(writer->chunkWritten);
+    }
+    return 0;
+}
+#else
+static void* log_Stream_Write_Thread(void *logWriter)
+{
+    logStreamWriter *writer = C_CAST(logStreamWriter*, logWriter);
+    pthread_mutex_lock(&writer->lock);
+    while (true)
+    {
+        while (!writer->chunkPending && !writer->stop)
+        {
+            pthread_cond_wait(&writer->changed, &writer->lock);
+        }
+        if (!writer->chunkPending)
+        {
+            break;
+        }
+        pthread_mutex_unlock(&writer->lock);
+        write_Log_Stream_Chunk(writer);
+        pthread_mutex_lock(&writer->lock);
+        writer->chunkPending = false;
+        pthread_cond_signal(&writer->changed);
+    }
+    pthread_mutex_unlock(&writer->lock);
+    return NULL;
+}
+#endif
+#endif //LOG_STREAM_THREADS_SUPPORTED
+
+//Starts the writer thread. When it cannot be started, each chunk is written by start_Log_Stream_Write() before it returns.
+static void start_Log_Stream_Writer(logStreamWriter *writer, FILE *file)
+{
+    memset(writer, 0, sizeof(logStreamWriter));
+    writer->file = file;
+#if defined (LOG_STREAM_THREADS_SUPPORTED)
+#if defined (_WIN32)
+    writer->chunkReady = CreateEvent(NULL, FALSE, FALSE, NULL);
+    writer->chunkWritten = CreateEvent(NULL, FALSE, FALSE, NULL);
+    if (writer->chunkReady && writer->chunkWritten)
+    {
+        writer->thread = C_CAST(HANDLE, _beginthreadex(NULL, 0, log_Stream_Write_Thread, writer, 0, NULL));
+        writer->threadRunning = writer->thread != NULL;
+    }
+    if (!writer->threadRunning)
+    {
+        if (writer->chunkReady)
+        {
+            CloseHandle(writer->chunkReady);
+        }
+        if (writer->chunkWritten)
+        {
+            CloseHandle(writer->chunkWritten);
+        }
+    }
+#else
+    if (0 == pthread_mutex_init(&writer->lock, NULL))
+    {
+        if (0 == pthread_cond_init(&writer->changed, NULL))
+        {
+            writer->threadRunning = 0 == pthread_create(&writer->thread, NULL, log_Stream_Write_Thread, writer);
+            if (!writer->threadRunning)
+            {
+                pthread_cond_destroy(&writer->changed);
+            }
+        }
+        if (!writer->threadRunning)
+        {
+            pthread_mutex_destroy(&writer->lock);
+        }
+    }
+#endif
+#endif
+}
+
+//Hands a chunk to the writer thread. Only one chunk may be outstanding, so finish_Log_Stream_Write() must be called before the next one.
+static void start_Log_Stream_Write(logStreamWriter *writer, uint8_t *data, uint32_t dataSize)
+{
+    writer->data = data;
+    writer->dataSize = dataSize;
+    writer->failed = false;
+#if defined (LOG_STREAM_THREADS_SUPPORTED)
+    if (writer->threadRunning)
+    {
+#if defined (_WIN32)
+        writer->chunkPending = true;
+        SetEvent(writer->chunkReady);
+#else
+        pthread_mutex_lock(&writer->lock);
+        writer->chunkPending = true;
+        pthread_cond_signal(&writer->changed);
+        pthread_mutex_unlock(&writer->lock);
+#endif
+        return;
+    }
+#endif
+    write_Log_Stream_Chunk(writer);
+}
+
+//Waits for the chunk from start_Log_Stream_Write() to be written. Returns false if the write failed.
+static bool finish_Log_Stream_Write(logStreamWriter *writer)
+{
+#if defined (LOG_STREAM_THREADS_SUPPORTED)
+    if (writer->threadRunning)
+    {
+#if defined (_WIN32)
+        if (writer->chunkPending)
+        {
+            WaitForSingleObject(writer->chunkWritten, INFINITE);
+            writer->chunkPending = false;
+        }
+#else
+        pthread_mutex_lock(&writer->lock);
+        while (writer->chunkPending)
+        {
+            pthread_cond_wait(&writer->changed, &writer->lock);
+        }
+        pthread_mutex_unlock(&writer->lock);
+#endif
+    }
+#endif
+    return !writer->failed;
+}
+
+//Stops the writer thread. Any chunk handed to it must already have been finished.
+static void stop_Log_Stream_Writer(logStreamWriter *writer)
+{
+#if defined (LOG_STREAM_THREADS_SUPPORTED)
+    if (writer->threadRunning)
+    {
+#if defined (_WIN32)
+        writer->stop = true;
+        SetEvent(writer->chunkReady);
+        WaitForSingleObject(writer->thread, INFINITE);
+        CloseHandle(writer->thread);
+        CloseHandle(writer->chunkReady);
+        CloseHandle(writer->chunkWritten);
+#else
+        pthread_mutex_lock(&writer->lock);
+        writer->stop = true;
+        pthread_cond_signal(&writer->changed);
+        pthread_mutex_unlock(&writer->lock);
+        pthread_join(writer->thread, NULL);
+        pthread_cond_destroy(&writer->changed);
+        pthread_mutex_destroy(&writer->lock);
+#endif
+        writer->threadRunning = false;
+    }
+#else
+    M_USE_UNUSED(writer);
+#endif
+}
+
+int stream_Log(tDevice *device, eLogStreamSource source, logStreamOptions *options, logStreamSink *sink, logStreamResult *result)
+{
+    int ret = SUCCESS;
+    logStreamSourceInfo info;
+    logStreamResult localResult;
+    logStreamWriter logWriter;
+    bool writePending = false;
+    uint32_t chunkBytes = 0;
+    uint8_t *buffers[2] = { NULL, NULL };
+    uint32_t chunkIndex = 0;
+    if (!device || !sink || (sink->type == LOG_STREAM_SINK_FILE && !sink->file) || (sink->type == LOG_STREAM_SINK_MEMORY && !sink->memory))
+    {
+        return BAD_PARAMETER;
+    }
+    if (!result)
+    {
+        result = &localResult;
+    }
+    memset(result, 0, sizeof(logStreamResult));
+    ret = get_Log_Stream_Source_Info(device, source, options, &info);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+    result->logSize = info.logSize;
+    if (sink->type == LOG_STREAM_SINK_MEMORY && sink->memoryCapacity < info.logSize)
+    {
+        return BAD_PARAMETER;
+    }
+    if (info.logSize == 0)
+    {
+        return SUCCESS;
+    }
+    //Pick the chunk size
+    if (options && options->chunkBytes > 0)
+    {
+        chunkBytes = options->chunkBytes;
+    }
+    else
+    {
+        chunkBytes = get_Passthrough_Max_Transfer_Length(device);
+        if (chunkBytes == 0)
+        {
+            chunkBytes = LOG_STREAM_DEFAULT_CHUNK_BYTES;
+        }
+    }
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+    if (device->drive_info.drive_type == NVME_DRIVE && device->drive_info.IdentifyData.nvme.ctrl.mdts > 0 && device->drive_info.IdentifyData.nvme.ctrl.mdts < 20)
+    {
+        chunkBytes = M_Min(chunkBytes, UINT32_C(4096) << device->drive_info.IdentifyData.nvme.ctrl.mdts);
+    }
+#endif
+    chunkBytes -= chunkBytes % LOG_STREAM_BLOCK_SIZE;
+    if (chunkBytes == 0 || (info.singleCommand && info.logSize > chunkBytes))
+    {
+        return NOT_SUPPORTED;
+    }
+    chunkBytes = C_CAST(uint32_t, M_Min(C_CAST(uint64_t, M_Min(chunkBytes, info.maxChunk)), info.logSize));
+    result->chunkBytes = chunkBytes;
+    //Two buffers so one can be written to the file while the other is read into
+    for (uint8_t bufferIter = 0; bufferIter < (sink->type == LOG_STREAM_SINK_FILE ? 2 : 1); ++bufferIter)
+    {
+        buffers[bufferIter] = C_CAST(uint8_t*, calloc_aligned(chunkBytes, sizeof(uint8_t), device->os_info.minimumAlignment));
+        if (!buffers[bufferIter])
+        {
+            safe_Free_aligned(buffers[0])
+            return MEMORY_FAILURE;
+        }
+    }
+    if (sink->type == LOG_STREAM_SINK_FILE)
+    {
+        start_Log_Stream_Writer(&logWriter, sink->file);
+#if defined (LOG_STREAM_THREADS_SUPPORTED)
+        result->overlappedWrites = logWriter.threadRunning;
+#endif
+    }
+    for (uint64_t offset = 0; offset < info.logSize; offset += chunkBytes, ++chunkIndex)
+    {
+        uint32_t dataSize = C_CAST(uint32_t, M_Min(C_CAST(uint64_t, chunkBytes), info.logSize - offset));
+        uint8_t *target = buffers[chunkIndex % 2];
+        if (sink->type == LOG_STREAM_SINK_MEMORY)
+        {
+            target = sink->memory + offset;
+            if (device->os_info.minimumAlignment > 1 && (C_CAST(uintptr_t, target) % device->os_info.minimumAlignment) != 0)
+            {
+                target = buffers[0];
+            }
+        }
+        ret = read_Log_Stream_Chunk(device, source, &info, offset, target, dataSize);
+        result->commandsIssued += 1;
+        if (ret != SUCCESS)
+        {
+            break;
+        }
+        if (offset == 0 && info.checkGeneration && target[383] != info.generation)
+        {
+            //replaced between reading the header and starting the stream
+            ret = FAILURE;
+            break;
+        }
+        if (sink->type == LOG_STREAM_SINK_MEMORY)
+        {
+            if (target != sink->memory + offset)
+            {
+                memcpy(sink->memory + offset, target, dataSize);
+            }
+            result->bytesWritten += dataSize;
+            continue;
+        }
+        //read the next chunk while this one is written
+        if (writePending)
+        {
+            writePending = false;
+            if (!finish_Log_Stream_Write(&logWriter))
+            {
+                ret = ERROR_WRITING_FILE;
+                break;
+            }
+            result->bytesWritten += logWriter.dataSize;
+        }
+        start_Log_Stream_Write(&logWriter, target, dataSize);
+        writePending = true;
+    }
+    if (writePending)
+    {
+        if (finish_Log_Stream_Write(&logWriter))
+        {
+            result->bytesWritten += logWriter.dataSize;
+        }
+        else if (ret == SUCCESS)
+        {
+            ret = ERROR_WRITING_FILE;
+        }
+    }
+    if (sink->type == LOG_STREAM_SINK_FILE)
+    {
+        stop_Log_Stream_Writer(&logWriter);
+    }
+    if (sink->type == LOG_STREAM_SINK_FILE && fflush(sink->file) != 0 && ret == SUCCESS)
+    {
+        ret = ERROR_WRITING_FILE;
+    }
+    if (ret == SUCCESS && info.checkGeneration)
+    {
+        //make sure the device did not replace the log partway through
+        memset(buffers[0], 0, LOG_STREAM_BLOCK_SIZE);
+        ret = read_Log_Stream_Header(device, source, false, buffers[0]);
+        result->commandsIssued += 1;
+        if (ret == SUCCESS && buffers[0][383] != info.generation)
+        {
+            ret = FAILURE;
+        }
+    }
+    safe_Free_aligned(buffers[0])
+    safe_Free_aligned(buffers[1])
+    return ret;
+}
@@ -0,0 +1,471 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file nv_cache_manager.c
+// \brief Defines a manager that pins the most frequently missed LBAs of an ATA hybrid drive into its NV cache.
+
+#include "nv_cache_manager.h"
+#include "cmds.h"
+#include "ata_helper_func.h"
+
+//LBA range entry: bits 47:0 = LBA, bits 63:48 = range length. A range length of 0 ends the list.
+static void get_NV_Cache_LBA_Range_Entry(uint8_t *entry, uint64_t *lba, uint16_t *length)
+{
+    *lba = M_BytesTo8ByteValue(0, 0, entry[5], entry[4], entry[3], entry[2], entry[1], entry[0]);
+    *length = M_BytesTo2ByteValue(entry[7], entry[6]);
+}
+
+static void set_NV_Cache_LBA_Range_Entry(uint8_t *entry, uint64_t lba, uint16_t length)
+{
+    entry[0] = M_Byte0(lba);
+    entry[1] = M_Byte1(lba);
+    entry[2] = M_Byte2(lba);
+    entry[3] = M_Byte3(lba);
+    entry[4] = M_Byte4(lba);
+    entry[5] = M_Byte5(lba);
+    entry[6] = M_Byte0(length);
+    entry[7] = M_Byte1(length);
+}
+
+static int read_NV_Cache_Pinned_Set(nvCacheManager *manager)
+{
+    int ret = SUCCESS;
+    uint8_t pinnedSetBlock[LEGACY_DRIVE_SEC_SIZE] = { 0 };
+    bool endOfList = false;
+    free_LBA_Interval_Set(&manager->pinned);
+    for (uint64_t dataBlock = 0; !endOfList && dataBlock <= UINT16_MAX; ++dataBlock)
+    {
+        memset(pinnedSetBlock, 0, LEGACY_DRIVE_SEC_SIZE);
+        ret = ata_NV_Query_Pinned_Set(manager->device, dataBlock, pinnedSetBlock, LEGACY_DRIVE_SEC_SIZE);
+        if (ret != SUCCESS)
+        {
+            break;
+        }
+        for (uint32_t entryIter = 0; entryIter < NV_CACHE_LBA_RANGE_ENTRIES_PER_BLOCK; ++entryIter)
+        {
+            uint64_t lba = 0;
+            uint16_t length = 0;
+            get_NV_Cache_LBA_Range_Entry(&pinnedSetBlock[entryIter * NV_CACHE_LBA_RANGE_ENTRY_LENGTH], &lba, &length);
+            if (length == 0)
+            {
+                endOfList = true;
+                break;
+            }
+            ret = add_LBA_Interval(&manager->pinned, lba, length);
+            if (ret != SUCCESS)
+            {
+                return ret;
+            }
+        }
+    }
+    return ret;
+}
+
+int start_NV_Cache_Manager(tDevice *device, nvCacheManagerOptions *options, nvCacheManager *manager)
+{
+    int ret = SUCCESS;
+    uint64_t nvCacheSize = 0;
+    if (!device || !manager)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(manager, 0, sizeof(nvCacheManager));
+    if (device->drive_info.drive_type != ATA_DRIVE)
+    {
+        return NOT_SUPPORTED;
+    }
+    //word 214 bit 4 = NV Cache feature set enabled. Words 215-216 = NV cache size in logical blocks
+    nvCacheSize = M_WordsTo4ByteValue(device->drive_info.IdentifyData.ata.Word216, device->drive_info.IdentifyData.ata.Word215);
+    if (!(device->drive_info.IdentifyData.ata.Word214 & BIT4) || nvCacheSize == 0 || device->drive_info.ata_Options.dmaMode == ATA_DMA_MODE_NO_DMA)
+    {
+        return NOT_SUPPORTED;
+    }
+    fill_Lazy_Device_Info(device, LAZY_INFO_CAPACITY);
+    manager->device = device;
+    manager->granularityLBAs = NV_CACHE_DEFAULT_GRANULARITY_LBAS;
+    manager->decayShift = NV_CACHE_DEFAULT_DECAY_SHIFT;
+    manager->maxPinnedLBAs = nvCacheSize;
+    if (options)
+    {
+        if (options->granularityLBAs > 0)
+        {
+            manager->granularityLBAs = options->granularityLBAs;
+        }
+        if (options->decayShift > 0 && options->decayShift < 32)
+        {
+            manager->decayShift = options->decayShift;
+        }
+        if (options->maxPinnedLBAs > 0)
+        {
+            manager->maxPinnedLBAs = M_Min(options->maxPinnedLBAs, nvCacheSize);
+        }
+        manager->populateImmediately = options->populateImmediately;
+    }
+    ret = read_NV_Cache_Pinned_Set(manager);
+    if (ret != SUCCESS)
+    {
+        free_NV_Cache_Manager(manager);
+    }
+    return ret;
+}
+
+//Returns the index of the region in the heat map, or where it should be inserted
+static uint32_t find_NV_Cache_Heat(nvCacheManager *manager, uint64_t region)
+{
+    uint32_t low = 0;
+    uint32_t high = manager->heatCount;
+    while (low < high)
+    {
+        uint32_t middle = low + (high - low) / 2;
+        if (manager->heatMap[middle].region < region)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+//A range longer than the pinned LBA budget could never be pinned as a whole, so only the regions the budget covers from the start of the range are warmed.
+//The regions in the range are merged into the heat map in one pass from the back, so a long range costs one move of the rest of the map rather than one per new region.
+static int warm_NV_Cache_Regions(nvCacheManager *manager, uint64_t lba, uint64_t length)
+{
+    uint64_t firstRegion = 0;
+    uint64_t regionCount = 0;
+    uint32_t index = 0;
+    uint32_t existingCount = 0;
+    uint32_t newCount = 0;
+    uint32_t source = 0;
+    if (length == 0 || lba > manager->device->drive_info.deviceMaxLba)
+    {
+        return SUCCESS;
+    }
+    length = M_Min(length, manager->device->drive_info.deviceMaxLba - lba + 1);
+    firstRegion = lba / manager->granularityLBAs;
+    regionCount = (lba + length - 1) / manager->granularityLBAs - firstRegion + 1;
+    regionCount = M_Min(regionCount, M_Max((manager->maxPinnedLBAs + manager->granularityLBAs - 1) / manager->granularityLBAs, UINT64_C(1)));
+    if (regionCount > UINT32_MAX - manager->heatCount)
+    {
+        return MEMORY_FAILURE;
+    }
+    index = find_NV_Cache_Heat(manager, firstRegion);
+    while (index + existingCount < manager->heatCount && manager->heatMap[index + existingCount].region < firstRegion + regionCount)
+    {
+        ++existingCount;
+    }
+    newCount = C_CAST(uint32_t, manager->heatCount + regionCount - existingCount);
+    if (newCount > manager->heatCapacity)
+    {
+        uint64_t newCapacity = manager->heatCapacity == 0 ? UINT64_C(256) : manager->heatCapacity;
+        nvCacheHeat *newHeatMap = NULL;
+        while (newCapacity < newCount)
+        {
+            newCapacity *= 2;
+        }
+        newCapacity = M_Min(newCapacity, C_CAST(uint64_t, UINT32_MAX));
+        newHeatMap = C_CAST(nvCacheHeat*, realloc(manager->heatMap, newCapacity * sizeof(nvCacheHeat)));
+        if (!newHeatMap)
+        {
+            return MEMORY_FAILURE;
+        }
+        manager->heatMap = newHeatMap;
+        manager->heatCapacity = C_CAST(uint32_t, newCapacity);
+    }
+    //move the regions after the range to their final place, then fill the range from its end so existing entries are read before they are overwritten
+    memmove(&manager->heatMap[index + regionCount], &manager->heatMap[index + existingCount], (manager->heatCount - index - existingCount) * sizeof(nvCacheHeat));
+    source = index + existingCount;
+    for (uint64_t regionIter = regionCount; regionIter > 0; --regionIter)
+    {
+        uint64_t region = firstRegion + regionIter - 1;
+        uint32_t heat = 0;
+        if (source > index && manager->heatMap[source - 1].region == region)
+        {
+            source -= 1;
+            heat = manager->heatMap[source].heat;
+        }
+        if (heat < UINT32_MAX - NV_CACHE_HEAT_PER_ACCESS)
+        {
+            heat += NV_CACHE_HEAT_PER_ACCESS;
+        }
+        manager->heatMap[index + regionIter - 1].region = region;
+        manager->heatMap[index + regionIter - 1].heat = heat;
+    }
+    manager->heatCount = newCount;
+    return SUCCESS;
+}
+
+int nv_Cache_Note_Access(nvCacheManager *manager, uint64_t lba, uint64_t length)
+{
+    if (!manager || !manager->device)
+    {
+        return BAD_PARAMETER;
+    }
+    return warm_NV_Cache_Regions(manager, lba, length);
+}
+
+int update_NV_Cache_Heat(nvCacheManager *manager)
+{
+    int ret = SUCCESS;
+    uint8_t missesData[LEGACY_DRIVE_SEC_SIZE] = { 0 };
+    uint32_t keptCount = 0;
+    if (!manager || !manager->device)
+    {
+        return BAD_PARAMETER;
+    }
+    ret = ata_NV_Query_Misses(manager->device, missesData);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+    //cool everything first so that the new misses count in full. Always take at least 1 off so that old regions reach 0 and drop out.
+    for (uint32_t heatIter = 0; heatIter < manager->heatCount; ++heatIter)
+    {
+        uint32_t heat = manager->heatMap[heatIter].heat;
+        heat -= M_Max(heat >> manager->decayShift, UINT32_C(1));
+        if (heat > 0)
+        {
+            manager->heatMap[keptCount].region = manager->heatMap[heatIter].region;
+            manager->heatMap[keptCount].heat = heat;
+            keptCount += 1;
+        }
+    }
+    manager->heatCount = keptCount;
+    //the misses data is a list of LBA range entries, each one a range that was read from the media instead of the NV cache
+    for (uint32_t entryIter = 0; entryIter < NV_CACHE_LBA_RANGE_ENTRIES_PER_BLOCK; ++entryIter)
+    {
+        uint64_t lba = 0;
+        uint16_t length = 0;
+        get_NV_Cache_LBA_Range_Entry(&missesData[entryIter * NV_CACHE_LBA_RANGE_ENTRY_LENGTH], &lba, &length);
+        if (length == 0)
+        {
+            break;
+        }
+        ret = warm_NV_Cache_Regions(manager, lba, length);
+        if (ret != SUCCESS)
+        {
+            break;
+        }
+    }
+    return ret;
+}
+
+static int compare_NV_Cache_Heat(const void *a, const void *b)
+{
+    const nvCacheHeat *first = C_CAST(const nvCacheHeat*, a);
+    const nvCacheHeat *second = C_CAST(const nvCacheHeat*, b);
+    //hottest first. Equal heat keeps LBA order so the result is the same every time.
+    if (first->heat != second->heat)
+    {
+        return first->heat > second->heat ? -1 : 1;
+    }
+    if (first->region != second->region)
+    {
+        return first->region < second->region ? -1 : 1;
+    }
+    return 0;
+}
+
+//adds everything in set that is not in remove to result. Both sets are sorted and have no overlapping intervals.
+static int subtract_LBA_Interval_Set(lbaIntervalSet *set, lbaIntervalSet *remove, lbaIntervalSet *result)
+{
+    int ret = SUCCESS;
+    uint32_t removeIter = 0;
+    for (uint32_t setIter = 0; ret == SUCCESS && setIter < set->intervalCount; ++setIter)
+    {
+        uint64_t start = set->intervals[setIter].startLBA;
+        uint64_t end = start + set->intervals[setIter].length;
+        while (removeIter < remove->intervalCount && remove->intervals[removeIter].startLBA + remove->intervals[removeIter].length <= start)
+        {
+            ++removeIter;
+        }
+        for (uint32_t overlapIter = removeIter; start < end && overlapIter < remove->intervalCount && remove->intervals[overlapIter].startLBA < end; ++overlapIter)
+        {
+            if (remove->intervals[overlapIter].startLBA > start)
+            {
+                ret = add_LBA_Interval(result, start, remove->intervals[overlapIter].startLBA - start);
+                if (ret != SUCCESS)
+                {
+                    break;
+                }
+            }
+            start = M_Max(start, remove->intervals[overlapIter].startLBA + remove->intervals[overlapIter].length);
+        }
+        if (ret == SUCCESS && start < end)
+        {
+            ret = add_LBA_Interval(result, start, end - start);
+        }
+    }
+    return ret;
+}
+
+//sends the intervals as LBA range entries, filling each command's data before starting another
+static int send_NV_Cache_LBA_Ranges(nvCacheManager *manager, lbaIntervalSet *ranges, bool add)
+{
+    int ret = SUCCESS;
+    uint32_t blocksPerCommand = NV_CACHE_MAX_BLOCKS_PER_COMMAND;
+    uint32_t bufferSize = 0;
+    uint32_t maxEntries = 0;
+    uint32_t entryCount = 0;
+    uint8_t *rangeEntries = NULL;
+    if (ranges->intervalCount == 0)
+    {
+        return SUCCESS;
+    }
+    if (get_Passthrough_Max_Transfer_Length(manager->device) >= LEGACY_DRIVE_SEC_SIZE)
+    {
+        blocksPerCommand = M_Min(blocksPerCommand, get_Passthrough_Max_Transfer_Length(manager->device) / LEGACY_DRIVE_SEC_SIZE);
+    }
+    bufferSize = blocksPerCommand * LEGACY_DRIVE_SEC_SIZE;
+    maxEntries = blocksPerCommand * NV_CACHE_LBA_RANGE_ENTRIES_PER_BLOCK;
+    rangeEntries = C_CAST(uint8_t*, calloc_aligned(bufferSize, sizeof(uint8_t), manager->device->os_info.minimumAlignment));
+    if (!rangeEntries)
+    {
+        return MEMORY_FAILURE;
+    }
+    for (uint32_t rangeIter = 0; ret == SUCCESS && rangeIter <= ranges->intervalCount; ++rangeIter)
+    {
+        uint64_t lba = 0;
+        uint64_t remaining = 0;
+        if (rangeIter < ranges->intervalCount)
+        {
+            lba = ranges->intervals[rangeIter].startLBA;
+            remaining = ranges->intervals[rangeIter].length;
+        }
+        do
+        {
+            if (entryCount == maxEntries || (rangeIter == ranges->intervalCount && entryCount > 0))
+            {
+                //only send whole blocks. Unused entries in the last block are zero, which ends the list.
+                uint32_t dataSize = ((entryCount + NV_CACHE_LBA_RANGE_ENTRIES_PER_BLOCK - 1) / NV_CACHE_LBA_RANGE_ENTRIES_PER_BLOCK) * LEGACY_DRIVE_SEC_SIZE;
+                if (add)
+                {
+                    ret = ata_NV_Cache_Add_LBAs_To_Cache(manager->device, manager->populateImmediately, rangeEntries, dataSize);
+                }
+                else
+                {
+                    ret = ata_NV_Remove_LBAs_From_Cache(manager->device, false, rangeEntries, dataSize);
+                }
+                manager->commandsIssued += 1;
+                memset(rangeEntries, 0, bufferSize);
+                entryCount = 0;
+                if (ret != SUCCESS)
+                {
+                    break;
+                }
+            }
+            if (remaining > 0)
+            {
+                uint16_t length = C_CAST(uint16_t, M_Min(remaining, C_CAST(uint64_t, UINT16_MAX)));
+                set_NV_Cache_LBA_Range_Entry(&rangeEntries[entryCount * NV_CACHE_LBA_RANGE_ENTRY_LENGTH], lba, length);
+                entryCount += 1;
+                lba += length;
+                remaining -= length;
+            }
+        } while (remaining > 0);
+    }
+    safe_Free_aligned(rangeEntries)
+    return ret;
+}
+
+int apply_NV_Cache_Pinning(nvCacheManager *manager)
+{
+    int ret = SUCCESS;
+    nvCacheHeat *hottest = NULL;
+    uint64_t targetLBAs = 0;
+    lbaIntervalSet target;
+    lbaIntervalSet toRemove;
+    lbaIntervalSet toAdd;
+    if (!manager || !manager->device)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(&target, 0, sizeof(lbaIntervalSet));
+    memset(&toRemove, 0, sizeof(lbaIntervalSet));
+    memset(&toAdd, 0, sizeof(lbaIntervalSet));
+    if (manager->heatCount > 0)
+    {
+        hottest = C_CAST(nvCacheHeat*, malloc(manager->heatCount * sizeof(nvCacheHeat)));
+        if (!hottest)
+        {
+            return MEMORY_FAILURE;
+        }
+        memcpy(hottest, manager->heatMap, manager->heatCount * sizeof(nvCacheHeat));
+        qsort(hottest, manager->heatCount, sizeof(nvCacheHeat), compare_NV_Cache_Heat);
+    }
+    for (uint32_t heatIter = 0; heatIter < manager->heatCount && targetLBAs < manager->maxPinnedLBAs; ++heatIter)
+    {
+        uint64_t regionLBA = hottest[heatIter].region * manager->granularityLBAs;
+        uint64_t regionLength = M_Min(C_CAST(uint64_t, manager->granularityLBAs), manager->device->drive_info.deviceMaxLba - regionLBA + 1);
+        if (targetLBAs + regionLength > manager->maxPinnedLBAs)
+        {
+            //a cooler region further down the list may still fit
+            continue;
+        }
+        ret = add_LBA_Interval(&target, regionLBA, regionLength);
+        if (ret != SUCCESS)
+        {
+            break;
+        }
+        targetLBAs += regionLength;
+    }
+    safe_Free(hottest)
+    if (ret == SUCCESS)
+    {
+        ret = subtract_LBA_Interval_Set(&manager->pinned, &target, &toRemove);
+    }
+    if (ret == SUCCESS)
+    {
+        ret = subtract_LBA_Interval_Set(&target, &manager->pinned, &toAdd);
+    }
+    if (ret == SUCCESS)
+    {
+        if (target.intervalCount == 0 && manager->pinned.intervalCount > 0)
+        {
+            ret = ata_NV_Remove_LBAs_From_Cache(manager->device, true, NULL, 0);
+            manager->commandsIssued += 1;
+        }
+        else
+        {
+            ret = send_NV_Cache_LBA_Ranges(manager, &toRemove, false);
+        }
+    }
+    if (ret == SUCCESS)
+    {
+        ret = send_NV_Cache_LBA_Ranges(manager, &toAdd, true);
+    }
+    if (ret == SUCCESS)
+    {
+        free_LBA_Interval_Set(&manager->pinned);
+        manager->pinned = target;
+        memset(&target, 0, sizeof(lbaIntervalSet));
+    }
+    else if (ret != MEMORY_FAILURE)
+    {
+        //some of the changes may have been made, so find out what the drive has pinned now
+        read_NV_Cache_Pinned_Set(manager);
+    }
+    free_LBA_Interval_Set(&target);
+    free_LBA_Interval_Set(&toRemove);
+    free_LBA_Interval_Set(&toAdd);
+    return ret;
+}
+
+void free_NV_Cache_Manager(nvCacheManager *manager)
+{
+    if (manager)
+    {
+        safe_Free(manager->heatMap)
+        free_LBA_Interval_Set(&manager->pinned);
+        memset(manager, 0, sizeof(nvCacheManager));
+    }
+}
@@ -620,6 +620,11 @@ int nvme_Firmware_Commit(tDevice *device, nvmeFWCommitAction commitAction, uint8
     {
         print_Return_Enum("Firmware Commit", ret);
     }
+    if (ret == SUCCESS && commitAction == NVME_CA_ACTIVITE_IMMEDIATE)
+    {
+        //new firmware may report different device information
+        invalidate_Lazy_Device_Info(device, LAZY_INFO_ALL);
+    }
     return ret;
 }
 
@@ -650,6 +655,34 @@ int nvme_Identify(tDevice *device, uint8_t *ptrData, uint32_t nvmeNamespace, uin
     return ret;
 }
 
+int nvme_Identify_IO_Command_Set(tDevice *device, uint8_t *ptrData, uint32_t nvmeNamespace, uint8_t cns, uint8_t csi)
+{
+    nvmeCmdCtx identify;
+    int ret = SUCCESS;
+    memset(&identify, 0, sizeof(identify));
+    identify.cmd.adminCmd.opcode = NVME_ADMIN_CMD_IDENTIFY;
+    identify.commandType = NVM_ADMIN_CMD;
+    identify.commandDirection = XFER_DATA_IN;
+    identify.cmd.adminCmd.nsid = nvmeNamespace;
+    identify.cmd.adminCmd.addr = C_CAST(uintptr_t, ptrData);
+    identify.cmd.adminCmd.cdw10 = cns;
+    identify.cmd.adminCmd.cdw11 = C_CAST(uint32_t, csi) << 24;
+    identify.timeout = 15;
+    identify.ptrData = ptrData;
+    identify.dataSize = NVME_IDENTIFY_DATA_LEN;
+
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        printf("Sending NVMe Identify Command (CSI %" PRIu8 ")\n", csi);
+    }
+    ret = nvme_Cmd(device, &identify);
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        print_Return_Enum("Identify", ret);
+    }
+    return ret;
+}
+
 int nvme_Get_Features(tDevice *device, nvmeFeaturesCmdOpt * featCmdOpts)
 {
     int ret = UNKNOWN; 
@@ -874,7 +907,10 @@ int nvme_Format(tDevice *device, nvmeFormatCmdOpts * formatCmdOpts)
     {
         print_Return_Enum("Format", ret);
     }
-
+    if (ret == SUCCESS)
+    {
+        invalidate_Lazy_Device_Info(device, LAZY_INFO_CAPACITY);
+    }
     return ret;
 }
 
@@ -1029,6 +1065,197 @@ int nvme_Reservation_Release(tDevice *device, uint8_t reservationType, bool igno
     return ret;
 }
 
+int nvme_Copy(tDevice *device, uint64_t destinationLBA, uint8_t numberOfRanges, uint8_t descriptorFormat, bool limitedRetry, bool fua, uint8_t *ptrData, uint32_t dataLength, uint32_t timeoutSeconds)
+{
+    int ret = UNKNOWN;
+    nvmeCmdCtx nvmCmd;
+    memset(&nvmCmd, 0, sizeof(nvmeCmdCtx));
+    nvmCmd.cmd.nvmCmd.opcode = NVME_CMD_COPY;
+    nvmCmd.cmd.nvmCmd.nsid = device->drive_info.namespaceID;
+    nvmCmd.cmd.nvmCmd.prp1 = C_CAST(uintptr_t, ptrData);
+    nvmCmd.commandDirection = XFER_DATA_OUT;
+    nvmCmd.commandType = NVM_CMD;
+    nvmCmd.dataSize = dataLength;
+    nvmCmd.device = device;
+    nvmCmd.ptrData = ptrData;
+    nvmCmd.timeout = timeoutSeconds > 0 ? timeoutSeconds : 15;
+
+    //sdlba
+    nvmCmd.cmd.nvmCmd.cdw10 = M_DoubleWord0(destinationLBA);
+    nvmCmd.cmd.nvmCmd.cdw11 = M_DoubleWord1(destinationLBA);
+    //number of ranges is 0 based
+    nvmCmd.cmd.nvmCmd.cdw12 = numberOfRanges;
+    nvmCmd.cmd.nvmCmd.cdw12 |= C_CAST(uint32_t, M_Nibble0(descriptorFormat)) << 8;
+    if (limitedRetry)
+    {
+        nvmCmd.cmd.nvmCmd.cdw12 |= BIT31;
+    }
+    if (fua)
+    {
+        nvmCmd.cmd.nvmCmd.cdw12 |= BIT30;
+    }
+
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        printf("Sending NVMe Copy Command\n");
+    }
+
+    ret = nvme_Cmd(device, &nvmCmd);
+
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        print_Return_Enum("Copy", ret);
+    }
+
+    return ret;
+}
+
+int nvme_Zone_Management_Send(tDevice *device, uint64_t startingLBA, bool selectAll, uint8_t zoneSendAction, uint8_t *ptrData, uint32_t dataLength)
+{
+    int ret = UNKNOWN;
+    nvmeCmdCtx nvmCmd;
+    memset(&nvmCmd, 0, sizeof(nvmeCmdCtx));
+    nvmCmd.cmd.nvmCmd.opcode = NVME_CMD_ZONE_MANAGEMENT_SEND;
+    nvmCmd.cmd.nvmCmd.nsid = device->drive_info.namespaceID;
+    nvmCmd.cmd.nvmCmd.prp1 = C_CAST(uintptr_t, ptrData);
+    nvmCmd.commandDirection = XFER_DATA_OUT;//opcode says data out, but only set zone descriptor extension transfers any
+    nvmCmd.commandType = NVM_CMD;
+    nvmCmd.dataSize = dataLength;
+    nvmCmd.device = device;
+    nvmCmd.ptrData = ptrData;
+    nvmCmd.timeout = 15;
+
+    //slba
+    nvmCmd.cmd.nvmCmd.cdw10 = M_DoubleWord0(startingLBA);
+    nvmCmd.cmd.nvmCmd.cdw11 = M_DoubleWord1(startingLBA);
+    nvmCmd.cmd.nvmCmd.cdw13 = zoneSendAction;
+    if (selectAll)
+    {
+        nvmCmd.cmd.nvmCmd.cdw13 |= BIT8;
+    }
+
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        printf("Sending NVMe Zone Management Send Command\n");
+    }
+
+    ret = nvme_Cmd(device, &nvmCmd);
+
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        print_Return_Enum("Zone Management Send", ret);
+    }
+
+    return ret;
+}
+
+int nvme_Zone_Management_Receive(tDevice *device, uint64_t startingLBA, uint8_t zoneReceiveAction, uint8_t reportingOptions, bool partial, uint8_t *ptrData, uint32_t dataLength)
+{
+    int ret = UNKNOWN;
+    nvmeCmdCtx nvmCmd;
+    if (dataLength < 4 || dataLength % 4 != 0)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(&nvmCmd, 0, sizeof(nvmeCmdCtx));
+    nvmCmd.cmd.nvmCmd.opcode = NVME_CMD_ZONE_MANAGEMENT_RECEIVE;
+    nvmCmd.cmd.nvmCmd.nsid = device->drive_info.namespaceID;
+    nvmCmd.cmd.nvmCmd.prp1 = C_CAST(uintptr_t, ptrData);
+    nvmCmd.commandDirection = XFER_DATA_IN;
+    nvmCmd.commandType = NVM_CMD;
+    nvmCmd.dataSize = dataLength;
+    nvmCmd.device = device;
+    nvmCmd.ptrData = ptrData;
+    nvmCmd.timeout = 15;
+
+    //slba
+    nvmCmd.cmd.nvmCmd.cdw10 = M_DoubleWord0(startingLBA);
+    nvmCmd.cmd.nvmCmd.cdw11 = M_DoubleWord1(startingLBA);
+    //number of dwords, 0 based
+    nvmCmd.cmd.nvmCmd.cdw12 = (dataLength / 4) - 1;
+    nvmCmd.cmd.nvmCmd.cdw13 = zoneReceiveAction | (C_CAST(uint32_t, reportingOptions) << 8);
+    if (partial)
+    {
+        nvmCmd.cmd.nvmCmd.cdw13 |= BIT16;
+    }
+
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        printf("Sending NVMe Zone Management Receive Command\n");
+    }
+
+    ret = nvme_Cmd(device, &nvmCmd);
+
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        print_Return_Enum("Zone Management Receive", ret);
+    }
+
+    return ret;
+}
+
+int nvme_Zone_Append(tDevice *device, uint64_t zoneStartLBA, uint16_t numberOfLogicalBlocks, bool fua, uint8_t *ptrData, uint32_t dataLength, uint64_t *assignedLBA)
+{
+    int ret = UNKNOWN;
+    nvmeCmdCtx nvmCmd;
+    memset(&nvmCmd, 0, sizeof(nvmeCmdCtx));
+    nvmCmd.cmd.nvmCmd.opcode = NVME_CMD_ZONE_APPEND;
+    nvmCmd.cmd.nvmCmd.nsid = device->drive_info.namespaceID;
+    nvmCmd.cmd.nvmCmd.prp1 = C_CAST(uintptr_t, ptrData);
+    nvmCmd.commandDirection = XFER_DATA_OUT;
+    nvmCmd.commandType = NVM_CMD;
+    nvmCmd.dataSize = dataLength;
+    nvmCmd.device = device;
+    nvmCmd.ptrData = ptrData;
+    nvmCmd.timeout = 15;
+
+    //zslba
+    nvmCmd.cmd.nvmCmd.cdw10 = M_DoubleWord0(zoneStartLBA);
+    nvmCmd.cmd.nvmCmd.cdw11 = M_DoubleWord1(zoneStartLBA);
+    nvmCmd.cmd.nvmCmd.cdw12 = numberOfLogicalBlocks;
+    if (fua)
+    {
+        nvmCmd.cmd.nvmCmd.cdw12 |= BIT30;
+    }
+
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        printf("Sending NVMe Zone Append Command\n");
+    }
+
+    ret = nvme_Cmd(device, &nvmCmd);
+
+    if (ret == SUCCESS && assignedLBA)
+    {
+        //The LBA the data was written at is returned in DW0 and DW1 of the completion.
+        //The data has been written either way, so this is still SUCCESS when the OS does not return it. Failing here would get the data appended again on a retry.
+        if (!nvmCmd.commandCompletionData.dw0Valid)
+        {
+            *assignedLBA = UINT64_MAX;
+        }
+        else if (nvmCmd.commandCompletionData.dw1Valid)
+        {
+            *assignedLBA = M_DWordsTo8ByteValue(nvmCmd.commandCompletionData.dw1, nvmCmd.commandCompletionData.dw0);
+        }
+        else
+        {
+            //Only DW0 came back from the OS. The LBA is in the zone, and zones are much smaller than 4G LBAs, so the upper bits come from the zone start LBA.
+            *assignedLBA = (zoneStartLBA & UINT64_C(0xFFFFFFFF00000000)) | nvmCmd.commandCompletionData.dw0;
+            if (*assignedLBA < zoneStartLBA)
+            {
+                *assignedLBA += UINT64_C(0x100000000);
+            }
+        }
+    }
+
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        print_Return_Enum("Zone Append", ret);
+    }
+
+    return ret;
+}
+
 int nvme_Read_Ctrl_Reg(tDevice *device, nvmeBarCtrlRegisters * ctrlRegs)
 {
     int ret = UNKNOWN;
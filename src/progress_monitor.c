@@ -0,0 +1,516 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file progress_monitor.c
+// \brief Defines a single threaded monitor that polls long running operations on many devices from a timer wheel.
+
+#include "progress_monitor.h"
+#include "ata_helper_func.h"
+#include "scsi_helper_func.h"
+#include "nvme_helper_func.h"
+
+static int get_ATA_Operation_Progress(tDevice *device, eMonitoredOperation operation, operationProgress *progress)
+{
+    int ret = SUCCESS;
+    switch (operation)
+    {
+    case MONITORED_OPERATION_SANITIZE:
+        ret = ata_Sanitize_Status(device, false);
+        //count bit 14 = sanitize in progress, count bit 15 = completed without error. LBA 15:0 = progress indicator
+        if (device->drive_info.lastCommandRTFRs.secCntExt & BIT6)
+        {
+            progress->state = MONITORED_OPERATION_STATE_IN_PROGRESS;
+            progress->percentValid = true;
+            progress->percentComplete = M_BytesTo2ByteValue(device->drive_info.lastCommandRTFRs.lbaMid, device->drive_info.lastCommandRTFRs.lbaLow) * 100.0 / 65536.0;
+            ret = SUCCESS;
+        }
+        else if (ret == SUCCESS)
+        {
+            progress->state = (device->drive_info.lastCommandRTFRs.secCntExt & BIT7) ? MONITORED_OPERATION_STATE_COMPLETE : MONITORED_OPERATION_STATE_FAILED;
+        }
+        else if (device->drive_info.lastCommandRTFRs.error & ATA_ERROR_BIT_ABORT)
+        {
+            //the device is in the sanitize operation failed state
+            progress->state = MONITORED_OPERATION_STATE_FAILED;
+            ret = SUCCESS;
+        }
+        break;
+    case MONITORED_OPERATION_SELF_TEST:
+    {
+        uint8_t smartData[LEGACY_DRIVE_SEC_SIZE] = { 0 };
+        ret = ata_SMART_Read_Data(device, smartData, LEGACY_DRIVE_SEC_SIZE);
+        if (ret == SUCCESS)
+        {
+            //self-test execution status: bits 7:4 = status, bits 3:0 = percent remaining in 10% units
+            uint8_t status = M_Nibble1(smartData[ATA_SMART_SELF_TEST_EXECUTION_STATUS_OFFSET]);
+            if (status == 0x0F)
+            {
+                progress->state = MONITORED_OPERATION_STATE_IN_PROGRESS;
+                progress->percentValid = true;
+                progress->percentComplete = 100.0 - (M_Nibble0(smartData[ATA_SMART_SELF_TEST_EXECUTION_STATUS_OFFSET]) * 10.0);
+            }
+            else
+            {
+                progress->state = status == 0 ? MONITORED_OPERATION_STATE_COMPLETE : MONITORED_OPERATION_STATE_FAILED;
+            }
+        }
+    }
+        break;
+    default:
+        ret = NOT_SUPPORTED;
+        break;
+    }
+    return ret;
+}
+
+static int get_SCSI_Operation_Progress(tDevice *device, eMonitoredOperation operation, operationProgress *progress)
+{
+    int ret = SUCCESS;
+    uint8_t senseData[SPC3_SENSE_LEN] = { 0 };
+    senseDataFields senseFields;
+    uint8_t inProgressASCQ = 0;
+    memset(&senseFields, 0, sizeof(senseDataFields));
+    switch (operation)
+    {
+    case MONITORED_OPERATION_SANITIZE:
+        inProgressASCQ = 0x1B;
+        break;
+    case MONITORED_OPERATION_SELF_TEST:
+        inProgressASCQ = 0x09;
+        break;
+    case MONITORED_OPERATION_FORMAT:
+        inProgressASCQ = 0x04;
+        break;
+    default:
+        return NOT_SUPPORTED;
+    }
+    ret = scsi_Request_Sense_Cmd(device, false, senseData, SPC3_SENSE_LEN);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+    get_Sense_Data_Fields(senseData, SPC3_SENSE_LEN, &senseFields);
+    if (senseFields.scsiStatusCodes.senseKey == SENSE_KEY_NOT_READY && senseFields.scsiStatusCodes.asc == 0x04 && senseFields.scsiStatusCodes.ascq == inProgressASCQ)
+    {
+        progress->state = MONITORED_OPERATION_STATE_IN_PROGRESS;
+        if (senseFields.senseKeySpecificInformation.senseKeySpecificValid && senseFields.senseKeySpecificInformation.type == SENSE_KEY_SPECIFIC_PROGRESS_INDICATION)
+        {
+            progress->percentValid = true;
+            progress->percentComplete = senseFields.senseKeySpecificInformation.progress.progressIndication * 100.0 / 65536.0;
+        }
+        return SUCCESS;
+    }
+    switch (operation)
+    {
+    case MONITORED_OPERATION_SANITIZE:
+        //sanitize command failed
+        progress->state = (senseFields.scsiStatusCodes.asc == 0x31 && senseFields.scsiStatusCodes.ascq == 0x03) ? MONITORED_OPERATION_STATE_FAILED : MONITORED_OPERATION_STATE_COMPLETE;
+        break;
+    case MONITORED_OPERATION_FORMAT:
+        //medium format corrupted or format command failed
+        progress->state = (senseFields.scsiStatusCodes.asc == 0x31 && senseFields.scsiStatusCodes.ascq <= 0x01) ? MONITORED_OPERATION_STATE_FAILED : MONITORED_OPERATION_STATE_COMPLETE;
+        break;
+    case MONITORED_OPERATION_SELF_TEST:
+    {
+        //background self-tests only show up in the self-test results log page. The first parameter is the most recent self-test.
+        uint8_t selfTestResults[LP_SELF_TEST_RESULTS_LEN] = { 0 };
+        ret = scsi_Log_Sense_Cmd(device, false, LPC_CUMULATIVE_VALUES, LP_SELF_TEST_RESULTS, 0, 0, selfTestResults, LP_SELF_TEST_RESULTS_LEN);
+        if (ret == SUCCESS)
+        {
+            uint8_t result = M_Nibble0(selfTestResults[8]);
+            if (result == 0x0F)
+            {
+                progress->state = MONITORED_OPERATION_STATE_IN_PROGRESS;
+            }
+            else
+            {
+                progress->state = result == 0 ? MONITORED_OPERATION_STATE_COMPLETE : MONITORED_OPERATION_STATE_FAILED;
+            }
+        }
+    }
+        break;
+    default:
+        break;
+    }
+    return ret;
+}
+
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+static int get_NVMe_Operation_Progress(tDevice *device, eMonitoredOperation operation, operationProgress *progress)
+{
+    int ret = SUCCESS;
+    uint8_t *data = C_CAST(uint8_t*, calloc_aligned(NVME_IDENTIFY_DATA_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+    nvmeGetLogPageCmdOpts getLogPage;
+    if (!data)
+    {
+        return MEMORY_FAILURE;
+    }
+    memset(&getLogPage, 0, sizeof(nvmeGetLogPageCmdOpts));
+    getLogPage.addr = data;
+    getLogPage.nsid = UINT32_MAX;//both logs are for the whole controller
+    switch (operation)
+    {
+    case MONITORED_OPERATION_SANITIZE:
+        getLogPage.lid = NVME_LOG_SANITIZE_ID;
+        getLogPage.dataLen = 512;
+        ret = nvme_Get_Log_Page(device, &getLogPage);
+        if (ret == SUCCESS)
+        {
+            //sanitize status bits 2:0: 1 = completed, 2 = in progress, 3 = failed, 4 = completed with no-deallocate inhibited
+            switch (M_GETBITRANGE(data[2], 2, 0))
+            {
+            case 2:
+                progress->state = MONITORED_OPERATION_STATE_IN_PROGRESS;
+                progress->percentValid = true;
+                progress->percentComplete = M_BytesTo2ByteValue(data[1], data[0]) * 100.0 / 65536.0;
+                break;
+            case 3:
+                progress->state = MONITORED_OPERATION_STATE_FAILED;
+                break;
+            default:
+                progress->state = MONITORED_OPERATION_STATE_COMPLETE;
+                break;
+            }
+        }
+        break;
+    case MONITORED_OPERATION_SELF_TEST:
+        getLogPage.lid = NVME_LOG_DEV_SELF_TEST;
+        getLogPage.dataLen = 564;
+        ret = nvme_Get_Log_Page(device, &getLogPage);
+        if (ret == SUCCESS)
+        {
+            //byte 0 = current self-test operation, byte 1 = percent complete. The newest result starts at byte 4.
+            if (M_Nibble0(data[0]) != 0)
+            {
+                progress->state = MONITORED_OPERATION_STATE_IN_PROGRESS;
+                progress->percentValid = true;
+                progress->percentComplete = M_GETBITRANGE(data[1], 6, 0);
+            }
+            else
+            {
+                uint8_t result = M_Nibble0(data[4]);
+                progress->state = (result == 0 || result == 0x0F) ? MONITORED_OPERATION_STATE_COMPLETE : MONITORED_OPERATION_STATE_FAILED;
+            }
+        }
+        break;
+    case MONITORED_OPERATION_FORMAT:
+        ret = nvme_Identify(device, data, device->drive_info.namespaceID, NVME_IDENTIFY_NS);
+        if (ret == SUCCESS)
+        {
+            //format progress indicator: bit 7 = supported, bits 6:0 = percent remaining
+            if (!(data[32] & BIT7))
+            {
+                ret = NOT_SUPPORTED;
+            }
+            else if (M_GETBITRANGE(data[32], 6, 0) > 0)
+            {
+                progress->state = MONITORED_OPERATION_STATE_IN_PROGRESS;
+                progress->percentValid = true;
+                progress->percentComplete = 100.0 - M_GETBITRANGE(data[32], 6, 0);
+            }
+            else
+            {
+                progress->state = MONITORED_OPERATION_STATE_COMPLETE;
+            }
+        }
+        break;
+    default:
+        ret = NOT_SUPPORTED;
+        break;
+    }
+    safe_Free_aligned(data)
+    return ret;
+}
+#endif //DISABLE_NVME_PASSTHROUGH
+
+int get_Operation_Progress(tDevice *device, eMonitoredOperation operation, operationProgress *progress)
+{
+    int ret = NOT_SUPPORTED;
+    if (!device || !progress)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(progress, 0, sizeof(operationProgress));
+    switch (device->drive_info.drive_type)
+    {
+    case ATA_DRIVE:
+        ret = get_ATA_Operation_Progress(device, operation, progress);
+        break;
+    case NVME_DRIVE:
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+        ret = get_NVMe_Operation_Progress(device, operation, progress);
+        break;
+#else
+        //rely on SCSI translation
+#endif
+    case SCSI_DRIVE:
+        ret = get_SCSI_Operation_Progress(device, operation, progress);
+        break;
+    default:
+        break;
+    }
+    if (ret != SUCCESS)
+    {
+        progress->state = MONITORED_OPERATION_STATE_ERROR;
+    }
+    else if (progress->state != MONITORED_OPERATION_STATE_IN_PROGRESS)
+    {
+        progress->percentValid = true;
+        progress->percentComplete = 100.0;
+    }
+    return ret;
+}
+
+int init_Progress_Monitor(progressMonitor *monitor, progressMonitorOptions *options)
+{
+    if (!monitor)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(monitor, 0, sizeof(progressMonitor));
+    monitor->tickMilliseconds = PROGRESS_MONITOR_DEFAULT_TICK_MILLISECONDS;
+    monitor->minIntervalMilliseconds = PROGRESS_MONITOR_DEFAULT_MIN_INTERVAL_MILLISECONDS;
+    monitor->maxIntervalMilliseconds = PROGRESS_MONITOR_DEFAULT_MAX_INTERVAL_MILLISECONDS;
+    if (options)
+    {
+        if (options->tickMilliseconds > 0)
+        {
+            monitor->tickMilliseconds = options->tickMilliseconds;
+        }
+        if (options->minIntervalMilliseconds > 0)
+        {
+            monitor->minIntervalMilliseconds = options->minIntervalMilliseconds;
+        }
+        if (options->maxIntervalMilliseconds > 0)
+        {
+            monitor->maxIntervalMilliseconds = options->maxIntervalMilliseconds;
+        }
+    }
+    monitor->maxIntervalMilliseconds = M_Max(monitor->maxIntervalMilliseconds, monitor->minIntervalMilliseconds);
+    for (uint32_t slotIter = 0; slotIter < PROGRESS_MONITOR_WHEEL_SLOTS; ++slotIter)
+    {
+        monitor->wheel[slotIter] = UINT32_MAX;
+    }
+    start_Timer(&monitor->clock);
+    return SUCCESS;
+}
+
+static uint64_t get_Progress_Monitor_Milliseconds(progressMonitor *monitor)
+{
+    stop_Timer(&monitor->clock);
+    return get_Nano_Seconds(monitor->clock) / UINT64_C(1000000);
+}
+
+//puts the operation in the wheel slot for the tick intervalMilliseconds from now. Ticks past one turn of the wheel wait in the slot until their turn comes around.
+static void schedule_Monitored_Operation(progressMonitor *monitor, uint32_t operationID, uint64_t nowMilliseconds)
+{
+    monitoredOperation *operation = &monitor->operations[operationID];
+    uint64_t dueTick = (nowMilliseconds + operation->intervalMilliseconds + monitor->tickMilliseconds - 1) / monitor->tickMilliseconds;
+    operation->dueTick = M_Max(dueTick, monitor->processedTick + 1);
+    operation->nextInSlot = monitor->wheel[operation->dueTick % PROGRESS_MONITOR_WHEEL_SLOTS];
+    monitor->wheel[operation->dueTick % PROGRESS_MONITOR_WHEEL_SLOTS] = operationID;
+}
+
+int add_Monitored_Operation(progressMonitor *monitor, tDevice *device, eMonitoredOperation operation, progressMonitorCallback callback, void *callbackData, bool progressUpdates, uint32_t *operationID)
+{
+    monitoredOperation *newOperation = NULL;
+    if (!monitor || !device || monitor->tickMilliseconds == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    if (monitor->operationCount == monitor->operationCapacity)
+    {
+        uint32_t newCapacity = monitor->operationCapacity == 0 ? UINT32_C(16) : monitor->operationCapacity * 2;
+        monitoredOperation *newOperations = C_CAST(monitoredOperation*, realloc(monitor->operations, newCapacity * sizeof(monitoredOperation)));
+        if (!newOperations)
+        {
+            return MEMORY_FAILURE;
+        }
+        monitor->operations = newOperations;
+        monitor->operationCapacity = newCapacity;
+    }
+    newOperation = &monitor->operations[monitor->operationCount];
+    memset(newOperation, 0, sizeof(monitoredOperation));
+    newOperation->device = device;
+    newOperation->operation = operation;
+    newOperation->callback = callback;
+    newOperation->callbackData = callbackData;
+    newOperation->progressUpdates = progressUpdates;
+    newOperation->active = true;
+    newOperation->progress.state = MONITORED_OPERATION_STATE_IN_PROGRESS;
+    newOperation->intervalMilliseconds = monitor->minIntervalMilliseconds;
+    newOperation->lastPollMilliseconds = get_Progress_Monitor_Milliseconds(monitor);
+    if (operationID)
+    {
+        *operationID = monitor->operationCount;
+    }
+    monitor->operationCount += 1;
+    monitor->activeCount += 1;
+    schedule_Monitored_Operation(monitor, monitor->operationCount - 1, newOperation->lastPollMilliseconds);
+    return SUCCESS;
+}
+
+//Picks the time to the next poll from how fast the operation has been moving
+static void update_Poll_Interval(progressMonitor *monitor, monitoredOperation *operation, uint64_t nowMilliseconds)
+{
+    uint64_t interval = C_CAST(uint64_t, operation->intervalMilliseconds) * 2;
+    if (operation->progress.percentValid && operation->progress.percentComplete > operation->lastPercentComplete && nowMilliseconds > operation->lastPollMilliseconds)
+    {
+        double percentPerMillisecond = (operation->progress.percentComplete - operation->lastPercentComplete) / C_CAST(double, nowMilliseconds - operation->lastPollMilliseconds);
+        double remainingMilliseconds = (100.0 - operation->progress.percentComplete) / percentPerMillisecond;
+        //a quarter of the time left keeps polls frequent near the end without wasting them at the start
+        interval = remainingMilliseconds / 4.0 > C_CAST(double, UINT32_MAX) ? UINT32_MAX : C_CAST(uint64_t, remainingMilliseconds / 4.0);
+    }
+    interval = M_Max(interval, C_CAST(uint64_t, monitor->minIntervalMilliseconds));
+    interval = M_Min(interval, C_CAST(uint64_t, monitor->maxIntervalMilliseconds));
+    operation->intervalMilliseconds = C_CAST(uint32_t, interval);
+    operation->lastPercentComplete = operation->progress.percentComplete;
+    operation->lastPollMilliseconds = nowMilliseconds;
+}
+
+int progress_Monitor_Poll(progressMonitor *monitor, uint32_t *millisecondsToNextPoll)
+{
+    uint64_t nowMilliseconds = 0;
+    uint64_t nowTick = 0;
+    uint64_t firstTick = 0;
+    uint32_t dueList = UINT32_MAX;
+    if (!monitor || monitor->tickMilliseconds == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    nowMilliseconds = get_Progress_Monitor_Milliseconds(monitor);
+    nowTick = nowMilliseconds / monitor->tickMilliseconds;
+    //after a long gap, one turn of the wheel covers every slot
+    firstTick = M_Max(monitor->processedTick + 1, nowTick >= PROGRESS_MONITOR_WHEEL_SLOTS ? nowTick - PROGRESS_MONITOR_WHEEL_SLOTS + 1 : 0);
+    for (uint64_t tick = firstTick; tick <= nowTick; ++tick)
+    {
+        //take the operations that are due out of the slot. The rest are waiting for a later turn of the wheel.
+        uint32_t *link = &monitor->wheel[tick % PROGRESS_MONITOR_WHEEL_SLOTS];
+        while (*link != UINT32_MAX)
+        {
+            uint32_t operationID = *link;
+            if (monitor->operations[operationID].dueTick <= nowTick)
+            {
+                *link = monitor->operations[operationID].nextInSlot;
+                monitor->operations[operationID].nextInSlot = dueList;
+                dueList = operationID;
+            }
+            else
+            {
+                link = &monitor->operations[operationID].nextInSlot;
+            }
+        }
+    }
+    monitor->processedTick = M_Max(monitor->processedTick, nowTick);
+    while (dueList != UINT32_MAX)
+    {
+        uint32_t operationID = dueList;
+        monitoredOperation *operation = &monitor->operations[operationID];
+        operationProgress progress;
+        dueList = operation->nextInSlot;
+        get_Operation_Progress(operation->device, operation->operation, &operation->progress);
+        operation->pollCount += 1;
+        //the callback gets a copy since adding an operation from the callback can move the operations array
+        progress = operation->progress;
+        if (progress.state == MONITORED_OPERATION_STATE_IN_PROGRESS)
+        {
+            if (operation->progressUpdates && operation->callback)
+            {
+                operation->callback(operation->device, operation->operation, &progress, operation->callbackData);
+                operation = &monitor->operations[operationID];
+            }
+            update_Poll_Interval(monitor, operation, nowMilliseconds);
+            schedule_Monitored_Operation(monitor, operationID, nowMilliseconds);
+        }
+        else
+        {
+            operation->active = false;
+            monitor->activeCount -= 1;
+            if (operation->callback)
+            {
+                operation->callback(operation->device, operation->operation, &progress, operation->callbackData);
+            }
+        }
+    }
+    if (millisecondsToNextPoll)
+    {
+        uint64_t nextDueTick = UINT64_MAX;
+        for (uint32_t operationIter = 0; operationIter < monitor->operationCount; ++operationIter)
+        {
+            if (monitor->operations[operationIter].active)
+            {
+                nextDueTick = M_Min(nextDueTick, monitor->operations[operationIter].dueTick);
+            }
+        }
+        *millisecondsToNextPoll = UINT32_MAX;
+        if (nextDueTick != UINT64_MAX)
+        {
+            uint64_t dueMilliseconds = nextDueTick * monitor->tickMilliseconds;
+            *millisecondsToNextPoll = C_CAST(uint32_t, M_Min(dueMilliseconds > nowMilliseconds ? dueMilliseconds - nowMilliseconds : UINT64_C(0), C_CAST(uint64_t, UINT32_MAX - 1)));
+        }
+    }
+    return SUCCESS;
+}
+
+int run_Progress_Monitor(progressMonitor *monitor, volatile bool *stopMonitor)
+{
+    if (!monitor)
+    {
+        return BAD_PARAMETER;
+    }
+    while (monitor->activeCount > 0)
+    {
+        uint32_t millisecondsToNextPoll = 0;
+        int ret = progress_Monitor_Poll(monitor, &millisecondsToNextPoll);
+        if (ret != SUCCESS)
+        {
+            return ret;
+        }
+        if (monitor->activeCount == 0)
+        {
+            break;
+        }
+        //sleep in ticks so that a stop request is noticed quickly
+        while (millisecondsToNextPoll > 0)
+        {
+            uint32_t sleepMilliseconds = M_Min(millisecondsToNextPoll, monitor->tickMilliseconds);
+            if (stopMonitor && *stopMonitor)
+            {
+                return ABORTED;
+            }
+            delay_Milliseconds(sleepMilliseconds);
+            millisecondsToNextPoll -= sleepMilliseconds;
+        }
+        if (stopMonitor && *stopMonitor)
+        {
+            return ABORTED;
+        }
+    }
+    return SUCCESS;
+}
+
+int get_Monitored_Operation_Progress(progressMonitor *monitor, uint32_t operationID, operationProgress *progress)
+{
+    if (!monitor || !progress || operationID >= monitor->operationCount)
+    {
+        return BAD_PARAMETER;
+    }
+    *progress = monitor->operations[operationID].progress;
+    return SUCCESS;
+}
+
+void free_Progress_Monitor(progressMonitor *monitor)
+{
+    if (monitor)
+    {
+        safe_Free(monitor->operations)
+        memset(monitor, 0, sizeof(progressMonitor));
+    }
+}
@@ -164,7 +164,7 @@ int send_PSP_Legacy_Passthrough_Command(tDevice *device, ataPassthroughCommand *
     bool localSenseData = false;
     if (!ataCommandOptions->ptrSenseData)
     {
-        senseData = C_CAST(uint8_t*, calloc_aligned(SPC3_SENSE_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+        senseData = borrow_Command_Buffer(device, SPC3_SENSE_LEN);
         if (!senseData)
         {
             return MEMORY_FAILURE;
@@ -215,7 +215,7 @@ int send_PSP_Legacy_Passthrough_Command(tDevice *device, ataPassthroughCommand *
     memset(device->drive_info.lastCommandSenseData, 0, SPC3_SENSE_LEN);//clear before copying over data
     memcpy(&device->drive_info.lastCommandSenseData[0], &ataCommandOptions->ptrSenseData, M_Min(SPC3_SENSE_LEN, ataCommandOptions->senseDataSize));
     memcpy(&device->drive_info.lastCommandRTFRs, &ataCommandOptions->rtfr, sizeof(ataReturnTFRs));
-    safe_Free_aligned(senseData)
+    return_Command_Buffer(device, &senseData);
     if (localSenseData)
     {
         ataCommandOptions->ptrSenseData = NULL;
@@ -19,6 +19,7 @@
 #include "sat_helper_func.h"
 #include "ata_helper_func.h"
 #include "platform_helper.h"
+#include "cmds.h"
 
 //the define below is to switch between different levels of SAT spec support. It is recommended that this is set to the highest version available
 //valid values are 1 - 4
@@ -53,7 +54,7 @@
 int get_Return_TFRs_From_Passthrough_Results_Log(tDevice *device, ataReturnTFRs *ataRTFRs, uint16_t parameterCode)
 {
     int ret = NOT_SUPPORTED;//Many devices don't support this log page.
-    uint8_t *sense70logBuffer = C_CAST(uint8_t*, calloc_aligned(14 + LOG_PAGE_HEADER_LENGTH, sizeof(uint8_t), device->os_info.minimumAlignment));//allocate a buffer to get the rtfrs in. the size of 12 is ATA Passthrough Descriptor + 4byte log page header
+    uint8_t *sense70logBuffer = borrow_Command_Buffer(device, 14 + LOG_PAGE_HEADER_LENGTH);//allocate a buffer to get the rtfrs in. the size of 12 is ATA Passthrough Descriptor + 4byte log page header
     if (!sense70logBuffer)
     {
         perror("Calloc Failure!\n");
@@ -98,7 +99,7 @@ int get_Return_TFRs_From_Passthrough_Results_Log(tDevice *device, ataReturnTFRs
             }
         }
     }
-    safe_Free_aligned(sense70logBuffer)
+    return_Command_Buffer(device, &sense70logBuffer);
     return ret;
 }
 
@@ -268,7 +269,7 @@ int get_RTFRs_From_Fixed_Format_Sense_Data(tDevice *device, uint8_t *ptrSenseDat
             if (ret != SUCCESS)
             {
                 //request descriptor format data
-                uint8_t *descriptorFormatSenseData = C_CAST(uint8_t*, calloc_aligned(SPC3_SENSE_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+                uint8_t *descriptorFormatSenseData = borrow_Command_Buffer(device, SPC3_SENSE_LEN);
                 if (!descriptorFormatSenseData)
                 {
                     return MEMORY_FAILURE;
@@ -278,7 +279,7 @@ int get_RTFRs_From_Fixed_Format_Sense_Data(tDevice *device, uint8_t *ptrSenseDat
                 {
                     ret = get_RTFRs_From_Descriptor_Format_Sense_Data(descriptorFormatSenseData, SPC3_SENSE_LEN, rtfr);
                 }
-                safe_Free_aligned(descriptorFormatSenseData)
+                return_Command_Buffer(device, &descriptorFormatSenseData);
             }
         }
         //Some devices say passthrough info available, but populate nothing...so need to set this error!
@@ -697,8 +698,8 @@ int request_Return_TFRs_From_Device(tDevice *device, ataReturnTFRs *rtfr)
 {
     //try and issue a request for the RTFRs...we'll see if this actually works
     int rtfrRet = NOT_SUPPORTED;//by default, most devices don't actually support this SAT command
-    uint8_t *rtfrBuffer = C_CAST(uint8_t*, calloc_aligned(14, sizeof(uint8_t), device->os_info.minimumAlignment));//this size is the size of the ATA pass through descriptor which is all that should be returned from the SATL with this command
-    uint8_t *rtfr_senseData = C_CAST(uint8_t*, calloc_aligned(SPC3_SENSE_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+    uint8_t *rtfrBuffer = borrow_Command_Buffer(device, 14);//this size is the size of the ATA pass through descriptor which is all that should be returned from the SATL with this command
+    uint8_t *rtfr_senseData = borrow_Command_Buffer(device, SPC3_SENSE_LEN);
     uint8_t *requestRTFRs = NULL;
     uint8_t cdbLen = CDB_LEN_12;
     uint8_t protocolOffset = SAT_PROTOCOL_OFFSET;
@@ -708,13 +709,13 @@ int request_Return_TFRs_From_Device(tDevice *device, ataReturnTFRs *rtfr)
         cdbLen = CDB_LEN_16;
     }
     //TODO: Not sure if there should be a "force" CDB size for this request or not at this time. With the other hacks, this should just work when a given SATL supports this request...-TJE
-    requestRTFRs = C_CAST(uint8_t*, calloc_aligned(cdbLen, sizeof(uint8_t), device->os_info.minimumAlignment));
+    requestRTFRs = borrow_Command_Buffer(device, cdbLen);
     if (!rtfrBuffer || !rtfr_senseData || !requestRTFRs)
     {
         perror("Calloc aligned Failure!\n");
-        safe_Free_aligned(rtfrBuffer)
-        safe_Free_aligned(rtfr_senseData)
-        safe_Free_aligned(requestRTFRs)
+        return_Command_Buffer(device, &rtfrBuffer);
+        return_Command_Buffer(device, &rtfr_senseData);
+        return_Command_Buffer(device, &requestRTFRs);
         return MEMORY_FAILURE;
     }
     //Set the op code up for the size of the CDB
@@ -744,9 +745,9 @@ int request_Return_TFRs_From_Device(tDevice *device, ataReturnTFRs *rtfr)
     }
     else
     {
-        safe_Free_aligned(rtfrBuffer)
-        safe_Free_aligned(rtfr_senseData)
-        safe_Free_aligned(requestRTFRs)
+        return_Command_Buffer(device, &rtfrBuffer);
+        return_Command_Buffer(device, &rtfr_senseData);
+        return_Command_Buffer(device, &requestRTFRs);
         return BAD_PARAMETER;
     }
     //set the protocol to Fh (15) to request the return TFRs be returned in that data in buffer.
@@ -796,9 +797,9 @@ int request_Return_TFRs_From_Device(tDevice *device, ataReturnTFRs *rtfr)
         }
     }
     //any other return value doesn't matter since this will not affect pass fail of our command. After this we will be dummying up a status anyways
-    safe_Free_aligned(rtfrBuffer)
-    safe_Free_aligned(rtfr_senseData)
-    safe_Free_aligned(requestRTFRs)
+    return_Command_Buffer(device, &rtfrBuffer);
+    return_Command_Buffer(device, &rtfr_senseData);
+    return_Command_Buffer(device, &requestRTFRs);
     if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
     {
         print_Return_Enum("SAT Return Response Information", rtfrRet);
@@ -834,7 +835,7 @@ int build_SAT_CDB(tDevice *device, uint8_t **satCDB, eCDBLen *cdbLen, ataPassthr
             }
             else
             {
-                *satCDB = C_CAST(uint8_t*, calloc_aligned(ataCommandOptions->forceCDBSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+                *satCDB = borrow_Command_Buffer(device, ataCommandOptions->forceCDBSize);
                 if (!*satCDB)
                 {
                     return MEMORY_FAILURE;
@@ -853,7 +854,7 @@ int build_SAT_CDB(tDevice *device, uint8_t **satCDB, eCDBLen *cdbLen, ataPassthr
             }
             else
             {
-                *satCDB = C_CAST(uint8_t*, calloc_aligned(ataCommandOptions->forceCDBSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+                *satCDB = borrow_Command_Buffer(device, ataCommandOptions->forceCDBSize);
                 if (!*satCDB)
                 {
                     return MEMORY_FAILURE;
@@ -864,7 +865,7 @@ int build_SAT_CDB(tDevice *device, uint8_t **satCDB, eCDBLen *cdbLen, ataPassthr
             }
             break;
         case 32:
-            *satCDB = C_CAST(uint8_t*, calloc_aligned(ataCommandOptions->forceCDBSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+            *satCDB = borrow_Command_Buffer(device, ataCommandOptions->forceCDBSize);
             if (!*satCDB)
             {
                 return MEMORY_FAILURE;
@@ -901,7 +902,7 @@ int build_SAT_CDB(tDevice *device, uint8_t **satCDB, eCDBLen *cdbLen, ataPassthr
             if (!device->drive_info.passThroughHacks.ataPTHacks.a1NeverSupported)
             {
                 //12B CDB
-                *satCDB = C_CAST(uint8_t*, calloc_aligned(CDB_LEN_12, sizeof(uint8_t), device->os_info.minimumAlignment));
+                *satCDB = borrow_Command_Buffer(device, CDB_LEN_12);
                 if (!*satCDB)
                 {
                     return MEMORY_FAILURE;
@@ -913,7 +914,7 @@ int build_SAT_CDB(tDevice *device, uint8_t **satCDB, eCDBLen *cdbLen, ataPassthr
             else
             {
                 //16B CDB
-                *satCDB = C_CAST(uint8_t*, calloc_aligned(CDB_LEN_16, sizeof(uint8_t), device->os_info.minimumAlignment));
+                *satCDB = borrow_Command_Buffer(device, CDB_LEN_16);
                 if (!*satCDB)
                 {
                     return MEMORY_FAILURE;
@@ -933,7 +934,7 @@ int build_SAT_CDB(tDevice *device, uint8_t **satCDB, eCDBLen *cdbLen, ataPassthr
                 {
                     //No ext registers are set, so we will issue the command with a 12B CDB. This is a major hack, but might help some devices get some more support.
                     //12B CDB
-                    *satCDB = C_CAST(uint8_t*, calloc_aligned(CDB_LEN_12, sizeof(uint8_t), device->os_info.minimumAlignment));
+                    *satCDB = borrow_Command_Buffer(device, CDB_LEN_12);
                     if (!*satCDB)
                     {
                         return MEMORY_FAILURE;
@@ -946,7 +947,7 @@ int build_SAT_CDB(tDevice *device, uint8_t **satCDB, eCDBLen *cdbLen, ataPassthr
             if (!*satCDB) //should fall into here if the above check did not work and allocate the satCDB memory.
             {
                 //16B CDB
-                *satCDB = C_CAST(uint8_t*, calloc_aligned(CDB_LEN_16, sizeof(uint8_t), device->os_info.minimumAlignment));
+                *satCDB = borrow_Command_Buffer(device, CDB_LEN_16);
                 if (!*satCDB)
                 {
                     return MEMORY_FAILURE;
@@ -958,7 +959,7 @@ int build_SAT_CDB(tDevice *device, uint8_t **satCDB, eCDBLen *cdbLen, ataPassthr
             break;
         case ATA_CMD_TYPE_COMPLETE_TASKFILE:
             //32B CDB
-            *satCDB = C_CAST(uint8_t*, calloc_aligned(CDB_LEN_32, sizeof(uint8_t), device->os_info.minimumAlignment));
+            *satCDB = borrow_Command_Buffer(device, CDB_LEN_32);
             if (!*satCDB)
             {
                 return MEMORY_FAILURE;
@@ -1044,7 +1045,7 @@ int send_SAT_Passthrough_Command(tDevice *device, ataPassthroughCommand  *ataCom
     bool localSenseData = false;
     if (!ataCommandOptions->ptrSenseData)
     {
-        senseData = C_CAST(uint8_t*, calloc_aligned(SPC3_SENSE_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+        senseData = borrow_Command_Buffer(device, SPC3_SENSE_LEN);
         if (!senseData)
         {
             return MEMORY_FAILURE;
@@ -1257,13 +1258,13 @@ int send_SAT_Passthrough_Command(tDevice *device, ataPassthroughCommand  *ataCom
             ret = sendIOret;
         }
     }
-    safe_Free_aligned(satCDB)
+    return_Command_Buffer(device, &satCDB);
     if ((device->drive_info.lastCommandTimeNanoSeconds / 1000000000) > ataCommandOptions->timeout)
     {
         ret = COMMAND_TIMEOUT;
     }
     memcpy(&device->drive_info.lastCommandRTFRs, &ataCommandOptions->rtfr, sizeof(ataReturnTFRs));
-    safe_Free_aligned(senseData)
+    return_Command_Buffer(device, &senseData);
     if (localSenseData)
     {
         ataCommandOptions->ptrSenseData = NULL;
@@ -1842,7 +1843,7 @@ static int satl_Read_Verify_Command(ScsiIoCtx *scsiIoCtx, uint64_t lba, uint32_t
                 set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_ILLEGAL_REQUEST, 0x24, 0x00, scsiIoCtx->device->drive_info.softSATFlags.senseDataDescriptorFormat, NULL, 0);
                 return SUCCESS;
             }
-            compareBuf = C_CAST(uint8_t*, calloc_aligned(scsiIoCtx->dataLength, sizeof(uint8_t), scsiIoCtx->device->os_info.minimumAlignment));
+            compareBuf = borrow_Translation_Buffer(scsiIoCtx->device, scsiIoCtx->dataLength);
             if (!compareBuf)
             {
                 set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_ILLEGAL_REQUEST, 0x24, 0x00, scsiIoCtx->device->drive_info.softSATFlags.senseDataDescriptorFormat, NULL, 0);
@@ -1879,7 +1880,7 @@ static int satl_Read_Verify_Command(ScsiIoCtx *scsiIoCtx, uint64_t lba, uint32_t
                     }
                 }
             }
-            safe_Free_aligned(compareBuf)
+            return_Translation_Buffer(scsiIoCtx->device, &compareBuf);
             if (errorFound)
             {
                 //set failure
@@ -1922,7 +1923,7 @@ static int satl_Read_Verify_Command(ScsiIoCtx *scsiIoCtx, uint64_t lba, uint32_t
                 set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_ILLEGAL_REQUEST, 0x24, 0x00, scsiIoCtx->device->drive_info.softSATFlags.senseDataDescriptorFormat, NULL, 0);
                 return SUCCESS;
             }
-            compareBuf = C_CAST(uint8_t*, calloc_aligned(scsiIoCtx->dataLength, sizeof(uint8_t), scsiIoCtx->device->os_info.minimumAlignment));
+            compareBuf = borrow_Translation_Buffer(scsiIoCtx->device, scsiIoCtx->dataLength);
             if (!compareBuf)
             {
                 set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_ILLEGAL_REQUEST, 0x24, 0x00, scsiIoCtx->device->drive_info.softSATFlags.senseDataDescriptorFormat, NULL, 0);
@@ -1959,7 +1960,7 @@ static int satl_Read_Verify_Command(ScsiIoCtx *scsiIoCtx, uint64_t lba, uint32_t
                     }
                 }
             }
-            safe_Free_aligned(compareBuf)
+            return_Translation_Buffer(scsiIoCtx->device, &compareBuf);
             if (errorFound)
             {
                 //set failure
@@ -2019,18 +2020,143 @@ static bool are_RTFRs_Non_Zero_From_Identify(ataReturnTFRs *identRTFRs)
     return nonZero;
 }
 
+void invalidate_Software_SAT_Snapshot(tDevice *device)
+{
+    if (device)
+    {
+        device->drive_info.softSATFlags.snapshot.identifyValid = false;
+        device->drive_info.softSATFlags.snapshot.deviceStatisticsPagesValid = 0;
+        invalidate_Translation_Responses(device);
+    }
+}
+
+//Makes sure device->drive_info.IdentifyData.ata holds current identify (or identify packet) data, only issuing a command if it was invalidated since it was last read.
+static int get_ATA_Identify_Snapshot(tDevice *device, bool allowIdentifyPacket)
+{
+    softwareSATSnapshot *snapshot = &device->drive_info.softSATFlags.snapshot;
+    if (!snapshot->identifyValid)
+    {
+        if (SUCCESS == ata_Identify(device, C_CAST(uint8_t*, &device->drive_info.IdentifyData.ata.Word000), LEGACY_DRIVE_SEC_SIZE))
+        {
+            snapshot->identifyCommand = ATA_IDENTIFY;
+        }
+        else if (allowIdentifyPacket && SUCCESS == ata_Identify_Packet_Device(device, C_CAST(uint8_t*, &device->drive_info.IdentifyData.ata.Word000), LEGACY_DRIVE_SEC_SIZE))
+        {
+            snapshot->identifyCommand = ATAPI_IDENTIFY;
+        }
+        else
+        {
+            return FAILURE;
+        }
+        snapshot->identifyValid = true;
+    }
+    if (!allowIdentifyPacket && snapshot->identifyCommand == ATAPI_IDENTIFY)
+    {
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+//Copies a device statistics log page into logPage. All the supported pages are read in one command and reused for SOFT_SAT_DEVICE_STATISTICS_SNAPSHOT_MILLISECONDS.
+static int read_ATA_Device_Statistics_Page(tDevice *device, uint8_t page, uint8_t *logPage)
+{
+    softwareSATSnapshot *snapshot = &device->drive_info.softSATFlags.snapshot;
+    if (page >= SOFT_SAT_DEVICE_STATISTICS_SNAPSHOT_PAGES)
+    {
+        return ata_Read_Log_Ext(device, ATA_LOG_DEVICE_STATISTICS, page, logPage, LEGACY_DRIVE_SEC_SIZE, device->drive_info.ata_Options.readLogWriteLogDMASupported, 0);
+    }
+    if (snapshot->deviceStatisticsPagesValid)
+    {
+        seatimer_t snapshotAge = snapshot->deviceStatisticsTimer;
+        stop_Timer(&snapshotAge);
+        if (get_Milli_Seconds(snapshotAge) >= SOFT_SAT_DEVICE_STATISTICS_SNAPSHOT_MILLISECONDS)
+        {
+            snapshot->deviceStatisticsPagesValid = 0;
+        }
+    }
+    if (!(snapshot->deviceStatisticsPagesValid & (BIT0 << page)))
+    {
+        //read from page 1 through the last supported page that is used by the translator. Pages in between are not used, but reading them is cheaper than issuing more commands.
+        //Only the supported pages are kept, since whatever the device returns for the others is not statistics.
+        uint8_t supportedPages = 0;
+        uint8_t lastPage = 0;
+        seatimer_t readTimer;
+        memset(&readTimer, 0, sizeof(seatimer_t));
+        if (device->drive_info.softSATFlags.deviceStatsPages.generalStatisitcsSupported)
+        {
+            supportedPages |= BIT0 << ATA_DEVICE_STATS_LOG_GENERAL;
+            lastPage = ATA_DEVICE_STATS_LOG_GENERAL;
+        }
+        if (device->drive_info.softSATFlags.deviceStatsPages.rotatingMediaStatisticsPageSupported)
+        {
+            supportedPages |= BIT0 << ATA_DEVICE_STATS_LOG_ROTATING_MEDIA;
+            lastPage = ATA_DEVICE_STATS_LOG_ROTATING_MEDIA;
+        }
+        if (device->drive_info.softSATFlags.deviceStatsPages.generalErrorStatisticsSupported)
+        {
+            supportedPages |= BIT0 << ATA_DEVICE_STATS_LOG_GEN_ERR;
+            lastPage = ATA_DEVICE_STATS_LOG_GEN_ERR;
+        }
+        if (device->drive_info.softSATFlags.deviceStatsPages.temperatureStatisticsSupported)
+        {
+            supportedPages |= BIT0 << ATA_DEVICE_STATS_LOG_TEMP;
+            lastPage = ATA_DEVICE_STATS_LOG_TEMP;
+        }
+        if (device->drive_info.softSATFlags.deviceStatsPages.solidStateDeviceStatisticsSupported)
+        {
+            supportedPages |= BIT0 << ATA_DEVICE_STATS_LOG_SSD;
+            lastPage = ATA_DEVICE_STATS_LOG_SSD;
+        }
+        if (!(supportedPages & (BIT0 << page)))
+        {
+            //not a page the translator knows is supported, so read it on its own and do not keep it
+            return ata_Read_Log_Ext(device, ATA_LOG_DEVICE_STATISTICS, page, logPage, LEGACY_DRIVE_SEC_SIZE, device->drive_info.ata_Options.readLogWriteLogDMASupported, 0);
+        }
+        start_Timer(&readTimer);
+        if (SUCCESS == ata_Read_Log_Ext(device, ATA_LOG_DEVICE_STATISTICS, ATA_DEVICE_STATS_LOG_GENERAL, &snapshot->deviceStatistics[ATA_DEVICE_STATS_LOG_GENERAL][0], C_CAST(uint32_t, lastPage) * LEGACY_DRIVE_SEC_SIZE, device->drive_info.ata_Options.readLogWriteLogDMASupported, 0))
+        {
+            snapshot->deviceStatisticsTimer = readTimer;
+            snapshot->deviceStatisticsPagesValid = supportedPages;
+        }
+        else if (SUCCESS == ata_Read_Log_Ext(device, ATA_LOG_DEVICE_STATISTICS, page, &snapshot->deviceStatistics[page][0], LEGACY_DRIVE_SEC_SIZE, device->drive_info.ata_Options.readLogWriteLogDMASupported, 0))
+        {
+            //reading all of them failed for some reason, so just keep this one page. The pages already kept keep their age.
+            if (snapshot->deviceStatisticsPagesValid == 0)
+            {
+                snapshot->deviceStatisticsTimer = readTimer;
+            }
+            snapshot->deviceStatisticsPagesValid |= C_CAST(uint8_t, BIT0 << page);
+        }
+        else
+        {
+            return FAILURE;
+        }
+    }
+    memcpy(logPage, &snapshot->deviceStatistics[page][0], LEGACY_DRIVE_SEC_SIZE);
+    return SUCCESS;
+}
+
 static int translate_ATA_Information_VPD_Page_89h(tDevice *device, ScsiIoCtx *scsiIoCtx)
 {
     int ret = SUCCESS;
     uint8_t peripheralDevice = 0;
     uint8_t commandCode = ATA_IDENTIFY;
     uint8_t ataInformation[572] = { 0 };
+    softwareSATSnapshot *snapshot = &device->drive_info.softSATFlags.snapshot;
+    if (snapshot->identifyValid)
+    {
+        commandCode = snapshot->identifyCommand;
+        if (commandCode == ATAPI_IDENTIFY)
+        {
+            peripheralDevice = 0x05;
+        }
+    }
 #if SAT_SPEC_SUPPORTED > 3
-    if (device->drive_info.softSATFlags.identifyDeviceDataLogSupported)
+    else if (device->drive_info.softSATFlags.identifyDeviceDataLogSupported)
     {
         if (SUCCESS != ata_Read_Log_Ext(device, ATA_LOG_IDENTIFY_DEVICE_DATA, ATA_ID_DATA_LOG_COPY_OF_IDENTIFY_DATA, (uint8_t*)&device->drive_info.IdentifyData.ata.Word000, LEGACY_DRIVE_SEC_SIZE, device->drive_info.ata_Options.readLogWriteLogDMASupported, 0))
         {
-            if (SUCCESS != ata_Identify(device, (uint8_t*)&device->drive_info.IdentifyData.ata.Word000, LEGACY_DRIVE_SEC_SIZE))
+            if (SUCCESS != get_ATA_Identify_Snapshot(device, false))
             {
                 return FAILURE;
             }
@@ -2045,18 +2171,19 @@ static int translate_ATA_Information_VPD_Page_89h(tDevice *device, ScsiIoCtx *sc
             {
                 commandCode = ATA_READ_LOG_EXT;
             }
+            //the copy of identify data is identical to identify device data, so it can be kept too
+            snapshot->identifyCommand = ATA_IDENTIFY;
+            snapshot->identifyValid = true;
         }
     }
-    else 
 #endif
-    if (SUCCESS != ata_Identify(device, (uint8_t*)&device->drive_info.IdentifyData.ata.Word000, LEGACY_DRIVE_SEC_SIZE))
+    else if (SUCCESS != get_ATA_Identify_Snapshot(device, true))
+    {
+        //if we didn't get anything from identify or identify packet device, then it's time to return a failure
+        return FAILURE;
+    }
+    else if (snapshot->identifyCommand == ATAPI_IDENTIFY)
     {
-        //that failed, so try an identify packet device
-        if (SUCCESS != ata_Identify_Packet_Device(device, (uint8_t*)&device->drive_info.IdentifyData.ata.Word000, LEGACY_DRIVE_SEC_SIZE))
-        {
-            //if we still didn't get anything, then it's time to return a failure
-            return FAILURE;
-        }
         peripheralDevice = 0x05;
         commandCode = ATAPI_IDENTIFY;
     }
@@ -2289,7 +2416,7 @@ static int translate_Device_Identification_VPD_Page_83h(tDevice *device, ScsiIoC
         char scsiNameString[SAT_SCSI_NAME_STRING_LENGTH] = { 0 };
         naaDesignatorLength = 12;
         //WWN Supported
-        naaDesignator = C_CAST(uint8_t*, calloc(naaDesignatorLength * sizeof(uint8_t), sizeof(uint8_t)));
+        naaDesignator = borrow_Translation_Buffer(device, naaDesignatorLength);
         if (!naaDesignator)
         {
             return MEMORY_FAILURE;
@@ -2310,10 +2437,10 @@ static int translate_Device_Identification_VPD_Page_83h(tDevice *device, ScsiIoC
         //now set up the scsi name string identifier
         snprintf(&scsiNameString[0], SAT_SCSI_NAME_STRING_LENGTH, "naa.%"PRIX64, wwn);
         SCSINameStringDesignatorLength = 24;
-        SCSINameStringDesignator = C_CAST(uint8_t*, calloc(SCSINameStringDesignatorLength * sizeof(uint8_t), sizeof(uint8_t)));
+        SCSINameStringDesignator = borrow_Translation_Buffer(device, SCSINameStringDesignatorLength);
         if (!SCSINameStringDesignator)
         {
-            safe_Free(naaDesignator)
+            return_Translation_Buffer(device, &naaDesignator);
             return MEMORY_FAILURE;
         }
         //now set this into the buffer
@@ -2340,11 +2467,11 @@ static int translate_Device_Identification_VPD_Page_83h(tDevice *device, ScsiIoC
     memcpy(&t10VendorIdDesignator[52], ataSerialNumber, SERIAL_NUM_LEN);
 
     //now setup the device identification page
-    deviceIdentificationPage = C_CAST(uint8_t*, calloc((4U + 72U + naaDesignatorLength + SCSINameStringDesignatorLength) * sizeof(uint8_t), sizeof(uint8_t)));
+    deviceIdentificationPage = borrow_Translation_Buffer(device, (4U + 72U + naaDesignatorLength + SCSINameStringDesignatorLength));
     if (!deviceIdentificationPage)
     {
-        safe_Free(SCSINameStringDesignator)
-        safe_Free(naaDesignator)
+        return_Translation_Buffer(device, &SCSINameStringDesignator);
+        return_Translation_Buffer(device, &naaDesignator);
         return MEMORY_FAILURE;
     }
     uint8_t peripheralDevice = 0;
@@ -2371,14 +2498,14 @@ static int translate_Device_Identification_VPD_Page_83h(tDevice *device, ScsiIoC
     //t10 vendor identification last
     memcpy(&deviceIdentificationPage[4 + naaDesignatorLength + SCSINameStringDesignatorLength], t10VendorIdDesignator, 72U);
     //now free the memory we no longer need
-    safe_Free(naaDesignator)
-    safe_Free(SCSINameStringDesignator)
+    return_Translation_Buffer(device, &naaDesignator);
+    return_Translation_Buffer(device, &SCSINameStringDesignator);
     //copy the final data back for the command
     if (scsiIoCtx->pdata)
     {
         memcpy(scsiIoCtx->pdata, deviceIdentificationPage, M_Min(72U + naaDesignatorLength + SCSINameStringDesignatorLength, scsiIoCtx->dataLength));
     }
-    safe_Free(deviceIdentificationPage)
+    return_Translation_Buffer(device, &deviceIdentificationPage);
     return ret;
 }
 
@@ -2981,6 +3108,51 @@ static int translate_Supported_VPD_Pages_00h(tDevice *device, ScsiIoCtx *scsiIoC
     return ret;
 }
 
+//Pages that only depend on what the device supports are built once, then copied from the device's saved translation responses.
+static int translate_Static_VPD_Page(tDevice *device, ScsiIoCtx *scsiIoCtx)
+{
+    int ret = SUCCESS;
+    uint8_t pageCode = scsiIoCtx->cdb[2];
+    uint64_t responseKey = TRANSLATION_RESPONSE_KEY(INQUIRY_CMD, BIT0, pageCode, 0, 0, 0, 0, 0);
+    if (!get_Translation_Response(device, responseKey, scsiIoCtx->pdata, scsiIoCtx->dataLength, &ret))
+    {
+        uint8_t vpdPage[LEGACY_DRIVE_SEC_SIZE] = { 0 };
+        uint32_t vpdPageLength = 0;
+        ScsiIoCtx pageCtx;
+        memcpy(&pageCtx, scsiIoCtx, sizeof(ScsiIoCtx));
+        pageCtx.pdata = vpdPage;
+        pageCtx.dataLength = LEGACY_DRIVE_SEC_SIZE;
+        switch (pageCode)
+        {
+        case SUPPORTED_VPD_PAGES:
+            ret = translate_Supported_VPD_Pages_00h(device, &pageCtx);
+            break;
+#if SAT_SPEC_SUPPORTED > 3 && SAT_4_ERROR_HISTORY_FEATURE
+        case EXTENDED_INQUIRY_DATA:
+            ret = translate_Extended_Inquiry_Data_VPD_Page_86h(device, &pageCtx);
+            break;
+#endif
+#if SAT_SPEC_SUPPORTED > 2
+        case BLOCK_LIMITS:
+            ret = translate_Block_Limits_VPD_Page_B0h(device, &pageCtx);
+            break;
+#endif
+        default:
+            return NOT_SUPPORTED;
+        }
+        vpdPageLength = M_Min(C_CAST(uint32_t, M_BytesTo2ByteValue(vpdPage[2], vpdPage[3])) + 4, LEGACY_DRIVE_SEC_SIZE);
+        if (ret == SUCCESS)
+        {
+            save_Translation_Response(device, responseKey, ret, vpdPage, vpdPageLength);
+        }
+        if (scsiIoCtx->pdata)
+        {
+            memcpy(scsiIoCtx->pdata, vpdPage, M_Min(vpdPageLength, scsiIoCtx->dataLength));
+        }
+    }
+    return ret;
+}
+
 static int translate_SCSI_Inquiry_Command(tDevice *device, ScsiIoCtx *scsiIoCtx)
 {
     int ret = SUCCESS;
@@ -3014,7 +3186,7 @@ static int translate_SCSI_Inquiry_Command(tDevice *device, ScsiIoCtx *scsiIoCtx)
             {
             case SUPPORTED_VPD_PAGES:
                 //update this as more supported pages are added!
-                ret = translate_Supported_VPD_Pages_00h(device, scsiIoCtx);
+                ret = translate_Static_VPD_Page(device, scsiIoCtx);
                 break;
             case UNIT_SERIAL_NUMBER:
                 ret = translate_Unit_Serial_Number_VPD_Page_80h(device, scsiIoCtx);
@@ -3024,7 +3196,7 @@ static int translate_SCSI_Inquiry_Command(tDevice *device, ScsiIoCtx *scsiIoCtx)
                 break;
 #if SAT_SPEC_SUPPORTED > 3 && SAT_4_ERROR_HISTORY_FEATURE
             case EXTENDED_INQUIRY_DATA:
-                ret = translate_Extended_Inquiry_Data_VPD_Page_86h(device, scsiIoCtx);
+                ret = translate_Static_VPD_Page(device, scsiIoCtx);
                 break;
 #endif
             case MODE_PAGE_POLICY:
@@ -3049,7 +3221,7 @@ static int translate_SCSI_Inquiry_Command(tDevice *device, ScsiIoCtx *scsiIoCtx)
                 }
                 break;
             case BLOCK_LIMITS:
-                ret = translate_Block_Limits_VPD_Page_B0h(device, scsiIoCtx);
+                ret = translate_Static_VPD_Page(device, scsiIoCtx);
                 break;
 #endif
 #if SAT_SPEC_SUPPORTED > 1
@@ -3113,14 +3285,14 @@ static int translate_SCSI_Inquiry_Command(tDevice *device, ScsiIoCtx *scsiIoCtx)
                 set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_ILLEGAL_REQUEST, 0x24, 0, device->drive_info.softSATFlags.senseDataDescriptorFormat, senseKeySpecificDescriptor, 1);
                 return NOT_SUPPORTED;
             }
-            if (SUCCESS != ata_Identify(device, (uint8_t*)&device->drive_info.IdentifyData.ata.Word000, LEGACY_DRIVE_SEC_SIZE))
+            //identify, or identify packet device if that fails
+            if (SUCCESS != get_ATA_Identify_Snapshot(device, true))
+            {
+                set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_NOT_READY, 0x04, 0, device->drive_info.softSATFlags.senseDataDescriptorFormat, NULL, 0);
+                return FAILURE;
+            }
+            if (device->drive_info.softSATFlags.snapshot.identifyCommand == ATAPI_IDENTIFY)
             {
-                //that failed, so try an identify packet device
-                if (SUCCESS != ata_Identify_Packet_Device(device, (uint8_t*)&device->drive_info.IdentifyData.ata.Word000, LEGACY_DRIVE_SEC_SIZE))
-                {
-                    set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_NOT_READY, 0x04, 0, device->drive_info.softSATFlags.senseDataDescriptorFormat, NULL, 0);
-                    return FAILURE;
-                }
                 peripheralDevice = 0x05;
             }
             set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_NO_ERROR, 0, 0, device->drive_info.softSATFlags.senseDataDescriptorFormat, NULL, 0);
@@ -3395,8 +3567,8 @@ static int translate_SCSI_Read_Capacity_Command(tDevice *device, bool readCapaci
             return ret;
         }
     }
-    //issue an identify command
-    if (SUCCESS == ata_Identify(device, (uint8_t *)&device->drive_info.IdentifyData.ata.Word000, LEGACY_DRIVE_SEC_SIZE))
+    //issue an identify command (or reuse the last one if nothing has changed since)
+    if (SUCCESS == get_ATA_Identify_Snapshot(device, false))
     {
         uint8_t *identifyData = (uint8_t*)&device->drive_info.IdentifyData.ata;
         uint16_t *ident_word = (uint16_t*)&device->drive_info.IdentifyData.ata;
@@ -3812,6 +3984,8 @@ static int translate_SCSI_ATA_Passthrough_Command(tDevice *device, ScsiIoCtx *sc
     }
     //issue the IO
     ret = send_IO(scsiIoCtx);
+    //a raw passthrough command can change anything on the drive, so nothing cached by the translator can be trusted after it
+    invalidate_Software_SAT_Snapshot(device);
 
     //now we need to dummy up sense data if we are on the IDE_INTERFACE (ATA) and it was unsuccessful or the check condition bit was set, otherwise the SATL (USB or SAS) will do this for us
     if ((ret != SUCCESS || scsiIoCtx->cdb[2] & BIT5) && device->drive_info.interface_type == IDE_INTERFACE)
@@ -4267,7 +4441,7 @@ static int translate_SCSI_Write_Same_Command(tDevice *device, ScsiIoCtx *scsiIoC
             {
                 patternLength = 65535;//64k
             }
-            uint8_t *writePattern = C_CAST(uint8_t*, calloc_aligned(patternLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+            uint8_t *writePattern = borrow_Translation_Buffer(device, patternLength);
             if (writePattern)
             {
                 if (!ataWritePatternZeros)
@@ -4275,7 +4449,7 @@ static int translate_SCSI_Write_Same_Command(tDevice *device, ScsiIoCtx *scsiIoC
                     memcpy(writePattern, scsiIoCtx->pdata, patternLength);
                 }
                 ret = satl_Sequential_Write_Commands(scsiIoCtx, logicalBlockAddress, numberOflogicalBlocks, writePattern, patternLength);
-                safe_Free_aligned(writePattern)
+                return_Translation_Buffer(device, &writePattern);
             }
             else
             {
@@ -4594,7 +4768,7 @@ static int translate_SCSI_Write_And_Verify_Command(tDevice *device, ScsiIoCtx *s
                 set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_ILLEGAL_REQUEST, 0x24, 0x00, device->drive_info.softSATFlags.senseDataDescriptorFormat, senseKeySpecificDescriptor, 1);
                 return SUCCESS;
             }
-            compareBuf = C_CAST(uint8_t*, calloc_aligned(scsiIoCtx->dataLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+            compareBuf = borrow_Translation_Buffer(device, scsiIoCtx->dataLength);
             if (!compareBuf)
             {
                 set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_ILLEGAL_REQUEST, 0x24, 0x00, device->drive_info.softSATFlags.senseDataDescriptorFormat, NULL, 0);
@@ -4631,7 +4805,7 @@ static int translate_SCSI_Write_And_Verify_Command(tDevice *device, ScsiIoCtx *s
                     }
                 }
             }
-            safe_Free_aligned(compareBuf)
+            return_Translation_Buffer(device, &compareBuf);
             if (errorFound)
             {
                 //set failure
@@ -4684,7 +4858,7 @@ static int translate_SCSI_Write_And_Verify_Command(tDevice *device, ScsiIoCtx *s
                 set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_ILLEGAL_REQUEST, 0x24, 0x00, device->drive_info.softSATFlags.senseDataDescriptorFormat, senseKeySpecificDescriptor, 1);
                 return SUCCESS;
             }
-            compareBuf = C_CAST(uint8_t*, calloc_aligned(scsiIoCtx->dataLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+            compareBuf = borrow_Translation_Buffer(device, scsiIoCtx->dataLength);
             if (!compareBuf)
             {
                 set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_ILLEGAL_REQUEST, 0x24, 0x00, device->drive_info.softSATFlags.senseDataDescriptorFormat, NULL, 0);
@@ -4721,7 +4895,7 @@ static int translate_SCSI_Write_And_Verify_Command(tDevice *device, ScsiIoCtx *s
                     }
                 }
             }
-            safe_Free_aligned(compareBuf)
+            return_Translation_Buffer(device, &compareBuf);
             if (errorFound)
             {
                 //set failure
@@ -4992,7 +5166,7 @@ static int translate_SCSI_Format_Unit_Command(tDevice *device, ScsiIoCtx *scsiIo
                                     uint32_t writeSectors64K = 65535 / device->drive_info.deviceBlockSize;
                                     //ATA Write commands
                                     uint32_t ataWriteDataLength = writeSectors64K * device->drive_info.deviceBlockSize;
-                                    uint8_t *ataWritePattern = C_CAST(uint8_t*, calloc_aligned(writeSectors64K, sizeof(uint8_t), device->os_info.minimumAlignment));
+                                    uint8_t *ataWritePattern = borrow_Translation_Buffer(device, writeSectors64K);
                                     if (ataWritePattern)
                                     {
                                         if (initializationPatternLength > 0)
@@ -5009,7 +5183,7 @@ static int translate_SCSI_Format_Unit_Command(tDevice *device, ScsiIoCtx *scsiIo
                                         {
                                             set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_MEDIUM_ERROR, 0x03, 0, device->drive_info.softSATFlags.senseDataDescriptorFormat, NULL, 0);
                                         }
-                                        safe_Free_aligned(ataWritePattern)
+                                        return_Translation_Buffer(device, &ataWritePattern);
                                     }
                                     else
                                     {
@@ -5056,7 +5230,7 @@ static int translate_SCSI_Format_Unit_Command(tDevice *device, ScsiIoCtx *scsiIo
                                             uint32_t writeSectors64K = 65536 / device->drive_info.deviceBlockSize;
                                             //ATA Write commands
                                             uint32_t ataWriteDataLength = writeSectors64K * device->drive_info.deviceBlockSize;
-                                            uint8_t *ataWritePattern = C_CAST(uint8_t*, calloc_aligned(writeSectors64K, sizeof(uint8_t), device->os_info.minimumAlignment));
+                                            uint8_t *ataWritePattern = borrow_Translation_Buffer(device, writeSectors64K);
                                             if (ataWritePattern)
                                             {
                                                 if (initializationPatternLength > 0)
@@ -5107,7 +5281,7 @@ static int translate_SCSI_Format_Unit_Command(tDevice *device, ScsiIoCtx *scsiIo
                                                         }
                                                     }
                                                 }
-                                                safe_Free_aligned(ataWritePattern)
+                                                return_Translation_Buffer(device, &ataWritePattern);
                                             }
                                             else
                                             {
@@ -5269,7 +5443,7 @@ static int translate_SCSI_Reassign_Blocks_Command(tDevice *device, ScsiIoCtx *sc
         set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_ILLEGAL_REQUEST, 0x24, 0, device->drive_info.softSATFlags.senseDataDescriptorFormat, senseKeySpecificDescriptor, 1);
         return ret;
     }
-    uint8_t *writeData = C_CAST(uint8_t*, calloc_aligned(device->drive_info.deviceBlockSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+    uint8_t *writeData = borrow_Translation_Buffer(device, device->drive_info.deviceBlockSize);
     if (!writeData)
     {
         return MEMORY_FAILURE;
@@ -5330,7 +5504,7 @@ static int translate_SCSI_Reassign_Blocks_Command(tDevice *device, ScsiIoCtx *sc
             }
         }
     }
-    safe_Free_aligned(writeData)
+    return_Translation_Buffer(device, &writeData);
     return ret;
 }
 
@@ -5569,7 +5743,7 @@ static int translate_SCSI_Security_Protocol_In_Command(tDevice *device, ScsiIoCt
             {
                 uint32_t paddedLength = ((allocationLength + 511) / 512) * LEGACY_DRIVE_SEC_SIZE;
                 //allocate memory and pad data....then copy back the amount that was requested
-                uint8_t *tempSecurityMemory = C_CAST(uint8_t*, calloc_aligned(paddedLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+                uint8_t *tempSecurityMemory = borrow_Translation_Buffer(device, paddedLength);
                 if (!tempSecurityMemory)
                 {
                     return MEMORY_FAILURE;
@@ -5661,7 +5835,7 @@ static int translate_SCSI_Security_Protocol_In_Command(tDevice *device, ScsiIoCt
                         memcpy(scsiIoCtx->pdata, tempSecurityMemory, allocationLength);
                     }
                 }
-                safe_Free_aligned(tempSecurityMemory)
+                return_Translation_Buffer(device, &tempSecurityMemory);
             }
         }
     }
@@ -5917,7 +6091,7 @@ static int translate_SCSI_Security_Protocol_Out_Command(tDevice *device, ScsiIoC
             {
                 uint32_t paddedLength = ((transferLength + 511) / 512);
                 //allocate memory and pad data....then copy back the amount that was requested
-                uint8_t *tempSecurityMemory = C_CAST(uint8_t*, calloc_aligned(paddedLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+                uint8_t *tempSecurityMemory = borrow_Translation_Buffer(device, paddedLength);
                 if (!tempSecurityMemory)
                 {
                     return MEMORY_FAILURE;
@@ -5928,7 +6102,7 @@ static int translate_SCSI_Security_Protocol_Out_Command(tDevice *device, ScsiIoC
                     ret = FAILURE;
                     set_Sense_Data_By_RTFRs(device, &device->drive_info.lastCommandRTFRs, scsiIoCtx->psense, scsiIoCtx->senseDataSize);
                 }
-                safe_Free_aligned(tempSecurityMemory)
+                return_Translation_Buffer(device, &tempSecurityMemory);
             }
         }
     }
@@ -8662,7 +8836,7 @@ static int translate_Read_Error_Counters_Log_0x03(tDevice *device, ScsiIoCtx *sc
     uint16_t fieldPointer = 0;
     if (parameterPointer <= 0x0004 && device->drive_info.softSATFlags.deviceStatsPages.rotatingMediaStatisticsPageSupported)
     {
-        if (SUCCESS != ata_Read_Log_Ext(device, ATA_LOG_DEVICE_STATISTICS, ATA_DEVICE_STATS_LOG_ROTATING_MEDIA, logPage, LEGACY_DRIVE_SEC_SIZE, device->drive_info.ata_Options.readLogWriteLogDMASupported, 0))
+        if (SUCCESS != read_ATA_Device_Statistics_Page(device, ATA_DEVICE_STATS_LOG_ROTATING_MEDIA, logPage))
         {
             set_Sense_Data_By_RTFRs(device, &device->drive_info.lastCommandRTFRs, scsiIoCtx->psense, scsiIoCtx->senseDataSize);
             return FAILURE;
@@ -8685,7 +8859,7 @@ static int translate_Read_Error_Counters_Log_0x03(tDevice *device, ScsiIoCtx *sc
     }
     if (parameterPointer <= 0x0006 && device->drive_info.softSATFlags.deviceStatsPages.generalErrorStatisticsSupported)
     {
-        if (SUCCESS != ata_Read_Log_Ext(device, ATA_LOG_DEVICE_STATISTICS, ATA_DEVICE_STATS_LOG_GEN_ERR, logPage, LEGACY_DRIVE_SEC_SIZE, device->drive_info.ata_Options.readLogWriteLogDMASupported, 0))
+        if (SUCCESS != read_ATA_Device_Statistics_Page(device, ATA_DEVICE_STATS_LOG_GEN_ERR, logPage))
         {
             set_Sense_Data_By_RTFRs(device, &device->drive_info.lastCommandRTFRs, scsiIoCtx->psense, scsiIoCtx->senseDataSize);
             return FAILURE;
@@ -8757,7 +8931,7 @@ static int translate_Temperature_Log_0x0D(tDevice *device, ScsiIoCtx *scsiIoCtx)
         set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_ILLEGAL_REQUEST, 0x24, 0, device->drive_info.softSATFlags.senseDataDescriptorFormat, senseKeySpecificDescriptor, 1);
         return ret;
     }
-    if (SUCCESS != ata_Read_Log_Ext(device, ATA_LOG_DEVICE_STATISTICS, ATA_DEVICE_STATS_LOG_TEMP, logPage, LEGACY_DRIVE_SEC_SIZE, device->drive_info.ata_Options.readLogWriteLogDMASupported, 0))
+    if (SUCCESS != read_ATA_Device_Statistics_Page(device, ATA_DEVICE_STATS_LOG_TEMP, logPage))
     {
         set_Sense_Data_By_RTFRs(device, &device->drive_info.lastCommandRTFRs, scsiIoCtx->psense, scsiIoCtx->senseDataSize);
         return FAILURE;
@@ -8850,7 +9024,7 @@ static int translate_Solid_State_Media_Log_0x11(tDevice *device, ScsiIoCtx *scsi
         set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_ILLEGAL_REQUEST, 0x24, 0, device->drive_info.softSATFlags.senseDataDescriptorFormat, senseKeySpecificDescriptor, 1);
         return ret;
     }
-    if (SUCCESS != ata_Read_Log_Ext(device, ATA_LOG_DEVICE_STATISTICS, ATA_DEVICE_STATS_LOG_SSD, logPage, LEGACY_DRIVE_SEC_SIZE, device->drive_info.ata_Options.readLogWriteLogDMASupported, 0))
+    if (SUCCESS != read_ATA_Device_Statistics_Page(device, ATA_DEVICE_STATS_LOG_SSD, logPage))
     {
         set_Sense_Data_By_RTFRs(device, &device->drive_info.lastCommandRTFRs, scsiIoCtx->psense, scsiIoCtx->senseDataSize);
         return FAILURE;
@@ -8916,7 +9090,7 @@ static int translate_Background_Scan_Results_Log_0x15(tDevice *device, ScsiIoCtx
         set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_ILLEGAL_REQUEST, 0x24, 0, device->drive_info.softSATFlags.senseDataDescriptorFormat, senseKeySpecificDescriptor, 1);
         return ret;
     }
-    if (SUCCESS != ata_Read_Log_Ext(device, ATA_LOG_DEVICE_STATISTICS, ATA_DEVICE_STATS_LOG_GENERAL, logPage, LEGACY_DRIVE_SEC_SIZE, device->drive_info.ata_Options.readLogWriteLogDMASupported, 0))
+    if (SUCCESS != read_ATA_Device_Statistics_Page(device, ATA_DEVICE_STATS_LOG_GENERAL, logPage))
     {
         set_Sense_Data_By_RTFRs(device, &device->drive_info.lastCommandRTFRs, scsiIoCtx->psense, scsiIoCtx->senseDataSize);
         return FAILURE;
@@ -8995,7 +9169,7 @@ static int translate_General_Statistics_And_Performance_Log_0x19(tDevice *device
         set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_ILLEGAL_REQUEST, 0x24, 0, device->drive_info.softSATFlags.senseDataDescriptorFormat, senseKeySpecificDescriptor, 1);
         return ret;
     }
-    if (SUCCESS != ata_Read_Log_Ext(device, ATA_LOG_DEVICE_STATISTICS, ATA_DEVICE_STATS_LOG_GENERAL, logPage, LEGACY_DRIVE_SEC_SIZE, device->drive_info.ata_Options.readLogWriteLogDMASupported, 0))
+    if (SUCCESS != read_ATA_Device_Statistics_Page(device, ATA_DEVICE_STATS_LOG_GENERAL, logPage))
     {
         set_Sense_Data_By_RTFRs(device, &device->drive_info.lastCommandRTFRs, scsiIoCtx->psense, scsiIoCtx->senseDataSize);
         return FAILURE;
@@ -9757,7 +9931,7 @@ static int translate_Application_Client_Log_Select_0x0F(tDevice *device, ScsiIoC
             {
                 uint16_t parameterCode = M_BytesTo2ByteValue(ptrData[parameterDataOffset + 0], ptrData[parameterDataOffset + 1]);
                 parameterLength = ptrData[parameterDataOffset + 3];
-                uint8_t *hostLogData = C_CAST(uint8_t*, calloc_aligned(16 * LEGACY_DRIVE_SEC_SIZE, sizeof(uint8_t), device->os_info.minimumAlignment));
+                uint8_t *hostLogData = borrow_Translation_Buffer(device, 16 * LEGACY_DRIVE_SEC_SIZE);
                 if (!hostLogData)
                 {
                     return MEMORY_FAILURE;
@@ -9862,7 +10036,7 @@ static int translate_Application_Client_Log_Select_0x0F(tDevice *device, ScsiIoC
                     {
                         //break and set an error code
                         set_Sense_Data_By_RTFRs(device, &device->drive_info.lastCommandRTFRs, scsiIoCtx->psense, scsiIoCtx->senseDataSize);
-                        safe_Free_aligned(hostLogData)
+                        return_Translation_Buffer(device, &hostLogData);
                         break;
                     }
                 }
@@ -9872,14 +10046,14 @@ static int translate_Application_Client_Log_Select_0x0F(tDevice *device, ScsiIoC
                     {
                         //break and set an error code
                         set_Sense_Data_By_RTFRs(device, &device->drive_info.lastCommandRTFRs, scsiIoCtx->psense, scsiIoCtx->senseDataSize);
-                        safe_Free_aligned(hostLogData)
+                        return_Translation_Buffer(device, &hostLogData);
                         break;
                     }
                 }
                 else
                 {
                     //error...we shouldn't be here!
-                    safe_Free_aligned(hostLogData)
+                    return_Translation_Buffer(device, &hostLogData);
                     break;
                 }
                 //need another for loop to go through the ATA log data we just read so that we can modify the data before we write it.
@@ -9904,7 +10078,7 @@ static int translate_Application_Client_Log_Select_0x0F(tDevice *device, ScsiIoC
                     {
                         //break and set an error code
                         set_Sense_Data_By_RTFRs(device, &device->drive_info.lastCommandRTFRs, scsiIoCtx->psense, scsiIoCtx->senseDataSize);
-                        safe_Free_aligned(hostLogData)
+                        return_Translation_Buffer(device, &hostLogData);
                         break;
                     }
                 }
@@ -9914,17 +10088,17 @@ static int translate_Application_Client_Log_Select_0x0F(tDevice *device, ScsiIoC
                     {
                         //break and set an error code
                         set_Sense_Data_By_RTFRs(device, &device->drive_info.lastCommandRTFRs, scsiIoCtx->psense, scsiIoCtx->senseDataSize);
-                        safe_Free_aligned(hostLogData)
+                        return_Translation_Buffer(device, &hostLogData);
                         break;
                     }
                 }
                 else
                 {
                     //error...we shouldn't be here!
-                    safe_Free_aligned(hostLogData)
+                    return_Translation_Buffer(device, &hostLogData);
                     break;
                 }
-                safe_Free_aligned(hostLogData)
+                return_Translation_Buffer(device, &hostLogData);
             }
         }
     }
@@ -10088,7 +10262,7 @@ static int translate_SCSI_Unmap_Command(tDevice *device, ScsiIoCtx *scsiIoCtx)
         uint16_t unmapBlockDescriptorLength = (M_BytesTo2ByteValue(scsiIoCtx->pdata[2], scsiIoCtx->pdata[3]) / 16) * 16;//this can be set to zero, which is NOT an error. Also, I'm making sure this is a multiple of 16 to avoid partial block descriptors-TJE
         if (unmapBlockDescriptorLength > 0)
         {
-            uint8_t *trimBuffer = C_CAST(uint8_t*, calloc_aligned(device->drive_info.IdentifyData.ata.Word105 * LEGACY_DRIVE_SEC_SIZE, sizeof(uint8_t), device->os_info.minimumAlignment));//allocate the max size the device supports...we'll fill in as much as we need to
+            uint8_t *trimBuffer = borrow_Translation_Buffer(device, device->drive_info.IdentifyData.ata.Word105 * LEGACY_DRIVE_SEC_SIZE);//allocate the max size the device supports...we'll fill in as much as we need to
 #if SAT_SPEC_SUPPORTED > 3
             bool useXL = device->drive_info.softSATFlags.dataSetManagementXLSupported;
             uint8_t maxDescriptorsPerBlock = device->drive_info.softSATFlags.dataSetManagementXLSupported ? 32 : 64;
@@ -10244,7 +10418,7 @@ static int translate_SCSI_Unmap_Command(tDevice *device, ScsiIoCtx *scsiIoCtx)
                     set_Sense_Data_By_RTFRs(device, &device->drive_info.lastCommandRTFRs, scsiIoCtx->psense, scsiIoCtx->senseDataSize);
                 }
             }
-            safe_Free_aligned(trimBuffer)
+            return_Translation_Buffer(device, &trimBuffer);
         }
     }
     return ret;
@@ -10290,7 +10464,7 @@ static int translate_Mode_Sense_Control_0Ah(tDevice *device, ScsiIoCtx *scsiIoCt
         }
     }
     //now that we know how many bytes we need for this, allocate memory
-    controlPage = C_CAST(uint8_t*, calloc(pageLength, sizeof(uint8_t)));
+    controlPage = borrow_Translation_Buffer(device, pageLength);
     if (!controlPage)
     {
         //TODO: set an error in the sense data
@@ -10372,7 +10546,7 @@ static int translate_Mode_Sense_Control_0Ah(tDevice *device, ScsiIoCtx *scsiIoCt
     {
         memcpy(scsiIoCtx->pdata, controlPage, M_Min(pageLength, allocationLength));
     }
-    safe_Free(controlPage)
+    return_Translation_Buffer(device, &controlPage);
     return ret;
 }
 
@@ -10415,7 +10589,7 @@ static int translate_Mode_Sense_PATA_Control_0Ah_F1h(ScsiIoCtx *scsiIoCtx, uint8
         }
     }
     //now that we know how many bytes we need for this, allocate memory
-    pataControlPage = C_CAST(uint8_t*, calloc(pageLength, sizeof(uint8_t)));
+    pataControlPage = borrow_Translation_Buffer(scsiIoCtx->device, pageLength);
     if (!pataControlPage)
     {
         //TODO: set an error in the sense data
@@ -10533,7 +10707,7 @@ static int translate_Mode_Sense_PATA_Control_0Ah_F1h(ScsiIoCtx *scsiIoCtx, uint8
     {
         memcpy(scsiIoCtx->pdata, pataControlPage, M_Min(pageLength, allocationLength));
     }
-    safe_Free(pataControlPage)
+    return_Translation_Buffer(scsiIoCtx->device, &pataControlPage);
     return ret;
 }
 
@@ -10576,7 +10750,7 @@ static int translate_Mode_Sense_Control_Extension_0Ah_01h(ScsiIoCtx *scsiIoCtx,
         }
     }
     //now that we know how many bytes we need for this, allocate memory
-    controlExtPage = C_CAST(uint8_t*, calloc(pageLength, sizeof(uint8_t)));
+    controlExtPage = borrow_Translation_Buffer(scsiIoCtx->device, pageLength);
     if (!controlExtPage)
     {
         //TODO: set an error in the sense data
@@ -10641,7 +10815,7 @@ static int translate_Mode_Sense_Control_Extension_0Ah_01h(ScsiIoCtx *scsiIoCtx,
     {
         memcpy(scsiIoCtx->pdata, controlExtPage, M_Min(pageLength, allocationLength));
     }
-    safe_Free(controlExtPage)
+    return_Translation_Buffer(scsiIoCtx->device, &controlExtPage);
     return ret;
 }
 //mode parameter header must be 4 bytes for short format and 8 bytes for long format (longHeader set to true)
@@ -10685,7 +10859,7 @@ static int translate_Mode_Sense_Power_Condition_1A(tDevice *device, ScsiIoCtx *s
         }
     }
     //now that we know how many bytes we need for this, allocate memory
-    powerConditionPage = C_CAST(uint8_t*, calloc(pageLength, sizeof(uint8_t)));
+    powerConditionPage = borrow_Translation_Buffer(device, pageLength);
     if (!powerConditionPage)
     {
         //TODO: set an error in the sense data
@@ -10948,7 +11122,7 @@ static int translate_Mode_Sense_Power_Condition_1A(tDevice *device, ScsiIoCtx *s
     {
         memcpy(scsiIoCtx->pdata, powerConditionPage, M_Min(pageLength, allocationLength));
     }
-    safe_Free(powerConditionPage)
+    return_Translation_Buffer(device, &powerConditionPage);
     return ret;
 }
 //mode parameter header must be 4 bytes for short format and 8 bytes for long format (longHeader set to true)
@@ -10992,7 +11166,7 @@ static int translate_Mode_Sense_ATA_Power_Condition_1A_F1(tDevice *device, ScsiI
         }
     }
     //now that we know how many bytes we need for this, allocate memory
-    powerConditionPage = C_CAST(uint8_t*, calloc(pageLength, sizeof(uint8_t)));
+    powerConditionPage = borrow_Translation_Buffer(device, pageLength);
     if (!powerConditionPage)
     {
         //TODO: set an error in the sense data
@@ -11064,7 +11238,7 @@ static int translate_Mode_Sense_ATA_Power_Condition_1A_F1(tDevice *device, ScsiI
     {
         memcpy(scsiIoCtx->pdata, powerConditionPage, M_Min(pageLength, allocationLength));
     }
-    safe_Free(powerConditionPage)
+    return_Translation_Buffer(device, &powerConditionPage);
     return ret;
 }
 
@@ -11109,7 +11283,7 @@ static int translate_Mode_Sense_Read_Write_Error_Recovery_01h(ScsiIoCtx *scsiIoC
         }
     }
     //now that we know how many bytes we need for this, allocate memory
-    readWriteErrorRecovery = C_CAST(uint8_t*, calloc(pageLength, sizeof(uint8_t)));
+    readWriteErrorRecovery = borrow_Translation_Buffer(scsiIoCtx->device, pageLength);
     if (!readWriteErrorRecovery)
     {
         //TODO: set an error in the sense data
@@ -11153,7 +11327,7 @@ static int translate_Mode_Sense_Read_Write_Error_Recovery_01h(ScsiIoCtx *scsiIoC
     {
         memcpy(scsiIoCtx->pdata, readWriteErrorRecovery, M_Min(pageLength, allocationLength));
     }
-    safe_Free(readWriteErrorRecovery)
+    return_Translation_Buffer(scsiIoCtx->device, &readWriteErrorRecovery);
     return ret;
 }
 
@@ -11198,7 +11372,7 @@ static int translate_Mode_Sense_Caching_08h(tDevice *device, ScsiIoCtx *scsiIoCt
         }
     }
     //now that we know how many bytes we need for this, allocate memory
-    caching = C_CAST(uint8_t*, calloc(pageLength, sizeof(uint8_t)));
+    caching = borrow_Translation_Buffer(device, pageLength);
     if (!caching)
     {
         //TODO: set an error in the sense data
@@ -11230,7 +11404,7 @@ static int translate_Mode_Sense_Caching_08h(tDevice *device, ScsiIoCtx *scsiIoCt
     }
     else//saved, current, and default. TODO: Handle saving what the drive had when we started talking to it.
     {
-        ata_Identify(device, (uint8_t*)&device->drive_info.IdentifyData.ata.Word000, LEGACY_DRIVE_SEC_SIZE);
+        get_ATA_Identify_Snapshot(device, false);
         set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_NO_ERROR, 0, 0, device->drive_info.softSATFlags.senseDataDescriptorFormat, NULL, 0);
         if (device->drive_info.IdentifyData.ata.Word085 & BIT5)
         {
@@ -11281,7 +11455,7 @@ static int translate_Mode_Sense_Caching_08h(tDevice *device, ScsiIoCtx *scsiIoCt
     {
         memcpy(scsiIoCtx->pdata, caching, M_Min(pageLength, allocationLength));
     }
-    safe_Free(caching)
+    return_Translation_Buffer(device, &caching);
     return ret;
 }
 
@@ -11326,7 +11500,7 @@ static int translate_Mode_Sense_Informational_Exceptions_Control_1Ch(ScsiIoCtx *
         }
     }
     //now that we know how many bytes we need for this, allocate memory
-    informationalExceptions = C_CAST(uint8_t*, calloc(pageLength, sizeof(uint8_t)));
+    informationalExceptions = borrow_Translation_Buffer(scsiIoCtx->device, pageLength);
     if (!informationalExceptions)
     {
         //TODO: set an error in the sense data
@@ -11375,7 +11549,7 @@ static int translate_Mode_Sense_Informational_Exceptions_Control_1Ch(ScsiIoCtx *
     {
         memcpy(scsiIoCtx->pdata, informationalExceptions, M_Min(pageLength, allocationLength));
     }
-    safe_Free(informationalExceptions)
+    return_Translation_Buffer(scsiIoCtx->device, &informationalExceptions);
     return ret;
 }
 
@@ -12951,13 +13125,13 @@ static int translate_SCSI_Zone_Management_In_Command(tDevice *device, ScsiIoCtx
     if ((allocationLength % 512) != 0)
     {
         dataBufLength = (allocationLength + 511) / 512;
-        dataBuf = C_CAST(uint8_t*, calloc_aligned(dataBufLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+        dataBuf = borrow_Translation_Buffer(device, dataBufLength);
         localMemory = true;
     }
     else if (allocationLength == 0)
     {
         dataBufLength = 512;
-        dataBuf = C_CAST(uint8_t*, calloc_aligned(dataBufLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+        dataBuf = borrow_Translation_Buffer(device, dataBufLength);
         if (!dataBuf)
         {
             return MEMORY_FAILURE;
@@ -13024,7 +13198,10 @@ static int translate_SCSI_Zone_Management_In_Command(tDevice *device, ScsiIoCtx
         //copy the data based on allocation length
         memcpy(scsiIoCtx->pdata, dataBuf, M_Min(scsiIoCtx->dataLength, dataBufLength));
     }
-    safe_Free_aligned(dataBuf)
+    if (localMemory)
+    {
+        return_Translation_Buffer(device, &dataBuf);
+    }
     return ret;
 }
 
@@ -13048,13 +13225,13 @@ static int translate_SCSI_Zone_Management_Out_Command(tDevice *device, ScsiIoCtx
     //if ((allocationLength % 512) != 0)
     //{
     //    dataBufLength = (allocationLength + 511) / 512;
-    //    dataBuf = C_CAST(uint8_t*, calloc_aligned(dataBufLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+    //    dataBuf = borrow_Translation_Buffer(device, dataBufLength);
     //    localMemory = true;
     //}
     //else if (allocationLength == 0)
     //{
     //    dataBufLength = 512;
-    //    dataBuf = C_CAST(uint8_t*, calloc_aligned(dataBufLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+    //    dataBuf = borrow_Translation_Buffer(device, dataBufLength);
     //    localMemory = true;
     //}
     //else
@@ -13132,7 +13309,7 @@ static int translate_SCSI_Zone_Management_Out_Command(tDevice *device, ScsiIoCtx
     //    //copy the data based on allocation length
     //    memcpy(scsiIoCtx->pdata, dataBuf, M_Min(scsiIoCtx->dataLength, dataBufLength));
     //}
-    //safe_Free_aligned(dataBuf)
+    //return_Translation_Buffer(device, &dataBuf);
     return ret;
 }
 
@@ -13336,7 +13513,7 @@ static int check_Operation_Code(tDevice *device, uint8_t operationCode, bool rct
     if (rctd)
     {
         //add 12 bytes for room for the command timeouts descriptor to be setup
-        dataLength += 12;
+        *dataLength += 12;
     }
     switch (operationCode)
     {
@@ -14136,7 +14313,7 @@ static int check_Operation_Code_and_Service_Action(tDevice *device, uint8_t oper
     if (rctd)
     {
         //add 12 bytes for room for the command timeouts descriptor to be setup
-        dataLength += 12;
+        *dataLength += 12;
     }
     switch (operationCode)
     {
@@ -15945,6 +16122,7 @@ static int translate_SCSI_Report_Supported_Operation_Codes_Command(tDevice *devi
     uint32_t allocationLength = M_BytesTo4ByteValue(scsiIoCtx->cdb[6], scsiIoCtx->cdb[7], scsiIoCtx->cdb[8], scsiIoCtx->cdb[9]);
     uint8_t *supportedOpData = NULL;
     uint32_t supportedOpDataLength = 0;
+    uint64_t responseKey = 0;
     uint8_t senseKeySpecificDescriptor[8] = { 0 };
     uint8_t bitPointer = 0;
     uint16_t fieldPointer = 0;
@@ -15979,6 +16157,15 @@ static int translate_SCSI_Report_Supported_Operation_Codes_Command(tDevice *devi
     {
         rctd = true;
     }
+    if (reportingOptions <= 3)
+    {
+        //these responses only depend on what the device supports, so only build them the first time they are asked for
+        responseKey = TRANSLATION_RESPONSE_KEY(REPORT_SUPPORTED_OPERATION_CODES_CMD, reportingOptions, rctd ? 1 : 0, reportingOptions > 0 ? requestedOperationCode : 0, reportingOptions > 1 ? M_Byte1(requestedServiceAction) : 0, reportingOptions > 1 ? M_Byte0(requestedServiceAction) : 0, 0, 0);
+        if (get_Translation_Response(device, responseKey, scsiIoCtx->pdata, M_Min(allocationLength, scsiIoCtx->dataLength), &ret))
+        {
+            return ret;
+        }
+    }
     switch (reportingOptions)
     {
     case 0://return all op codes (return not supported for now until we get the other methods working...)
@@ -16024,6 +16211,10 @@ static int translate_SCSI_Report_Supported_Operation_Codes_Command(tDevice *devi
     {
         memcpy(scsiIoCtx->pdata, supportedOpData, M_Min(supportedOpDataLength, allocationLength));
     }
+    if (supportedOpData && reportingOptions <= 3 && (ret == SUCCESS || ret == NOT_SUPPORTED))
+    {
+        save_Translation_Response(device, responseKey, ret, supportedOpData, supportedOpDataLength);
+    }
     safe_Free(supportedOpData)
     return ret;
 }
@@ -16111,6 +16302,8 @@ int translate_SCSI_Command(tDevice *device, ScsiIoCtx *scsiIoCtx)
             deviceInfoAvailable = true;
         }
     }
+    //read the log support used by the translation if it was skipped during discovery (LAZY_DISCOVERY) or invalidated
+    fill_Lazy_Device_Info(device, LAZY_INFO_ATA_LOG_CAPABILITIES);
     if (device->drive_info.drive_type == ATAPI_DRIVE)
     {
         //TODO: set up an ata packet command and send it to the device to let it handle the scsi command translation
@@ -16121,6 +16314,8 @@ int translate_SCSI_Command(tDevice *device, ScsiIoCtx *scsiIoCtx)
     }
     else
     {
+        //all temporary buffers used by the translation come from the device's scratch region and are released together below.
+        uint32_t scratchMark = begin_Translation_Scratch(device);
         //start checking the scsi command and call the function to translate it
         //All functions within this switch-case should dummy up their own sense data specific to the translation!
         switch (scsiIoCtx->cdb[OPERATION_CODE])
@@ -16399,6 +16594,7 @@ int translate_SCSI_Command(tDevice *device, ScsiIoCtx *scsiIoCtx)
             set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_ILLEGAL_REQUEST, 0x20, 0, device->drive_info.softSATFlags.senseDataDescriptorFormat, senseKeySpecificDescriptor, 1);
             ret = NOT_SUPPORTED;
         }
+        end_Translation_Scratch(device, scratchMark);
     }
     return ret;
 }
@@ -723,6 +723,11 @@ int scsi_Mode_Select_6(tDevice *device, uint8_t parameterListLength, bool pageFo
     {
         print_Return_Enum("Mode Select 6", ret);
     }
+    if (ret == SUCCESS)
+    {
+        //block descriptor may have changed the logical block size or number of blocks
+        invalidate_Lazy_Device_Info(device, LAZY_INFO_CAPACITY);
+    }
     return ret;
 }
 
@@ -772,6 +777,11 @@ int scsi_Mode_Select_10(tDevice *device, uint16_t parameterListLength, bool page
     {
         print_Return_Enum("Mode Select 10", ret);
     }
+    if (ret == SUCCESS)
+    {
+        //block descriptor may have changed the logical block size or number of blocks
+        invalidate_Lazy_Device_Info(device, LAZY_INFO_CAPACITY);
+    }
     return ret;
 }
 
@@ -816,6 +826,11 @@ int scsi_Write_Buffer(tDevice *device, eWriteBufferMode mode, uint8_t modeSpecif
     {
         print_Return_Enum("Write Buffer", ret);
     }
+    if (ret == SUCCESS && ((mode >= SCSI_WB_DL_MICROCODE_TEMP_ACTIVATE && mode <= SCSI_WB_DL_MICROCODE_OFFSETS_SAVE_ACTIVATE) || mode == SCSI_WB_ACTIVATE_DEFERRED_MICROCODE))
+    {
+        //new firmware may report different device information
+        invalidate_Lazy_Device_Info(device, LAZY_INFO_ALL);
+    }
     return ret;
 }
 
@@ -1784,6 +1799,115 @@ int scsi_Format_Unit(tDevice *device, uint8_t fmtpInfo, bool longList, bool fmtD
     {
         print_Return_Enum("Format Unit", ret);
     }
+    if (ret == SUCCESS)
+    {
+        invalidate_Lazy_Device_Info(device, LAZY_INFO_CAPACITY);
+    }
+    return ret;
+}
+
+int scsi_Populate_Token(tDevice *device, uint32_t listIdentifier, uint8_t *ptrData, uint32_t parameterListLength, uint32_t timeoutSeconds)
+{
+    int       ret = FAILURE;
+    uint8_t   cdb[CDB_LEN_16] = { 0 };
+
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        printf("Sending SCSI Populate Token\n");
+    }
+
+    cdb[OPERATION_CODE] = POPULATE_TOKEN;
+    cdb[1] = 0x10;//service action
+    cdb[2] = RESERVED;
+    cdb[3] = RESERVED;
+    cdb[4] = RESERVED;
+    cdb[5] = RESERVED;
+    cdb[6] = M_Byte3(listIdentifier);
+    cdb[7] = M_Byte2(listIdentifier);
+    cdb[8] = M_Byte1(listIdentifier);
+    cdb[9] = M_Byte0(listIdentifier);
+    cdb[10] = M_Byte3(parameterListLength);
+    cdb[11] = M_Byte2(parameterListLength);
+    cdb[12] = M_Byte1(parameterListLength);
+    cdb[13] = M_Byte0(parameterListLength);
+    cdb[14] = 0;//group number
+    cdb[15] = 0;//control
+
+    ret = scsi_Send_Cdb(device, &cdb[0], sizeof(cdb), ptrData, parameterListLength, XFER_DATA_OUT, device->drive_info.lastCommandSenseData, SPC3_SENSE_LEN, timeoutSeconds);
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        print_Return_Enum("Populate Token", ret);
+    }
+    return ret;
+}
+
+int scsi_Write_Using_Token(tDevice *device, uint32_t listIdentifier, uint8_t *ptrData, uint32_t parameterListLength, uint32_t timeoutSeconds)
+{
+    int       ret = FAILURE;
+    uint8_t   cdb[CDB_LEN_16] = { 0 };
+
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        printf("Sending SCSI Write Using Token\n");
+    }
+
+    cdb[OPERATION_CODE] = WRITE_USING_TOKEN;
+    cdb[1] = 0x11;//service action
+    cdb[2] = RESERVED;
+    cdb[3] = RESERVED;
+    cdb[4] = RESERVED;
+    cdb[5] = RESERVED;
+    cdb[6] = M_Byte3(listIdentifier);
+    cdb[7] = M_Byte2(listIdentifier);
+    cdb[8] = M_Byte1(listIdentifier);
+    cdb[9] = M_Byte0(listIdentifier);
+    cdb[10] = M_Byte3(parameterListLength);
+    cdb[11] = M_Byte2(parameterListLength);
+    cdb[12] = M_Byte1(parameterListLength);
+    cdb[13] = M_Byte0(parameterListLength);
+    cdb[14] = 0;//group number
+    cdb[15] = 0;//control
+
+    ret = scsi_Send_Cdb(device, &cdb[0], sizeof(cdb), ptrData, parameterListLength, XFER_DATA_OUT, device->drive_info.lastCommandSenseData, SPC3_SENSE_LEN, timeoutSeconds);
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        print_Return_Enum("Write Using Token", ret);
+    }
+    return ret;
+}
+
+int scsi_Receive_ROD_Token_Information(tDevice *device, uint32_t listIdentifier, uint8_t *ptrData, uint32_t allocationLength)
+{
+    int       ret = FAILURE;
+    uint8_t   cdb[CDB_LEN_16] = { 0 };
+
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        printf("Sending SCSI Receive ROD Token Information\n");
+    }
+
+    cdb[OPERATION_CODE] = RECEIVE_ROD_TOKEN_INFORMATION;
+    cdb[1] = 0x07;//service action
+    cdb[2] = M_Byte3(listIdentifier);
+    cdb[3] = M_Byte2(listIdentifier);
+    cdb[4] = M_Byte1(listIdentifier);
+    cdb[5] = M_Byte0(listIdentifier);
+    cdb[6] = RESERVED;
+    cdb[7] = RESERVED;
+    cdb[8] = RESERVED;
+    cdb[9] = RESERVED;
+    cdb[10] = M_Byte3(allocationLength);
+    cdb[11] = M_Byte2(allocationLength);
+    cdb[12] = M_Byte1(allocationLength);
+    cdb[13] = M_Byte0(allocationLength);
+    cdb[14] = RESERVED;
+    cdb[15] = 0;//control
+
+    ret = scsi_Send_Cdb(device, &cdb[0], sizeof(cdb), ptrData, allocationLength, XFER_DATA_IN, device->drive_info.lastCommandSenseData, SPC3_SENSE_LEN, 15);
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        print_Return_Enum("Receive ROD Token Information", ret);
+    }
     return ret;
 }
 
@@ -18,30 +18,269 @@
 #include "nvme_helper_func.h"
 #endif
 
+//Slice by 8 tables for the SBC CRC16 (polynomial 8BB7h). Table[0] is the CRC of each byte value, table[n] is the CRC of that byte followed by n zero bytes.
+//This lets 8 bytes be folded into the CRC with 8 table lookups instead of 128 shift and xor steps.
+static const uint16_t t10DIFCRCTable[8][256] = {
+    {
+        0x0000, 0x8BB7, 0x9CD9, 0x176E, 0xB205, 0x39B2, 0x2EDC, 0xA56B, 0xEFBD, 0x640A, 0x7364, 0xF8D3, 0x5DB8, 0xD60F, 0xC161, 0x4AD6,
+        0x54CD, 0xDF7A, 0xC814, 0x43A3, 0xE6C8, 0x6D7F, 0x7A11, 0xF1A6, 0xBB70, 0x30C7, 0x27A9, 0xAC1E, 0x0975, 0x82C2, 0x95AC, 0x1E1B,
+        0xA99A, 0x222D, 0x3543, 0xBEF4, 0x1B9F, 0x9028, 0x8746, 0x0CF1, 0x4627, 0xCD90, 0xDAFE, 0x5149, 0xF422, 0x7F95, 0x68FB, 0xE34C,
+        0xFD57, 0x76E0, 0x618E, 0xEA39, 0x4F52, 0xC4E5, 0xD38B, 0x583C, 0x12EA, 0x995D, 0x8E33, 0x0584, 0xA0EF, 0x2B58, 0x3C36, 0xB781,
+        0xD883, 0x5334, 0x445A, 0xCFED, 0x6A86, 0xE131, 0xF65F, 0x7DE8, 0x373E, 0xBC89, 0xABE7, 0x2050, 0x853B, 0x0E8C, 0x19E2, 0x9255,
+        0x8C4E, 0x07F9, 0x1097, 0x9B20, 0x3E4B, 0xB5FC, 0xA292, 0x2925, 0x63F3, 0xE844, 0xFF2A, 0x749D, 0xD1F6, 0x5A41, 0x4D2F, 0xC698,
+        0x7119, 0xFAAE, 0xEDC0, 0x6677, 0xC31C, 0x48AB, 0x5FC5, 0xD472, 0x9EA4, 0x1513, 0x027D, 0x89CA, 0x2CA1, 0xA716, 0xB078, 0x3BCF,
+        0x25D4, 0xAE63, 0xB90D, 0x32BA, 0x97D1, 0x1C66, 0x0B08, 0x80BF, 0xCA69, 0x41DE, 0x56B0, 0xDD07, 0x786C, 0xF3DB, 0xE4B5, 0x6F02,
+        0x3AB1, 0xB106, 0xA668, 0x2DDF, 0x88B4, 0x0303, 0x146D, 0x9FDA, 0xD50C, 0x5EBB, 0x49D5, 0xC262, 0x6709, 0xECBE, 0xFBD0, 0x7067,
+        0x6E7C, 0xE5CB, 0xF2A5, 0x7912, 0xDC79, 0x57CE, 0x40A0, 0xCB17, 0x81C1, 0x0A76, 0x1D18, 0x96AF, 0x33C4, 0xB873, 0xAF1D, 0x24AA,
+        0x932B, 0x189C, 0x0FF2, 0x8445, 0x212E, 0xAA99, 0xBDF7, 0x3640, 0x7C96, 0xF721, 0xE04F, 0x6BF8, 0xCE93, 0x4524, 0x524A, 0xD9FD,
+        0xC7E6, 0x4C51, 0x5B3F, 0xD088, 0x75E3, 0xFE54, 0xE93A, 0x628D, 0x285B, 0xA3EC, 0xB482, 0x3F35, 0x9A5E, 0x11E9, 0x0687, 0x8D30,
+        0xE232, 0x6985, 0x7EEB, 0xF55C, 0x5037, 0xDB80, 0xCCEE, 0x4759, 0x0D8F, 0x8638, 0x9156, 0x1AE1, 0xBF8A, 0x343D, 0x2353, 0xA8E4,
+        0xB6FF, 0x3D48, 0x2A26, 0xA191, 0x04FA, 0x8F4D, 0x9823, 0x1394, 0x5942, 0xD2F5, 0xC59B, 0x4E2C, 0xEB47, 0x60F0, 0x779E, 0xFC29,
+        0x4BA8, 0xC01F, 0xD771, 0x5CC6, 0xF9AD, 0x721A, 0x6574, 0xEEC3, 0xA415, 0x2FA2, 0x38CC, 0xB37B, 0x1610, 0x9DA7, 0x8AC9, 0x017E,
+        0x1F65, 0x94D2, 0x83BC, 0x080B, 0xAD60, 0x26D7, 0x31B9, 0xBA0E, 0xF0D8, 0x7B6F, 0x6C01, 0xE7B6, 0x42DD, 0xC96A, 0xDE04, 0x55B3
+    },
+    {
+        0x0000, 0x7562, 0xEAC4, 0x9FA6, 0x5E3F, 0x2B5D, 0xB4FB, 0xC199, 0xBC7E, 0xC91C, 0x56BA, 0x23D8, 0xE241, 0x9723, 0x0885, 0x7DE7,
+        0xF34B, 0x8629, 0x198F, 0x6CED, 0xAD74, 0xD816, 0x47B0, 0x32D2, 0x4F35, 0x3A57, 0xA5F1, 0xD093, 0x110A, 0x6468, 0xFBCE, 0x8EAC,
+        0x6D21, 0x1843, 0x87E5, 0xF287, 0x331E, 0x467C, 0xD9DA, 0xACB8, 0xD15F, 0xA43D, 0x3B9B, 0x4EF9, 0x8F60, 0xFA02, 0x65A4, 0x10C6,
+        0x9E6A, 0xEB08, 0x74AE, 0x01CC, 0xC055, 0xB537, 0x2A91, 0x5FF3, 0x2214, 0x5776, 0xC8D0, 0xBDB2, 0x7C2B, 0x0949, 0x96EF, 0xE38D,
+        0xDA42, 0xAF20, 0x3086, 0x45E4, 0x847D, 0xF11F, 0x6EB9, 0x1BDB, 0x663C, 0x135E, 0x8CF8, 0xF99A, 0x3803, 0x4D61, 0xD2C7, 0xA7A5,
+        0x2909, 0x5C6B, 0xC3CD, 0xB6AF, 0x7736, 0x0254, 0x9DF2, 0xE890, 0x9577, 0xE015, 0x7FB3, 0x0AD1, 0xCB48, 0xBE2A, 0x218C, 0x54EE,
+        0xB763, 0xC201, 0x5DA7, 0x28C5, 0xE95C, 0x9C3E, 0x0398, 0x76FA, 0x0B1D, 0x7E7F, 0xE1D9, 0x94BB, 0x5522, 0x2040, 0xBFE6, 0xCA84,
+        0x4428, 0x314A, 0xAEEC, 0xDB8E, 0x1A17, 0x6F75, 0xF0D3, 0x85B1, 0xF856, 0x8D34, 0x1292, 0x67F0, 0xA669, 0xD30B, 0x4CAD, 0x39CF,
+        0x3F33, 0x4A51, 0xD5F7, 0xA095, 0x610C, 0x146E, 0x8BC8, 0xFEAA, 0x834D, 0xF62F, 0x6989, 0x1CEB, 0xDD72, 0xA810, 0x37B6, 0x42D4,
+        0xCC78, 0xB91A, 0x26BC, 0x53DE, 0x9247, 0xE725, 0x7883, 0x0DE1, 0x7006, 0x0564, 0x9AC2, 0xEFA0, 0x2E39, 0x5B5B, 0xC4FD, 0xB19F,
+        0x5212, 0x2770, 0xB8D6, 0xCDB4, 0x0C2D, 0x794F, 0xE6E9, 0x938B, 0xEE6C, 0x9B0E, 0x04A8, 0x71CA, 0xB053, 0xC531, 0x5A97, 0x2FF5,
+        0xA159, 0xD43B, 0x4B9D, 0x3EFF, 0xFF66, 0x8A04, 0x15A2, 0x60C0, 0x1D27, 0x6845, 0xF7E3, 0x8281, 0x4318, 0x367A, 0xA9DC, 0xDCBE,
+        0xE571, 0x9013, 0x0FB5, 0x7AD7, 0xBB4E, 0xCE2C, 0x518A, 0x24E8, 0x590F, 0x2C6D, 0xB3CB, 0xC6A9, 0x0730, 0x7252, 0xEDF4, 0x9896,
+        0x163A, 0x6358, 0xFCFE, 0x899C, 0x4805, 0x3D67, 0xA2C1, 0xD7A3, 0xAA44, 0xDF26, 0x4080, 0x35E2, 0xF47B, 0x8119, 0x1EBF, 0x6BDD,
+        0x8850, 0xFD32, 0x6294, 0x17F6, 0xD66F, 0xA30D, 0x3CAB, 0x49C9, 0x342E, 0x414C, 0xDEEA, 0xAB88, 0x6A11, 0x1F73, 0x80D5, 0xF5B7,
+        0x7B1B, 0x0E79, 0x91DF, 0xE4BD, 0x2524, 0x5046, 0xCFE0, 0xBA82, 0xC765, 0xB207, 0x2DA1, 0x58C3, 0x995A, 0xEC38, 0x739E, 0x06FC
+    },
+    {
+        0x0000, 0x7E66, 0xFCCC, 0x82AA, 0x722F, 0x0C49, 0x8EE3, 0xF085, 0xE45E, 0x9A38, 0x1892, 0x66F4, 0x9671, 0xE817, 0x6ABD, 0x14DB,
+        0x430B, 0x3D6D, 0xBFC7, 0xC1A1, 0x3124, 0x4F42, 0xCDE8, 0xB38E, 0xA755, 0xD933, 0x5B99, 0x25FF, 0xD57A, 0xAB1C, 0x29B6, 0x57D0,
+        0x8616, 0xF870, 0x7ADA, 0x04BC, 0xF439, 0x8A5F, 0x08F5, 0x7693, 0x6248, 0x1C2E, 0x9E84, 0xE0E2, 0x1067, 0x6E01, 0xECAB, 0x92CD,
+        0xC51D, 0xBB7B, 0x39D1, 0x47B7, 0xB732, 0xC954, 0x4BFE, 0x3598, 0x2143, 0x5F25, 0xDD8F, 0xA3E9, 0x536C, 0x2D0A, 0xAFA0, 0xD1C6,
+        0x879B, 0xF9FD, 0x7B57, 0x0531, 0xF5B4, 0x8BD2, 0x0978, 0x771E, 0x63C5, 0x1DA3, 0x9F09, 0xE16F, 0x11EA, 0x6F8C, 0xED26, 0x9340,
+        0xC490, 0xBAF6, 0x385C, 0x463A, 0xB6BF, 0xC8D9, 0x4A73, 0x3415, 0x20CE, 0x5EA8, 0xDC02, 0xA264, 0x52E1, 0x2C87, 0xAE2D, 0xD04B,
+        0x018D, 0x7FEB, 0xFD41, 0x8327, 0x73A2, 0x0DC4, 0x8F6E, 0xF108, 0xE5D3, 0x9BB5, 0x191F, 0x6779, 0x97FC, 0xE99A, 0x6B30, 0x1556,
+        0x4286, 0x3CE0, 0xBE4A, 0xC02C, 0x30A9, 0x4ECF, 0xCC65, 0xB203, 0xA6D8, 0xD8BE, 0x5A14, 0x2472, 0xD4F7, 0xAA91, 0x283B, 0x565D,
+        0x8481, 0xFAE7, 0x784D, 0x062B, 0xF6AE, 0x88C8, 0x0A62, 0x7404, 0x60DF, 0x1EB9, 0x9C13, 0xE275, 0x12F0, 0x6C96, 0xEE3C, 0x905A,
+        0xC78A, 0xB9EC, 0x3B46, 0x4520, 0xB5A5, 0xCBC3, 0x4969, 0x370F, 0x23D4, 0x5DB2, 0xDF18, 0xA17E, 0x51FB, 0x2F9D, 0xAD37, 0xD351,
+        0x0297, 0x7CF1, 0xFE5B, 0x803D, 0x70B8, 0x0EDE, 0x8C74, 0xF212, 0xE6C9, 0x98AF, 0x1A05, 0x6463, 0x94E6, 0xEA80, 0x682A, 0x164C,
+        0x419C, 0x3FFA, 0xBD50, 0xC336, 0x33B3, 0x4DD5, 0xCF7F, 0xB119, 0xA5C2, 0xDBA4, 0x590E, 0x2768, 0xD7ED, 0xA98B, 0x2B21, 0x5547,
+        0x031A, 0x7D7C, 0xFFD6, 0x81B0, 0x7135, 0x0F53, 0x8DF9, 0xF39F, 0xE744, 0x9922, 0x1B88, 0x65EE, 0x956B, 0xEB0D, 0x69A7, 0x17C1,
+        0x4011, 0x3E77, 0xBCDD, 0xC2BB, 0x323E, 0x4C58, 0xCEF2, 0xB094, 0xA44F, 0xDA29, 0x5883, 0x26E5, 0xD660, 0xA806, 0x2AAC, 0x54CA,
+        0x850C, 0xFB6A, 0x79C0, 0x07A6, 0xF723, 0x8945, 0x0BEF, 0x7589, 0x6152, 0x1F34, 0x9D9E, 0xE3F8, 0x137D, 0x6D1B, 0xEFB1, 0x91D7,
+        0xC607, 0xB861, 0x3ACB, 0x44AD, 0xB428, 0xCA4E, 0x48E4, 0x3682, 0x2259, 0x5C3F, 0xDE95, 0xA0F3, 0x5076, 0x2E10, 0xACBA, 0xD2DC
+    },
+    {
+        0x0000, 0x82B5, 0x8EDD, 0x0C68, 0x960D, 0x14B8, 0x18D0, 0x9A65, 0xA7AD, 0x2518, 0x2970, 0xABC5, 0x31A0, 0xB315, 0xBF7D, 0x3DC8,
+        0xC4ED, 0x4658, 0x4A30, 0xC885, 0x52E0, 0xD055, 0xDC3D, 0x5E88, 0x6340, 0xE1F5, 0xED9D, 0x6F28, 0xF54D, 0x77F8, 0x7B90, 0xF925,
+        0x026D, 0x80D8, 0x8CB0, 0x0E05, 0x9460, 0x16D5, 0x1ABD, 0x9808, 0xA5C0, 0x2775, 0x2B1D, 0xA9A8, 0x33CD, 0xB178, 0xBD10, 0x3FA5,
+        0xC680, 0x4435, 0x485D, 0xCAE8, 0x508D, 0xD238, 0xDE50, 0x5CE5, 0x612D, 0xE398, 0xEFF0, 0x6D45, 0xF720, 0x7595, 0x79FD, 0xFB48,
+        0x04DA, 0x866F, 0x8A07, 0x08B2, 0x92D7, 0x1062, 0x1C0A, 0x9EBF, 0xA377, 0x21C2, 0x2DAA, 0xAF1F, 0x357A, 0xB7CF, 0xBBA7, 0x3912,
+        0xC037, 0x4282, 0x4EEA, 0xCC5F, 0x563A, 0xD48F, 0xD8E7, 0x5A52, 0x679A, 0xE52F, 0xE947, 0x6BF2, 0xF197, 0x7322, 0x7F4A, 0xFDFF,
+        0x06B7, 0x8402, 0x886A, 0x0ADF, 0x90BA, 0x120F, 0x1E67, 0x9CD2, 0xA11A, 0x23AF, 0x2FC7, 0xAD72, 0x3717, 0xB5A2, 0xB9CA, 0x3B7F,
+        0xC25A, 0x40EF, 0x4C87, 0xCE32, 0x5457, 0xD6E2, 0xDA8A, 0x583F, 0x65F7, 0xE742, 0xEB2A, 0x699F, 0xF3FA, 0x714F, 0x7D27, 0xFF92,
+        0x09B4, 0x8B01, 0x8769, 0x05DC, 0x9FB9, 0x1D0C, 0x1164, 0x93D1, 0xAE19, 0x2CAC, 0x20C4, 0xA271, 0x3814, 0xBAA1, 0xB6C9, 0x347C,
+        0xCD59, 0x4FEC, 0x4384, 0xC131, 0x5B54, 0xD9E1, 0xD589, 0x573C, 0x6AF4, 0xE841, 0xE429, 0x669C, 0xFCF9, 0x7E4C, 0x7224, 0xF091,
+        0x0BD9, 0x896C, 0x8504, 0x07B1, 0x9DD4, 0x1F61, 0x1309, 0x91BC, 0xAC74, 0x2EC1, 0x22A9, 0xA01C, 0x3A79, 0xB8CC, 0xB4A4, 0x3611,
+        0xCF34, 0x4D81, 0x41E9, 0xC35C, 0x5939, 0xDB8C, 0xD7E4, 0x5551, 0x6899, 0xEA2C, 0xE644, 0x64F1, 0xFE94, 0x7C21, 0x7049, 0xF2FC,
+        0x0D6E, 0x8FDB, 0x83B3, 0x0106, 0x9B63, 0x19D6, 0x15BE, 0x970B, 0xAAC3, 0x2876, 0x241E, 0xA6AB, 0x3CCE, 0xBE7B, 0xB213, 0x30A6,
+        0xC983, 0x4B36, 0x475E, 0xC5EB, 0x5F8E, 0xDD3B, 0xD153, 0x53E6, 0x6E2E, 0xEC9B, 0xE0F3, 0x6246, 0xF823, 0x7A96, 0x76FE, 0xF44B,
+        0x0F03, 0x8DB6, 0x81DE, 0x036B, 0x990E, 0x1BBB, 0x17D3, 0x9566, 0xA8AE, 0x2A1B, 0x2673, 0xA4C6, 0x3EA3, 0xBC16, 0xB07E, 0x32CB,
+        0xCBEE, 0x495B, 0x4533, 0xC786, 0x5DE3, 0xDF56, 0xD33E, 0x518B, 0x6C43, 0xEEF6, 0xE29E, 0x602B, 0xFA4E, 0x78FB, 0x7493, 0xF626
+    },
+    {
+        0x0000, 0x1368, 0x26D0, 0x35B8, 0x4DA0, 0x5EC8, 0x6B70, 0x7818, 0x9B40, 0x8828, 0xBD90, 0xAEF8, 0xD6E0, 0xC588, 0xF030, 0xE358,
+        0xBD37, 0xAE5F, 0x9BE7, 0x888F, 0xF097, 0xE3FF, 0xD647, 0xC52F, 0x2677, 0x351F, 0x00A7, 0x13CF, 0x6BD7, 0x78BF, 0x4D07, 0x5E6F,
+        0xF1D9, 0xE2B1, 0xD709, 0xC461, 0xBC79, 0xAF11, 0x9AA9, 0x89C1, 0x6A99, 0x79F1, 0x4C49, 0x5F21, 0x2739, 0x3451, 0x01E9, 0x1281,
+        0x4CEE, 0x5F86, 0x6A3E, 0x7956, 0x014E, 0x1226, 0x279E, 0x34F6, 0xD7AE, 0xC4C6, 0xF17E, 0xE216, 0x9A0E, 0x8966, 0xBCDE, 0xAFB6,
+        0x6805, 0x7B6D, 0x4ED5, 0x5DBD, 0x25A5, 0x36CD, 0x0375, 0x101D, 0xF345, 0xE02D, 0xD595, 0xC6FD, 0xBEE5, 0xAD8D, 0x9835, 0x8B5D,
+        0xD532, 0xC65A, 0xF3E2, 0xE08A, 0x9892, 0x8BFA, 0xBE42, 0xAD2A, 0x4E72, 0x5D1A, 0x68A2, 0x7BCA, 0x03D2, 0x10BA, 0x2502, 0x366A,
+        0x99DC, 0x8AB4, 0xBF0C, 0xAC64, 0xD47C, 0xC714, 0xF2AC, 0xE1C4, 0x029C, 0x11F4, 0x244C, 0x3724, 0x4F3C, 0x5C54, 0x69EC, 0x7A84,
+        0x24EB, 0x3783, 0x023B, 0x1153, 0x694B, 0x7A23, 0x4F9B, 0x5CF3, 0xBFAB, 0xACC3, 0x997B, 0x8A13, 0xF20B, 0xE163, 0xD4DB, 0xC7B3,
+        0xD00A, 0xC362, 0xF6DA, 0xE5B2, 0x9DAA, 0x8EC2, 0xBB7A, 0xA812, 0x4B4A, 0x5822, 0x6D9A, 0x7EF2, 0x06EA, 0x1582, 0x203A, 0x3352,
+        0x6D3D, 0x7E55, 0x4BED, 0x5885, 0x209D, 0x33F5, 0x064D, 0x1525, 0xF67D, 0xE515, 0xD0AD, 0xC3C5, 0xBBDD, 0xA8B5, 0x9D0D, 0x8E65,
+        0x21D3, 0x32BB, 0x0703, 0x146B, 0x6C73, 0x7F1B, 0x4AA3, 0x59CB, 0xBA93, 0xA9FB, 0x9C43, 0x8F2B, 0xF733, 0xE45B, 0xD1E3, 0xC28B,
+        0x9CE4, 0x8F8C, 0xBA34, 0xA95C, 0xD144, 0xC22C, 0xF794, 0xE4FC, 0x07A4, 0x14CC, 0x2174, 0x321C, 0x4A04, 0x596C, 0x6CD4, 0x7FBC,
+        0xB80F, 0xAB67, 0x9EDF, 0x8DB7, 0xF5AF, 0xE6C7, 0xD37F, 0xC017, 0x234F, 0x3027, 0x059F, 0x16F7, 0x6EEF, 0x7D87, 0x483F, 0x5B57,
+        0x0538, 0x1650, 0x23E8, 0x3080, 0x4898, 0x5BF0, 0x6E48, 0x7D20, 0x9E78, 0x8D10, 0xB8A8, 0xABC0, 0xD3D8, 0xC0B0, 0xF508, 0xE660,
+        0x49D6, 0x5ABE, 0x6F06, 0x7C6E, 0x0476, 0x171E, 0x22A6, 0x31CE, 0xD296, 0xC1FE, 0xF446, 0xE72E, 0x9F36, 0x8C5E, 0xB9E6, 0xAA8E,
+        0xF4E1, 0xE789, 0xD231, 0xC159, 0xB941, 0xAA29, 0x9F91, 0x8CF9, 0x6FA1, 0x7CC9, 0x4971, 0x5A19, 0x2201, 0x3169, 0x04D1, 0x17B9
+    },
+    {
+        0x0000, 0x2BA3, 0x5746, 0x7CE5, 0xAE8C, 0x852F, 0xF9CA, 0xD269, 0xD6AF, 0xFD0C, 0x81E9, 0xAA4A, 0x7823, 0x5380, 0x2F65, 0x04C6,
+        0x26E9, 0x0D4A, 0x71AF, 0x5A0C, 0x8865, 0xA3C6, 0xDF23, 0xF480, 0xF046, 0xDBE5, 0xA700, 0x8CA3, 0x5ECA, 0x7569, 0x098C, 0x222F,
+        0x4DD2, 0x6671, 0x1A94, 0x3137, 0xE35E, 0xC8FD, 0xB418, 0x9FBB, 0x9B7D, 0xB0DE, 0xCC3B, 0xE798, 0x35F1, 0x1E52, 0x62B7, 0x4914,
+        0x6B3B, 0x4098, 0x3C7D, 0x17DE, 0xC5B7, 0xEE14, 0x92F1, 0xB952, 0xBD94, 0x9637, 0xEAD2, 0xC171, 0x1318, 0x38BB, 0x445E, 0x6FFD,
+        0x9BA4, 0xB007, 0xCCE2, 0xE741, 0x3528, 0x1E8B, 0x626E, 0x49CD, 0x4D0B, 0x66A8, 0x1A4D, 0x31EE, 0xE387, 0xC824, 0xB4C1, 0x9F62,
+        0xBD4D, 0x96EE, 0xEA0B, 0xC1A8, 0x13C1, 0x3862, 0x4487, 0x6F24, 0x6BE2, 0x4041, 0x3CA4, 0x1707, 0xC56E, 0xEECD, 0x9228, 0xB98B,
+        0xD676, 0xFDD5, 0x8130, 0xAA93, 0x78FA, 0x5359, 0x2FBC, 0x041F, 0x00D9, 0x2B7A, 0x579F, 0x7C3C, 0xAE55, 0x85F6, 0xF913, 0xD2B0,
+        0xF09F, 0xDB3C, 0xA7D9, 0x8C7A, 0x5E13, 0x75B0, 0x0955, 0x22F6, 0x2630, 0x0D93, 0x7176, 0x5AD5, 0x88BC, 0xA31F, 0xDFFA, 0xF459,
+        0xBCFF, 0x975C, 0xEBB9, 0xC01A, 0x1273, 0x39D0, 0x4535, 0x6E96, 0x6A50, 0x41F3, 0x3D16, 0x16B5, 0xC4DC, 0xEF7F, 0x939A, 0xB839,
+        0x9A16, 0xB1B5, 0xCD50, 0xE6F3, 0x349A, 0x1F39, 0x63DC, 0x487F, 0x4CB9, 0x671A, 0x1BFF, 0x305C, 0xE235, 0xC996, 0xB573, 0x9ED0,
+        0xF12D, 0xDA8E, 0xA66B, 0x8DC8, 0x5FA1, 0x7402, 0x08E7, 0x2344, 0x2782, 0x0C21, 0x70C4, 0x5B67, 0x890E, 0xA2AD, 0xDE48, 0xF5EB,
+        0xD7C4, 0xFC67, 0x8082, 0xAB21, 0x7948, 0x52EB, 0x2E0E, 0x05AD, 0x016B, 0x2AC8, 0x562D, 0x7D8E, 0xAFE7, 0x8444, 0xF8A1, 0xD302,
+        0x275B, 0x0CF8, 0x701D, 0x5BBE, 0x89D7, 0xA274, 0xDE91, 0xF532, 0xF1F4, 0xDA57, 0xA6B2, 0x8D11, 0x5F78, 0x74DB, 0x083E, 0x239D,
+        0x01B2, 0x2A11, 0x56F4, 0x7D57, 0xAF3E, 0x849D, 0xF878, 0xD3DB, 0xD71D, 0xFCBE, 0x805B, 0xABF8, 0x7991, 0x5232, 0x2ED7, 0x0574,
+        0x6A89, 0x412A, 0x3DCF, 0x166C, 0xC405, 0xEFA6, 0x9343, 0xB8E0, 0xBC26, 0x9785, 0xEB60, 0xC0C3, 0x12AA, 0x3909, 0x45EC, 0x6E4F,
+        0x4C60, 0x67C3, 0x1B26, 0x3085, 0xE2EC, 0xC94F, 0xB5AA, 0x9E09, 0x9ACF, 0xB16C, 0xCD89, 0xE62A, 0x3443, 0x1FE0, 0x6305, 0x48A6
+    },
+    {
+        0x0000, 0xF249, 0x6F25, 0x9D6C, 0xDE4A, 0x2C03, 0xB16F, 0x4326, 0x3723, 0xC56A, 0x5806, 0xAA4F, 0xE969, 0x1B20, 0x864C, 0x7405,
+        0x6E46, 0x9C0F, 0x0163, 0xF32A, 0xB00C, 0x4245, 0xDF29, 0x2D60, 0x5965, 0xAB2C, 0x3640, 0xC409, 0x872F, 0x7566, 0xE80A, 0x1A43,
+        0xDC8C, 0x2EC5, 0xB3A9, 0x41E0, 0x02C6, 0xF08F, 0x6DE3, 0x9FAA, 0xEBAF, 0x19E6, 0x848A, 0x76C3, 0x35E5, 0xC7AC, 0x5AC0, 0xA889,
+        0xB2CA, 0x4083, 0xDDEF, 0x2FA6, 0x6C80, 0x9EC9, 0x03A5, 0xF1EC, 0x85E9, 0x77A0, 0xEACC, 0x1885, 0x5BA3, 0xA9EA, 0x3486, 0xC6CF,
+        0x32AF, 0xC0E6, 0x5D8A, 0xAFC3, 0xECE5, 0x1EAC, 0x83C0, 0x7189, 0x058C, 0xF7C5, 0x6AA9, 0x98E0, 0xDBC6, 0x298F, 0xB4E3, 0x46AA,
+        0x5CE9, 0xAEA0, 0x33CC, 0xC185, 0x82A3, 0x70EA, 0xED86, 0x1FCF, 0x6BCA, 0x9983, 0x04EF, 0xF6A6, 0xB580, 0x47C9, 0xDAA5, 0x28EC,
+        0xEE23, 0x1C6A, 0x8106, 0x734F, 0x3069, 0xC220, 0x5F4C, 0xAD05, 0xD900, 0x2B49, 0xB625, 0x446C, 0x074A, 0xF503, 0x686F, 0x9A26,
+        0x8065, 0x722C, 0xEF40, 0x1D09, 0x5E2F, 0xAC66, 0x310A, 0xC343, 0xB746, 0x450F, 0xD863, 0x2A2A, 0x690C, 0x9B45, 0x0629, 0xF460,
+        0x655E, 0x9717, 0x0A7B, 0xF832, 0xBB14, 0x495D, 0xD431, 0x2678, 0x527D, 0xA034, 0x3D58, 0xCF11, 0x8C37, 0x7E7E, 0xE312, 0x115B,
+        0x0B18, 0xF951, 0x643D, 0x9674, 0xD552, 0x271B, 0xBA77, 0x483E, 0x3C3B, 0xCE72, 0x531E, 0xA157, 0xE271, 0x1038, 0x8D54, 0x7F1D,
+        0xB9D2, 0x4B9B, 0xD6F7, 0x24BE, 0x6798, 0x95D1, 0x08BD, 0xFAF4, 0x8EF1, 0x7CB8, 0xE1D4, 0x139D, 0x50BB, 0xA2F2, 0x3F9E, 0xCDD7,
+        0xD794, 0x25DD, 0xB8B1, 0x4AF8, 0x09DE, 0xFB97, 0x66FB, 0x94B2, 0xE0B7, 0x12FE, 0x8F92, 0x7DDB, 0x3EFD, 0xCCB4, 0x51D8, 0xA391,
+        0x57F1, 0xA5B8, 0x38D4, 0xCA9D, 0x89BB, 0x7BF2, 0xE69E, 0x14D7, 0x60D2, 0x929B, 0x0FF7, 0xFDBE, 0xBE98, 0x4CD1, 0xD1BD, 0x23F4,
+        0x39B7, 0xCBFE, 0x5692, 0xA4DB, 0xE7FD, 0x15B4, 0x88D8, 0x7A91, 0x0E94, 0xFCDD, 0x61B1, 0x93F8, 0xD0DE, 0x2297, 0xBFFB, 0x4DB2,
+        0x8B7D, 0x7934, 0xE458, 0x1611, 0x5537, 0xA77E, 0x3A12, 0xC85B, 0xBC5E, 0x4E17, 0xD37B, 0x2132, 0x6214, 0x905D, 0x0D31, 0xFF78,
+        0xE53B, 0x1772, 0x8A1E, 0x7857, 0x3B71, 0xC938, 0x5454, 0xA61D, 0xD218, 0x2051, 0xBD3D, 0x4F74, 0x0C52, 0xFE1B, 0x6377, 0x913E
+    },
+    {
+        0x0000, 0xCABC, 0x1ECF, 0xD473, 0x3D9E, 0xF722, 0x2351, 0xE9ED, 0x7B3C, 0xB180, 0x65F3, 0xAF4F, 0x46A2, 0x8C1E, 0x586D, 0x92D1,
+        0xF678, 0x3CC4, 0xE8B7, 0x220B, 0xCBE6, 0x015A, 0xD529, 0x1F95, 0x8D44, 0x47F8, 0x938B, 0x5937, 0xB0DA, 0x7A66, 0xAE15, 0x64A9,
+        0x6747, 0xADFB, 0x7988, 0xB334, 0x5AD9, 0x9065, 0x4416, 0x8EAA, 0x1C7B, 0xD6C7, 0x02B4, 0xC808, 0x21E5, 0xEB59, 0x3F2A, 0xF596,
+        0x913F, 0x5B83, 0x8FF0, 0x454C, 0xACA1, 0x661D, 0xB26E, 0x78D2, 0xEA03, 0x20BF, 0xF4CC, 0x3E70, 0xD79D, 0x1D21, 0xC952, 0x03EE,
+        0xCE8E, 0x0432, 0xD041, 0x1AFD, 0xF310, 0x39AC, 0xEDDF, 0x2763, 0xB5B2, 0x7F0E, 0xAB7D, 0x61C1, 0x882C, 0x4290, 0x96E3, 0x5C5F,
+        0x38F6, 0xF24A, 0x2639, 0xEC85, 0x0568, 0xCFD4, 0x1BA7, 0xD11B, 0x43CA, 0x8976, 0x5D05, 0x97B9, 0x7E54, 0xB4E8, 0x609B, 0xAA27,
+        0xA9C9, 0x6375, 0xB706, 0x7DBA, 0x9457, 0x5EEB, 0x8A98, 0x4024, 0xD2F5, 0x1849, 0xCC3A, 0x0686, 0xEF6B, 0x25D7, 0xF1A4, 0x3B18,
+        0x5FB1, 0x950D, 0x417E, 0x8BC2, 0x622F, 0xA893, 0x7CE0, 0xB65C, 0x248D, 0xEE31, 0x3A42, 0xF0FE, 0x1913, 0xD3AF, 0x07DC, 0xCD60,
+        0x16AB, 0xDC17, 0x0864, 0xC2D8, 0x2B35, 0xE189, 0x35FA, 0xFF46, 0x6D97, 0xA72B, 0x7358, 0xB9E4, 0x5009, 0x9AB5, 0x4EC6, 0x847A,
+        0xE0D3, 0x2A6F, 0xFE1C, 0x34A0, 0xDD4D, 0x17F1, 0xC382, 0x093E, 0x9BEF, 0x5153, 0x8520, 0x4F9C, 0xA671, 0x6CCD, 0xB8BE, 0x7202,
+        0x71EC, 0xBB50, 0x6F23, 0xA59F, 0x4C72, 0x86CE, 0x52BD, 0x9801, 0x0AD0, 0xC06C, 0x141F, 0xDEA3, 0x374E, 0xFDF2, 0x2981, 0xE33D,
+        0x8794, 0x4D28, 0x995B, 0x53E7, 0xBA0A, 0x70B6, 0xA4C5, 0x6E79, 0xFCA8, 0x3614, 0xE267, 0x28DB, 0xC136, 0x0B8A, 0xDFF9, 0x1545,
+        0xD825, 0x1299, 0xC6EA, 0x0C56, 0xE5BB, 0x2F07, 0xFB74, 0x31C8, 0xA319, 0x69A5, 0xBDD6, 0x776A, 0x9E87, 0x543B, 0x8048, 0x4AF4,
+        0x2E5D, 0xE4E1, 0x3092, 0xFA2E, 0x13C3, 0xD97F, 0x0D0C, 0xC7B0, 0x5561, 0x9FDD, 0x4BAE, 0x8112, 0x68FF, 0xA243, 0x7630, 0xBC8C,
+        0xBF62, 0x75DE, 0xA1AD, 0x6B11, 0x82FC, 0x4840, 0x9C33, 0x568F, 0xC45E, 0x0EE2, 0xDA91, 0x102D, 0xF9C0, 0x337C, 0xE70F, 0x2DB3,
+        0x491A, 0x83A6, 0x57D5, 0x9D69, 0x7484, 0xBE38, 0x6A4B, 0xA0F7, 0x3226, 0xF89A, 0x2CE9, 0xE655, 0x0FB8, 0xC504, 0x1177, 0xDBCB
+    }
+};
+
+static uint16_t t10_DIF_CRC(uint16_t crc, const uint8_t *buffer, uint32_t length)
+{
+    uint32_t iter = 0;
+    for (; iter + 8 <= length; iter += 8)
+    {
+        crc = t10DIFCRCTable[7][buffer[iter] ^ M_Byte1(crc)] ^ t10DIFCRCTable[6][buffer[iter + 1] ^ M_Byte0(crc)]
+            ^ t10DIFCRCTable[5][buffer[iter + 2]] ^ t10DIFCRCTable[4][buffer[iter + 3]]
+            ^ t10DIFCRCTable[3][buffer[iter + 4]] ^ t10DIFCRCTable[2][buffer[iter + 5]]
+            ^ t10DIFCRCTable[1][buffer[iter + 6]] ^ t10DIFCRCTable[0][buffer[iter + 7]];
+    }
+    for (; iter < length; ++iter)
+    {
+        crc = C_CAST(uint16_t, crc << 8) ^ t10DIFCRCTable[0][M_Byte1(crc) ^ buffer[iter]];
+    }
+    return crc;
+}
+
 uint16_t calculate_Logical_Block_Guard(uint8_t *buffer, uint32_t userDataLength, uint32_t totalDataLength)
 {
-    uint16_t crc = 0;//Can also be all F's to invert it. TODO: should invert be a boolean option to this function? - TJE
-    uint16_t const polynomial = 0x8BB7L;
     if (!buffer)
     {
         return 0;
     }
-    for (uint32_t iter = 0; iter < userDataLength && iter < totalDataLength; iter += 2)
+    //Can also start with all F's to invert it. TODO: should invert be a boolean option to this function? - TJE
+    return t10_DIF_CRC(0, buffer, M_Min(userDataLength, totalDataLength));
+}
+
+#define PROTECTION_INFORMATION_LENGTH 8
+
+//Checks the arguments common to generating and verifying PI and gets the size of each protection interval.
+static int get_Protection_Interval_Size(uint32_t bufferLength, uint32_t logicalBlockSize, uint8_t protectionType, uint8_t piExponent, uint32_t *intervalSize, uint32_t *intervalCount)
+{
+    if (protectionType < 1 || protectionType > 3 || piExponent > 15 || logicalBlockSize == 0 || (logicalBlockSize % (UINT32_C(1) << piExponent)) != 0)
+    {
+        return BAD_PARAMETER;
+    }
+    *intervalSize = logicalBlockSize >> piExponent;
+    if (*intervalSize == 0 || (bufferLength % (*intervalSize + PROTECTION_INFORMATION_LENGTH)) != 0)
+    {
+        return BAD_PARAMETER;
+    }
+    *intervalCount = bufferLength / (*intervalSize + PROTECTION_INFORMATION_LENGTH);
+    return SUCCESS;
+}
+
+int generate_Protection_Information(uint8_t *buffer, uint32_t bufferLength, uint32_t logicalBlockSize, uint8_t protectionType, uint8_t piExponent, uint32_t initialReferenceTag, uint16_t applicationTag)
+{
+    uint32_t intervalSize = 0;
+    uint32_t intervalCount = 0;
+    int ret = SUCCESS;
+    if (!buffer)
+    {
+        return BAD_PARAMETER;
+    }
+    ret = get_Protection_Interval_Size(bufferLength, logicalBlockSize, protectionType, piExponent, &intervalSize, &intervalCount);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+    for (uint32_t intervalIter = 0; intervalIter < intervalCount; ++intervalIter)
+    {
+        uint8_t *interval = buffer + C_CAST(size_t, intervalIter) * (intervalSize + PROTECTION_INFORMATION_LENGTH);
+        uint8_t *pi = interval + intervalSize;
+        uint16_t guard = t10_DIF_CRC(0, interval, intervalSize);
+        uint32_t referenceTag = protectionType == 3 ? initialReferenceTag : initialReferenceTag + intervalIter;
+        pi[0] = M_Byte1(guard);
+        pi[1] = M_Byte0(guard);
+        pi[2] = M_Byte1(applicationTag);
+        pi[3] = M_Byte0(applicationTag);
+        pi[4] = M_Byte3(referenceTag);
+        pi[5] = M_Byte2(referenceTag);
+        pi[6] = M_Byte1(referenceTag);
+        pi[7] = M_Byte0(referenceTag);
+    }
+    return ret;
+}
+
+int verify_Protection_Information(uint8_t *buffer, uint32_t bufferLength, uint32_t logicalBlockSize, uint8_t protectionType, uint8_t piExponent, uint32_t initialReferenceTag, uint16_t applicationTag, uint16_t applicationTagMask, uint32_t *firstBadInterval)
+{
+    uint32_t intervalSize = 0;
+    uint32_t intervalCount = 0;
+    int ret = SUCCESS;
+    if (!buffer)
+    {
+        return BAD_PARAMETER;
+    }
+    ret = get_Protection_Interval_Size(bufferLength, logicalBlockSize, protectionType, piExponent, &intervalSize, &intervalCount);
+    if (ret != SUCCESS)
     {
-        uint16_t x = M_BytesTo2ByteValue(buffer[iter], buffer[iter + 1]);
-        for (uint32_t bitIter = 0; bitIter < 16; ++bitIter)
+        return ret;
+    }
+    for (uint32_t intervalIter = 0; intervalIter < intervalCount; ++intervalIter)
+    {
+        uint8_t *interval = buffer + C_CAST(size_t, intervalIter) * (intervalSize + PROTECTION_INFORMATION_LENGTH);
+        uint8_t *pi = interval + intervalSize;
+        uint16_t storedApplicationTag = M_BytesTo2ByteValue(pi[2], pi[3]);
+        uint32_t storedReferenceTag = M_BytesTo4ByteValue(pi[4], pi[5], pi[6], pi[7]);
+        //SBC: an application tag of all F's turns off checking for the interval. Type 3 also needs the reference tag to be all F's since it is not otherwise checked.
+        if (storedApplicationTag == UINT16_MAX && (protectionType != 3 || storedReferenceTag == UINT32_MAX))
+        {
+            continue;
+        }
+        if (M_BytesTo2ByteValue(pi[0], pi[1]) != t10_DIF_CRC(0, interval, intervalSize)
+            || (storedApplicationTag & applicationTagMask) != (applicationTag & applicationTagMask)
+            || (protectionType != 3 && storedReferenceTag != initialReferenceTag + intervalIter))
         {
-            bool bit15Set = ((x & BIT15) == BIT15) ^ ((crc & BIT15) == BIT15);
-            x <<= 1;
-            crc <<= 1;
-            if (bit15Set)
+            if (firstBadInterval)
             {
-                crc ^= polynomial;
+                *firstBadInterval = intervalIter;
             }
+            return FAILURE;
         }
-
     }
-    return crc;
+    return ret;
 }
 
 //this is mean to only be called by check_Sense_Key_asc_And_ascq()
@@ -8959,6 +9198,340 @@ bool is_Seagate_USB_Vendor_ID(tDevice* device)
     }
 }
 
+//Reads the unit serial number VPD page into the device's serial number
+static int read_SCSI_Unit_Serial_Number(tDevice *device)
+{
+    int ret = FAILURE;
+    uint8_t unitSerialNumberPageLength = SERIAL_NUM_LEN + 4;//adding 4 bytes extra for the header
+    uint8_t *unitSerialNumber = C_CAST(uint8_t*, calloc_aligned(unitSerialNumberPageLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!unitSerialNumber)
+    {
+        perror("Error allocating memory to read the unit serial number");
+        return MEMORY_FAILURE;
+    }
+    if (SUCCESS == (ret = scsi_Inquiry(device, unitSerialNumber, unitSerialNumberPageLength, UNIT_SERIAL_NUMBER, true, false)))
+    {
+        if (unitSerialNumber[1] == UNIT_SERIAL_NUMBER)//check the page code to make sure we got the right thing
+        {
+            uint16_t serialNumberLength = M_BytesTo2ByteValue(unitSerialNumber[2], unitSerialNumber[3]);
+            if (serialNumberLength > 0)
+            {
+                memcpy(&device->drive_info.serialNumber[0], &unitSerialNumber[4], M_Min(SERIAL_NUM_LEN, serialNumberLength));
+                device->drive_info.serialNumber[M_Min(SERIAL_NUM_LEN, serialNumberLength)] = '\0';
+                remove_Leading_And_Trailing_Whitespace(device->drive_info.serialNumber);
+                for (size_t iter = 0; iter < SERIAL_NUM_LEN && iter < strlen(device->drive_info.serialNumber); ++iter)
+                {
+                    if (!isprint(device->drive_info.serialNumber[iter]))
+                    {
+                        device->drive_info.serialNumber[iter] = ' ';
+                    }
+                }
+            }
+        }
+        else
+        {
+            ret = FAILURE;
+        }
+    }
+    safe_Free_aligned(unitSerialNumber)
+    return ret;
+}
+
+//SN may not be available...just going to read where it may otherwise show up in inquiry data like some vendors like to put it
+static void copy_SCSI_Serial_Number_From_Inquiry_Data(tDevice *device)
+{
+    memcpy(&device->drive_info.serialNumber[0], &device->drive_info.scsiVpdData.inquiryData[36], SERIAL_NUM_LEN);
+    device->drive_info.serialNumber[SERIAL_NUM_LEN] = '\0';
+    //make sure the SN is printable if it's coming from here since it's non-standardized
+    for (uint8_t iter = 0; iter < SERIAL_NUM_LEN; ++iter)
+    {
+        if (!is_ASCII(device->drive_info.serialNumber[iter]) || !isprint(device->drive_info.serialNumber[iter]))
+        {
+            device->drive_info.serialNumber[iter] = ' ';
+        }
+    }
+}
+
+//Reads the device identification VPD page to get the world wide name
+static int read_SCSI_Device_Identification_WWN(tDevice *device)
+{
+    int ret = FAILURE;
+    uint8_t *deviceIdentification = C_CAST(uint8_t*, calloc_aligned(INQ_RETURN_DATA_LENGTH, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!deviceIdentification)
+    {
+        perror("Error allocating memory to read device identification VPD page");
+        return MEMORY_FAILURE;
+    }
+    if (SUCCESS == (ret = scsi_Inquiry(device, deviceIdentification, INQ_RETURN_DATA_LENGTH, DEVICE_IDENTIFICATION, true, false)))
+    {
+        if (deviceIdentification[1] == DEVICE_IDENTIFICATION)//check the page number
+        {
+            //this SHOULD work for getting a WWN 90% of the time, but if it doesn't, then we will need to go through the descriptors from the device and set it from the correct one. See the SATChecker util code for how to do this
+            memcpy(&device->drive_info.worldWideName, &deviceIdentification[8], 8);
+            byte_Swap_64(&device->drive_info.worldWideName);
+        }
+        else
+        {
+            ret = FAILURE;
+        }
+    }
+    safe_Free_aligned(deviceIdentification)
+    return ret;
+}
+
+//Reads the block device characteristics VPD page to set the media type and zoned type.
+//satVPDPageRead should be set when ATA identify data already set the media type so that it is not changed here.
+//rotatingMedia is optional and is set to true when a rotation rate (HDD) is reported.
+static int read_SCSI_Block_Device_Characteristics(tDevice *device, bool satVPDPageRead, bool *rotatingMedia)
+{
+    int ret = FAILURE;
+    uint8_t *blockDeviceCharacteristics = C_CAST(uint8_t*, calloc_aligned(VPD_BLOCK_DEVICE_CHARACTERISTICS_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!blockDeviceCharacteristics)
+    {
+        perror("Error allocating memory to read block device characteistics VPD page");
+        return MEMORY_FAILURE;
+    }
+    if (SUCCESS == (ret = scsi_Inquiry(device, blockDeviceCharacteristics, VPD_BLOCK_DEVICE_CHARACTERISTICS_LEN, BLOCK_DEVICE_CHARACTERISTICS, true, false)))
+    {
+        if (blockDeviceCharacteristics[1] == BLOCK_DEVICE_CHARACTERISTICS)
+        {
+            uint16_t mediumRotationRate = M_BytesTo2ByteValue(blockDeviceCharacteristics[4], blockDeviceCharacteristics[5]);
+            uint8_t productType = blockDeviceCharacteristics[6];
+            if (device->drive_info.media_type != MEDIA_SSM_FLASH)//if this is already set, we don't want to change it because this is a helpful filter for some card-reader type devices.
+            {
+                if (mediumRotationRate == 0x0001)
+                {
+                    if (!satVPDPageRead)
+                    {
+                        device->drive_info.media_type = MEDIA_SSD;
+                    }
+                }
+                else if (mediumRotationRate >= 0x401 && mediumRotationRate <= 0xFFFE)
+                {
+                    if (!satVPDPageRead)
+                    {
+                        device->drive_info.media_type = MEDIA_HDD;
+                    }
+                    if (rotatingMedia)
+                    {
+                        *rotatingMedia = true;
+                    }
+                }
+            }
+            switch (productType)
+            {
+            case 0x01://CFAST
+            case 0x02://compact flash
+            case 0x03://Memory Stick
+            case 0x04://MultiMediaCard
+            case 0x05://SecureDigitalCard
+            case 0x06://XQD
+            case 0x07://Universal Flash Storage
+                if (!satVPDPageRead)
+                {
+                    device->drive_info.media_type = MEDIA_SSM_FLASH;
+                }
+                break;
+            default://not indicated or reserved or vendor unique so do nothing
+                break;
+            }
+            //get zoned information (as long as it isn't already set from SAT passthrough)
+            if (device->drive_info.zonedType == ZONED_TYPE_NOT_ZONED)
+            {
+                switch ((blockDeviceCharacteristics[8] & 0x30) >> 4)
+                {
+                case 0:
+                    device->drive_info.zonedType = ZONED_TYPE_NOT_ZONED;
+                    break;
+                case 1:
+                    device->drive_info.zonedType = ZONED_TYPE_HOST_AWARE;
+                    break;
+                case 2:
+                    device->drive_info.zonedType = ZONED_TYPE_DEVICE_MANAGED;
+                    break;
+                case 3:
+                    device->drive_info.zonedType = ZONED_TYPE_RESERVED;
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+        else
+        {
+            ret = FAILURE;
+        }
+    }
+    safe_Free_aligned(blockDeviceCharacteristics)
+    return ret;
+}
+
+//Issue report LUNs to figure out how many logical units are present.
+static void read_SCSI_Number_Of_Logical_Units(tDevice *device)
+{
+    if (device->drive_info.interface_type != USB_INTERFACE && device->drive_info.interface_type != IEEE_1394_INTERFACE)
+    {
+        uint8_t reportLuns[8] = { 0 };//only really need first 4 bytes, but this will make sure we get the length, hopefully without error
+        if (SUCCESS == scsi_Report_Luns(device, 0, 8, reportLuns))
+        {
+            uint32_t lunListLength = M_BytesTo4ByteValue(reportLuns[0], reportLuns[1], reportLuns[2], reportLuns[3]);
+            device->drive_info.numberOfLUs = lunListLength / 8;//each LUN is 8 bytes long
+        }
+        else
+        {
+            //some other crappy device that doesn't respond properly
+            device->drive_info.numberOfLUs = 1;
+        }
+    }
+    else
+    {
+        device->drive_info.numberOfLUs = 1;
+    }
+}
+
+//Reads the logical and physical block sizes, maxLBA, and protection information with read capacity 10 and 16.
+//protectionEnabled is optional and is set to true when the device is formatted with protection information.
+static int read_SCSI_Capacity(tDevice *device, bool *protectionEnabled)
+{
+    int ret = SUCCESS;
+    //if inquiry says SPC or lower (3), then only do read capacity 10
+    //Anything else can have read capacity 16 command available
+
+    //send a read capacity command to get the device's logical block size...read capacity 10 should be enough for this
+    uint8_t *readCapBuf = C_CAST(uint8_t*, calloc_aligned(READ_CAPACITY_10_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!readCapBuf)
+    {
+        return MEMORY_FAILURE;
+    }
+    if (SUCCESS == scsi_Read_Capacity_10(device, readCapBuf, READ_CAPACITY_10_LEN))
+    {
+        copy_Read_Capacity_Info(&device->drive_info.deviceBlockSize, &device->drive_info.devicePhyBlockSize, &device->drive_info.deviceMaxLba, &device->drive_info.sectorAlignment, readCapBuf, false);
+        if (device->drive_info.scsiVersion > 3)//SPC2 and higher can reference SBC2 and higher which introduced read capacity 16
+        {
+            //try a read capacity 16 anyways and see if the data from that was valid or not since that will give us a physical sector size whereas readcap10 data will not
+            uint8_t* temp = C_CAST(uint8_t*, realloc_aligned(readCapBuf, READ_CAPACITY_10_LEN, READ_CAPACITY_16_LEN, device->os_info.minimumAlignment));
+            if (!temp)
+            {
+                safe_Free_aligned(readCapBuf)
+                return MEMORY_FAILURE;
+            }
+            readCapBuf = temp;
+            memset(readCapBuf, 0, READ_CAPACITY_16_LEN);
+            if (SUCCESS == scsi_Read_Capacity_16(device, readCapBuf, READ_CAPACITY_16_LEN))
+            {
+                uint32_t logicalBlockSize = 0;
+                uint32_t physicalBlockSize = 0;
+                uint64_t maxLBA = 0;
+                uint16_t sectorAlignment = 0;
+                copy_Read_Capacity_Info(&logicalBlockSize, &physicalBlockSize, &maxLBA, &sectorAlignment, readCapBuf, true);
+                //some USB drives will return success and no data, so check if this local var is 0 or not...if not, we can use this data
+                if (maxLBA != 0)
+                {
+                    device->drive_info.deviceBlockSize = logicalBlockSize;
+                    device->drive_info.devicePhyBlockSize = physicalBlockSize;
+                    device->drive_info.deviceMaxLba = maxLBA;
+                    device->drive_info.sectorAlignment = sectorAlignment;
+                }
+                device->drive_info.currentProtectionType = 0;
+                device->drive_info.piExponent = M_GETBITRANGE(readCapBuf[13], 7, 4);
+                if (readCapBuf[12] & BIT0)
+                {
+                    device->drive_info.currentProtectionType = M_GETBITRANGE(readCapBuf[12], 3, 1) + 1;
+                    if (protectionEnabled)
+                    {
+                        *protectionEnabled = true;
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        //try read capacity 16, if that fails we are done trying
+        uint8_t* temp = C_CAST(uint8_t*, realloc_aligned(readCapBuf, READ_CAPACITY_10_LEN, READ_CAPACITY_16_LEN, device->os_info.minimumAlignment));
+        if (temp == NULL)
+        {
+            safe_Free_aligned(readCapBuf)
+            return MEMORY_FAILURE;
+        }
+        readCapBuf = temp;
+        memset(readCapBuf, 0, READ_CAPACITY_16_LEN);
+        if (SUCCESS == (ret = scsi_Read_Capacity_16(device, readCapBuf, READ_CAPACITY_16_LEN)))
+        {
+            copy_Read_Capacity_Info(&device->drive_info.deviceBlockSize, &device->drive_info.devicePhyBlockSize, &device->drive_info.deviceMaxLba, &device->drive_info.sectorAlignment, readCapBuf, true);
+            device->drive_info.currentProtectionType = 0;
+            device->drive_info.piExponent = M_GETBITRANGE(readCapBuf[13], 7, 4);
+            if (readCapBuf[12] & BIT0)
+            {
+                device->drive_info.currentProtectionType = M_GETBITRANGE(readCapBuf[12], 3, 1) + 1;
+                if (protectionEnabled)
+                {
+                    *protectionEnabled = true;
+                }
+            }
+        }
+    }
+    safe_Free_aligned(readCapBuf)
+    if (device->drive_info.devicePhyBlockSize == 0)
+    {
+        //If we did not get a physical blocksize, we need to set it to the blocksize (logical).
+        //This will help with old devices or those that don't support the read capacity 16 command or return other weird invalid data.
+        device->drive_info.devicePhyBlockSize = device->drive_info.deviceBlockSize;
+    }
+    return ret;
+}
+
+int fill_Lazy_SCSI_Device_Info(tDevice *device, uint32_t lazyInfo)
+{
+    int ret = SUCCESS;
+    uint8_t version = device->drive_info.scsiVersion;
+    uint8_t peripheralDeviceType = M_GETBITRANGE(device->drive_info.scsiVpdData.inquiryData[0], 4, 0);
+    bool vpdPagesAvailable = !device->drive_info.passThroughHacks.scsiHacks.noVPDPages && version >= 3;//same checks used during discovery for pages added in SPC
+    if (lazyInfo & LAZY_INFO_SERIAL_NUMBER)
+    {
+        if ((!device->drive_info.passThroughHacks.scsiHacks.noVPDPages || device->drive_info.passThroughHacks.scsiHacks.unitSNAvailable) && (version >= 2 || device->drive_info.passThroughHacks.scsiHacks.unitSNAvailable))//unit serial number added in SCSI2
+        {
+            if (MEMORY_FAILURE == read_SCSI_Unit_Serial_Number(device))
+            {
+                return MEMORY_FAILURE;
+            }
+        }
+        else
+        {
+            copy_SCSI_Serial_Number_From_Inquiry_Data(device);
+        }
+    }
+    if (lazyInfo & LAZY_INFO_WORLD_WIDE_NAME && vpdPagesAvailable)
+    {
+        if (MEMORY_FAILURE == read_SCSI_Device_Identification_WWN(device))
+        {
+            return MEMORY_FAILURE;
+        }
+    }
+    if (lazyInfo & LAZY_INFO_MEDIA_TYPE && vpdPagesAvailable && !device->drive_info.passThroughHacks.scsiHacks.unitSNAvailable
+        && (peripheralDeviceType == PERIPHERAL_DIRECT_ACCESS_BLOCK_DEVICE || peripheralDeviceType == PERIPHERAL_SIMPLIFIED_DIRECT_ACCESS_DEVICE || peripheralDeviceType == PERIPHERAL_HOST_MANAGED_ZONED_BLOCK_DEVICE))
+    {
+        //Do not let this override what was already read from the ATA identify data on SAT devices
+        if (MEMORY_FAILURE == read_SCSI_Block_Device_Characteristics(device, device->drive_info.drive_type == ATA_DRIVE, NULL))
+        {
+            return MEMORY_FAILURE;
+        }
+    }
+    if (lazyInfo & LAZY_INFO_CAPACITY && device->drive_info.media_type != MEDIA_UNKNOWN)
+    {
+        ret = read_SCSI_Capacity(device, NULL);
+        if (ret == MEMORY_FAILURE)
+        {
+            return ret;
+        }
+    }
+    if (lazyInfo & LAZY_INFO_LOGICAL_UNITS)
+    {
+        read_SCSI_Number_Of_Logical_Units(device);
+    }
+    return ret;
+}
+
 // \fn fill_In_Device_Info(device device)
 // \brief Sends a set of INQUIRY commands & fills in the device information
 // \param device device struture
@@ -8971,16 +9544,19 @@ int fill_In_Device_Info(tDevice *device)
     #endif
 
     bool mediumNotPresent = false;//assume medium is available until we find out otherwise.
-    scsiStatus turStatus;
-    memset(&turStatus, 0, sizeof(scsiStatus));
-    scsi_Test_Unit_Ready(device, &turStatus);
-    if (turStatus.senseKey != SENSE_KEY_NO_ERROR)
+    if (M_Word0(device->dFlags) != LAZY_DISCOVERY)//medium status is only used for read capacity, which is not done until needed in lazy discovery
     {
-        if (turStatus.senseKey == SENSE_KEY_NOT_READY)
+        scsiStatus turStatus;
+        memset(&turStatus, 0, sizeof(scsiStatus));
+        scsi_Test_Unit_Ready(device, &turStatus);
+        if (turStatus.senseKey != SENSE_KEY_NO_ERROR)
         {
-            if (turStatus.asc == 0x3A)//NOTE: 3A seems to be all the "medium not present" status's, so not currently checking for ascq - TJE
+            if (turStatus.senseKey == SENSE_KEY_NOT_READY)
             {
-                mediumNotPresent = true;
+                if (turStatus.asc == 0x3A)//NOTE: 3A seems to be all the "medium not present" status's, so not currently checking for ascq - TJE
+                {
+                    mediumNotPresent = true;
+                }
             }
         }
     }
@@ -9467,10 +10043,10 @@ int fill_In_Device_Info(tDevice *device)
             //      A1 SAT identify should return "Invalid field in CDB" and 85h should return "Invalid operation code". While SOME SAT device may do this too, this will reduce commanmds sent to genuine SAT devices.
         }
 
-        if (M_Word0(device->dFlags) == DO_NOT_WAKE_DRIVE)
+        if (M_Word0(device->dFlags) == DO_NOT_WAKE_DRIVE || M_Word0(device->dFlags) == LAZY_DISCOVERY)
         {
 #if defined (_DEBUG)
-            printf("Quiting device discovery early per DO_NOT_WAKE_DRIVE\n");
+            printf("Quiting device discovery early per DO_NOT_WAKE_DRIVE or LAZY_DISCOVERY\n");
 #endif
             //We actually need to try issuing an ATA/ATAPI identify to the drive to set the drive type...but I'm going to try and ONLY do it for ATA drives with the if statement below...it should catch almost all cases (which is good enough for now)
             if (checkForSAT && device->drive_info.passThroughHacks.passthroughType < NVME_PASSTHROUGH_JMICRON && (satVersionDescriptorFound || strncmp(device->drive_info.T10_vendor_ident, "ATA", 3) == 0 || device->drive_info.interface_type == USB_INTERFACE || device->drive_info.interface_type == IEEE_1394_INTERFACE || device->drive_info.interface_type == IDE_INTERFACE)
@@ -9508,6 +10084,18 @@ int fill_In_Device_Info(tDevice *device)
                     }
                 }
             }
+            if (M_Word0(device->dFlags) == LAZY_DISCOVERY && device->drive_info.drive_type != NVME_DRIVE)
+            {
+                //Everything else from SCSI discovery is read the first time it is needed by fill_Lazy_Device_Info().
+                //ATA identify data already provided the serial number, world wide name, and media type when this is an ATA drive.
+                uint32_t lazyItems = LAZY_INFO_CAPACITY | LAZY_INFO_LOGICAL_UNITS;
+                if (device->drive_info.drive_type != ATA_DRIVE)
+                {
+                    lazyItems |= LAZY_INFO_SERIAL_NUMBER | LAZY_INFO_WORLD_WIDE_NAME | LAZY_INFO_MEDIA_TYPE;
+                }
+                device->drive_info.lazyInfo.readable |= lazyItems;
+                device->drive_info.lazyInfo.pending |= lazyItems;
+            }
             safe_Free_aligned(inq_buf)
             return ret;
         }
@@ -9556,37 +10144,15 @@ int fill_In_Device_Info(tDevice *device)
             }
             else
             {
-                //SN may not be available...just going to read where it may otherwise show up in inquiry data like some vendors like to put it
-                memcpy(&device->drive_info.serialNumber[0], &inq_buf[36], SERIAL_NUM_LEN);
-                device->drive_info.serialNumber[SERIAL_NUM_LEN] = '\0';
-                //make sure the SN is printable if it's coming from here since it's non-standardized
-                for (uint8_t iter = 0; iter < SERIAL_NUM_LEN; ++iter)
-                {
-                    if (!is_ASCII(device->drive_info.serialNumber[iter]) || !isprint(device->drive_info.serialNumber[iter]))
-                    {
-                        device->drive_info.serialNumber[iter] = ' ';
-                    }
-                }
+                copy_SCSI_Serial_Number_From_Inquiry_Data(device);
             }
             if (version >= 3 && !device->drive_info.passThroughHacks.scsiHacks.noVPDPages)//device identification added in SPC
             {
-                uint8_t *deviceIdentification = C_CAST(uint8_t*, calloc_aligned(INQ_RETURN_DATA_LENGTH, sizeof(uint8_t), device->os_info.minimumAlignment));
-                if (!deviceIdentification)
+                if (MEMORY_FAILURE == read_SCSI_Device_Identification_WWN(device))
                 {
-                    perror("Error allocating memory to read device identification VPD page");
                     safe_Free_aligned(inq_buf)
                     return MEMORY_FAILURE;
                 }
-                if (SUCCESS == scsi_Inquiry(device, deviceIdentification, INQ_RETURN_DATA_LENGTH, DEVICE_IDENTIFICATION, true, false))
-                {
-                    if (deviceIdentification[1] == DEVICE_IDENTIFICATION)//check the page number
-                    {
-                        //this SHOULD work for getting a WWN 90% of the time, but if it doesn't, then we will need to go through the descriptors from the device and set it from the correct one. See the SATChecker util code for how to do this
-                        memcpy(&device->drive_info.worldWideName, &deviceIdentification[8], 8);
-                        byte_Swap_64(&device->drive_info.worldWideName);
-                    }
-                }
-                safe_Free_aligned(deviceIdentification)
             }
             //One last thing...Need to do a SAT scan...
             if (checkForSAT)
@@ -9624,25 +10190,8 @@ int fill_In_Device_Info(tDevice *device)
             return ret;
         }
 
-        if (device->drive_info.interface_type != USB_INTERFACE && device->drive_info.interface_type != IEEE_1394_INTERFACE)
-        {
-            //Issue report LUNs to figure out how many logical units are present.
-            uint8_t reportLuns[8] = { 0 };//only really need first 4 bytes, but this will make sure we get the length, hopefully without error
-            if (SUCCESS == scsi_Report_Luns(device, 0, 8, reportLuns))
-            {
-                uint32_t lunListLength = M_BytesTo4ByteValue(reportLuns[0], reportLuns[1], reportLuns[2], reportLuns[3]);
-                device->drive_info.numberOfLUs = lunListLength / 8;//each LUN is 8 bytes long
-            }
-            else
-            {
-                //some other crappy device that doesn't respond properly
-                device->drive_info.numberOfLUs = 1;
-            }
-        }
-        else
-        {
-            device->drive_info.numberOfLUs = 1;
-        }
+        read_SCSI_Number_Of_Logical_Units(device);
+        device->drive_info.lazyInfo.readable |= LAZY_INFO_LOGICAL_UNITS;
 
         bool satVPDPageRead = false;
         bool satComplianceChecked = false;
@@ -9741,57 +10290,13 @@ int fill_In_Device_Info(tDevice *device)
                 switch (supportedVPDPages[vpdIter])
                 {
                 case UNIT_SERIAL_NUMBER://Device serial number (only grab 20 characters worth since that's what we need for the device struct)
-                {
-                    uint8_t unitSerialNumberPageLength = SERIAL_NUM_LEN + 4;//adding 4 bytes extra for the header
-                    uint8_t *unitSerialNumber = C_CAST(uint8_t*, calloc_aligned(unitSerialNumberPageLength, sizeof(uint8_t), device->os_info.minimumAlignment));
-                    if (!unitSerialNumber)
-                    {
-                        perror("Error allocating memory to read the unit serial number");
-                        continue;//continue the loop
-                    }
-                    if (SUCCESS == scsi_Inquiry(device, unitSerialNumber, unitSerialNumberPageLength, supportedVPDPages[vpdIter], true, false))
-                    {
-                        if (unitSerialNumber[1] == UNIT_SERIAL_NUMBER)//check the page code to make sure we got the right thing
-                        {
-                            uint16_t serialNumberLength = M_BytesTo2ByteValue(unitSerialNumber[2], unitSerialNumber[3]);
-                            if (serialNumberLength > 0)
-                            {
-                                memcpy(&device->drive_info.serialNumber[0], &unitSerialNumber[4], M_Min(SERIAL_NUM_LEN, serialNumberLength));
-                                device->drive_info.serialNumber[M_Min(SERIAL_NUM_LEN, serialNumberLength)] = '\0';
-                                remove_Leading_And_Trailing_Whitespace(device->drive_info.serialNumber);
-                                for (size_t iter = 0; iter < SERIAL_NUM_LEN && iter < strlen(device->drive_info.serialNumber); ++iter)
-                                {
-                                    if (!isprint(device->drive_info.serialNumber[iter]))
-                                    {
-                                        device->drive_info.serialNumber[iter] = ' ';
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    safe_Free_aligned(unitSerialNumber)
+                    read_SCSI_Unit_Serial_Number(device);
+                    device->drive_info.lazyInfo.readable |= LAZY_INFO_SERIAL_NUMBER;
                     break;
-                }
                 case DEVICE_IDENTIFICATION://World wide name
-                {
-                    uint8_t *deviceIdentification = C_CAST(uint8_t*, calloc_aligned(INQ_RETURN_DATA_LENGTH, sizeof(uint8_t), device->os_info.minimumAlignment));
-                    if (!deviceIdentification)
-                    {
-                        perror("Error allocating memory to read device identification VPD page");
-                        continue;
-                    }
-                    if (SUCCESS == scsi_Inquiry(device, deviceIdentification, INQ_RETURN_DATA_LENGTH, DEVICE_IDENTIFICATION, true, false))
-                    {
-                        if (deviceIdentification[1] == DEVICE_IDENTIFICATION)
-                        {
-                            //this SHOULD work for getting a WWN 90% of the time, but if it doesn't, then we will need to go through the descriptors from the device and set it from the correct one. See the SATChecker util code for how to do this
-                            memcpy(&device->drive_info.worldWideName, &deviceIdentification[8], 8);
-                            byte_Swap_64(&device->drive_info.worldWideName);
-                        }
-                    }
-                    safe_Free_aligned(deviceIdentification)
+                    read_SCSI_Device_Identification_WWN(device);
+                    device->drive_info.lazyInfo.readable |= LAZY_INFO_WORLD_WIDE_NAME;
                     break;
-                }
                 case ATA_INFORMATION: //use this to determine if it's SAT compliant
                 {
                     if(device->drive_info.passThroughHacks.passthroughType < NVME_PASSTHROUGH_JMICRON)
@@ -9842,81 +10347,14 @@ int fill_In_Device_Info(tDevice *device)
                 }
                 case BLOCK_DEVICE_CHARACTERISTICS: //use this to determine if it's SSD or HDD and whether it's a HDD or not
                 {
-                    uint8_t *blockDeviceCharacteristics = C_CAST(uint8_t*, calloc_aligned(VPD_BLOCK_DEVICE_CHARACTERISTICS_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
-                    if (!blockDeviceCharacteristics)
-                    {
-                        perror("Error allocating memory to read block device characteistics VPD page");
-                        continue;
-                    }
-                    if (SUCCESS == scsi_Inquiry(device, blockDeviceCharacteristics, VPD_BLOCK_DEVICE_CHARACTERISTICS_LEN, BLOCK_DEVICE_CHARACTERISTICS, true, false))
+                    bool rotatingMedia = false;
+                    read_SCSI_Block_Device_Characteristics(device, satVPDPageRead, &rotatingMedia);
+                    device->drive_info.lazyInfo.readable |= LAZY_INFO_MEDIA_TYPE;
+                    if (rotatingMedia && checkJMicronNVMe)
                     {
-                        if (blockDeviceCharacteristics[1] == BLOCK_DEVICE_CHARACTERISTICS)
-                        {
-                            uint16_t mediumRotationRate = M_BytesTo2ByteValue(blockDeviceCharacteristics[4], blockDeviceCharacteristics[5]);
-                            uint8_t productType = blockDeviceCharacteristics[6];
-                            if (device->drive_info.media_type != MEDIA_SSM_FLASH)//if this is already set, we don't want to change it because this is a helpful filter for some card-reader type devices.
-                            {
-                                if (mediumRotationRate == 0x0001)
-                                {
-                                    if (!satVPDPageRead)
-                                    {
-                                        device->drive_info.media_type = MEDIA_SSD;
-                                    }
-                                }
-                                else if (mediumRotationRate >= 0x401 && mediumRotationRate <= 0xFFFE)
-                                {
-                                    if (!satVPDPageRead)
-                                    {
-                                        device->drive_info.media_type = MEDIA_HDD;
-                                    }
-                                    if (checkJMicronNVMe)
-                                    {
-                                        //The logic here is that there are no NVMe HDDs that will use this bridge, so do not do a SAT check, and instead check only for JMicron NVMe adapter - TJE
-                                        checkForSAT = false;
-                                    }
-                                }
-                            }
-                            switch (productType)
-                            {
-                            case 0x01://CFAST
-                            case 0x02://compact flash
-                            case 0x03://Memory Stick
-                            case 0x04://MultiMediaCard
-                            case 0x05://SecureDigitalCard
-                            case 0x06://XQD
-                            case 0x07://Universal Flash Storage
-                                if (!satVPDPageRead)
-                                {
-                                    device->drive_info.media_type = MEDIA_SSM_FLASH;
-                                }
-                                break;
-                            default://not indicated or reserved or vendor unique so do nothing
-                                break;
-                            }
-                            //get zoned information (as long as it isn't already set from SAT passthrough)
-                            if (device->drive_info.zonedType == ZONED_TYPE_NOT_ZONED)
-                            {
-                                switch ((blockDeviceCharacteristics[8] & 0x30) >> 4)
-                                {
-                                case 0:
-                                    device->drive_info.zonedType = ZONED_TYPE_NOT_ZONED;
-                                    break;
-                                case 1:
-                                    device->drive_info.zonedType = ZONED_TYPE_HOST_AWARE;
-                                    break;
-                                case 2:
-                                    device->drive_info.zonedType = ZONED_TYPE_DEVICE_MANAGED;
-                                    break;
-                                case 3:
-                                    device->drive_info.zonedType = ZONED_TYPE_RESERVED;
-                                    break;
-                                default:
-                                    break;
-                                }
-                            }
-                        }
+                        //The logic here is that there are no NVMe HDDs that will use this bridge, so do not do a SAT check, and instead check only for JMicron NVMe adapter - TJE
+                        checkForSAT = false;
                     }
-                    safe_Free_aligned(blockDeviceCharacteristics)
                     break;
                 }
                 default:
@@ -9928,101 +10366,21 @@ int fill_In_Device_Info(tDevice *device)
         }
         else
         {
-            //SN may not be available...just going to read where it may otherwise show up in inquiry data like some vendors like to put it
-            memcpy(&device->drive_info.serialNumber[0], &inq_buf[36], SERIAL_NUM_LEN);
-            device->drive_info.serialNumber[SERIAL_NUM_LEN] = '\0';
-            //make sure the SN is printable if it's coming from here since it's non-standardized
-            for (uint8_t iter = 0; iter < SERIAL_NUM_LEN; ++iter)
-            {
-                if (!is_ASCII(device->drive_info.serialNumber[iter]) || !isprint(device->drive_info.serialNumber[iter]))
-                {
-                    device->drive_info.serialNumber[iter] = ' ';
-                }
-            }
+            copy_SCSI_Serial_Number_From_Inquiry_Data(device);
         }
 
         if (readCapacity && !mediumNotPresent)
         {
-            //if inquiry says SPC or lower (3), then only do read capacity 10
-            //Anything else can have read capacity 16 command available
-
-            //send a read capacity command to get the device's logical block size...read capacity 10 should be enough for this
-            uint8_t *readCapBuf = C_CAST(uint8_t*, calloc_aligned(READ_CAPACITY_10_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
-            if (!readCapBuf)
+            bool protectionEnabled = false;
+            if (MEMORY_FAILURE == read_SCSI_Capacity(device, &protectionEnabled))
             {
                 safe_Free_aligned(inq_buf)
                 return MEMORY_FAILURE;
             }
-            if (SUCCESS == scsi_Read_Capacity_10(device, readCapBuf, READ_CAPACITY_10_LEN))
+            device->drive_info.lazyInfo.readable |= LAZY_INFO_CAPACITY;
+            if (protectionEnabled)
             {
-                copy_Read_Capacity_Info(&device->drive_info.deviceBlockSize, &device->drive_info.devicePhyBlockSize, &device->drive_info.deviceMaxLba, &device->drive_info.sectorAlignment, readCapBuf, false);
-                if (version > 3)//SPC2 and higher can reference SBC2 and higher which introduced read capacity 16
-                {
-                    //try a read capacity 16 anyways and see if the data from that was valid or not since that will give us a physical sector size whereas readcap10 data will not
-                    uint8_t* temp = C_CAST(uint8_t*, realloc_aligned(readCapBuf, READ_CAPACITY_10_LEN, READ_CAPACITY_16_LEN, device->os_info.minimumAlignment));
-                    if (!temp)
-                    {
-                        safe_Free_aligned(readCapBuf)
-                        safe_Free_aligned(inq_buf)
-                        return MEMORY_FAILURE;
-                    }
-                    readCapBuf = temp;
-                    memset(readCapBuf, 0, READ_CAPACITY_16_LEN);
-                    if (SUCCESS == scsi_Read_Capacity_16(device, readCapBuf, READ_CAPACITY_16_LEN))
-                    {
-                        uint32_t logicalBlockSize = 0;
-                        uint32_t physicalBlockSize = 0;
-                        uint64_t maxLBA = 0;
-                        uint16_t sectorAlignment = 0;
-                        copy_Read_Capacity_Info(&logicalBlockSize, &physicalBlockSize, &maxLBA, &sectorAlignment, readCapBuf, true);
-                        //some USB drives will return success and no data, so check if this local var is 0 or not...if not, we can use this data
-                        if (maxLBA != 0)
-                        {
-                            device->drive_info.deviceBlockSize = logicalBlockSize;
-                            device->drive_info.devicePhyBlockSize = physicalBlockSize;
-                            device->drive_info.deviceMaxLba = maxLBA;
-                            device->drive_info.sectorAlignment = sectorAlignment;
-                        }
-                        device->drive_info.currentProtectionType = 0;
-                        device->drive_info.piExponent = M_GETBITRANGE(readCapBuf[13], 7, 4);
-                        if (readCapBuf[12] & BIT0)
-                        {
-                            device->drive_info.currentProtectionType = M_GETBITRANGE(readCapBuf[12], 3, 1) + 1;
-                            checkForSAT = false;
-                        }
-                    }
-                }
-            }
-            else
-            {
-                //try read capacity 16, if that fails we are done trying
-                uint8_t* temp = C_CAST(uint8_t*, realloc_aligned(readCapBuf, READ_CAPACITY_10_LEN, READ_CAPACITY_16_LEN, device->os_info.minimumAlignment));
-                if (temp == NULL)
-                {
-                    safe_Free_aligned(readCapBuf)
-                    safe_Free_aligned(inq_buf)
-                    return MEMORY_FAILURE;
-                }
-                readCapBuf = temp;
-                memset(readCapBuf, 0, READ_CAPACITY_16_LEN);
-                if (SUCCESS == scsi_Read_Capacity_16(device, readCapBuf, READ_CAPACITY_16_LEN))
-                {
-                    copy_Read_Capacity_Info(&device->drive_info.deviceBlockSize, &device->drive_info.devicePhyBlockSize, &device->drive_info.deviceMaxLba, &device->drive_info.sectorAlignment, readCapBuf, true);
-                    device->drive_info.currentProtectionType = 0;
-                    device->drive_info.piExponent = M_GETBITRANGE(readCapBuf[13], 7, 4);
-                    if (readCapBuf[12] & BIT0)
-                    {
-                        device->drive_info.currentProtectionType = M_GETBITRANGE(readCapBuf[12], 3, 1) + 1;
-                        checkForSAT = false;
-                    }
-                }
-            }
-            safe_Free_aligned(readCapBuf)
-            if (device->drive_info.devicePhyBlockSize == 0)
-            {
-                //If we did not get a physical blocksize, we need to set it to the blocksize (logical).
-                //This will help with old devices or those that don't support the read capacity 16 command or return other weird invalid data.
-                device->drive_info.devicePhyBlockSize = device->drive_info.deviceBlockSize;
+                checkForSAT = false;
             }
         }
 
@@ -1092,6 +1092,178 @@ int os_Controller_Reset(tDevice *device)
     return sg_reset(device->os_info.fd, SG_SCSI_RESET_HOST);
 }
 
+static int get_SG_Path_Handle(tDevice *device, uint8_t path)
+{
+    if (path == 0)
+    {
+        return device->os_info.fd;
+    }
+    return device->os_info.multipath.extraPaths[path - 1];
+}
+
+static bool is_Load_Balanced_Operation(uint8_t operationCode)
+{
+    switch (operationCode)
+    {
+    case READ6:
+    case READ10:
+    case READ12:
+    case READ16:
+    case WRITE6:
+    case WRITE10:
+    case WRITE12:
+    case WRITE16:
+    case VERIFY10:
+    case VERIFY12:
+    case VERIFY16:
+        return true;
+    default:
+        return false;
+    }
+}
+
+//Picks the path to issue a command on. Returns UINT8_MAX when every path has failed.
+static uint8_t get_SG_Path_For_Command(tDevice *device, uint8_t operationCode)
+{
+    uint8_t pathCount = device->os_info.multipath.extraPathCount + 1;
+    if (is_Load_Balanced_Operation(operationCode))
+    {
+        for (uint8_t attempt = 0; attempt < pathCount; ++attempt)
+        {
+            uint8_t path = device->os_info.multipath.nextPath % pathCount;
+            device->os_info.multipath.nextPath = C_CAST(uint8_t, (path + 1) % pathCount);
+            if ((device->os_info.multipath.failedPaths & (1 << path)) == 0)
+            {
+                return path;
+            }
+        }
+    }
+    else
+    {
+        for (uint8_t path = 0; path < pathCount; ++path)
+        {
+            if ((device->os_info.multipath.failedPaths & (1 << path)) == 0)
+            {
+                return path;
+            }
+        }
+    }
+    return UINT8_MAX;
+}
+
+//Only failures where the command never reached the device are retried on another path. A timeout is not, since the command may still be running.
+static bool is_SG_Path_Failure(int ioctlResult, int error, sg_io_hdr_t *io_hdr)
+{
+    if (ioctlResult < 0)
+    {
+        return error == ENODEV || error == ENXIO;
+    }
+    switch (io_hdr->host_status)
+    {
+    case OPENSEA_SG_ERR_DID_NO_CONNECT:
+    case OPENSEA_SG_ERR_DID_BAD_TARGET:
+    case OPENSEA_SG_ERR_DID_TRANSPORT_DISRUPTED:
+    case OPENSEA_SG_ERR_DID_TRANSPORT_FAILFAST:
+        return true;
+    default:
+        return false;
+    }
+}
+
+//Compares what discovery found on both handles. Only the world wide name or serial number is checked since a translator may report different vendor and model strings on each port.
+static bool is_Same_Logical_Unit(tDevice *device, tDevice *otherPath)
+{
+    uint64_t worldWideName = get_Device_World_Wide_Name(device);
+    uint64_t otherWorldWideName = get_Device_World_Wide_Name(otherPath);
+    if (worldWideName != 0 || otherWorldWideName != 0)
+    {
+        return worldWideName == otherWorldWideName;
+    }
+    return strlen(get_Device_Serial_Number(device)) > 0 && strcmp(get_Device_Serial_Number(device), get_Device_Serial_Number(otherPath)) == 0;
+}
+
+//A handle is already one of the device's paths when it is the same device node, or when it reaches the logical unit through the same host, channel, and target
+static bool is_Existing_Device_Path(tDevice *device, int handle)
+{
+    struct stat handleStat;
+    struct sg_scsi_id handleAddress;
+    bool handleAddressValid = false;
+    memset(&handleStat, 0, sizeof(struct stat));
+    memset(&handleAddress, 0, sizeof(struct sg_scsi_id));
+    if (fstat(handle, &handleStat) != 0)
+    {
+        return false;
+    }
+    handleAddressValid = ioctl(handle, SG_GET_SCSI_ID, &handleAddress) == 0;
+    for (uint8_t pathIter = 0; pathIter <= device->os_info.multipath.extraPathCount; ++pathIter)
+    {
+        struct stat pathStat;
+        struct sg_scsi_id pathAddress;
+        int pathHandle = get_SG_Path_Handle(device, pathIter);
+        memset(&pathStat, 0, sizeof(struct stat));
+        memset(&pathAddress, 0, sizeof(struct sg_scsi_id));
+        if (fstat(pathHandle, &pathStat) == 0 && (S_ISCHR(handleStat.st_mode) || S_ISBLK(handleStat.st_mode))
+            && (pathStat.st_mode & S_IFMT) == (handleStat.st_mode & S_IFMT) && pathStat.st_rdev == handleStat.st_rdev)
+        {
+            return true;
+        }
+        if (handleAddressValid && ioctl(pathHandle, SG_GET_SCSI_ID, &pathAddress) == 0
+            && pathAddress.host_no == handleAddress.host_no && pathAddress.channel == handleAddress.channel
+            && pathAddress.scsi_id == handleAddress.scsi_id && pathAddress.lun == handleAddress.lun)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+int sg_Add_Device_Path(tDevice *device, const char *filename)
+{
+    int ret = SUCCESS;
+    tDevice *otherPath = NULL;
+    if (!device || !filename)
+    {
+        return BAD_PARAMETER;
+    }
+    if (device->os_info.multipath.extraPathCount >= OS_MAX_EXTRA_PATHS)
+    {
+        return FAILURE;
+    }
+    otherPath = C_CAST(tDevice*, calloc(1, sizeof(tDevice)));
+    if (!otherPath)
+    {
+        return MEMORY_FAILURE;
+    }
+    otherPath->sanity.size = sizeof(tDevice);
+    otherPath->sanity.version = DEVICE_BLOCK_VERSION;
+    otherPath->dFlags = device->dFlags;
+    otherPath->deviceVerbosity = device->deviceVerbosity;
+    ret = get_Device(filename, otherPath);
+    if (ret == SUCCESS)
+    {
+        if (!is_Same_Logical_Unit(device, otherPath) || is_Existing_Device_Path(device, otherPath->os_info.fd))
+        {
+            ret = BAD_PARAMETER;
+        }
+        else
+        {
+            int pathHandle = dup(otherPath->os_info.fd);
+            if (pathHandle < 0)
+            {
+                ret = FAILURE;
+            }
+            else
+            {
+                device->os_info.multipath.extraPaths[device->os_info.multipath.extraPathCount] = pathHandle;
+                device->os_info.multipath.extraPathCount += 1;
+            }
+        }
+        close_Device(otherPath);
+    }
+    safe_Free(otherPath)
+    return ret;
+}
+
 int send_IO( ScsiIoCtx *scsiIoCtx )
 {
     int ret = FAILURE;    
@@ -1144,6 +1316,7 @@ int send_sg_io( ScsiIoCtx *scsiIoCtx )
     uint8_t     *localSenseBuffer = NULL;
     int         ret          = SUCCESS;
     seatimer_t  commandTimer;
+    uint8_t     path = 0;
 #ifdef _DEBUG
     printf("-->%s \n",__FUNCTION__);
 #endif
@@ -1170,7 +1343,7 @@ int send_sg_io( ScsiIoCtx *scsiIoCtx )
     }
     else
     {
-        localSenseBuffer = C_CAST(uint8_t *, calloc_aligned(SPC3_SENSE_LEN, sizeof(uint8_t), scsiIoCtx->device->os_info.minimumAlignment));
+        localSenseBuffer = borrow_Command_Buffer(scsiIoCtx->device, SPC3_SENSE_LEN);
         if (!localSenseBuffer)
         {
             return MEMORY_FAILURE;
@@ -1204,7 +1377,7 @@ int send_sg_io( ScsiIoCtx *scsiIoCtx )
         {
             printf("%s Didn't understand direction\n", __FUNCTION__);
         }
-        safe_Free_aligned(localSenseBuffer)
+        return_Command_Buffer(scsiIoCtx->device, &localSenseBuffer);
         return BAD_PARAMETER;
     }
 
@@ -1252,10 +1425,34 @@ int send_sg_io( ScsiIoCtx *scsiIoCtx )
     scsiIoCtx->returnStatus.ascq = 0;
     //print_io_hdr(&io_hdr);
     //printf("scsiIoCtx->device->os_info.fd = %d\n", scsiIoCtx->device->os_info.fd);
+    path = get_SG_Path_For_Command(scsiIoCtx->device, scsiIoCtx->cdb[OPERATION_CODE]);
+    if (path == UINT8_MAX)
+    {
+        //every path has failed. Start over from the first one in case a link has come back.
+        scsiIoCtx->device->os_info.multipath.failedPaths = 0;
+        path = 0;
+    }
     start_Timer(&commandTimer);
-    ret = ioctl(scsiIoCtx->device->os_info.fd, SG_IO, &io_hdr);
+    ret = ioctl(get_SG_Path_Handle(scsiIoCtx->device, path), SG_IO, &io_hdr);
     stop_Timer(&commandTimer);
     scsiIoCtx->device->os_info.last_error = errno;
+    while (scsiIoCtx->device->os_info.multipath.extraPathCount > 0 && is_SG_Path_Failure(ret, scsiIoCtx->device->os_info.last_error, &io_hdr))
+    {
+        scsiIoCtx->device->os_info.multipath.failedPaths |= C_CAST(uint8_t, 1 << path);
+        path = get_SG_Path_For_Command(scsiIoCtx->device, scsiIoCtx->cdb[OPERATION_CODE]);
+        if (path == UINT8_MAX)
+        {
+            break;
+        }
+        if (VERBOSITY_COMMAND_VERBOSE <= scsiIoCtx->device->deviceVerbosity)
+        {
+            printf("Transport failure. Retrying on path %" PRIu8 "\n", path);
+        }
+        start_Timer(&commandTimer);
+        ret = ioctl(get_SG_Path_Handle(scsiIoCtx->device, path), SG_IO, &io_hdr);
+        stop_Timer(&commandTimer);
+        scsiIoCtx->device->os_info.last_error = errno;
+    }
     if (ret < 0)
     {
         ret = OS_PASSTHROUGH_FAILURE;
@@ -1494,7 +1691,7 @@ int send_sg_io( ScsiIoCtx *scsiIoCtx )
 #ifdef _DEBUG
     printf("<--%s (%d)\n",__FUNCTION__, ret);
 #endif
-    safe_Free_aligned(localSenseBuffer)
+    return_Command_Buffer(scsiIoCtx->device, &localSenseBuffer);
     return ret;
 }
 
@@ -1525,6 +1722,51 @@ static int nvme_filter( const struct dirent *entry)
 }
 #endif
 
+//Gets the interface of a handle in /dev from the same sysfs link that set_Device_Fields_From_Handle() reads, without opening it.
+//Used to skip handles that cannot pass the scan filters passed in with GET_DEVICE_FUNCS_SCAN_FILTER().
+static eInterfaceType get_Interface_From_Handle_Name(const char *handleName)
+{
+    eInterfaceType interfaceType = UNKNOWN_INTERFACE;
+    char classPath[PATH_MAX] = { 0 };
+    char handleLink[PATH_MAX] = { 0 };
+    if (strncmp(handleName, "nvme", 4) == 0)
+    {
+        return NVME_INTERFACE;
+    }
+    else if (strncmp(handleName, "sg", 2) == 0)
+    {
+        snprintf(classPath, PATH_MAX, "/sys/class/scsi_generic/%s", handleName);
+    }
+    else if (strncmp(handleName, "sd", 2) == 0)
+    {
+        snprintf(classPath, PATH_MAX, "/sys/class/block/%s", handleName);
+    }
+    else
+    {
+        return UNKNOWN_INTERFACE;
+    }
+    if (readlink(classPath, handleLink, PATH_MAX - 1) > 0)
+    {
+        if (strstr(handleLink, "ata") != 0)
+        {
+            interfaceType = IDE_INTERFACE;
+        }
+        else if (strstr(handleLink, "usb") != 0)
+        {
+            interfaceType = USB_INTERFACE;
+        }
+        else if (strstr(handleLink, "fw") != 0)
+        {
+            interfaceType = IEEE_1394_INTERFACE;
+        }
+        else
+        {
+            interfaceType = SCSI_INTERFACE;
+        }
+    }
+    return interfaceType;
+}
+
 //-----------------------------------------------------------------------------
 //
 //  get_Device_Count()
@@ -1536,7 +1778,7 @@ static int nvme_filter( const struct dirent *entry)
 //  Entry:
 //!   \param[out] numberOfDevices = integer to hold the number of devices found. 
 //!   \param[in] flags = eScanFlags based mask to let application control. 
-//!                      NOTE: currently flags param is not being used.  
+//!                      Scan filters passed with GET_DEVICE_FUNCS_SCAN_FILTER() leave out handles that cannot match.
 //!
 //  Exit:
 //!   \return SUCCESS - pass, !SUCCESS fail or something went wrong
@@ -1544,7 +1786,7 @@ static int nvme_filter( const struct dirent *entry)
 //-----------------------------------------------------------------------------
 int get_Device_Count(uint32_t * numberOfDevices, uint64_t flags)
 {
-    int  num_devs = 0, num_nvme_devs = 0;
+    int  num_devs = 0, num_nvme_devs = 0, filteredDevs = 0;
 
     struct dirent **namelist;
     #if !defined(DISABLE_NVME_PASSTHROUGH)
@@ -1564,6 +1806,10 @@ int get_Device_Count(uint32_t * numberOfDevices, uint64_t flags)
     //free the list of names to not leak memory
     for(int iter = 0; iter < num_devs; ++iter)
     {
+        if (!scan_Filter_Could_Match(get_Interface_From_Handle_Name(namelist[iter]->d_name), flags))
+        {
+            ++filteredDevs;
+        }
     	safe_Free(namelist[iter])
     }
     safe_Free(namelist)
@@ -1573,14 +1819,17 @@ int get_Device_Count(uint32_t * numberOfDevices, uint64_t flags)
     //free the nvmenamelist to not leak memory
     for(int iter = 0; iter < num_nvme_devs; ++iter)
     {
+        if (!scan_Filter_Could_Match(NVME_INTERFACE, flags))
+        {
+            ++filteredDevs;
+        }
     	safe_Free(nvmenamelist[iter])
     }
     safe_Free(nvmenamelist)
     #endif
 
-    *numberOfDevices = num_devs + num_nvme_devs;
+    *numberOfDevices = num_devs + num_nvme_devs - filteredDevs;
 
-    M_USE_UNUSED(flags);    
     return SUCCESS;
 }
 
@@ -1602,7 +1851,7 @@ int get_Device_Count(uint32_t * numberOfDevices, uint64_t flags)
 //!   \param[in]  versionBlock = versionBlock structure filled in by application for 
 //!                              sanity check by library. 
 //!   \param[in] flags = eScanFlags based mask to let application control. 
-//!                      NOTE: currently flags param is not being used.  
+//!                      Scan filters passed with GET_DEVICE_FUNCS_SCAN_FILTER() skip handles that cannot match without opening them.
 //!
 //  Exit:
 //!   \return SUCCESS - pass, !SUCCESS fail or something went wrong
@@ -1612,7 +1861,7 @@ int get_Device_List(tDevice * const ptrToDeviceList, uint32_t sizeInBytes, versi
 {
     int returnValue = SUCCESS;
     int numberOfDevices = 0;
-    int driveNumber = 0, found = 0, failedGetDeviceCount = 0, permissionDeniedCount = 0;
+    int driveNumber = 0, found = 0, failedGetDeviceCount = 0, permissionDeniedCount = 0, filteredCount = 0;
     char name[80] = { 0 }; //Because get device needs char
     int fd;
     tDevice * d = NULL;
@@ -1697,6 +1946,13 @@ int get_Device_List(tDevice * const ptrToDeviceList, uint32_t sizeInBytes, versi
             {
                 continue;
             }
+            if (!scan_Filter_Could_Match(get_Interface_From_Handle_Name(basename(devs[driveNumber])), flags))
+            {
+                //will not show up in the scan anyways, so don't spend time opening it and sending discovery commands
+                safe_Free(devs[driveNumber])
+                ++filteredCount;
+                continue;
+            }
             memset(name, 0, sizeof(name));//clear name before reusing it
             snprintf(name, sizeof(name), "%s", devs[driveNumber]);
             fd = -1;
@@ -1744,11 +2000,16 @@ int get_Device_List(tDevice * const ptrToDeviceList, uint32_t sizeInBytes, versi
         stop_Timer(&getDeviceListTimer);
         printf("Time to get all device = %fms\n", get_Milli_Seconds(getDeviceListTimer));
 #endif
-	    if (found == failedGetDeviceCount)
+	    if (found == 0 && failedGetDeviceCount == 0 && filteredCount > 0)
+	    {
+	        //everything was filtered out, which is not an error
+	        returnValue = SUCCESS;
+	    }
+	    else if (found == failedGetDeviceCount)
 	    {
 	        returnValue = FAILURE;
 	    }
-        else if(permissionDeniedCount == (num_sg_devs + num_sd_devs + num_nvme_devs))
+        else if(permissionDeniedCount == (num_sg_devs + num_sd_devs + num_nvme_devs - filteredCount))
         {
             returnValue = PERMISSION_DENIED;
         }
@@ -1779,6 +2040,13 @@ int close_Device(tDevice *dev)
     int retValue = 0;
     if (dev)
     {
+        free_Translation_Scratch(dev);
+        for (uint8_t pathIter = 0; pathIter < dev->os_info.multipath.extraPathCount; ++pathIter)
+        {
+            close(dev->os_info.multipath.extraPaths[pathIter]);
+        }
+        dev->os_info.multipath.extraPathCount = 0;
+        dev->os_info.multipath.failedPaths = 0;
         retValue = close(dev->os_info.fd);
         dev->os_info.last_error = errno;
         if ( retValue == 0)
@@ -1902,6 +2170,55 @@ int send_NVMe_IO(nvmeCmdCtx *nvmeIoCtx )
                 nvmeIoCtx->commandCompletionData.statusAndCID = ioctlResult << 17;//shift into place since we don't get the phase tag or command ID bits and these are the status field
             }
             break;
+#if defined (NVME_IOCTL_IO64_CMD)
+        case NVME_CMD_ZONE_APPEND:
+        {
+            //The assigned LBA is returned in both DW0 and DW1 of the completion, and only the 64bit passthrough returns DW1.
+            struct nvme_passthru_cmd64 passThroughCmd64;
+            memset(&passThroughCmd64, 0, sizeof(struct nvme_passthru_cmd64));
+            passThroughCmd64.opcode = nvmeIoCtx->cmd.nvmCmd.opcode;
+            passThroughCmd64.flags = nvmeIoCtx->cmd.nvmCmd.flags;
+            passThroughCmd64.nsid = nvmeIoCtx->cmd.nvmCmd.nsid;
+            passThroughCmd64.cdw2 = nvmeIoCtx->cmd.nvmCmd.cdw2;
+            passThroughCmd64.cdw3 = nvmeIoCtx->cmd.nvmCmd.cdw3;
+            passThroughCmd64.metadata = C_CAST(uint64_t, C_CAST(uintptr_t, nvmeIoCtx->cmd.nvmCmd.metadata));
+            passThroughCmd64.addr = C_CAST(uint64_t, C_CAST(uintptr_t, nvmeIoCtx->ptrData));
+            passThroughCmd64.data_len = nvmeIoCtx->dataSize;
+            passThroughCmd64.cdw10 = nvmeIoCtx->cmd.nvmCmd.cdw10;
+            passThroughCmd64.cdw11 = nvmeIoCtx->cmd.nvmCmd.cdw11;
+            passThroughCmd64.cdw12 = nvmeIoCtx->cmd.nvmCmd.cdw12;
+            passThroughCmd64.cdw13 = nvmeIoCtx->cmd.nvmCmd.cdw13;
+            passThroughCmd64.cdw14 = nvmeIoCtx->cmd.nvmCmd.cdw14;
+            passThroughCmd64.cdw15 = nvmeIoCtx->cmd.nvmCmd.cdw15;
+            passThroughCmd64.timeout_ms = nvmeIoCtx->timeout ? nvmeIoCtx->timeout * 1000 : 15000;
+            start_Timer(&commandTimer);
+            ioctlResult = ioctl(nvmeIoCtx->device->os_info.fd, NVME_IOCTL_IO64_CMD, &passThroughCmd64);
+            stop_Timer(&commandTimer);
+            nvmeIoCtx->device->os_info.last_error = errno;
+            if (ioctlResult < 0)
+            {
+                ret = OS_PASSTHROUGH_FAILURE;
+                if (VERBOSITY_COMMAND_VERBOSE <= nvmeIoCtx->device->deviceVerbosity)
+                {
+                    if (nvmeIoCtx->device->os_info.last_error != 0)
+                    {
+                        printf("Error: ");
+                        print_Errno_To_Screen(nvmeIoCtx->device->os_info.last_error);
+                    }
+                }
+            }
+            else
+            {
+                nvmeIoCtx->commandCompletionData.dw0 = M_DoubleWord0(passThroughCmd64.result);
+                nvmeIoCtx->commandCompletionData.dw1 = M_DoubleWord1(passThroughCmd64.result);
+                nvmeIoCtx->commandCompletionData.dw0Valid = true;
+                nvmeIoCtx->commandCompletionData.dw1Valid = true;
+                nvmeIoCtx->commandCompletionData.dw3Valid = true;
+                nvmeIoCtx->commandCompletionData.statusAndCID = ioctlResult << 17;//shift into place since we don't get the phase tag or command ID bits and these are the status field
+            }
+        }
+            break;
+#endif
         default:
             //use the generic passthrough command structure and IO_CMD
             memset(passThroughCmd, 0,sizeof(struct nvme_passthru_cmd));
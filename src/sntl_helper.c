@@ -910,7 +910,7 @@ static int sntl_Translate_Device_Identification_VPD_Page_83h(tDevice *device, Sc
     if (eui64nonZero)//this must be non-zero to be supported.
     {
         naaDesignatorLength = 20 /*ext*/ + 12 /*locally assigned*/;
-        naaDesignator = C_CAST(uint8_t*, calloc(naaDesignatorLength, sizeof(uint8_t)));
+        naaDesignator = borrow_Translation_Buffer(device, naaDesignatorLength);
         if (naaDesignator)
         {
             //NAA extended format (6 + OUI + 64bitsEUI64 + 32bits of zeros)
@@ -952,7 +952,7 @@ static int sntl_Translate_Device_Identification_VPD_Page_83h(tDevice *device, Sc
     else if (!eui64nonZero && !nguidnonZero) //NVMe 1.0 devices won't support EUI or NGUID, so we should be able to detect them like this
     {
         naaDesignatorLength = 20 /*ext*/ + 12 /*locally assigned*/;
-        naaDesignator = C_CAST(uint8_t*, calloc(naaDesignatorLength, sizeof(uint8_t)));
+        naaDesignator = borrow_Translation_Buffer(device, naaDesignatorLength);
         if (naaDesignator)
         {
             //NAA extended format (6 + OUI + 64bitsEUI64 + 32bits of zeros)
@@ -1009,7 +1009,7 @@ static int sntl_Translate_Device_Identification_VPD_Page_83h(tDevice *device, Sc
         {
             t10VendorIdDesignatorLength += 16;//16 characters to hold the EUI64 as a string
         }
-        t10VendorIdDesignator = C_CAST(uint8_t*, calloc(t10VendorIdDesignatorLength, sizeof(uint8_t)));
+        t10VendorIdDesignator = borrow_Translation_Buffer(device, t10VendorIdDesignatorLength);
         if (t10VendorIdDesignator)
         {
             t10VendorIdDesignator[0] = 2;//codes set 2
@@ -1059,7 +1059,7 @@ static int sntl_Translate_Device_Identification_VPD_Page_83h(tDevice *device, Sc
     {
         uint8_t offset = 12;
         t10VendorIdDesignatorLength = 47;
-        t10VendorIdDesignator = C_CAST(uint8_t*, calloc(t10VendorIdDesignatorLength, sizeof(uint8_t)));
+        t10VendorIdDesignator = borrow_Translation_Buffer(device, t10VendorIdDesignatorLength);
         if (t10VendorIdDesignator)
         {
             t10VendorIdDesignator[0] = 2;//codes set 2 (ASCII)
@@ -1116,7 +1116,7 @@ static int sntl_Translate_Device_Identification_VPD_Page_83h(tDevice *device, Sc
         uint8_t offset = 8;
         //1 descriptor for eui64 and 1 for nguid
         SCSINameStringDesignatorLength = 64;
-        SCSINameStringDesignator = C_CAST(uint8_t*, calloc(SCSINameStringDesignatorLength, sizeof(uint8_t)));
+        SCSINameStringDesignator = borrow_Translation_Buffer(device, SCSINameStringDesignatorLength);
         if (SCSINameStringDesignator)
         {
             //NGUID first!
@@ -1165,7 +1165,7 @@ static int sntl_Translate_Device_Identification_VPD_Page_83h(tDevice *device, Sc
         uint8_t offset = 8;
         //eui. + 32 hex digits from nguid (msb to lsb) 36Bytes total length
         SCSINameStringDesignatorLength = 40;
-        SCSINameStringDesignator = C_CAST(uint8_t*, calloc(SCSINameStringDesignatorLength, sizeof(uint8_t)));
+        SCSINameStringDesignator = borrow_Translation_Buffer(device, SCSINameStringDesignatorLength);
         if (SCSINameStringDesignator)
         {
             SCSINameStringDesignator[0] = 3;//codes set 3 (UTF-8)
@@ -1193,7 +1193,7 @@ static int sntl_Translate_Device_Identification_VPD_Page_83h(tDevice *device, Sc
         uint8_t offset = 8;
         //eui. + 32 hex digits from nguid (msb to lsb) 36Bytes total length
         SCSINameStringDesignatorLength = 24;
-        SCSINameStringDesignator = C_CAST(uint8_t*, calloc(SCSINameStringDesignatorLength, sizeof(uint8_t)));
+        SCSINameStringDesignator = borrow_Translation_Buffer(device, SCSINameStringDesignatorLength);
         if (SCSINameStringDesignator)
         {
             SCSINameStringDesignator[0] = 3;//codes set 3 (UTF-8)
@@ -1219,7 +1219,7 @@ static int sntl_Translate_Device_Identification_VPD_Page_83h(tDevice *device, Sc
     {
         uint8_t offset = 8;
         SCSINameStringDesignatorLength = 72;
-        SCSINameStringDesignator = C_CAST(uint8_t*, calloc(SCSINameStringDesignatorLength, sizeof(uint8_t)));
+        SCSINameStringDesignator = borrow_Translation_Buffer(device, SCSINameStringDesignatorLength);
         if (SCSINameStringDesignator)
         {
             SCSINameStringDesignator[0] = 3;//codes set 3 (UTF-8)
@@ -1260,7 +1260,7 @@ static int sntl_Translate_Device_Identification_VPD_Page_83h(tDevice *device, Sc
         //1 descriptor for eui64 and 1 for nguid
         uint8_t offset = 4;
         eui64DesignatorLength = 32;
-        eui64Designator = C_CAST(uint8_t*, calloc(eui64DesignatorLength, sizeof(uint8_t)));
+        eui64Designator = borrow_Translation_Buffer(device, eui64DesignatorLength);
         if (eui64Designator)
         {
             //NGUID first
@@ -1288,7 +1288,7 @@ static int sntl_Translate_Device_Identification_VPD_Page_83h(tDevice *device, Sc
     {
         uint8_t offset = 4;
         eui64DesignatorLength = 20;
-        eui64Designator = C_CAST(uint8_t*, calloc(eui64DesignatorLength, sizeof(uint8_t)));
+        eui64Designator = borrow_Translation_Buffer(device, eui64DesignatorLength);
         if (eui64Designator)
         {
             eui64Designator[0] = 1;//codes set 1 (binary)
@@ -1305,7 +1305,7 @@ static int sntl_Translate_Device_Identification_VPD_Page_83h(tDevice *device, Sc
     {
         uint8_t offset = 4;
         eui64DesignatorLength = 12;
-        eui64Designator = C_CAST(uint8_t*, calloc(eui64DesignatorLength, sizeof(uint8_t)));
+        eui64Designator = borrow_Translation_Buffer(device, eui64DesignatorLength);
         if (eui64Designator)
         {
             eui64Designator[0] = 1;//codes set 1 (binary)
@@ -1321,12 +1321,12 @@ static int sntl_Translate_Device_Identification_VPD_Page_83h(tDevice *device, Sc
     //else NVMe 1.0 will not support this designator!
     
     //now setup the device identification page
-    deviceIdentificationPage = C_CAST(uint8_t*, calloc(4U + eui64DesignatorLength + t10VendorIdDesignatorLength + naaDesignatorLength + SCSINameStringDesignatorLength, sizeof(uint8_t)));
+    deviceIdentificationPage = borrow_Translation_Buffer(device, 4U + eui64DesignatorLength + t10VendorIdDesignatorLength + naaDesignatorLength + SCSINameStringDesignatorLength);
     if (!deviceIdentificationPage)
     {
-        safe_Free(naaDesignator)
-        safe_Free(SCSINameStringDesignator)
-        safe_Free(t10VendorIdDesignator)
+        return_Translation_Buffer(device, &naaDesignator);
+        return_Translation_Buffer(device, &SCSINameStringDesignator);
+        return_Translation_Buffer(device, &t10VendorIdDesignator);
         return MEMORY_FAILURE;
     }
     deviceIdentificationPage[0] = 0;
@@ -1342,7 +1342,7 @@ static int sntl_Translate_Device_Identification_VPD_Page_83h(tDevice *device, Sc
     {
         naaDesignatorLength = 0;
     }
-    safe_Free(naaDesignator)
+    return_Translation_Buffer(device, &naaDesignator);
     //t10 second
     if (t10VendorIdDesignatorLength > 0 && t10VendorIdDesignator)
     {
@@ -1352,7 +1352,7 @@ static int sntl_Translate_Device_Identification_VPD_Page_83h(tDevice *device, Sc
     {
         t10VendorIdDesignatorLength = 0;
     }
-    safe_Free(t10VendorIdDesignator)
+    return_Translation_Buffer(device, &t10VendorIdDesignator);
     //scsi name string third
     if (SCSINameStringDesignatorLength > 0 && SCSINameStringDesignator)
     {
@@ -1362,7 +1362,7 @@ static int sntl_Translate_Device_Identification_VPD_Page_83h(tDevice *device, Sc
     {
         SCSINameStringDesignatorLength = 0;
     }
-    safe_Free(SCSINameStringDesignator)
+    return_Translation_Buffer(device, &SCSINameStringDesignator);
     //eui64 last
     if (eui64DesignatorLength > 0 && eui64Designator)
     {
@@ -1372,13 +1372,13 @@ static int sntl_Translate_Device_Identification_VPD_Page_83h(tDevice *device, Sc
     {
         eui64DesignatorLength = 0;
     }
-    safe_Free(eui64Designator)
+    return_Translation_Buffer(device, &eui64Designator);
     //copy the final data back for the command
     if (scsiIoCtx->pdata && deviceIdentificationPage)
     {
         memcpy(scsiIoCtx->pdata, deviceIdentificationPage, M_Min(4U + eui64DesignatorLength + t10VendorIdDesignatorLength + naaDesignatorLength + SCSINameStringDesignatorLength, scsiIoCtx->dataLength));
     }
-    safe_Free(deviceIdentificationPage)
+    return_Translation_Buffer(device, &deviceIdentificationPage);
     return ret;
 }
 
@@ -1635,6 +1635,47 @@ static int sntl_Translate_Logical_Block_Provisioning_VPD_Page_B2h(tDevice *devic
     return ret;
 }
 
+//Pages that only depend on what the device supports are built once, then copied from the device's saved translation responses.
+static int sntl_Translate_Static_VPD_Page(tDevice *device, ScsiIoCtx *scsiIoCtx)
+{
+    int ret = SUCCESS;
+    uint8_t pageCode = scsiIoCtx->cdb[2];
+    uint64_t responseKey = TRANSLATION_RESPONSE_KEY(INQUIRY_CMD, BIT0, pageCode, 0, 0, 0, 0, 0);
+    if (!get_Translation_Response(device, responseKey, scsiIoCtx->pdata, scsiIoCtx->dataLength, &ret))
+    {
+        uint8_t vpdPage[LEGACY_DRIVE_SEC_SIZE] = { 0 };
+        uint32_t vpdPageLength = 0;
+        ScsiIoCtx pageCtx;
+        memcpy(&pageCtx, scsiIoCtx, sizeof(ScsiIoCtx));
+        pageCtx.pdata = vpdPage;
+        pageCtx.dataLength = LEGACY_DRIVE_SEC_SIZE;
+        switch (pageCode)
+        {
+        case SUPPORTED_VPD_PAGES:
+            ret = sntl_Translate_Supported_VPD_Pages_00h(&pageCtx);
+            break;
+        case EXTENDED_INQUIRY_DATA:
+            ret = sntl_Translate_Extended_Inquiry_Data_VPD_Page_86h(device, &pageCtx);
+            break;
+        case BLOCK_LIMITS:
+            ret = sntl_Translate_Block_Limits_VPD_Page_B0h(device, &pageCtx);
+            break;
+        default:
+            return NOT_SUPPORTED;
+        }
+        vpdPageLength = M_Min(C_CAST(uint32_t, M_BytesTo2ByteValue(vpdPage[2], vpdPage[3])) + 4, LEGACY_DRIVE_SEC_SIZE);
+        if (ret == SUCCESS)
+        {
+            save_Translation_Response(device, responseKey, ret, vpdPage, vpdPageLength);
+        }
+        if (scsiIoCtx->pdata)
+        {
+            memcpy(scsiIoCtx->pdata, vpdPage, M_Min(vpdPageLength, scsiIoCtx->dataLength));
+        }
+    }
+    return ret;
+}
+
 static int sntl_Translate_SCSI_Inquiry_Command(tDevice *device, ScsiIoCtx *scsiIoCtx)
 {
     int ret = SUCCESS;
@@ -1668,7 +1709,7 @@ static int sntl_Translate_SCSI_Inquiry_Command(tDevice *device, ScsiIoCtx *scsiI
             {
             case SUPPORTED_VPD_PAGES:
                 //update this as more supported pages are added!
-                ret = sntl_Translate_Supported_VPD_Pages_00h(scsiIoCtx);
+                ret = sntl_Translate_Static_VPD_Page(device, scsiIoCtx);
                 break;
             case UNIT_SERIAL_NUMBER:
                 ret = sntl_Translate_Unit_Serial_Number_VPD_Page_80h(device, scsiIoCtx);
@@ -1677,13 +1718,13 @@ static int sntl_Translate_SCSI_Inquiry_Command(tDevice *device, ScsiIoCtx *scsiI
                 ret = sntl_Translate_Device_Identification_VPD_Page_83h(device, scsiIoCtx);
                 break;
             case EXTENDED_INQUIRY_DATA:
-                ret = sntl_Translate_Extended_Inquiry_Data_VPD_Page_86h(device, scsiIoCtx);
+                ret = sntl_Translate_Static_VPD_Page(device, scsiIoCtx);
                 break;
             //case MODE_PAGE_POLICY:
             //  ret = translate_Mode_Page_Policy_VPD_Page_87h(device, scsiIoCtx);
             //  break;
             case BLOCK_LIMITS:
-                ret = sntl_Translate_Block_Limits_VPD_Page_B0h(device, scsiIoCtx);
+                ret = sntl_Translate_Static_VPD_Page(device, scsiIoCtx);
                 break;
             case BLOCK_DEVICE_CHARACTERISTICS:
                 ret = sntl_Translate_Block_Device_Characteristics_VPD_Page_B1h(scsiIoCtx);
@@ -2884,7 +2925,7 @@ static int sntl_Translate_Mode_Sense_Read_Write_Error_Recovery_01h(tDevice *devi
         }
     }
     //now that we know how many bytes we need for this, allocate memory
-    readWriteErrorRecovery = C_CAST(uint8_t*, calloc(pageLength, sizeof(uint8_t)));
+    readWriteErrorRecovery = borrow_Translation_Buffer(device, pageLength);
     if (!readWriteErrorRecovery)
     {
         //TODO: set an error in the sense data
@@ -2949,7 +2990,7 @@ static int sntl_Translate_Mode_Sense_Read_Write_Error_Recovery_01h(tDevice *devi
         }
         else
         {
-            safe_Free(readWriteErrorRecovery)
+            return_Translation_Buffer(device, &readWriteErrorRecovery);
             set_Sense_Data_By_NVMe_Status(device, device->drive_info.lastNVMeResult.lastNVMeStatus, scsiIoCtx->psense, scsiIoCtx->senseDataSize);
             return ret;
         }
@@ -2975,7 +3016,7 @@ static int sntl_Translate_Mode_Sense_Read_Write_Error_Recovery_01h(tDevice *devi
     {
         memcpy(scsiIoCtx->pdata, readWriteErrorRecovery, M_Min(pageLength, allocationLength));
     }
-    safe_Free(readWriteErrorRecovery)
+    return_Translation_Buffer(device, &readWriteErrorRecovery);
     return ret;
 }
 
@@ -3020,7 +3061,7 @@ static int sntl_Translate_Mode_Sense_Caching_08h(tDevice *device, ScsiIoCtx *scs
         }
     }
     //now that we know how many bytes we need for this, allocate memory
-    caching = C_CAST(uint8_t*, calloc(pageLength, sizeof(uint8_t)));
+    caching = borrow_Translation_Buffer(device, pageLength);
     if (!caching)
     {
         //TODO: set an error in the sense data
@@ -3084,7 +3125,7 @@ static int sntl_Translate_Mode_Sense_Caching_08h(tDevice *device, ScsiIoCtx *scs
             {
                 //TODO: set an error...even though this shouldn't happen
                 set_Sense_Data_By_NVMe_Status(device, device->drive_info.lastNVMeResult.lastNVMeStatus, scsiIoCtx->psense, scsiIoCtx->senseDataSize);
-                safe_Free(caching)
+                return_Translation_Buffer(device, &caching);
                 return ret;
             }
         }
@@ -3126,7 +3167,7 @@ static int sntl_Translate_Mode_Sense_Caching_08h(tDevice *device, ScsiIoCtx *scs
     {
         memcpy(scsiIoCtx->pdata, caching, M_Min(pageLength, allocationLength));
     }
-    safe_Free(caching)
+    return_Translation_Buffer(device, &caching);
     return ret;
 }
 
@@ -3171,7 +3212,7 @@ static int sntl_Translate_Mode_Sense_Control_0Ah(ScsiIoCtx *scsiIoCtx, uint8_t p
         }
     }
     //now that we know how many bytes we need for this, allocate memory
-    controlPage = C_CAST(uint8_t*, calloc(pageLength, sizeof(uint8_t)));
+    controlPage = borrow_Translation_Buffer(scsiIoCtx->device, pageLength);
     if (!controlPage)
     {
         //TODO: set an error in the sense data
@@ -3228,7 +3269,7 @@ static int sntl_Translate_Mode_Sense_Control_0Ah(ScsiIoCtx *scsiIoCtx, uint8_t p
     {
         memcpy(scsiIoCtx->pdata, controlPage, M_Min(pageLength, allocationLength));
     }
-    safe_Free(controlPage)
+    return_Translation_Buffer(scsiIoCtx->device, &controlPage);
     return ret;
 }
 
@@ -3273,7 +3314,7 @@ static int sntl_Translate_Mode_Sense_Power_Condition_1A(ScsiIoCtx *scsiIoCtx, ui
         }
     }
     //now that we know how many bytes we need for this, allocate memory
-    powerConditionPage = C_CAST(uint8_t*, calloc(pageLength, sizeof(uint8_t)));
+    powerConditionPage = borrow_Translation_Buffer(scsiIoCtx->device, pageLength);
     if (!powerConditionPage)
     {
         //TODO: set an error in the sense data
@@ -3306,7 +3347,7 @@ static int sntl_Translate_Mode_Sense_Power_Condition_1A(ScsiIoCtx *scsiIoCtx, ui
     {
         memcpy(scsiIoCtx->pdata, powerConditionPage, M_Min(pageLength, allocationLength));
     }
-    safe_Free(powerConditionPage)
+    return_Translation_Buffer(scsiIoCtx->device, &powerConditionPage);
     return ret;
 }
 
@@ -3350,7 +3391,7 @@ static int sntl_Translate_Mode_Sense_Control_Extension_0Ah_01h(ScsiIoCtx *scsiIo
         }
     }
     //now that we know how many bytes we need for this, allocate memory
-    controlExtPage = C_CAST(uint8_t*, calloc(pageLength, sizeof(uint8_t)));
+    controlExtPage = borrow_Translation_Buffer(scsiIoCtx->device, pageLength);
     if (!controlExtPage)
     {
         //TODO: set an error in the sense data
@@ -3415,7 +3456,7 @@ static int sntl_Translate_Mode_Sense_Control_Extension_0Ah_01h(ScsiIoCtx *scsiIo
     {
         memcpy(scsiIoCtx->pdata, controlExtPage, M_Min(pageLength, allocationLength));
     }
-    safe_Free(controlExtPage)
+    return_Translation_Buffer(scsiIoCtx->device, &controlExtPage);
     return ret;
 }
 
@@ -3458,7 +3499,7 @@ static int sntl_Translate_Mode_Sense_Informational_Exceptions_Control_1Ch(ScsiIo
         }
     }
     //now that we know how many bytes we need for this, allocate memory
-    informationalExceptions = C_CAST(uint8_t*, calloc(pageLength, sizeof(uint8_t)));
+    informationalExceptions = borrow_Translation_Buffer(scsiIoCtx->device, pageLength);
     if (!informationalExceptions)
     {
         //TODO: set an error in the sense data
@@ -3507,7 +3548,7 @@ static int sntl_Translate_Mode_Sense_Informational_Exceptions_Control_1Ch(ScsiIo
     {
         memcpy(scsiIoCtx->pdata, informationalExceptions, M_Min(pageLength, allocationLength));
     }
-    safe_Free(informationalExceptions)
+    return_Translation_Buffer(scsiIoCtx->device, &informationalExceptions);
     return ret;
 }
 
@@ -4319,6 +4360,109 @@ static int sntl_Translate_SCSI_Synchronize_Cache_Command(tDevice *device, ScsiIo
     return ret;
 }
 
+//Adds the information field to sense data that was already set up. Used to report the LBA a failing transfer started at.
+static void sntl_Set_Sense_Information(uint8_t *sensePtr, uint32_t senseDataLength, uint64_t information)
+{
+    if (!sensePtr || senseDataLength < 8)
+    {
+        return;
+    }
+    if ((sensePtr[0] & 0x7F) == 0x72 || (sensePtr[0] & 0x7F) == 0x73)
+    {
+        uint32_t descriptorOffset = C_CAST(uint32_t, 8) + sensePtr[7];
+        if (descriptorOffset + 12 <= senseDataLength && descriptorOffset + 12 <= SPC3_SENSE_LEN)
+        {
+            sensePtr[descriptorOffset + 0] = 0;//information descriptor
+            sensePtr[descriptorOffset + 1] = 0x0A;
+            sensePtr[descriptorOffset + 2] = BIT7;//valid
+            sensePtr[descriptorOffset + 3] = RESERVED;
+            sensePtr[descriptorOffset + 4] = M_Byte7(information);
+            sensePtr[descriptorOffset + 5] = M_Byte6(information);
+            sensePtr[descriptorOffset + 6] = M_Byte5(information);
+            sensePtr[descriptorOffset + 7] = M_Byte4(information);
+            sensePtr[descriptorOffset + 8] = M_Byte3(information);
+            sensePtr[descriptorOffset + 9] = M_Byte2(information);
+            sensePtr[descriptorOffset + 10] = M_Byte1(information);
+            sensePtr[descriptorOffset + 11] = M_Byte0(information);
+            sensePtr[7] += 12;
+        }
+    }
+    else if (information <= UINT32_MAX)
+    {
+        //fixed format
+        sensePtr[0] |= BIT7;//valid
+        sensePtr[3] = M_Byte3(information);
+        sensePtr[4] = M_Byte2(information);
+        sensePtr[5] = M_Byte1(information);
+        sensePtr[6] = M_Byte0(information);
+    }
+}
+
+//Most logical blocks a single NVMe read or write can transfer. NLB is a 16 bit 0's based field, and MDTS (when non-zero) also limits the bytes per command.
+static uint32_t sntl_Get_Max_Blocks_Per_Command(tDevice *device)
+{
+    uint32_t maxBlocks = UINT32_C(65536);
+    //MDTS is a power of 2 in units of the minimum memory page size. CAP.MPSMIN cannot be read through most OS passthroughs, so assume 4KiB which is what almost every controller reports.
+    if (device->drive_info.IdentifyData.nvme.ctrl.mdts > 0 && device->drive_info.IdentifyData.nvme.ctrl.mdts < 20 && device->drive_info.deviceBlockSize > 0)
+    {
+        uint64_t mdtsBlocks = (UINT64_C(4096) << device->drive_info.IdentifyData.nvme.ctrl.mdts) / device->drive_info.deviceBlockSize;
+        if (mdtsBlocks > 0 && mdtsBlocks < maxBlocks)
+        {
+            maxBlocks = C_CAST(uint32_t, mdtsBlocks);
+        }
+    }
+    return maxBlocks;
+}
+
+//Issues a SCSI read or write as however many NVMe commands it takes to stay within the controller's limits.
+//Stops at the first command that fails and sets the sense data for it with the LBA that command started at in the information field.
+static int sntl_Read_Write_Split(tDevice *device, ScsiIoCtx *scsiIoCtx, bool write, uint64_t lba, uint32_t transferLength, bool fua, uint8_t pi)
+{
+    int ret = SUCCESS;
+    uint32_t maxBlocks = sntl_Get_Max_Blocks_Per_Command(device);
+    uint32_t blocksDone = 0;
+    if (transferLength <= maxBlocks)
+    {
+        //single command. Pass the buffer through exactly as it was given
+        if (write)
+        {
+            ret = nvme_Write(device, lba, C_CAST(uint16_t, transferLength - 1), false, fua, pi, 0, scsiIoCtx->pdata, scsiIoCtx->dataLength);
+        }
+        else
+        {
+            ret = nvme_Read(device, lba, C_CAST(uint16_t, transferLength - 1), false, fua, pi, scsiIoCtx->pdata, scsiIoCtx->dataLength);
+        }
+        set_Sense_Data_By_NVMe_Status(device, device->drive_info.lastNVMeResult.lastNVMeStatus, scsiIoCtx->psense, scsiIoCtx->senseDataSize);
+        return ret;
+    }
+    if (!scsiIoCtx->pdata || C_CAST(uint64_t, transferLength) * device->drive_info.deviceBlockSize > scsiIoCtx->dataLength)
+    {
+        return BAD_PARAMETER;
+    }
+    while (blocksDone < transferLength)
+    {
+        uint32_t blocks = M_Min(transferLength - blocksDone, maxBlocks);
+        uint8_t *chunk = scsiIoCtx->pdata + C_CAST(uint64_t, blocksDone) * device->drive_info.deviceBlockSize;
+        uint32_t chunkLength = blocks * device->drive_info.deviceBlockSize;
+        if (write)
+        {
+            ret = nvme_Write(device, lba + blocksDone, C_CAST(uint16_t, blocks - 1), false, fua, pi, 0, chunk, chunkLength);
+        }
+        else
+        {
+            ret = nvme_Read(device, lba + blocksDone, C_CAST(uint16_t, blocks - 1), false, fua, pi, chunk, chunkLength);
+        }
+        set_Sense_Data_By_NVMe_Status(device, device->drive_info.lastNVMeResult.lastNVMeStatus, scsiIoCtx->psense, scsiIoCtx->senseDataSize);
+        if (ret != SUCCESS)
+        {
+            sntl_Set_Sense_Information(scsiIoCtx->psense, scsiIoCtx->senseDataSize, lba + blocksDone);
+            break;
+        }
+        blocksDone += blocks;
+    }
+    return ret;
+}
+
 //TODO: DPO bit
 static int sntl_Translate_SCSI_Read_Command(tDevice *device, ScsiIoCtx *scsiIoCtx)
 {
@@ -4430,26 +4574,6 @@ static int sntl_Translate_SCSI_Read_Command(tDevice *device, ScsiIoCtx *scsiIoCt
     {
         return SUCCESS;
     }
-    else if (transferLength > UINT32_C(65536))//not issuing multiple commands...
-    {
-        //return an error
-        switch (scsiIoCtx->cdb[OPERATION_CODE])
-        {
-        case 0x28://read 10
-            fieldPointer = 7;
-            break;
-        case 0xA8://read 12
-            fieldPointer = 6;
-            break;
-        case 0x88://read 16
-            fieldPointer = 10;
-            break;
-        }
-        bitPointer = 7;
-        sntl_Set_Sense_Key_Specific_Descriptor_Invalid_Field(senseKeySpecificDescriptor, true, true, bitPointer, fieldPointer);
-        sntl_Set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_ILLEGAL_REQUEST, 0x24, 0x00, device->drive_info.softSATFlags.senseDataDescriptorFormat, senseKeySpecificDescriptor, 1);
-        return SUCCESS;
-    }
     //TODO: we may need to add additional work to make this happen...not sure.
     if (device->drive_info.IdentifyData.nvme.ns.dps > 0 && scsiIoCtx->cdb[OPERATION_CODE] != 0x08)
     {
@@ -4475,9 +4599,7 @@ static int sntl_Translate_SCSI_Read_Command(tDevice *device, ScsiIoCtx *scsiIoCt
             return UNKNOWN;
         }
     }
-    int ret = nvme_Read(device, lba, C_CAST(uint16_t, transferLength - 1), false, fua, pi, scsiIoCtx->pdata, scsiIoCtx->dataLength);
-    set_Sense_Data_By_NVMe_Status(device, device->drive_info.lastNVMeResult.lastNVMeStatus, scsiIoCtx->psense, scsiIoCtx->senseDataSize);
-    return ret;
+    return sntl_Read_Write_Split(device, scsiIoCtx, false, lba, transferLength, fua, pi);
 }
 
 //TODO: DPO bit
@@ -4591,26 +4713,6 @@ static int sntl_Translate_SCSI_Write_Command(tDevice *device, ScsiIoCtx *scsiIoC
         //a transfer length of zero means do nothing but validate inputs and is not an error
         return SUCCESS;
     }
-    else if (transferLength > UINT32_C(65536))
-    {
-        //return an error
-        switch (scsiIoCtx->cdb[OPERATION_CODE])
-        {
-        case 0x2A://write 10
-            fieldPointer = 7;
-            break;
-        case 0xAA://write 12
-            fieldPointer = 6;
-            break;
-        case 0x8A://write 16
-            fieldPointer = 10;
-            break;
-        }
-        bitPointer = 7;
-        sntl_Set_Sense_Key_Specific_Descriptor_Invalid_Field(senseKeySpecificDescriptor, true, true, bitPointer, fieldPointer);
-        sntl_Set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_ILLEGAL_REQUEST, 0x24, 0x00, device->drive_info.softSATFlags.senseDataDescriptorFormat, senseKeySpecificDescriptor, 1);
-        return SUCCESS;
-    }
     //TODO: we may need to add additional work to make this happen...not sure.
     if (device->drive_info.IdentifyData.nvme.ns.dps > 0 && scsiIoCtx->cdb[OPERATION_CODE] != 0x0A)
     {
@@ -4636,9 +4738,7 @@ static int sntl_Translate_SCSI_Write_Command(tDevice *device, ScsiIoCtx *scsiIoC
             return UNKNOWN;
         }
     }
-    int ret = nvme_Write(device, lba, C_CAST(uint16_t, transferLength - 1), false, fua, pi, 0, scsiIoCtx->pdata, scsiIoCtx->dataLength);
-    set_Sense_Data_By_NVMe_Status(device, device->drive_info.lastNVMeResult.lastNVMeStatus, scsiIoCtx->psense, scsiIoCtx->senseDataSize);
-    return ret;
+    return sntl_Read_Write_Split(device, scsiIoCtx, true, lba, transferLength, fua, pi);
 }
 
 static int sntl_Translate_SCSI_Verify_Command(tDevice *device, ScsiIoCtx *scsiIoCtx)
@@ -4984,14 +5084,14 @@ static int sntl_Translate_SCSI_Report_Luns_Command(tDevice *device, ScsiIoCtx *s
         //read the identify active namespace list
     {
         bool singleLun = false;
-        uint8_t* activeNamespaces = C_CAST(uint8_t*, calloc_aligned(4096, sizeof(uint8_t), device->os_info.minimumAlignment));
+        uint8_t* activeNamespaces = borrow_Translation_Buffer(device, 4096);
         if (activeNamespaces)
         {
             if (SUCCESS == nvme_Identify(device, activeNamespaces, 0, 2))
             {
                 //allocate based on maximum number of namespaces
                 reportLunsDataLength += UINT32_C(8) * device->drive_info.IdentifyData.nvme.ctrl.nn;
-                reportLunsData = C_CAST(uint8_t*, calloc(reportLunsDataLength, sizeof(uint8_t)));
+                reportLunsData = borrow_Translation_Buffer(device, reportLunsDataLength);
                 if (reportLunsData)
                 {
                     uint32_t reportLunsOffset = 8;
@@ -5033,11 +5133,11 @@ static int sntl_Translate_SCSI_Report_Luns_Command(tDevice *device, ScsiIoCtx *s
             //dummy up a single lun
             singleLun = true;
         }
-        safe_Free_aligned(activeNamespaces)
+        return_Translation_Buffer(device, &activeNamespaces);
         if (singleLun)
         {
             reportLunsDataLength += 8;
-            reportLunsData = C_CAST(uint8_t*, calloc(reportLunsDataLength, sizeof(uint8_t)));
+            reportLunsData = borrow_Translation_Buffer(device, reportLunsDataLength);
             if (reportLunsData)
             {
                 reportLunsData[15] = device->drive_info.namespaceID > 0 ? C_CAST(uint8_t, device->drive_info.namespaceID - UINT32_C(1)) : UINT8_C(0);
@@ -5062,7 +5162,7 @@ static int sntl_Translate_SCSI_Report_Luns_Command(tDevice *device, ScsiIoCtx *s
     if (emptyData)
     {
         //allocate zeroed data for the minimum length we need to return
-        reportLunsData = C_CAST(uint8_t*, calloc(reportLunsDataLength, sizeof(uint8_t)));
+        reportLunsData = borrow_Translation_Buffer(device, reportLunsDataLength);
     }
     if (scsiIoCtx->pdata && reportLunsData)
     {
@@ -5072,7 +5172,7 @@ static int sntl_Translate_SCSI_Report_Luns_Command(tDevice *device, ScsiIoCtx *s
     {
         ret = MEMORY_FAILURE;
     }
-    safe_Free(reportLunsData)
+    return_Translation_Buffer(device, &reportLunsData);
     return ret;
 }
 //TODO: if any kind of "device fault" occurs, send back a sense code similar to SAT with ATA devices
@@ -5946,7 +6046,7 @@ static int sntl_Translate_SCSI_Unmap_Command(tDevice *device, ScsiIoCtx *scsiIoC
         uint16_t unmapBlockDescriptorLength = (M_BytesTo2ByteValue(scsiIoCtx->pdata[2], scsiIoCtx->pdata[3]) / 16) * 16;//this can be set to zero, which is NOT an error. Also, I'm making sure this is a multiple of 16 to avoid partial block descriptors-TJE
         if (unmapBlockDescriptorLength > 0)
         {
-            uint8_t *dsmBuffer = C_CAST(uint8_t*, calloc_aligned(4096, sizeof(uint8_t), device->os_info.minimumAlignment));//allocate the max size the device supports...we'll fill in as much as we need to
+            uint8_t *dsmBuffer = borrow_Translation_Buffer(device, 4096);//allocate the max size the device supports...we'll fill in as much as we need to
             //need to check to make sure there weren't any truncated block descriptors before we begin
             uint16_t minBlockDescriptorLength = M_Min(unmapBlockDescriptorLength + 8, parameterListLength);
             uint16_t unmapBlockDescriptorIter = 8;
@@ -6071,7 +6171,7 @@ static int sntl_Translate_SCSI_Unmap_Command(tDevice *device, ScsiIoCtx *scsiIoC
                     set_Sense_Data_By_NVMe_Status(device, device->drive_info.lastNVMeResult.lastNVMeStatus, scsiIoCtx->psense, scsiIoCtx->senseDataSize);
                 }
             }
-            safe_Free_aligned(dsmBuffer)
+            return_Translation_Buffer(device, &dsmBuffer);
         }
     }
     return ret;
@@ -6262,7 +6362,7 @@ static int sntl_Translate_Persistent_Reserve_In(tDevice * device, ScsiIoCtx * sc
         uint16_t numberOfRegisteredControllers = M_BytesTo2ByteValue(nvmeReportKeys[5], nvmeReportKeys[6]);
         persistentReserveDataLength = (numberOfRegisteredControllers * 8) + 8;
         //allocate the memory we need.
-        persistentReserveData = C_CAST(uint8_t*, calloc(persistentReserveDataLength, sizeof(uint8_t)));
+        persistentReserveData = borrow_Translation_Buffer(scsiIoCtx->device, persistentReserveDataLength);
         if (persistentReserveData)
         {
             //set PRGeneration (remember, the endianness is different!)
@@ -6323,7 +6423,7 @@ static int sntl_Translate_Persistent_Reserve_In(tDevice * device, ScsiIoCtx * sc
             persistentReserveDataLength += 16;
         }
         //allocate the memory we need.
-        persistentReserveData = C_CAST(uint8_t*, calloc(persistentReserveDataLength, sizeof(uint8_t)));
+        persistentReserveData = borrow_Translation_Buffer(scsiIoCtx->device, persistentReserveDataLength);
         if (persistentReserveData)
         {
             //set PRGeneration (remember, the endianness is different!)
@@ -6402,7 +6502,7 @@ static int sntl_Translate_Persistent_Reserve_In(tDevice * device, ScsiIoCtx * sc
         }
         //Both commands must complete before translating!
         persistentReserveDataLength = 8;
-        persistentReserveData = C_CAST(uint8_t*, calloc(persistentReserveDataLength, sizeof(uint8_t)));
+        persistentReserveData = borrow_Translation_Buffer(scsiIoCtx->device, persistentReserveDataLength);
         if (persistentReserveData)
         {
             //length
@@ -6472,7 +6572,7 @@ static int sntl_Translate_Persistent_Reserve_In(tDevice * device, ScsiIoCtx * sc
         uint16_t numberOfRegisteredControllers = M_BytesTo2ByteValue(nvmeReport[5], nvmeReport[6]);
         persistentReserveDataLength = (numberOfRegisteredControllers * 32) + 8;//data structure size for full status is 32 bytes
         //allocate the memory we need.
-        persistentReserveData = C_CAST(uint8_t*, calloc(persistentReserveDataLength, sizeof(uint8_t)));
+        persistentReserveData = borrow_Translation_Buffer(scsiIoCtx->device, persistentReserveDataLength);
         if (persistentReserveData)
         {
             //set PRGeneration (remember, the endianness is different!)
@@ -6575,7 +6675,7 @@ static int sntl_Translate_Persistent_Reserve_In(tDevice * device, ScsiIoCtx * sc
     {
         memcpy(scsiIoCtx->pdata, persistentReserveData, M_Min(persistentReserveDataLength, allocationLength));
     }
-    safe_Free(persistentReserveData)
+    return_Translation_Buffer(scsiIoCtx->device, &persistentReserveData);
     return ret;
 }
 
@@ -7388,7 +7488,7 @@ static int sntl_Check_Operation_Code(tDevice *device, uint8_t operationCode, boo
     if (rctd)
     {
         //add 12 bytes for room for the command timeouts descriptor to be setup
-        dataLength += 12;
+        *dataLength += 12;
     }
     switch (operationCode)
     {
@@ -8080,7 +8180,7 @@ static int sntl_Check_Operation_Code_and_Service_Action(tDevice *device, uint8_t
     if (rctd)
     {
         //add 12 bytes for room for the command timeouts descriptor to be setup
-        dataLength += 12;
+        *dataLength += 12;
     }
     switch (operationCode)
     {
@@ -9396,6 +9496,7 @@ static int sntl_Translate_SCSI_Report_Supported_Operation_Codes_Command(tDevice
     uint32_t allocationLength = M_BytesTo4ByteValue(scsiIoCtx->cdb[6], scsiIoCtx->cdb[7], scsiIoCtx->cdb[8], scsiIoCtx->cdb[9]);
     uint8_t *supportedOpData = NULL;
     uint32_t supportedOpDataLength = 0;
+    uint64_t responseKey = 0;
     uint8_t senseKeySpecificDescriptor[8] = { 0 };
     uint8_t bitPointer = 0;
     uint16_t fieldPointer = 0;
@@ -9430,6 +9531,15 @@ static int sntl_Translate_SCSI_Report_Supported_Operation_Codes_Command(tDevice
     {
         rctd = true;
     }
+    if (reportingOptions <= 3)
+    {
+        //these responses only depend on what the device supports, so only build them the first time they are asked for
+        responseKey = TRANSLATION_RESPONSE_KEY(REPORT_SUPPORTED_OPERATION_CODES_CMD, reportingOptions, rctd ? 1 : 0, reportingOptions > 0 ? requestedOperationCode : 0, reportingOptions > 1 ? M_Byte1(requestedServiceAction) : 0, reportingOptions > 1 ? M_Byte0(requestedServiceAction) : 0, 0, 0);
+        if (get_Translation_Response(device, responseKey, scsiIoCtx->pdata, M_Min(allocationLength, scsiIoCtx->dataLength), &ret))
+        {
+            return ret;
+        }
+    }
     switch (reportingOptions)
     {
     case 0://return all op codes (return not supported for now until we get the other methods working...)
@@ -9475,6 +9585,10 @@ static int sntl_Translate_SCSI_Report_Supported_Operation_Codes_Command(tDevice
     {
         memcpy(scsiIoCtx->pdata, supportedOpData, M_Min(supportedOpDataLength, allocationLength));
     }
+    if (supportedOpData && reportingOptions <= 3 && (ret == SUCCESS || ret == NOT_SUPPORTED))
+    {
+        save_Translation_Response(device, responseKey, ret, supportedOpData, supportedOpDataLength);
+    }
     safe_Free(supportedOpData)
     return ret;
 }
@@ -9539,6 +9653,8 @@ int sntl_Translate_SCSI_Command(tDevice *device, ScsiIoCtx *scsiIoCtx)
             deviceInfoAvailable = true;
         }
     }
+    //all temporary buffers used by the translation come from the device's scratch region and are released together below.
+    uint32_t scratchMark = begin_Translation_Scratch(device);
     //start checking the scsi command and call the function to translate it
     //All functions within this switch-case should dummy up their own sense data specific to the translation!
     switch (scsiIoCtx->cdb[OPERATION_CODE])
@@ -9774,6 +9890,7 @@ int sntl_Translate_SCSI_Command(tDevice *device, ScsiIoCtx *scsiIoCtx)
         sntl_Set_Sense_Data_For_Translation(scsiIoCtx->psense, scsiIoCtx->senseDataSize, SENSE_KEY_ILLEGAL_REQUEST, 0x20, 0, device->drive_info.softSATFlags.senseDataDescriptorFormat, senseKeySpecificDescriptor, 1);
         ret = NOT_SUPPORTED;
     }
+    end_Translation_Scratch(device, scratchMark);
     return ret;
 }
 
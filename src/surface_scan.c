@@ -0,0 +1,374 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file surface_scan.c
+// \brief Defines the functions to scan a range of LBAs for media errors and keep track of the bad LBAs found.
+
+#include "surface_scan.h"
+#include "allocation_map.h"
+#include "cmds.h"
+#include "scsi_helper_func.h"
+
+//Returns the index of the first interval that ends at or after lba (so it may contain or touch lba), or intervalCount if there is none.
+static uint32_t find_LBA_Interval(lbaIntervalSet *intervalSet, uint64_t lba)
+{
+    uint32_t low = 0;
+    uint32_t high = intervalSet->intervalCount;
+    while (low < high)
+    {
+        uint32_t middle = low + (high - low) / 2;
+        lbaInterval *interval = &intervalSet->intervals[middle];
+        if (interval->startLBA + interval->length < lba)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+int add_LBA_Interval(lbaIntervalSet *intervalSet, uint64_t startLBA, uint64_t length)
+{
+    uint64_t endLBA = 0;
+    uint32_t first = 0;
+    uint32_t last = 0;
+    if (!intervalSet || length == 0 || startLBA + length < startLBA)
+    {
+        return BAD_PARAMETER;
+    }
+    endLBA = startLBA + length;
+    first = find_LBA_Interval(intervalSet, startLBA);
+    //find every interval that overlaps or touches the new one
+    last = first;
+    while (last < intervalSet->intervalCount && intervalSet->intervals[last].startLBA <= endLBA)
+    {
+        ++last;
+    }
+    if (last > first)
+    {
+        //merge into the first one and remove the rest
+        lbaInterval *merged = &intervalSet->intervals[first];
+        uint64_t mergedEnd = M_Max(endLBA, intervalSet->intervals[last - 1].startLBA + intervalSet->intervals[last - 1].length);
+        merged->startLBA = M_Min(merged->startLBA, startLBA);
+        merged->length = mergedEnd - merged->startLBA;
+        if (last - first > 1)
+        {
+            memmove(&intervalSet->intervals[first + 1], &intervalSet->intervals[last], (intervalSet->intervalCount - last) * sizeof(lbaInterval));
+            intervalSet->intervalCount -= last - first - 1;
+        }
+        return SUCCESS;
+    }
+    if (intervalSet->intervalCount == intervalSet->intervalCapacity)
+    {
+        uint32_t newCapacity = intervalSet->intervalCapacity == 0 ? UINT32_C(16) : intervalSet->intervalCapacity * 2;
+        lbaInterval *newIntervals = C_CAST(lbaInterval*, realloc(intervalSet->intervals, newCapacity * sizeof(lbaInterval)));
+        if (!newIntervals)
+        {
+            return MEMORY_FAILURE;
+        }
+        intervalSet->intervals = newIntervals;
+        intervalSet->intervalCapacity = newCapacity;
+    }
+    memmove(&intervalSet->intervals[first + 1], &intervalSet->intervals[first], (intervalSet->intervalCount - first) * sizeof(lbaInterval));
+    intervalSet->intervals[first].startLBA = startLBA;
+    intervalSet->intervals[first].length = length;
+    intervalSet->intervalCount += 1;
+    return SUCCESS;
+}
+
+bool is_LBA_In_Interval_Set(lbaIntervalSet *intervalSet, uint64_t lba)
+{
+    uint32_t index = 0;
+    if (!intervalSet)
+    {
+        return false;
+    }
+    index = find_LBA_Interval(intervalSet, lba);
+    return index < intervalSet->intervalCount && intervalSet->intervals[index].startLBA <= lba && lba < intervalSet->intervals[index].startLBA + intervalSet->intervals[index].length;
+}
+
+uint64_t get_LBA_Interval_Set_Total(lbaIntervalSet *intervalSet)
+{
+    uint64_t total = 0;
+    if (intervalSet)
+    {
+        for (uint32_t intervalIter = 0; intervalIter < intervalSet->intervalCount; ++intervalIter)
+        {
+            total += intervalSet->intervals[intervalIter].length;
+        }
+    }
+    return total;
+}
+
+void free_LBA_Interval_Set(lbaIntervalSet *intervalSet)
+{
+    if (intervalSet)
+    {
+        safe_Free(intervalSet->intervals)
+        intervalSet->intervalCount = 0;
+        intervalSet->intervalCapacity = 0;
+    }
+}
+
+void free_Surface_Scan_Results(surfaceScanResults *results)
+{
+    if (results)
+    {
+        free_LBA_Interval_Set(&results->badLBAs);
+        free_LBA_Interval_Set(&results->skippedLBAs);
+    }
+}
+
+typedef struct _surfaceScanState
+{
+    tDevice *device;
+    surfaceScanOptions *options;
+    surfaceScanResults *results;
+    uint8_t *readBuffer;
+}surfaceScanState;
+
+static int scan_LBAs(surfaceScanState *scan, uint64_t lba, uint64_t count)
+{
+    scan->results->commandsIssued += 1;
+    if (scan->options->mode == SURFACE_SCAN_READ)
+    {
+        return read_LBA(scan->device, lba, false, scan->readBuffer, C_CAST(uint32_t, count * scan->device->drive_info.deviceBlockSize));
+    }
+    return verify_LBA(scan->device, lba, C_CAST(uint32_t, count));
+}
+
+//Called after a command on count LBAs at lba failed with a media error. Sets badLBA to the first bad LBA in the range, or UINT64_MAX if the pieces that were retried all passed.
+//nextLBA is set to the first LBA that has not been scanned yet, which may be before the end of the range when the retry passed, so the caller must continue from there.
+static int find_First_Bad_LBA(surfaceScanState *scan, uint64_t lba, uint64_t count, uint64_t *badLBA, uint64_t *nextLBA)
+{
+    int ret = SUCCESS;
+    bool informationValid = false;
+    uint64_t information = 0;
+    bool singleLBAFailed = count == 1;
+    *badLBA = UINT64_MAX;
+    *nextLBA = lba + count;
+    //SCSI and SAT report the first LBA that failed in the information field, which saves splitting the range.
+    get_Information_From_Sense_Data(scan->device->drive_info.lastCommandSenseData, SPC3_SENSE_LEN, &informationValid, &information);
+    if (informationValid && information >= lba && information < lba + count)
+    {
+        scan->results->lbasScanned += information - lba + 1;
+        *badLBA = information;
+        *nextLBA = information + 1;
+        return SUCCESS;
+    }
+    while (count > 1)
+    {
+        uint64_t half = count / 2;
+        ret = scan_LBAs(scan, lba, half);
+        if (ret == SUCCESS)
+        {
+            scan->results->lbasScanned += half;
+            lba += half;
+            count -= half;
+            singleLBAFailed = false;
+        }
+        else if (ret == FAILURE)
+        {
+            count = half;
+            singleLBAFailed = half == 1;
+        }
+        else
+        {
+            return ret;
+        }
+    }
+    if (!singleLBAFailed)
+    {
+        //everything before this LBA passed, so this one should be the bad one, but it has not failed on its own yet
+        ret = scan_LBAs(scan, lba, 1);
+        if (ret != SUCCESS && ret != FAILURE)
+        {
+            return ret;
+        }
+    }
+    else
+    {
+        ret = FAILURE;
+    }
+    scan->results->lbasScanned += 1;
+    if (ret == FAILURE)
+    {
+        *badLBA = lba;
+    }
+    *nextLBA = lba + 1;
+    return SUCCESS;
+}
+
+int run_Surface_Scan(tDevice *device, surfaceScanOptions *options, surfaceScanResults *results)
+{
+    int ret = SUCCESS;
+    surfaceScanState scan;
+    uint64_t lba = 0;
+    uint64_t endLBA = 0;
+    uint64_t chunkSize = 0;
+    uint64_t skipDistance = 0;
+    uint64_t resumeLBA = UINT64_MAX;//first LBA scanned after the last bad LBA (and skip). A bad LBA here means errors are clustered.
+    allocationMapIterator allocationMap;
+    bool useAllocationMap = false;
+    lbaInterval mappedExtent = { 0, 0 };
+    if (!device || !options || !results)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(results, 0, sizeof(surfaceScanResults));
+    fill_Lazy_Device_Info(device, LAZY_INFO_CAPACITY);
+    if (device->drive_info.deviceBlockSize == 0 || options->startLBA > device->drive_info.deviceMaxLba)
+    {
+        return BAD_PARAMETER;
+    }
+    endLBA = device->drive_info.deviceMaxLba + 1;
+    if (options->range > 0 && options->range < endLBA - options->startLBA)
+    {
+        endLBA = options->startLBA + options->range;
+    }
+    chunkSize = options->chunkSize;
+    if (chunkSize == 0)
+    {
+        chunkSize = options->mode == SURFACE_SCAN_READ ? M_Max(SURFACE_SCAN_DEFAULT_READ_BYTES / device->drive_info.deviceBlockSize, UINT32_C(1)) : SURFACE_SCAN_DEFAULT_VERIFY_CHUNK;
+    }
+    if (options->mode == SURFACE_SCAN_READ)
+    {
+        //keep the transfer length in bytes within what read_LBA() can take
+        chunkSize = M_Min(chunkSize, UINT32_MAX / device->drive_info.deviceBlockSize);
+    }
+    memset(&scan, 0, sizeof(surfaceScanState));
+    scan.device = device;
+    scan.options = options;
+    scan.results = results;
+    if (options->mode == SURFACE_SCAN_READ)
+    {
+        scan.readBuffer = C_CAST(uint8_t*, calloc_aligned(C_CAST(size_t, chunkSize * device->drive_info.deviceBlockSize), sizeof(uint8_t), device->os_info.minimumAlignment));
+        if (!scan.readBuffer)
+        {
+            return MEMORY_FAILURE;
+        }
+    }
+    lba = options->startLBA;
+    memset(&allocationMap, 0, sizeof(allocationMapIterator));
+    if (options->skipUnmappedLBAs)
+    {
+        ret = start_Allocation_Map(device, lba, endLBA - lba, &allocationMap);
+        if (ret == MEMORY_FAILURE)
+        {
+            safe_Free_aligned(scan.readBuffer)
+            return ret;
+        }
+        useAllocationMap = ret == SUCCESS;
+        ret = SUCCESS;
+    }
+    while (lba < endLBA)
+    {
+        uint64_t count = 0;
+        if (useAllocationMap && lba >= mappedExtent.startLBA + mappedExtent.length)
+        {
+            int mapRet = get_Next_Mapped_Extent(&allocationMap, &mappedExtent);
+            while (mapRet == SUCCESS && mappedExtent.length > 0 && mappedExtent.startLBA + mappedExtent.length <= lba)
+            {
+                //a skip after bad LBAs can jump past a whole extent
+                mapRet = get_Next_Mapped_Extent(&allocationMap, &mappedExtent);
+            }
+            if (mapRet != SUCCESS)
+            {
+                //scan everything from here rather than risk missing mapped LBAs
+                useAllocationMap = false;
+            }
+            else
+            {
+                uint64_t nextMappedLBA = mappedExtent.length > 0 ? M_Max(mappedExtent.startLBA, lba) : endLBA;
+                results->unmappedLBAs += nextMappedLBA - lba;
+                lba = nextMappedLBA;
+                if (lba >= endLBA)
+                {
+                    break;
+                }
+            }
+        }
+        count = M_Min(chunkSize, endLBA - lba);
+        if (useAllocationMap)
+        {
+            count = M_Min(count, mappedExtent.startLBA + mappedExtent.length - lba);
+        }
+        ret = scan_LBAs(&scan, lba, count);
+        if (ret == SUCCESS)
+        {
+            results->lbasScanned += count;
+            lba += count;
+            skipDistance = 0;
+        }
+        else if (ret == FAILURE)
+        {
+            uint64_t badLBA = UINT64_MAX;
+            uint64_t nextLBA = lba + count;
+            ret = find_First_Bad_LBA(&scan, lba, count, &badLBA, &nextLBA);
+            if (ret != SUCCESS)
+            {
+                break;
+            }
+            if (badLBA == UINT64_MAX)
+            {
+                //the pieces that were retried passed. Anything after them in this chunk has not been read yet, so carry on from there.
+                lba = nextLBA;
+            }
+            else
+            {
+                ret = add_LBA_Interval(&results->badLBAs, badLBA, 1);
+                if (ret != SUCCESS)
+                {
+                    break;
+                }
+                results->badLBACount += 1;
+                lba = nextLBA;
+                if (options->maxSkipLBAs > 0 && badLBA == resumeLBA && lba < endLBA)
+                {
+                    //the first LBA tried after the last error also failed, so this is likely a damaged area. Jump ahead, further each time it keeps happening.
+                    uint64_t skipEnd = 0;
+                    skipDistance = skipDistance == 0 ? 1 : M_Min(skipDistance * 2, C_CAST(uint64_t, options->maxSkipLBAs));
+                    skipEnd = M_Min(lba + skipDistance, endLBA);
+                    ret = add_LBA_Interval(&results->skippedLBAs, lba, skipEnd - lba);
+                    if (ret != SUCCESS)
+                    {
+                        break;
+                    }
+                    lba = skipEnd;
+                }
+                else
+                {
+                    skipDistance = 0;
+                }
+                resumeLBA = lba;
+            }
+            if (options->maxBadLBAs > 0 && results->badLBACount >= options->maxBadLBAs)
+            {
+                results->stoppedEarly = true;
+                break;
+            }
+        }
+        else
+        {
+            break;
+        }
+        if (options->progress && !options->progress(device, options->progressData, lba, results->badLBACount))
+        {
+            results->stoppedEarly = lba < endLBA;
+            break;
+        }
+    }
+    free_Allocation_Map(&allocationMap);
+    safe_Free_aligned(scan.readBuffer)
+    return ret;
+}
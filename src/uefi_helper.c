@@ -1784,6 +1784,7 @@ int os_nvme_Subsystem_Reset(tDevice *device)
 
 int close_Device(tDevice *device)
 {
+    free_Translation_Scratch(device);
     return NOT_SUPPORTED;
 }
 
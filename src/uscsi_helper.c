@@ -305,6 +305,7 @@ int close_Device(tDevice *device)
     int retValue = 0;
     if(device)
     {
+        free_Translation_Scratch(device);
         retValue = close(device->os_info.fd);
         device->os_info.last_error = errno;
         if(retValue == 0)
@@ -1250,7 +1250,7 @@ int send_sg_io( ScsiIoCtx *scsiIoCtx )
     }
     else
     {
-        localSenseBuffer = C_CAST(uint8_t *, calloc_aligned(SPC3_SENSE_LEN, sizeof(uint8_t), scsiIoCtx->device->os_info.minimumAlignment));
+        localSenseBuffer = borrow_Command_Buffer(scsiIoCtx->device, SPC3_SENSE_LEN);
         if (!localSenseBuffer)
         {
             return MEMORY_FAILURE;
@@ -1284,7 +1284,7 @@ int send_sg_io( ScsiIoCtx *scsiIoCtx )
         {
             printf("%s Didn't understand direction\n", __FUNCTION__);
         }
-        safe_Free_aligned(localSenseBuffer)
+        return_Command_Buffer(scsiIoCtx->device, &localSenseBuffer);
         return BAD_PARAMETER;
     }
 
@@ -1567,7 +1567,7 @@ int send_sg_io( ScsiIoCtx *scsiIoCtx )
 #ifdef _DEBUG
     printf("<--%s (%d)\n",__FUNCTION__, ret);
 #endif
-    safe_Free_aligned(localSenseBuffer)
+    return_Command_Buffer(scsiIoCtx->device, &localSenseBuffer);
     return ret;
 }
 
@@ -1845,6 +1845,7 @@ int close_Device(tDevice *dev)
 
     if (dev)
     {
+        free_Translation_Scratch(dev);
         if (isNVMe) 
         {
             Nvme_Close(dev->os_info.nvmeFd);
@@ -3175,6 +3175,7 @@ int close_Device(tDevice *dev)
     int retValue = 0;
     if (dev)
     {
+        free_Translation_Scratch(dev);
 #if defined (ENABLE_CSMI)
         if (is_CSMI_Handle(dev->os_info.name))
         {
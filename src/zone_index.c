@@ -0,0 +1,597 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file zone_index.c
+// \brief Defines an in memory table of the zones on a ZBC or ZAC device that is kept up to date as zones are written and managed.
+
+#include "zone_index.h"
+#include "cmds.h"
+
+static uint64_t get_Zone_End(zoneIndex *index, uint32_t zoneNumber)
+{
+    if (zoneNumber + 1 < index->zoneCount)
+    {
+        return index->zoneStartLBA[zoneNumber + 1];
+    }
+    return index->endLBA;
+}
+
+//LBA after the last one that can be written in a zone. This is the end of the zone unless the zone capacity is smaller than its length.
+static uint64_t get_Zone_Writable_End(zoneIndex *index, uint32_t zoneNumber)
+{
+    uint64_t zoneEnd = get_Zone_End(index, zoneNumber);
+    if (index->zoneCapacity[zoneNumber] > 0 && index->zoneCapacity[zoneNumber] < zoneEnd - index->zoneStartLBA[zoneNumber])
+    {
+        return index->zoneStartLBA[zoneNumber] + index->zoneCapacity[zoneNumber];
+    }
+    return zoneEnd;
+}
+
+static bool is_Write_Pointer_Zone_Type(uint8_t zoneType)
+{
+    return zoneType == ZONE_TYPE_SEQUENTIAL_WRITE_REQUIRED || zoneType == ZONE_TYPE_SEQUENTIAL_WRITE_PREFERRED || zoneType == ZONE_TYPE_SEQUENTIAL_OR_BEFORE_REQUIRED;
+}
+
+static bool is_Zone_Writable(zoneIndex *index, uint32_t zoneNumber)
+{
+    switch (index->zoneCondition[zoneNumber])
+    {
+    case ZONE_CONDITION_INACTIVE:
+    case ZONE_CONDITION_READ_ONLY:
+    case ZONE_CONDITION_FULL:
+    case ZONE_CONDITION_OFFLINE:
+        return false;
+    default:
+        break;
+    }
+    if (index->zoneType[zoneNumber] == ZONE_TYPE_CONVENTIONAL)
+    {
+        return true;
+    }
+    if (is_Write_Pointer_Zone_Type(index->zoneType[zoneNumber]))
+    {
+        return index->writePointer[zoneNumber] < get_Zone_Writable_End(index, zoneNumber);
+    }
+    return false;
+}
+
+//The Fenwick tree is 1 based: writableTree[n] holds the number of writable zones in a range ending at zone n - 1.
+static void writable_Tree_Add(zoneIndex *index, uint32_t zoneNumber, bool writable)
+{
+    for (uint32_t node = zoneNumber + 1; node <= index->zoneCount; node += node & (~node + 1))
+    {
+        if (writable)
+        {
+            index->writableTree[node] += 1;
+        }
+        else
+        {
+            index->writableTree[node] -= 1;
+        }
+    }
+    if (writable)
+    {
+        index->writableZoneCount += 1;
+    }
+    else
+    {
+        index->writableZoneCount -= 1;
+    }
+}
+
+//number of writable zones before zoneNumber
+static uint32_t writable_Tree_Count_Before(zoneIndex *index, uint32_t zoneNumber)
+{
+    uint32_t count = 0;
+    for (uint32_t node = zoneNumber; node > 0; node -= node & (~node + 1))
+    {
+        count += index->writableTree[node];
+    }
+    return count;
+}
+
+//zone number of the nth (starting at 1) writable zone. n must be no more than writableZoneCount
+static uint32_t writable_Tree_Find(zoneIndex *index, uint32_t n)
+{
+    uint32_t position = 0;
+    uint32_t step = 1;
+    while (step <= index->zoneCount / 2)
+    {
+        step <<= 1;
+    }
+    for (; step > 0; step >>= 1)
+    {
+        if (position + step <= index->zoneCount && index->writableTree[position + step] < n)
+        {
+            position += step;
+            n -= index->writableTree[position];
+        }
+    }
+    return position;
+}
+
+static void build_Writable_Tree(zoneIndex *index)
+{
+    index->writableZoneCount = 0;
+    for (uint32_t node = 1; node <= index->zoneCount; ++node)
+    {
+        index->writableTree[node] = is_Zone_Writable(index, node - 1) ? 1 : 0;
+        index->writableZoneCount += index->writableTree[node];
+    }
+    for (uint32_t node = 1; node <= index->zoneCount; ++node)
+    {
+        uint32_t parent = node + (node & (~node + 1));
+        if (parent <= index->zoneCount)
+        {
+            index->writableTree[parent] += index->writableTree[node];
+        }
+    }
+}
+
+static void set_Zone(zoneIndex *index, uint32_t zoneNumber, uint8_t zoneType, uint8_t zoneCondition, uint64_t writePointer, uint64_t zoneCapacity)
+{
+    bool wasWritable = is_Zone_Writable(index, zoneNumber);
+    bool writable = false;
+    index->zoneType[zoneNumber] = zoneType;
+    index->zoneCondition[zoneNumber] = zoneCondition;
+    index->writePointer[zoneNumber] = writePointer;
+    index->zoneCapacity[zoneNumber] = zoneCapacity;
+    writable = is_Zone_Writable(index, zoneNumber);
+    if (writable != wasWritable)
+    {
+        writable_Tree_Add(index, zoneNumber, writable);
+    }
+}
+
+static uint32_t get_Zone_Report_Buffer_Size(tDevice *device)
+{
+    uint32_t bufferSize = ZONE_INDEX_REPORT_BUFFER_SIZE;
+    uint32_t maxTransferLength = 0;
+    if (device->drive_info.drive_type == ATA_DRIVE)
+    {
+        maxTransferLength = device->drive_info.passThroughHacks.ataPTHacks.maxTransferLength;
+    }
+    else
+    {
+        maxTransferLength = device->drive_info.passThroughHacks.scsiHacks.maxTransferLength;
+    }
+    if (maxTransferLength > 0)
+    {
+        bufferSize = M_Min(bufferSize, maxTransferLength);
+    }
+    //ATA reports are in 512 byte pages
+    bufferSize -= bufferSize % LEGACY_DRIVE_SEC_SIZE;
+    return M_Max(bufferSize, LEGACY_DRIVE_SEC_SIZE);
+}
+
+//ZAC reports are little endian. ZBC reports, including ones translated by a SATL, are big endian.
+static uint64_t get_Zone_Report_Qword(uint8_t *ptr, bool littleEndian)
+{
+    if (littleEndian)
+    {
+        return M_BytesTo8ByteValue(ptr[7], ptr[6], ptr[5], ptr[4], ptr[3], ptr[2], ptr[1], ptr[0]);
+    }
+    return M_BytesTo8ByteValue(ptr[0], ptr[1], ptr[2], ptr[3], ptr[4], ptr[5], ptr[6], ptr[7]);
+}
+
+static uint32_t get_Zone_Report_Descriptor_Count(uint8_t *report, uint32_t reportSize, bool littleEndian)
+{
+    uint32_t zoneListLength = 0;
+    if (littleEndian)
+    {
+        zoneListLength = M_BytesTo4ByteValue(report[3], report[2], report[1], report[0]);
+    }
+    else
+    {
+        zoneListLength = M_BytesTo4ByteValue(report[0], report[1], report[2], report[3]);
+    }
+    return M_Min(zoneListLength, reportSize - ZONE_DESCRIPTOR_LENGTH) / ZONE_DESCRIPTOR_LENGTH;
+}
+
+typedef struct _zoneDescriptorFields
+{
+    uint8_t zoneType;
+    uint8_t zoneCondition;
+    uint64_t zoneLength;
+    uint64_t zoneStartLBA;
+    uint64_t writePointer;
+    uint64_t zoneCapacity;//0 = the whole zone can be written
+}zoneDescriptorFields;
+
+static void get_Zone_Descriptor(uint8_t *report, uint32_t descriptorNumber, bool littleEndian, zoneDescriptorFields *fields)
+{
+    //the header is the same length as a descriptor
+    uint8_t *descriptor = &report[ZONE_DESCRIPTOR_LENGTH * (descriptorNumber + 1)];
+    fields->zoneType = descriptor[0] & 0x0F;
+    fields->zoneCondition = (descriptor[1] >> 4) & 0x0F;
+    fields->zoneLength = get_Zone_Report_Qword(&descriptor[8], littleEndian);
+    fields->zoneStartLBA = get_Zone_Report_Qword(&descriptor[16], littleEndian);
+    fields->writePointer = get_Zone_Report_Qword(&descriptor[24], littleEndian);
+    //only set in reports converted from an NVMe zoned namespace. Reserved (0) from ZBC and ZAC devices.
+    fields->zoneCapacity = get_Zone_Report_Qword(&descriptor[ZONE_DESCRIPTOR_CAPACITY_OFFSET], littleEndian);
+}
+
+void free_Zone_Index(zoneIndex *index)
+{
+    if (index)
+    {
+        safe_Free(index->zoneType)
+        safe_Free(index->zoneCondition)
+        safe_Free(index->zoneStartLBA)
+        safe_Free(index->writePointer)
+        safe_Free(index->zoneCapacity)
+        safe_Free(index->writableTree)
+        memset(index, 0, sizeof(zoneIndex));
+    }
+}
+
+int build_Zone_Index(tDevice *device, zoneIndex *index)
+{
+    int ret = SUCCESS;
+    zoneIndex newIndex;
+    uint8_t *report = NULL;
+    uint32_t reportSize = 0;
+    uint32_t totalZones = 0;
+    uint64_t zoneLocator = 0;
+    bool littleEndian = false;
+    if (!device || !index)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(&newIndex, 0, sizeof(zoneIndex));
+    littleEndian = device->drive_info.drive_type == ATA_DRIVE;
+    reportSize = get_Zone_Report_Buffer_Size(device);
+    report = C_CAST(uint8_t*, calloc_aligned(reportSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!report)
+    {
+        return MEMORY_FAILURE;
+    }
+    //The first report is not partial so that the zone list length gives the number of zones on the device
+    ret = report_Zones(device, ZONE_REPORT_LIST_ALL_ZONES, false, 0, report, reportSize);
+    if (ret == SUCCESS)
+    {
+        uint32_t zoneListLength = littleEndian ? M_BytesTo4ByteValue(report[3], report[2], report[1], report[0]) : M_BytesTo4ByteValue(report[0], report[1], report[2], report[3]);
+        totalZones = zoneListLength / ZONE_DESCRIPTOR_LENGTH;
+        if (totalZones == 0)
+        {
+            ret = NOT_SUPPORTED;
+        }
+    }
+    if (ret == SUCCESS)
+    {
+        newIndex.zoneType = C_CAST(uint8_t*, calloc(totalZones, sizeof(uint8_t)));
+        newIndex.zoneCondition = C_CAST(uint8_t*, calloc(totalZones, sizeof(uint8_t)));
+        newIndex.zoneStartLBA = C_CAST(uint64_t*, calloc(totalZones, sizeof(uint64_t)));
+        newIndex.writePointer = C_CAST(uint64_t*, calloc(totalZones, sizeof(uint64_t)));
+        newIndex.zoneCapacity = C_CAST(uint64_t*, calloc(totalZones, sizeof(uint64_t)));
+        newIndex.writableTree = C_CAST(uint32_t*, calloc(C_CAST(size_t, totalZones) + 1, sizeof(uint32_t)));
+        if (!newIndex.zoneType || !newIndex.zoneCondition || !newIndex.zoneStartLBA || !newIndex.writePointer || !newIndex.zoneCapacity || !newIndex.writableTree)
+        {
+            ret = MEMORY_FAILURE;
+        }
+    }
+    while (ret == SUCCESS && newIndex.zoneCount < totalZones)
+    {
+        uint32_t descriptorCount = 0;
+        if (newIndex.zoneCount > 0)
+        {
+            ret = report_Zones(device, ZONE_REPORT_LIST_ALL_ZONES, true, zoneLocator, report, reportSize);
+            if (ret != SUCCESS)
+            {
+                break;
+            }
+        }
+        descriptorCount = M_Min(get_Zone_Report_Descriptor_Count(report, reportSize, littleEndian), totalZones - newIndex.zoneCount);
+        if (descriptorCount == 0)
+        {
+            //the device stopped returning zones before the count it reported at the start
+            ret = FAILURE;
+            break;
+        }
+        for (uint32_t descriptorIter = 0; descriptorIter < descriptorCount; ++descriptorIter)
+        {
+            zoneDescriptorFields fields;
+            get_Zone_Descriptor(report, descriptorIter, littleEndian, &fields);
+            if (fields.zoneLength == 0 || fields.zoneStartLBA != zoneLocator)
+            {
+                //zones must be contiguous
+                ret = FAILURE;
+                break;
+            }
+            newIndex.zoneType[newIndex.zoneCount] = fields.zoneType;
+            newIndex.zoneCondition[newIndex.zoneCount] = fields.zoneCondition;
+            newIndex.zoneStartLBA[newIndex.zoneCount] = fields.zoneStartLBA;
+            newIndex.writePointer[newIndex.zoneCount] = fields.writePointer;
+            newIndex.zoneCapacity[newIndex.zoneCount] = fields.zoneCapacity;
+            newIndex.zoneCount += 1;
+            zoneLocator = fields.zoneStartLBA + fields.zoneLength;
+        }
+    }
+    safe_Free_aligned(report)
+    if (ret != SUCCESS)
+    {
+        free_Zone_Index(&newIndex);
+        return ret;
+    }
+    newIndex.endLBA = zoneLocator;
+    build_Writable_Tree(&newIndex);
+    free_Zone_Index(index);
+    memcpy(index, &newIndex, sizeof(zoneIndex));
+    return SUCCESS;
+}
+
+int find_Zone_In_Index(zoneIndex *index, uint64_t lba, uint32_t *zoneNumber)
+{
+    uint32_t low = 0;
+    uint32_t high = 0;
+    if (!index || !zoneNumber || index->zoneCount == 0 || lba < index->zoneStartLBA[0] || lba >= index->endLBA)
+    {
+        return BAD_PARAMETER;
+    }
+    //find the last zone that starts at or before the LBA
+    high = index->zoneCount - 1;
+    while (low < high)
+    {
+        uint32_t middle = low + (high - low + 1) / 2;
+        if (index->zoneStartLBA[middle] <= lba)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+    *zoneNumber = low;
+    return SUCCESS;
+}
+
+uint64_t get_Zone_Index_Zone_Length(zoneIndex *index, uint32_t zoneNumber)
+{
+    if (!index || zoneNumber >= index->zoneCount)
+    {
+        return 0;
+    }
+    return get_Zone_End(index, zoneNumber) - index->zoneStartLBA[zoneNumber];
+}
+
+uint64_t get_Zone_Index_Zone_Capacity(zoneIndex *index, uint32_t zoneNumber)
+{
+    if (!index || zoneNumber >= index->zoneCount)
+    {
+        return 0;
+    }
+    return get_Zone_Writable_End(index, zoneNumber) - index->zoneStartLBA[zoneNumber];
+}
+
+int refresh_Zone_Index_Range(tDevice *device, zoneIndex *index, uint64_t startLBA, uint64_t lbaCount)
+{
+    int ret = SUCCESS;
+    uint8_t *report = NULL;
+    uint32_t reportSize = 0;
+    uint32_t zoneNumber = 0;
+    uint32_t lastZoneNumber = 0;
+    bool littleEndian = false;
+    if (!device || !index)
+    {
+        return BAD_PARAMETER;
+    }
+    if (SUCCESS != find_Zone_In_Index(index, startLBA, &zoneNumber))
+    {
+        return BAD_PARAMETER;
+    }
+    lastZoneNumber = zoneNumber;
+    if (lbaCount > 1)
+    {
+        uint64_t lastLBA = lbaCount - 1 < index->endLBA - startLBA ? startLBA + lbaCount - 1 : index->endLBA - 1;
+        find_Zone_In_Index(index, lastLBA, &lastZoneNumber);
+    }
+    littleEndian = device->drive_info.drive_type == ATA_DRIVE;
+    //only ask for as many descriptors as there are zones to refresh
+    reportSize = M_Min(get_Zone_Report_Buffer_Size(device), C_CAST(uint32_t, M_Min(C_CAST(uint64_t, lastZoneNumber - zoneNumber) + 2, C_CAST(uint64_t, UINT32_MAX / ZONE_DESCRIPTOR_LENGTH)) * ZONE_DESCRIPTOR_LENGTH));
+    reportSize = ((reportSize + LEGACY_DRIVE_SEC_SIZE - 1) / LEGACY_DRIVE_SEC_SIZE) * LEGACY_DRIVE_SEC_SIZE;
+    report = C_CAST(uint8_t*, calloc_aligned(reportSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!report)
+    {
+        return MEMORY_FAILURE;
+    }
+    while (zoneNumber <= lastZoneNumber)
+    {
+        uint32_t descriptorCount = 0;
+        ret = report_Zones(device, ZONE_REPORT_LIST_ALL_ZONES, true, index->zoneStartLBA[zoneNumber], report, reportSize);
+        if (ret != SUCCESS)
+        {
+            break;
+        }
+        descriptorCount = M_Min(get_Zone_Report_Descriptor_Count(report, reportSize, littleEndian), lastZoneNumber - zoneNumber + 1);
+        if (descriptorCount == 0)
+        {
+            ret = FAILURE;
+            break;
+        }
+        for (uint32_t descriptorIter = 0; descriptorIter < descriptorCount; ++descriptorIter, ++zoneNumber)
+        {
+            zoneDescriptorFields fields;
+            get_Zone_Descriptor(report, descriptorIter, littleEndian, &fields);
+            if (fields.zoneStartLBA != index->zoneStartLBA[zoneNumber] || fields.zoneLength != get_Zone_End(index, zoneNumber) - index->zoneStartLBA[zoneNumber])
+            {
+                //the zone layout is not what was read before, so nothing else in the index can be trusted either
+                safe_Free_aligned(report)
+                return build_Zone_Index(device, index);
+            }
+            set_Zone(index, zoneNumber, fields.zoneType, fields.zoneCondition, fields.writePointer, fields.zoneCapacity);
+        }
+    }
+    safe_Free_aligned(report)
+    return ret;
+}
+
+int get_Next_Writable_LBA(zoneIndex *index, uint64_t lba, uint64_t *writableLBA, uint32_t *zoneNumber)
+{
+    uint32_t zone = 0;
+    uint32_t writableBefore = 0;
+    if (!index || !writableLBA)
+    {
+        return BAD_PARAMETER;
+    }
+    if (lba >= index->endLBA)
+    {
+        return NOT_SUPPORTED;
+    }
+    if (SUCCESS != find_Zone_In_Index(index, lba, &zone))
+    {
+        return BAD_PARAMETER;
+    }
+    if (is_Zone_Writable(index, zone))
+    {
+        if (index->zoneType[zone] == ZONE_TYPE_CONVENTIONAL)
+        {
+            *writableLBA = lba;
+            if (zoneNumber)
+            {
+                *zoneNumber = zone;
+            }
+            return SUCCESS;
+        }
+        else if (index->writePointer[zone] >= lba)
+        {
+            *writableLBA = index->writePointer[zone];
+            if (zoneNumber)
+            {
+                *zoneNumber = zone;
+            }
+            return SUCCESS;
+        }
+    }
+    //skip to the first writable zone after this one
+    writableBefore = writable_Tree_Count_Before(index, zone + 1);
+    if (writableBefore >= index->writableZoneCount)
+    {
+        return NOT_SUPPORTED;
+    }
+    zone = writable_Tree_Find(index, writableBefore + 1);
+    *writableLBA = index->zoneType[zone] == ZONE_TYPE_CONVENTIONAL ? index->zoneStartLBA[zone] : index->writePointer[zone];
+    if (zoneNumber)
+    {
+        *zoneNumber = zone;
+    }
+    return SUCCESS;
+}
+
+void zone_Index_Note_Write(zoneIndex *index, uint64_t lba, uint64_t lbaCount)
+{
+    uint32_t zone = 0;
+    uint64_t writeEnd = 0;
+    if (!index || lbaCount == 0 || SUCCESS != find_Zone_In_Index(index, lba, &zone))
+    {
+        return;
+    }
+    writeEnd = lbaCount < index->endLBA - lba ? lba + lbaCount : index->endLBA;
+    for (; zone < index->zoneCount && index->zoneStartLBA[zone] < writeEnd; ++zone)
+    {
+        uint64_t zoneEnd = get_Zone_Writable_End(index, zone);
+        uint64_t newWritePointer = M_Min(writeEnd, zoneEnd);
+        uint8_t condition = index->zoneCondition[zone];
+        if (!is_Write_Pointer_Zone_Type(index->zoneType[zone]) || newWritePointer <= index->writePointer[zone])
+        {
+            continue;
+        }
+        if (condition != ZONE_CONDITION_EMPTY && condition != ZONE_CONDITION_IMPLICITLY_OPENED && condition != ZONE_CONDITION_EXPLICITLY_OPENED && condition != ZONE_CONDITION_CLOSED)
+        {
+            continue;
+        }
+        if (newWritePointer == zoneEnd)
+        {
+            condition = ZONE_CONDITION_FULL;
+        }
+        else if (condition == ZONE_CONDITION_EMPTY || condition == ZONE_CONDITION_CLOSED)
+        {
+            condition = ZONE_CONDITION_IMPLICITLY_OPENED;
+        }
+        set_Zone(index, zone, index->zoneType[zone], condition, newWritePointer, index->zoneCapacity[zone]);
+    }
+}
+
+int zone_Index_Write_LBA(tDevice *device, zoneIndex *index, uint64_t lba, uint8_t *ptrData, uint32_t dataSize)
+{
+    int ret = SUCCESS;
+    uint32_t lbaCount = 0;
+    if (!device || !index || !ptrData || device->drive_info.deviceBlockSize == 0 || dataSize % device->drive_info.deviceBlockSize != 0)
+    {
+        return BAD_PARAMETER;
+    }
+    lbaCount = dataSize / device->drive_info.deviceBlockSize;
+    ret = write_LBA(device, lba, false, ptrData, dataSize);
+    if (ret == SUCCESS)
+    {
+        zone_Index_Note_Write(index, lba, lbaCount);
+    }
+    else if (ret == FAILURE)
+    {
+        //part of the write may have made it to the media before the error
+        refresh_Zone_Index_Range(device, index, lba, lbaCount);
+    }
+    return ret;
+}
+
+static int refresh_After_Zone_Management(tDevice *device, zoneIndex *index, int managementResult, bool allZones, uint64_t zoneID)
+{
+    int ret = SUCCESS;
+    if (managementResult != SUCCESS && managementResult != FAILURE)
+    {
+        //the command never made it to the device, so no zones have changed
+        return managementResult;
+    }
+    if (allZones)
+    {
+        ret = build_Zone_Index(device, index);
+    }
+    else
+    {
+        ret = refresh_Zone_Index_Range(device, index, zoneID, 0);
+    }
+    return managementResult == SUCCESS ? ret : managementResult;
+}
+
+int zone_Index_Open_Zone(tDevice *device, zoneIndex *index, bool openAll, uint64_t zoneID)
+{
+    if (!device || !index)
+    {
+        return BAD_PARAMETER;
+    }
+    return refresh_After_Zone_Management(device, index, open_Zone(device, openAll, zoneID), openAll, zoneID);
+}
+
+int zone_Index_Close_Zone(tDevice *device, zoneIndex *index, bool closeAll, uint64_t zoneID)
+{
+    if (!device || !index)
+    {
+        return BAD_PARAMETER;
+    }
+    return refresh_After_Zone_Management(device, index, close_Zone(device, closeAll, zoneID), closeAll, zoneID);
+}
+
+int zone_Index_Finish_Zone(tDevice *device, zoneIndex *index, bool finishAll, uint64_t zoneID)
+{
+    if (!device || !index)
+    {
+        return BAD_PARAMETER;
+    }
+    return refresh_After_Zone_Management(device, index, finish_Zone(device, finishAll, zoneID), finishAll, zoneID);
+}
+
+int zone_Index_Reset_Write_Pointer(tDevice *device, zoneIndex *index, bool resetAll, uint64_t zoneID)
+{
+    if (!device || !index)
+    {
+        return BAD_PARAMETER;
+    }
+    return refresh_After_Zone_Management(device, index, reset_Write_Pointer(device, resetAll, zoneID), resetAll, zoneID);
+}
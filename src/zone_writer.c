@@ -0,0 +1,271 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+// \file zone_writer.c
+// \brief Defines a writer that lays a stream of data out sequentially across several open zones of a host managed or host aware device.
+
+#include "zone_writer.h"
+#include "ata_helper_func.h"
+#include "scsi_helper_func.h"
+
+int get_Max_Open_Sequential_Write_Required_Zones(tDevice *device, uint32_t *maxOpenZones)
+{
+    int ret = SUCCESS;
+    if (!device || !maxOpenZones)
+    {
+        return BAD_PARAMETER;
+    }
+    *maxOpenZones = UINT32_MAX;
+    if (device->drive_info.drive_type == ATA_DRIVE)
+    {
+        uint8_t zonedDeviceInformation[LEGACY_DRIVE_SEC_SIZE] = { 0 };
+        ret = ata_Read_Log_Ext(device, ATA_LOG_IDENTIFY_DEVICE_DATA, ATA_ID_DATA_LOG_ZONED_DEVICE_INFORMATION, zonedDeviceInformation, LEGACY_DRIVE_SEC_SIZE, device->drive_info.ata_Options.readLogWriteLogDMASupported, 0);
+        if (ret == SUCCESS)
+        {
+            //page header qword: bit 63 = valid, byte 2 = page number
+            if (!(zonedDeviceInformation[7] & BIT7) || zonedDeviceInformation[2] != ATA_ID_DATA_LOG_ZONED_DEVICE_INFORMATION)
+            {
+                return NOT_SUPPORTED;
+            }
+            //qword 5: maximum number of open sequential write required zones
+            if (zonedDeviceInformation[47] & BIT7)
+            {
+                *maxOpenZones = M_BytesTo4ByteValue(zonedDeviceInformation[43], zonedDeviceInformation[42], zonedDeviceInformation[41], zonedDeviceInformation[40]);
+            }
+        }
+    }
+    else if (device->drive_info.drive_type == SCSI_DRIVE)
+    {
+        uint8_t zonedCharacteristics[64] = { 0 };
+        ret = scsi_Inquiry(device, zonedCharacteristics, 64, ZONED_BLOCK_DEVICE_CHARACTERISTICS, true, false);
+        if (ret == SUCCESS)
+        {
+            if (zonedCharacteristics[1] != ZONED_BLOCK_DEVICE_CHARACTERISTICS)
+            {
+                return NOT_SUPPORTED;
+            }
+            *maxOpenZones = M_BytesTo4ByteValue(zonedCharacteristics[16], zonedCharacteristics[17], zonedCharacteristics[18], zonedCharacteristics[19]);
+        }
+    }
+    else
+    {
+        return NOT_SUPPORTED;
+    }
+    if (*maxOpenZones == 0)
+    {
+        //0 is not a usable limit, so it is the same as not reporting one (host aware devices may leave the field reserved)
+        *maxOpenZones = UINT32_MAX;
+    }
+    return ret;
+}
+
+int start_Zone_Writer(tDevice *device, zoneIndex *index, zoneWriterOptions *options, zoneWriter *writer)
+{
+    uint32_t deviceMaxOpenZones = UINT32_MAX;
+    if (!device || !index || !writer || index->zoneCount == 0 || device->drive_info.deviceBlockSize == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(writer, 0, sizeof(zoneWriter));
+    writer->device = device;
+    writer->index = index;
+    writer->maxOpenZones = ZONE_WRITER_DEFAULT_MAX_OPEN_ZONES;
+    writer->chunkLBAs = M_Max(ZONE_WRITER_DEFAULT_CHUNK_BYTES / device->drive_info.deviceBlockSize, UINT32_C(1));
+    if (options)
+    {
+        if (options->maxOpenZones > 0)
+        {
+            writer->maxOpenZones = options->maxOpenZones;
+        }
+        if (options->chunkLBAs > 0)
+        {
+            writer->chunkLBAs = options->chunkLBAs;
+        }
+        writer->explicitOpen = options->explicitOpen;
+        writer->nextSearchLBA = options->startLBA;
+    }
+    if (SUCCESS == get_Max_Open_Sequential_Write_Required_Zones(device, &deviceMaxOpenZones))
+    {
+        writer->maxOpenZones = M_Min(writer->maxOpenZones, deviceMaxOpenZones);
+    }
+    writer->maxOpenZones = M_Min(writer->maxOpenZones, index->zoneCount);
+    writer->openZones = C_CAST(uint32_t*, calloc(writer->maxOpenZones, sizeof(uint32_t)));
+    if (!writer->openZones)
+    {
+        return MEMORY_FAILURE;
+    }
+    return SUCCESS;
+}
+
+//finds the next writable sequential zone after the last one the writer used and adds it to the open zones
+static int open_Next_Zone(zoneWriter *writer)
+{
+    int ret = SUCCESS;
+    uint32_t zoneNumber = 0;
+    uint64_t writableLBA = 0;
+    do
+    {
+        ret = get_Next_Writable_LBA(writer->index, writer->nextSearchLBA, &writableLBA, &zoneNumber);
+        if (ret != SUCCESS)
+        {
+            return ret;
+        }
+        writer->nextSearchLBA = writer->index->zoneStartLBA[zoneNumber] + get_Zone_Index_Zone_Length(writer->index, zoneNumber);
+    } while (writer->index->zoneType[zoneNumber] == ZONE_TYPE_CONVENTIONAL);
+    if (writer->explicitOpen)
+    {
+        ret = zone_Index_Open_Zone(writer->device, writer->index, false, writer->index->zoneStartLBA[zoneNumber]);
+        if (ret != SUCCESS)
+        {
+            return ret;
+        }
+    }
+    writer->openZones[writer->openZoneCount] = zoneNumber;
+    writer->openZoneCount += 1;
+    return SUCCESS;
+}
+
+static int add_Zone_Writer_Extent(zoneWriter *writer, uint64_t lba, uint64_t lbaCount)
+{
+    if (writer->extentCount > 0)
+    {
+        zoneWriterExtent *last = &writer->extents[writer->extentCount - 1];
+        if (last->lba + last->lbaCount == lba)
+        {
+            //the stream is always contiguous, so this only needs the LBAs to line up
+            last->lbaCount += lbaCount;
+            return SUCCESS;
+        }
+    }
+    if (writer->extentCount == writer->extentCapacity)
+    {
+        uint32_t newCapacity = writer->extentCapacity == 0 ? UINT32_C(64) : writer->extentCapacity * 2;
+        zoneWriterExtent *newExtents = C_CAST(zoneWriterExtent*, realloc(writer->extents, newCapacity * sizeof(zoneWriterExtent)));
+        if (!newExtents)
+        {
+            return MEMORY_FAILURE;
+        }
+        writer->extents = newExtents;
+        writer->extentCapacity = newCapacity;
+    }
+    writer->extents[writer->extentCount].streamOffsetLBAs = writer->streamLBAs;
+    writer->extents[writer->extentCount].lba = lba;
+    writer->extents[writer->extentCount].lbaCount = lbaCount;
+    writer->extentCount += 1;
+    return SUCCESS;
+}
+
+int zone_Writer_Write(zoneWriter *writer, uint8_t *ptrData, uint32_t dataSize)
+{
+    int ret = SUCCESS;
+    uint32_t blockSize = 0;
+    uint64_t remainingLBAs = 0;
+    if (!writer || !writer->openZones || !ptrData)
+    {
+        return BAD_PARAMETER;
+    }
+    blockSize = writer->device->drive_info.deviceBlockSize;
+    if (dataSize % blockSize != 0)
+    {
+        return BAD_PARAMETER;
+    }
+    remainingLBAs = dataSize / blockSize;
+    while (remainingLBAs > 0)
+    {
+        uint32_t slot = 0;
+        uint32_t zoneNumber = 0;
+        uint64_t writePointer = 0;
+        uint64_t zoneEnd = 0;
+        uint64_t lbaCount = 0;
+        while (writer->openZoneCount < writer->maxOpenZones)
+        {
+            ret = open_Next_Zone(writer);
+            if (ret == NOT_SUPPORTED && writer->openZoneCount > 0)
+            {
+                //out of new zones, but the open ones still have room
+                ret = SUCCESS;
+                break;
+            }
+            else if (ret != SUCCESS)
+            {
+                return ret;
+            }
+        }
+        slot = writer->nextOpenZone < writer->openZoneCount ? writer->nextOpenZone : 0;
+        zoneNumber = writer->openZones[slot];
+        writePointer = writer->index->writePointer[zoneNumber];
+        zoneEnd = writer->index->zoneStartLBA[zoneNumber] + get_Zone_Index_Zone_Capacity(writer->index, zoneNumber);
+        lbaCount = M_Min(M_Min(C_CAST(uint64_t, writer->chunkLBAs), remainingLBAs), zoneEnd - writePointer);
+        ret = zone_Index_Write_LBA(writer->device, writer->index, writePointer, ptrData, C_CAST(uint32_t, lbaCount * blockSize));
+        if (ret != SUCCESS)
+        {
+            return ret;
+        }
+        ret = add_Zone_Writer_Extent(writer, writePointer, lbaCount);
+        if (ret != SUCCESS)
+        {
+            return ret;
+        }
+        writer->streamLBAs += lbaCount;
+        remainingLBAs -= lbaCount;
+        ptrData += lbaCount * blockSize;
+        if (writer->index->zoneCondition[zoneNumber] == ZONE_CONDITION_FULL || writer->index->writePointer[zoneNumber] >= zoneEnd)
+        {
+            //the device closes a zone once it is full, so it no longer counts as open. Another zone takes its place on the next pass.
+            memmove(&writer->openZones[slot], &writer->openZones[slot + 1], (writer->openZoneCount - slot - 1) * sizeof(uint32_t));
+            writer->openZoneCount -= 1;
+            writer->nextOpenZone = slot;
+        }
+        else
+        {
+            writer->nextOpenZone = slot + 1;
+        }
+    }
+    return ret;
+}
+
+int end_Zone_Writer(zoneWriter *writer, bool finishZones)
+{
+    int ret = SUCCESS;
+    if (!writer)
+    {
+        return BAD_PARAMETER;
+    }
+    for (uint32_t zoneIter = 0; zoneIter < writer->openZoneCount; ++zoneIter)
+    {
+        int zoneRet = SUCCESS;
+        uint64_t zoneID = writer->index->zoneStartLBA[writer->openZones[zoneIter]];
+        if (finishZones)
+        {
+            zoneRet = zone_Index_Finish_Zone(writer->device, writer->index, false, zoneID);
+        }
+        else
+        {
+            zoneRet = zone_Index_Close_Zone(writer->device, writer->index, false, zoneID);
+        }
+        if (ret == SUCCESS)
+        {
+            ret = zoneRet;
+        }
+    }
+    writer->openZoneCount = 0;
+    writer->nextOpenZone = 0;
+    return ret;
+}
+
+void free_Zone_Writer(zoneWriter *writer)
+{
+    if (writer)
+    {
+        safe_Free(writer->openZones)
+        safe_Free(writer->extents)
+        memset(writer, 0, sizeof(zoneWriter));
+    }
+}